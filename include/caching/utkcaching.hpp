@@ -0,0 +1,578 @@
+//===================================================================================================================================
+// @file	utkcaching.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the LRU caches provided by UTK::Caching. lruCache is the single
+//			threaded building block, shardedLruCache splits keys over independently locked shards
+//			for use from many threads.
+//
+// @note    Entries are intrusive nodes drawn from a per-cache pool, so get/put/erase are O(1) and
+//          the steady state performs no allocations. Lookups are heterogeneous, a cache keyed by
+//          std::string can be queried with a std::string_view or string literal.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include <type_traits>
+#include <string_view>
+#include <functional>
+#include <algorithm>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <memory>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <new>
+
+namespace UTK::Caching {
+
+	/**
+	 * @brief Hit/miss/eviction accounting, shared by every cache in UTK::Caching
+	 */
+	struct cacheStats {
+		std::uint64_t hits = 0;
+		std::uint64_t misses = 0;
+		std::uint64_t insertions = 0;
+		std::uint64_t evictions = 0;
+		std::uint64_t expirations = 0;	// Entries removed because their time to live ran out
+		std::uint64_t rejections = 0;	// New entries turned away by an admission policy
+
+		cacheStats& operator+=(const cacheStats& other);
+
+		/// Fraction of lookups that hit, 0 when nothing has been looked up yet
+		double hitRate() const;
+	};
+
+	/**
+	 * @brief Capacity limits, either or both may be set. A limit of 0 leaves that dimension unbounded.
+	 */
+	struct cacheCapacity {
+		std::size_t maxEntries = 0;
+		std::size_t maxBytes = 0;
+	};
+
+	/**
+	 * @brief Returns a power of two shard count suited to the machine's hardware concurrency
+	 */
+	std::size_t defaultShardCount();
+
+	/**
+	 * @brief Finalizes a hash so its high bits are usable for shard selection
+	 */
+	constexpr std::uint64_t mixHash(std::uint64_t hash) noexcept {
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdULL;
+		hash ^= hash >> 33;
+		hash *= 0xc4ceb9fe1a85ec53ULL;
+		hash ^= hash >> 33;
+		return hash;
+	}
+
+	/**
+	 * @brief Transparent hash, strings of every flavour hash identically so they can be looked up interchangeably
+	 */
+	struct cacheHash {
+		using is_transparent = void;
+
+		std::size_t operator()(std::string_view key) const noexcept {
+			return std::hash<std::string_view>{}(key);
+		}
+		std::size_t operator()(const std::string& key) const noexcept {
+			return std::hash<std::string_view>{}(key);
+		}
+		std::size_t operator()(const char* key) const noexcept {
+			return std::hash<std::string_view>{}(key);
+		}
+
+		template<typename T>
+			requires (!std::is_convertible_v<const T&, std::string_view>)
+		std::size_t operator()(const T& key) const noexcept {
+			return std::hash<T>{}(key);
+		}
+	};
+
+	/**
+	 * @brief Default weigher used by byte budgets: inline size plus any heap buffer the key and value own
+	 */
+	struct cacheWeigher {
+	private:
+		template<typename T>
+		static std::size_t heapBytes(const T& item) {
+			if constexpr (requires { item.capacity(); typename T::value_type; }) {
+				return item.capacity() * sizeof(typename T::value_type);
+			}
+			else {
+				return 0;
+			}
+		}
+
+	public:
+		template<typename Key, typename Value>
+		std::size_t operator()(const Key& key, const Value& value) const {
+			return sizeof(Key) + sizeof(Value) + heapBytes(key) + heapBytes(value);
+		}
+	};
+
+	namespace Internal {
+
+		/**
+		 * @brief Block allocator handing out storage for intrusive cache nodes, released nodes are reused
+		 */
+		template<typename Node>
+		class nodePool {
+		private:
+			/// Placed in the storage of released nodes to thread them onto the free list
+			struct freeNode {
+				freeNode* next;
+			};
+
+			static constexpr std::size_t blockSize = 64;
+			static_assert(alignof(Node) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Pooled nodes rely on the default new alignment");
+			static_assert(sizeof(Node) >= sizeof(freeNode), "Pooled nodes must be able to hold a free list link");
+
+			std::vector<std::unique_ptr<std::byte[]>> _blocks;
+			freeNode* _free = nullptr;
+
+		public:
+			/// Returns uninitialized storage for one Node
+			void* allocate() {
+				if (!_free) {
+					// Grow the pool a block at a time and thread the new storage onto the free list
+					auto block = std::make_unique<std::byte[]>(sizeof(Node) * blockSize);
+					for (std::size_t i = blockSize; i-- > 0;) {
+						_free = new (block.get() + i * sizeof(Node)) freeNode{ _free };
+					}
+					_blocks.push_back(std::move(block));
+				}
+
+				freeNode* result = _free;
+				_free = result->next;
+				return result;
+			}
+
+			/// Destroys the node and returns its storage to the pool
+			void release(Node* n) {
+				n->~Node();
+				_free = new (n) freeNode{ _free };
+			}
+		};
+
+		/**
+		 * @brief Doubly linked recency list over nodes exposing prev/next members, head is most recent
+		 */
+		template<typename Node>
+		struct intrusiveList {
+			Node* head = nullptr;
+			Node* tail = nullptr;
+			std::size_t size = 0;
+
+			void pushFront(Node* n) {
+				n->prev = nullptr;
+				n->next = head;
+				(head ? head->prev : tail) = n;
+				head = n;
+				size++;
+			}
+			void unlink(Node* n) {
+				(n->prev ? n->prev->next : head) = n->next;
+				(n->next ? n->next->prev : tail) = n->prev;
+				size--;
+			}
+			void moveToFront(Node* n) {
+				if (n == head) return;
+				unlink(n);
+				pushFront(n);
+			}
+		};
+
+		/**
+		 * @brief Chained hash table over nodes exposing chain/hash/key members, sized to a power of two
+		 */
+		template<typename Node>
+		class intrusiveTable {
+		private:
+			std::vector<Node*> _buckets;
+			std::size_t _size = 0;
+
+			std::size_t bucketOf(std::size_t hash) const {
+				return hash & (_buckets.size() - 1);
+			}
+
+			void rehash(std::size_t bucketCount) {
+				std::vector<Node*> buckets(bucketCount, nullptr);
+				for (Node* head : _buckets) {
+					while (head) {
+						Node* next = head->chain;
+						std::size_t index = head->hash & (bucketCount - 1);
+						head->chain = buckets[index];
+						buckets[index] = head;
+						head = next;
+					}
+				}
+				_buckets.swap(buckets);
+			}
+
+		public:
+			template<typename K, typename Equal>
+			Node* find(const K& key, std::size_t hash, const Equal& equal) const {
+				if (_buckets.empty()) return nullptr;
+
+				for (Node* n = _buckets[bucketOf(hash)]; n; n = n->chain) {
+					if (n->hash == hash && equal(n->key, key)) return n;
+				}
+				return nullptr;
+			}
+
+			void insert(Node* n) {
+				if (_size + 1 > _buckets.size()) {
+					rehash(_buckets.empty() ? 16 : _buckets.size() * 2);
+				}
+
+				std::size_t index = bucketOf(n->hash);
+				n->chain = _buckets[index];
+				_buckets[index] = n;
+				_size++;
+			}
+
+			void remove(Node* n) {
+				Node** link = &_buckets[bucketOf(n->hash)];
+				while (*link != n) link = &(*link)->chain;
+				*link = n->chain;
+				_size--;
+			}
+
+			void clear() {
+				std::fill(_buckets.begin(), _buckets.end(), nullptr);
+				_size = 0;
+			}
+		};
+	}
+
+	/**
+	 * @brief Single threaded LRU cache with O(1) get/put/erase over pooled intrusive nodes
+	 *
+	 * @tparam Key:		 Stored key type.
+	 * @tparam Value:	 Stored value type.
+	 * @tparam Hash:	 Hash functor, must be transparent for heterogeneous lookups.
+	 * @tparam KeyEqual: Equality functor, must be transparent for heterogeneous lookups.
+	 * @tparam Weigher:	 Functor returning the byte cost of an entry, used when a byte budget is set.
+	 */
+	template<typename Key, typename Value,
+		typename Hash = cacheHash, typename KeyEqual = std::equal_to<>, typename Weigher = cacheWeigher>
+	class lruCache {
+	private:
+		struct node {
+			node* prev;
+			node* next;
+			node* chain;			// Next node in the same hash bucket
+			std::size_t hash;
+			std::size_t weight;
+			Key key;
+			Value value;
+		};
+
+		cacheCapacity _capacity;
+		Hash _hash;
+		KeyEqual _equal;
+		Weigher _weigher;
+
+		Internal::nodePool<node> _pool;
+		Internal::intrusiveTable<node> _table;
+		Internal::intrusiveList<node> _list;		// Head is the most recently used, tail the next eviction
+		std::size_t _bytes = 0;
+		cacheStats _stats;
+
+		void removeNode(node* n) {
+			_table.remove(n);
+			_list.unlink(n);
+			_bytes -= n->weight;
+			_pool.release(n);
+		}
+
+		bool overCapacity() const {
+			return (_capacity.maxEntries && _list.size > _capacity.maxEntries) ||
+				   (_capacity.maxBytes && _bytes > _capacity.maxBytes);
+		}
+		void evict() {
+			while (_list.tail && overCapacity()) {
+				removeNode(_list.tail);
+				_stats.evictions++;
+			}
+		}
+
+	public:
+		explicit lruCache(cacheCapacity capacity = {}, Hash hash = {}, KeyEqual equal = {}, Weigher weigher = {})
+			: _capacity(capacity), _hash(std::move(hash)), _equal(std::move(equal)), _weigher(std::move(weigher))
+		{
+			;
+		}
+		~lruCache() {
+			clear();
+		}
+
+		lruCache(const lruCache&) = delete;
+		lruCache& operator=(const lruCache&) = delete;
+
+		/**
+		 * @brief Looks up a key and marks it most recently used
+		 *
+		 * @return Pointer to the cached value, valid until the next mutating call. nullptr on a miss.
+		 */
+		template<typename K>
+		Value* get(const K& key) {
+			return get(key, _hash(key));
+		}
+
+		/// Overload for callers that already hashed the key(e.g. to pick a shard)
+		template<typename K>
+		Value* get(const K& key, std::size_t hash) {
+			node* n = _table.find(key, hash, _equal);
+			if (!n) {
+				_stats.misses++;
+				return nullptr;
+			}
+
+			_stats.hits++;
+			_list.moveToFront(n);
+			return &n->value;
+		}
+
+		/**
+		 * @brief Checks for a key without touching its recency or the counters
+		 */
+		template<typename K>
+		bool contains(const K& key) const {
+			return _table.find(key, _hash(key), _equal) != nullptr;
+		}
+
+		/**
+		 * @brief Inserts or replaces an entry, then evicts least recently used entries until within capacity
+		 *
+		 * @return True if the key was newly inserted.
+		 */
+		bool put(Key key, Value value) {
+			const std::size_t hash = _hash(key);
+			return put(std::move(key), std::move(value), hash);
+		}
+
+		/// Overload for callers that already hashed the key(e.g. to pick a shard)
+		bool put(Key key, Value value, std::size_t hash) {
+
+			if (node* n = _table.find(key, hash, _equal)) {
+				const std::size_t weight = _capacity.maxBytes ? _weigher(n->key, value) : 0;
+				_bytes = _bytes - n->weight + weight;
+				n->weight = weight;
+				n->value = std::move(value);
+				_list.moveToFront(n);
+				evict();
+				return false;
+			}
+
+			const std::size_t weight = _capacity.maxBytes ? _weigher(key, value) : 0;
+			node* n = new (_pool.allocate()) node{ nullptr, nullptr, nullptr, hash, weight, std::move(key), std::move(value) };
+
+			_table.insert(n);
+			_list.pushFront(n);
+
+			_bytes += weight;
+			_stats.insertions++;
+
+			evict();
+			return true;
+		}
+
+		/**
+		 * @brief Removes an entry if present
+		 */
+		template<typename K>
+		bool erase(const K& key) {
+			return erase(key, _hash(key));
+		}
+
+		template<typename K>
+		bool erase(const K& key, std::size_t hash) {
+			node* n = _table.find(key, hash, _equal);
+			if (!n) return false;
+
+			removeNode(n);
+			return true;
+		}
+
+		/**
+		 * @brief Removes every entry, pooled node storage is kept for reuse
+		 */
+		void clear() {
+			while (node* n = _list.head) {
+				_list.unlink(n);
+				_pool.release(n);
+			}
+			_table.clear();
+			_bytes = 0;
+		}
+
+		/**
+		 * @brief Applies new limits, evicting straight away if the cache is now over them
+		 */
+		void setCapacity(cacheCapacity capacity) {
+			_capacity = capacity;
+			evict();
+		}
+
+		std::size_t size() const { return _list.size; }
+		std::size_t bytes() const { return _bytes; }
+		cacheCapacity capacity() const { return _capacity; }
+		const cacheStats& stats() const { return _stats; }
+		void resetStats() { _stats = {}; }
+	};
+
+	/**
+	 * @brief Thread safe LRU cache made of independently locked lruCache shards
+	 *
+	 * @note Recency is tracked per shard, so eviction order is approximately(not strictly) LRU across
+	 *		 the whole cache. Capacity limits are split evenly between the shards.
+	 */
+	template<typename Key, typename Value,
+		typename Hash = cacheHash, typename KeyEqual = std::equal_to<>, typename Weigher = cacheWeigher>
+	class shardedLruCache {
+	private:
+		using shardCache = lruCache<Key, Value, Hash, KeyEqual, Weigher>;
+
+		/// Each shard on its own cache lines so neighbouring locks do not false share
+		struct alignas(64) shard {
+			mutable std::mutex mutex;
+			shardCache cache;
+
+			shard(cacheCapacity capacity, const Hash& hash, const KeyEqual& equal, const Weigher& weigher)
+				: cache(capacity, hash, equal, weigher) {}
+		};
+
+		Hash _hash;
+		std::vector<std::unique_ptr<shard>> _shards;
+		unsigned _shardShift = 0;
+
+		static cacheCapacity splitCapacity(cacheCapacity capacity, std::size_t shards) {
+			auto split = [shards](std::size_t limit) { return limit ? (limit + shards - 1) / shards : 0; };
+			return { split(capacity.maxEntries), split(capacity.maxBytes) };
+		}
+
+		/// Shard from the high bits, the low bits already pick the bucket inside the shard
+		shard& shardFor(std::size_t hash) const {
+			return *_shards[_shardShift >= 64 ? 0 : static_cast<std::size_t>(mixHash(hash) >> _shardShift)];
+		}
+
+	public:
+		/**
+		 * @param capacity:	  Total limits across all shards.
+		 * @param shardCount: Number of shards, rounded up to a power of two(0 picks from the hardware concurrency).
+		 */
+		explicit shardedLruCache(cacheCapacity capacity = {}, std::size_t shardCount = 0,
+			Hash hash = {}, KeyEqual equal = {}, Weigher weigher = {})
+			: _hash(std::move(hash))
+		{
+			std::size_t count = 1;
+			while (count < (shardCount ? shardCount : defaultShardCount())) count <<= 1;
+
+			unsigned bits = 0;
+			while ((std::size_t{ 1 } << bits) < count) bits++;
+			_shardShift = 64 - bits;
+
+			_shards.reserve(count);
+			for (std::size_t i = 0; i < count; i++) {
+				_shards.push_back(std::make_unique<shard>(splitCapacity(capacity, count), _hash, equal, weigher));
+			}
+		}
+
+		/**
+		 * @brief Looks up a key, copying the value out under the shard lock
+		 */
+		template<typename K>
+		std::optional<Value> get(const K& key) {
+			const std::size_t hash = _hash(key);
+			shard& s = shardFor(hash);
+
+			std::lock_guard<std::mutex> lock(s.mutex);
+			if (Value* value = s.cache.get(key, hash)) return *value;
+			return std::nullopt;
+		}
+
+		/**
+		 * @brief Inserts or replaces an entry
+		 *
+		 * @return True if the key was newly inserted.
+		 */
+		bool put(Key key, Value value) {
+			const std::size_t hash = _hash(key);
+			shard& s = shardFor(hash);
+
+			std::lock_guard<std::mutex> lock(s.mutex);
+			return s.cache.put(std::move(key), std::move(value), hash);
+		}
+
+		/**
+		 * @brief Memoization helper, returns the cached value or computes, stores and returns it
+		 *
+		 * @note compute runs outside the shard lock, so concurrent misses on one key may each compute it.
+		 */
+		template<typename K, typename Compute>
+		Value getOrCompute(const K& key, Compute&& compute) {
+			if (auto cached = get(key)) return std::move(*cached);
+
+			Value value = std::invoke(std::forward<Compute>(compute), key);
+			put(Key(key), value);
+			return value;
+		}
+
+		template<typename K>
+		bool erase(const K& key) {
+			const std::size_t hash = _hash(key);
+			shard& s = shardFor(hash);
+
+			std::lock_guard<std::mutex> lock(s.mutex);
+			return s.cache.erase(key, hash);
+		}
+
+		void clear() {
+			for (auto& s : _shards) {
+				std::lock_guard<std::mutex> lock(s->mutex);
+				s->cache.clear();
+			}
+		}
+
+		std::size_t size() const {
+			std::size_t total = 0;
+			for (const auto& s : _shards) {
+				std::lock_guard<std::mutex> lock(s->mutex);
+				total += s->cache.size();
+			}
+			return total;
+		}
+
+		std::size_t bytes() const {
+			std::size_t total = 0;
+			for (const auto& s : _shards) {
+				std::lock_guard<std::mutex> lock(s->mutex);
+				total += s->cache.bytes();
+			}
+			return total;
+		}
+
+		/**
+		 * @brief Counters summed over every shard
+		 */
+		cacheStats stats() const {
+			cacheStats total;
+			for (const auto& s : _shards) {
+				std::lock_guard<std::mutex> lock(s->mutex);
+				total += s->cache.stats();
+			}
+			return total;
+		}
+
+		std::size_t shardCount() const { return _shards.size(); }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,389 @@
+//===================================================================================================================================
+// @file	utkttlcache.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the time-bounded cache provided by UTK::Caching, along with the
+//			hierarchical timing wheel and frequency sketch it is built from.
+//
+// @note    Expiry is driven by the timing wheel, so each operation only touches the entries that
+//          are actually due(amortized O(1)) instead of sweeping the cache. Admission follows
+//          W-TinyLFU: new entries land in a small LRU window and only displace a main-space entry
+//          when the frequency sketch has seen them more often, which keeps one-off scans from
+//          flushing hot data.
+//===================================================================================================================================
+
+#pragma once
+
+#include "caching/utkcaching.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <array>
+#include <span>
+
+namespace UTK::Caching {
+
+	/**
+	 * @brief Eviction/admission policies supported by ttlCache
+	 */
+	enum class cachePolicy {
+		LRU,				// Plain recency, every new entry is admitted
+		WINDOW_TINY_LFU		// 1% LRU window in front of a segmented LRU guarded by a frequency filter
+	};
+
+	/**
+	 * @brief Intrusive hook for entries scheduled on a timingWheel
+	 */
+	struct timerNode {
+		timerNode* timerPrev = nullptr;
+		timerNode* timerNext = nullptr;		// nullptr while the node is not scheduled
+		std::uint64_t expiry = 0;			// Tick at which the node expires
+	};
+
+	/**
+	 * @brief Hierarchical timing wheel, four levels of 64 slots covering 2^24 ticks before wrapping
+	 *
+	 * @note Scheduling and cancelling are O(1). Advancing jumps straight to the next occupied slot or
+	 *		 cascade boundary, found from a per-level occupancy bitmap, so idle time costs nothing and each
+	 *		 timer is re-slotted at most once per level it cascades through.
+	 */
+	class timingWheel {
+	private:
+		static constexpr unsigned levelBits = 6;
+		static constexpr std::size_t levelSlots = std::size_t{ 1 } << levelBits;
+		static constexpr std::size_t levels = 4;
+
+		std::array<std::array<timerNode, levelSlots>, levels> _slots;	// Circular lists headed by sentinels
+		timerNode _due;													// Expired timers waiting to be popped
+		std::uint64_t _current = 0;
+		std::size_t _pending = 0;										// Timers in the wheel slots, excludes _due
+		std::array<std::uint64_t, levels> _occupied{};					// Bit per slot that may hold timers, cleared lazily
+
+		static void linkBefore(timerNode& sentinel, timerNode* n);
+		static void unlink(timerNode* n);
+
+		void place(timerNode* n);
+		void cascade(std::size_t level, std::size_t slot);
+		std::uint64_t nextEvent();
+		void step(std::uint64_t tick);
+
+	public:
+		explicit timingWheel(std::uint64_t startTick = 0);
+
+		timingWheel(const timingWheel&) = delete;
+		timingWheel& operator=(const timingWheel&) = delete;
+
+		/**
+		 * @brief Schedules(or reschedules) a node to expire at the given tick
+		 */
+		void schedule(timerNode* n, std::uint64_t expiryTick);
+
+		/**
+		 * @brief Removes a node from the wheel if it is scheduled
+		 */
+		void cancel(timerNode* n);
+
+		/**
+		 * @brief Advances the wheel towards tick and returns the next expired node, nullptr once caught up
+		 */
+		timerNode* popExpired(std::uint64_t tick);
+
+		std::uint64_t now() const { return _current; }
+	};
+
+	/**
+	 * @brief Count-min sketch of 4-bit saturating counters with periodic halving(aging)
+	 */
+	class frequencySketch {
+	private:
+		std::vector<std::uint8_t> _counters;
+		std::size_t _mask = 0;
+		std::uint64_t _additions = 0;
+		std::uint64_t _sampleSize = 0;
+
+		static constexpr std::size_t depth = 4;
+
+		std::size_t indexOf(std::uint64_t hash, std::size_t row) const;
+		void age();
+
+	public:
+		/**
+		 * @param capacity: Expected number of distinct hot keys, sizes the sketch and its aging period.
+		 */
+		explicit frequencySketch(std::size_t capacity);
+
+		void increment(std::uint64_t hash);
+		unsigned frequency(std::uint64_t hash) const;
+	};
+
+	/**
+	 * @brief Settings for ttlCache
+	 */
+	struct ttlOptions {
+		std::size_t maxEntries = 1024;
+		std::chrono::nanoseconds defaultTtl{ 0 };							// 0 means entries never expire
+		std::chrono::nanoseconds tickResolution = std::chrono::milliseconds(1);
+		cachePolicy policy = cachePolicy::WINDOW_TINY_LFU;
+	};
+
+	/**
+	 * @brief Single threaded cache with per-entry time to live and a selectable admission policy
+	 *
+	 * @tparam Clock: Clock providing now(), replaceable for deterministic tests.
+	 */
+	template<typename Key, typename Value,
+		typename Hash = cacheHash, typename KeyEqual = std::equal_to<>, typename Clock = std::chrono::steady_clock>
+	class ttlCache {
+	private:
+		enum class segment : std::uint8_t { WINDOW, PROBATION, PROTECTED };
+
+		struct node : timerNode {
+			node* prev;
+			node* next;
+			node* chain;
+			std::size_t hash;
+			segment seg;
+			Key key;
+			Value value;
+
+			node(std::size_t h, Key&& k, Value&& v)
+				: prev(nullptr), next(nullptr), chain(nullptr), hash(h), seg(segment::WINDOW), key(std::move(k)), value(std::move(v)) {}
+		};
+
+		ttlOptions _options;
+		Hash _hash;
+		KeyEqual _equal;
+		typename Clock::time_point _epoch;
+
+		Internal::nodePool<node> _pool;
+		Internal::intrusiveTable<node> _table;
+		Internal::intrusiveList<node> _window;
+		Internal::intrusiveList<node> _probation;
+		Internal::intrusiveList<node> _protected;
+		timingWheel _wheel;
+		frequencySketch _sketch;
+		cacheStats _stats;
+
+		std::size_t _windowMax = 0;
+		std::size_t _protectedMax = 0;
+
+		std::uint64_t nowTick() const {
+			auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _epoch);
+			return static_cast<std::uint64_t>(elapsed.count() / _options.tickResolution.count());
+		}
+		std::uint64_t expiryTick(std::chrono::nanoseconds ttl) const {
+			const auto ticks = (ttl.count() + _options.tickResolution.count() - 1) / _options.tickResolution.count();
+			return nowTick() + static_cast<std::uint64_t>(std::max<std::int64_t>(ticks, 1));
+		}
+
+		Internal::intrusiveList<node>& listOf(node* n) {
+			switch (n->seg) {
+				case segment::PROBATION: return _probation;
+				case segment::PROTECTED: return _protected;
+				case segment::WINDOW:
+				default:				 return _window;
+			}
+		}
+		std::size_t size() const {
+			return _window.size + _probation.size + _protected.size;
+		}
+
+		void removeNode(node* n) {
+			_wheel.cancel(n);
+			_table.remove(n);
+			listOf(n).unlink(n);
+			_pool.release(n);
+		}
+
+		void expireDue() {
+			const std::uint64_t tick = nowTick();
+			while (timerNode* expired = _wheel.popExpired(tick)) {
+				removeNode(static_cast<node*>(expired));
+				_stats.expirations++;
+			}
+		}
+
+		/// Segmented LRU promotion: probation hits move to protected, protected overflow drops back to probation
+		void onAccess(node* n) {
+			if (n->seg != segment::PROBATION) {
+				listOf(n).moveToFront(n);
+				return;
+			}
+
+			_probation.unlink(n);
+			n->seg = segment::PROTECTED;
+			_protected.pushFront(n);
+
+			if (_protected.size > _protectedMax) {
+				node* demoted = _protected.tail;
+				_protected.unlink(demoted);
+				demoted->seg = segment::PROBATION;
+				_probation.pushFront(demoted);
+			}
+		}
+
+		void evict() {
+			if (_options.policy == cachePolicy::LRU) {
+				while (size() > _options.maxEntries && _window.tail) {
+					removeNode(_window.tail);
+					_stats.evictions++;
+				}
+				return;
+			}
+
+			// Window overflow moves to probation as a candidate for the main space
+			while (_window.size > _windowMax) {
+				node* candidate = _window.tail;
+				_window.unlink(candidate);
+				candidate->seg = segment::PROBATION;
+				_probation.pushFront(candidate);
+
+				if (size() <= _options.maxEntries) continue;
+
+				node* victim = (_probation.tail != candidate) ? _probation.tail : _protected.tail;
+				if (victim && _sketch.frequency(candidate->hash) > _sketch.frequency(victim->hash)) {
+					removeNode(victim);
+					_stats.evictions++;
+				}
+				else {
+					removeNode(candidate);
+					_stats.rejections++;
+				}
+			}
+		}
+
+	public:
+		explicit ttlCache(ttlOptions options = {}, Hash hash = {}, KeyEqual equal = {})
+			: _options(options), _hash(std::move(hash)), _equal(std::move(equal)), _epoch(Clock::now()),
+			  _sketch(std::max<std::size_t>(options.maxEntries, 1))
+		{
+			_options.maxEntries = std::max<std::size_t>(_options.maxEntries, 1);
+			if (_options.tickResolution.count() <= 0) _options.tickResolution = std::chrono::nanoseconds(1);
+
+			_windowMax = (_options.policy == cachePolicy::LRU)
+				? _options.maxEntries
+				: std::max<std::size_t>(_options.maxEntries / 100, 1);
+			_protectedMax = (_options.maxEntries - std::min(_windowMax, _options.maxEntries)) * 8 / 10;
+		}
+		~ttlCache() {
+			clear();
+		}
+
+		ttlCache(const ttlCache&) = delete;
+		ttlCache& operator=(const ttlCache&) = delete;
+
+		/**
+		 * @brief Looks up a live entry, expired entries are treated as misses
+		 *
+		 * @return Pointer to the cached value, valid until the next mutating call. nullptr on a miss.
+		 */
+		template<typename K>
+		Value* get(const K& key) {
+			expireDue();
+
+			const std::size_t hash = _hash(key);
+			_sketch.increment(hash);
+
+			node* n = _table.find(key, hash, _equal);
+			if (!n) {
+				_stats.misses++;
+				return nullptr;
+			}
+
+			_stats.hits++;
+			onAccess(n);
+			return &n->value;
+		}
+
+		/**
+		 * @brief Inserts or replaces an entry using the default time to live
+		 */
+		bool put(Key key, Value value) {
+			return put(std::move(key), std::move(value), _options.defaultTtl);
+		}
+
+		/**
+		 * @brief Inserts or replaces an entry with its own time to live(0 never expires)
+		 *
+		 * @return True if the key was newly inserted, an inserted key may still be rejected by admission.
+		 */
+		bool put(Key key, Value value, std::chrono::nanoseconds ttl) {
+			expireDue();
+
+			const std::size_t hash = _hash(key);
+			_sketch.increment(hash);
+
+			node* n = _table.find(key, hash, _equal);
+			const bool inserted = (n == nullptr);
+
+			if (n) {
+				n->value = std::move(value);
+				onAccess(n);
+			}
+			else {
+				n = new (_pool.allocate()) node(hash, std::move(key), std::move(value));
+				_table.insert(n);
+				_window.pushFront(n);
+				_stats.insertions++;
+			}
+
+			if (ttl.count() > 0) {
+				_wheel.schedule(n, expiryTick(ttl));
+			}
+			else {
+				_wheel.cancel(n);
+			}
+
+			evict();
+			return inserted;
+		}
+
+		template<typename K>
+		bool erase(const K& key) {
+			node* n = _table.find(key, _hash(key), _equal);
+			if (!n) return false;
+
+			removeNode(n);
+			return true;
+		}
+
+		/**
+		 * @brief Removes every entry whose time to live has run out, without needing a lookup
+		 */
+		void expire() {
+			expireDue();
+		}
+
+		void clear() {
+			for (auto* list : { &_window, &_probation, &_protected }) {
+				while (node* n = list->head) {
+					_wheel.cancel(n);
+					list->unlink(n);
+					_pool.release(n);
+				}
+			}
+			_table.clear();
+		}
+
+		std::size_t entries() const { return size(); }
+		const cacheStats& stats() const { return _stats; }
+		void resetStats() { _stats = {}; }
+		cachePolicy policy() const { return _options.policy; }
+	};
+
+	/**
+	 * @brief Hit rate of one policy over a replayed access trace
+	 */
+	struct policyResult {
+		cachePolicy policy;
+		cacheStats stats;
+	};
+
+	/**
+	 * @brief Replays a trace of key hashes through every cachePolicy at the given capacity, each access
+	 *		  is a get followed by a put on a miss. Use it to pick a policy from real access patterns.
+	 */
+	std::vector<policyResult> evaluatePolicies(std::span<const std::uint64_t> trace, std::size_t capacity);
+}
\ No newline at end of file
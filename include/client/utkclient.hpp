@@ -0,0 +1,133 @@
+//===================================================================================================================================
+// @file	utkclient.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the HTTP/1.1 client provided by UTK::Client, built for pulling large
+//			numbers of small resources from internal endpoints.
+//
+// @note    Every client runs one event loop thread(epoll) that owns all of its sockets. Connections to a
+//          host are kept alive and reused, capped per host, and GET/HEAD requests are pipelined several deep
+//          on each one. Responses are parsed in the buffer they were read into and handed out as views of
+//          it, so a body is never copied after it comes off the socket. Plain http:// only, no TLS.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include <string_view>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <future>
+#include <memory>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace UTK::Client {
+
+	namespace Internal {
+		class eventLoop;
+	}
+
+	struct request {
+		std::string method = "GET";
+		std::string url;											// http://host[:port]/path?query
+		std::vector<std::pair<std::string, std::string>> headers;	// Host and Content-Length are added when missing
+		std::string body;
+	};
+
+	/**
+	 * @brief A complete response, its views stay valid for as long as the response object lives
+	 *
+	 * @note Responses read together share the receive buffer they were parsed in, the buffer is freed once
+	 *		 the last of them is destroyed.
+	 */
+	class response {
+	private:
+		friend class Internal::eventLoop;
+
+		std::shared_ptr<const char[]> _storage;
+		int _status = 0;
+		std::string_view _reason;
+		std::vector<std::pair<std::string_view, std::string_view>> _headers;
+		std::string_view _body;
+
+	public:
+		response() = default;
+
+		int status() const { return _status; }
+		std::string_view reason() const { return _reason; }
+		std::string_view body() const { return _body; }
+
+		/**
+		 * @brief Header fields in the order received, names exactly as the server wrote them
+		 */
+		const std::vector<std::pair<std::string_view, std::string_view>>& headers() const { return _headers; }
+
+		/**
+		 * @brief First header whose name matches case-insensitively
+		 */
+		std::optional<std::string_view> header(std::string_view name) const;
+	};
+
+	struct clientOptions {
+		std::size_t maxConnectionsPerHost = 6;
+		std::size_t maxPipelineDepth = 16;							// In-flight requests per connection, 1 disables pipelining
+		std::chrono::milliseconds timeout{ 30000 };					// From submission to the last byte of the response
+		std::chrono::milliseconds idleTimeout{ 60000 };				// Idle pooled connections are closed after this
+		std::size_t maxResponseBytes = std::size_t(64) << 20;		// Headers plus body, capped at 4GB
+	};
+
+	/**
+	 * @brief Running totals, mostly to confirm pooling and pipelining are doing their job
+	 */
+	struct clientStats {
+		std::uint64_t connectionsOpened = 0;
+		std::uint64_t requestsSent = 0;
+		std::uint64_t responsesReceived = 0;
+		std::uint64_t retries = 0;					// Idempotent requests resent after a connection dropped
+		std::uint64_t failures = 0;
+		std::size_t maxInFlight = 0;				// Deepest pipeline seen on a single connection
+	};
+
+	/**
+	 * @brief Connection-pooled, pipelined HTTP/1.1 client
+	 *
+	 * @note Thread safe, any thread may submit. Only GET and HEAD are pipelined or retried after a dropped
+	 *		 connection, other methods wait for a connection of their own. Requests time out with a
+	 *		 resolution of about 100ms.
+	 */
+	class httpClient {
+	private:
+		std::unique_ptr<Internal::eventLoop> _loop;
+
+	public:
+		explicit httpClient(clientOptions options = {});
+		~httpClient();
+
+		httpClient(const httpClient&) = delete;
+		httpClient& operator=(const httpClient&) = delete;
+
+		/**
+		 * @brief Queues a request, the future throws std::runtime_error if it fails or times out
+		 *
+		 * @note Requests still outstanding when the client is destroyed fail.
+		 */
+		std::future<response> fetch(request req);
+
+		/**
+		 * @brief Queues a batch with a single wakeup of the event loop, futures are in request order
+		 */
+		std::vector<std::future<response>> fetchAll(std::vector<request> requests);
+
+		/**
+		 * @brief Blocking GET
+		 */
+		response get(std::string_view url);
+
+		clientStats stats() const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+//===================================================================================================================================
+// @file	utkconsole.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Internal header shared by the tools that draw straight to stdout(the terminal sink and the
+//			progress bars), finds out whether stdout is a terminal and writes whole buffers to it.
+//
+// @note    Header only so each tool library stays free of a link dependency on the others. Not part of
+//			the public API.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include <system_error>
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <cerrno>
+
+#if defined(__WINDOWS__)
+#include <io.h>
+#else
+#include <unistd.h>
+#include <poll.h>
+#endif
+
+namespace UTK::Core::Internal {
+
+	/**
+	 * @brief True when stdout is attached to a terminal rather than a file or pipe
+	 */
+	inline bool stdoutIsTerminal() {
+#if defined(__WINDOWS__)
+		return _isatty(_fileno(stdout)) != 0;
+#else
+		return isatty(STDOUT_FILENO) != 0;
+#endif
+	}
+
+	/**
+	 * @brief Hands all of data to the OS, bypassing stdio and iostream buffering
+	 *
+	 * @note Interrupted writes are retried. A non-blocking stdout that is full is waited on until it is
+	 *		 writable again rather than losing the rest of the buffer. Throws std::system_error on any other
+	 *		 failure, with whatever was written before it left in place.
+	 */
+	inline void writeStdout(const char* data, std::size_t size) {
+
+		while (size > 0) {
+#if defined(__WINDOWS__)
+			int written = _write(_fileno(stdout), data, static_cast<unsigned int>(std::min<std::size_t>(size, INT_MAX)));
+#else
+			ssize_t written = ::write(STDOUT_FILENO, data, size);
+#endif
+			if (written < 0) {
+				if (errno == EINTR) continue;
+#if !defined(__WINDOWS__)
+				if (errno == EAGAIN || errno == EWOULDBLOCK) {
+					pollfd out{ STDOUT_FILENO, POLLOUT, 0 };
+					if (::poll(&out, 1, -1) >= 0 || errno == EINTR) continue;
+				}
+#endif
+				throw std::system_error(errno, std::generic_category(), "stdout write failed");
+			}
+
+			data += written;
+			size -= static_cast<std::size_t>(written);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,182 @@
+//===================================================================================================================================
+// @file	utkarchive.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the block-compressed log archive written by the ARCHIVE sink, and its reader.
+//
+// @note    Entries are encoded into fixed size blocks. A full block is compressed on a taskExecutor worker
+//          while the next one fills, and blocks reach the file in the order they were sealed. Every block
+//          starts with a frame header giving its size and the range of timestamps inside it, and closing
+//          the archive adds a seek table of those headers at the end of the file. A reader with a time
+//          range only decompresses the blocks that overlap it. An archive whose writer died before closing
+//          has no seek table, so readers rebuild it by walking the frame headers instead. Frames carry a
+//          checksum of their payload, and one that fails it is treated as torn wherever it is read.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include "types/utklogentry.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace UTK::Dispatch {
+
+	class taskExecutor;
+
+	namespace Internal {
+		class archiveSink;
+		class archiveSource;
+	}
+
+	/**
+	 * @brief Settings for an archiveWriter
+	 */
+	struct archiveOptions {
+		std::size_t blockBytes = 256 * 1024;	// Encoded bytes collected before a block is sealed and compressed
+		taskExecutor* executor = nullptr;		// Pool the blocks are compressed on, nullptr for taskExecutor::shared()
+	};
+
+	/**
+	 * @brief Seek table entry describing one block of an archive
+	 */
+	struct archiveBlock {
+		std::uint64_t offset;				// File offset of the block's frame header
+		std::uint32_t storedBytes;			// Payload bytes on disk, equal to rawBytes when stored uncompressed
+		std::uint32_t rawBytes;
+		std::uint32_t entries;
+		std::int64_t earliest;				// Smallest and largest timestamp in the block
+		std::int64_t latest;
+	};
+
+	/**
+	 * @brief A log entry read back out of an archive, along with the time it was archived
+	 */
+	struct archivedEntry {
+		std::int64_t timeStamp;		// Nanoseconds since the system clock epoch
+		UTK::Types::LogEntry::logEntry entry;
+	};
+
+	/**
+	 * @brief Appends entries to a block-compressed archive file
+	 *
+	 * @note Not thread safe, the ARCHIVE sink calls it from its own worker only. Opening an existing archive
+	 *		 continues it: the old seek table, or a block torn by a crash, is cut off and new blocks follow
+	 *		 the last whole one.
+	 */
+	class archiveWriter {
+	private:
+		std::unique_ptr<Internal::archiveSink> _sink;
+
+	public:
+		/**
+		 * @note Throws std::runtime_error if path cannot be opened, or holds something other than an archive.
+		 */
+		explicit archiveWriter(const std::string& path, const archiveOptions& options = {});
+
+		/// Closes the archive, see close()
+		~archiveWriter();
+
+		archiveWriter(const archiveWriter&) = delete;
+		archiveWriter& operator=(const archiveWriter&) = delete;
+
+		/**
+		 * @brief Encodes an entry into the open block, sealing the block once it reaches blockBytes
+		 *
+		 * @param timeStamp: Nanoseconds since the system clock epoch, used to seek by time.
+		 */
+		void append(const UTK::Types::LogEntry::logEntry& entry, std::int64_t timeStamp);
+
+		/**
+		 * @brief Writes any blocks that have finished compressing, without waiting on the rest
+		 */
+		void drain();
+
+		/**
+		 * @brief Seals the open block even if it is not full, then waits for every block to reach the file
+		 */
+		void flush();
+
+		/**
+		 * @brief Flushes, then writes the seek table. Later appends start a new block after the table is cut off.
+		 */
+		void close();
+
+		/**
+		 * @brief Seek table of every block written so far
+		 */
+		const std::vector<archiveBlock>& blocks() const;
+	};
+
+	/**
+	 * @brief Streams entries back out of an archive, decompressing one block at a time
+	 */
+	class archiveReader {
+	private:
+		std::unique_ptr<Internal::archiveSource> _source;
+
+	public:
+		/**
+		 * @note Throws std::runtime_error if path cannot be opened or is not an archive.
+		 */
+		explicit archiveReader(const std::string& path);
+		~archiveReader();
+
+		archiveReader(const archiveReader&) = delete;
+		archiveReader& operator=(const archiveReader&) = delete;
+
+		/**
+		 * @brief Seek table of the archive, read from its end or rebuilt from the frame headers
+		 */
+		const std::vector<archiveBlock>& blocks() const;
+
+		/**
+		 * @brief False if the archive was not closed, so its seek table was rebuilt
+		 */
+		bool complete() const;
+
+		/**
+		 * @brief Limits next() to entries stamped within [from, to], skipping blocks entirely outside it
+		 */
+		void seek(std::int64_t from, std::int64_t to = INT64_MAX);
+
+		/**
+		 * @brief Reads the next entry in archive order
+		 *
+		 * @return False once there are no more entries in range, or at a torn block. The torn block and those
+		 *		   after it leave blocks() until refresh() finds them whole, next() then carries on from there.
+		 *
+		 * @note Throws std::runtime_error if a block fails to decompress.
+		 */
+		bool next(archivedEntry& out);
+
+		/**
+		 * @brief Reads every entry stamped within [from, to]
+		 *
+		 * @note Same as seek(from, to) followed by next() until it returns false.
+		 */
+		std::vector<archivedEntry> range(std::int64_t from, std::int64_t to);
+
+		/**
+		 * @brief Picks up blocks a writer has appended since the archive was opened or last refreshed
+		 *
+		 * @note Throws std::runtime_error if the file has shrunk below the blocks already known.
+		 * @return The number of blocks added to blocks().
+		 */
+		std::size_t refresh();
+
+		/**
+		 * @brief Decodes every entry of one block into out, leaving next()'s position alone
+		 *
+		 * @param index: Index into blocks().
+		 *
+		 * @note Throws std::runtime_error for a torn block, after dropping it and those after it from blocks()
+		 *		 as next() does.
+		 */
+		void readBlock(std::size_t index, std::vector<archivedEntry>& out);
+	};
+}
\ No newline at end of file
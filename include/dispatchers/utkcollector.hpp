@@ -0,0 +1,171 @@
+//===================================================================================================================================
+// @file	utkcollector.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the shared-memory rings used to collect log entries from many
+//			processes into a single local collector(utklogd).
+//
+// @note    Each publishing process owns one ring in POSIX shared memory and registers its name with
+//          the collector over a Unix domain socket. The socket is only used for registration and to
+//          notice the publisher exiting, the entries themselves never pass through it.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include "types/utklogentry.hpp"
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace UTK::Dispatch {
+
+	class logDispatcher;
+
+	/**
+	 * @brief A log entry drained out of a shared ring, along with the time it was published
+	 */
+	struct collectedEntry {
+		std::int64_t timeStamp;		// Nanoseconds since the system clock epoch
+		UTK::Types::LogEntry::logEntry entry;
+	};
+
+	/**
+	 * @brief Bounded multi-producer, single-consumer ring of fixed size slots in POSIX shared memory
+	 */
+	class sharedRing {
+	private:
+		std::string _name;
+		std::byte* _base = nullptr;
+		std::size_t _size = 0;
+		std::uint32_t _slotCount = 0;
+		bool _owner = false;
+
+		sharedRing(std::string name, std::byte* base, std::size_t size, bool owner);
+
+	public:
+		~sharedRing();
+
+		sharedRing(const sharedRing&) = delete;
+		sharedRing& operator=(const sharedRing&) = delete;
+
+		/**
+		 * @brief Creates a new shared memory ring, the name is unlinked again when the ring is destroyed
+		 *
+		 * @param name:		 Shared memory object name(e.g. "/utk.1234").
+		 * @param slotCount: Number of entries the ring can hold before publishers start dropping.
+		 */
+		static std::unique_ptr<sharedRing> create(const std::string& name, std::uint32_t slotCount);
+
+		/**
+		 * @brief Maps an existing ring created by another process
+		 */
+		static std::unique_ptr<sharedRing> attach(const std::string& name);
+
+		/**
+		 * @brief Copies an entry into the ring. Safe to call from many threads and processes.
+		 *
+		 * @return False if the ring is full and the entry was dropped.
+		 */
+		bool publish(const UTK::Types::LogEntry::logEntry& entry) noexcept;
+
+		/**
+		 * @brief Moves up to maxEntries committed entries out of the ring. Only one consumer may drain.
+		 *
+		 * @return The number of entries appended to out.
+		 */
+		std::size_t drain(std::vector<collectedEntry>& out, std::size_t maxEntries = SIZE_MAX);
+
+		/**
+		 * @brief Number of entries publishers dropped because the ring was full
+		 */
+		std::uint64_t dropped() const;
+
+		const std::string& name() const { return _name; }
+	};
+
+	/**
+	 * @brief Publisher side of the collector, owns this process's ring and its registration
+	 */
+	class collectorClient {
+	private:
+		std::unique_ptr<sharedRing> _ring;
+		int _socket = -1;
+
+	public:
+		/**
+		 * @param socketPath: Path of the collector's Unix domain socket.
+		 * @param slotCount:  Number of entries the process ring holds.
+		 */
+		collectorClient(const std::string& socketPath, std::uint32_t slotCount);
+		~collectorClient();
+
+		collectorClient(const collectorClient&) = delete;
+		collectorClient& operator=(const collectorClient&) = delete;
+
+		bool publish(const UTK::Types::LogEntry::logEntry& entry) noexcept { return _ring->publish(entry); }
+		std::uint64_t dropped() const { return _ring->dropped(); }
+	};
+
+	/**
+	 * @brief Collector side, accepts registrations and drains every ring into one dispatcher
+	 */
+	class logCollector {
+	private:
+		struct registration {
+			std::string pending;				// Partial registration line read from the socket
+			std::unique_ptr<sharedRing> ring;
+		};
+
+		std::string _socketPath;
+		int _listener = -1;
+		logDispatcher& _dispatcher;
+		std::unordered_map<int, registration> _clients;
+		std::vector<collectedEntry> _batch;
+		std::vector<collectedEntry> _held;		// Merged entries still inside the reorder window, oldest first
+		std::int64_t _reorderWindow = 0;		// Nanoseconds
+
+		void acceptClients();
+		bool readRegistration(int fd, registration& client);
+		void releaseClient(int fd);
+		std::size_t dispatchBatch(bool everything = false);
+
+	public:
+		/**
+		 * @param socketPath:	   Path to bind the registration socket to, any stale socket is replaced.
+		 * @param dispatcher:	   Dispatcher whose sinks receive the merged entries.
+		 * @param reorderWindowMs: How long entries are held back before being dispatched, see poll().
+		 *
+		 * @note Only rings named the way collectorClient names them("/utk.<pid>.<n>"), registered by that
+		 *		 same pid, are attached. The collector unlinks every ring it lets go of.
+		 */
+		logCollector(const std::string& socketPath, logDispatcher& dispatcher, int reorderWindowMs = 0);
+		~logCollector();
+
+		logCollector(const logCollector&) = delete;
+		logCollector& operator=(const logCollector&) = delete;
+
+		/**
+		 * @brief Waits up to timeoutMs for socket activity, then drains every ring and dispatches
+		 *		  the entries merged into timestamp order.
+		 *
+		 * @note Entries are only ordered against the others dispatched with them. With no reorder window
+		 *		 that is a single poll, so an entry drained in a later poll can come out after one stamped
+		 *		 later than it. A window holds entries back until they are that old, ordering everything
+		 *		 published less than a window apart at the cost of that much latency. Whatever is still
+		 *		 held when the collector is destroyed is dispatched then.
+		 *
+		 * @return The number of entries dispatched.
+		 */
+		std::size_t poll(int timeoutMs);
+
+		/**
+		 * @brief Number of processes currently registered
+		 */
+		std::size_t ringCount() const;
+	};
+}
\ No newline at end of file
@@ -13,23 +13,83 @@
 #include "types/utkstates.hpp"
 #include "types/utkmetadata.hpp"
 #include "types/utklogentry.hpp"
+#include "dispatchers/utkflightrecorder.hpp"
+#include "dispatchers/utkcollector.hpp"
+#include "dispatchers/utkrouting.hpp"
+#include "dispatchers/utkkeytable.hpp"
+#include "dispatchers/utkarchive.hpp"
 #include <string_view>
+#include <cstdint>
 #include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <array>
 #include <queue>
 #include <mutex>
 
 namespace UTK::Dispatch {
 
+	class logController;
+
+	/**
+	 * @brief Snapshot of the queue accounting for a single sink worker
+	 */
+	struct sinkStats {
+		UTK::Types::States::Logger lg;
+		std::uint64_t enqueued = 0;		// Entries accepted onto the sink queue
+		std::uint64_t written = 0;		// Entries the sink has finished writing
+		std::uint64_t dropped = 0;		// Entries rejected because the queue was full
+		std::size_t depth = 0;			// Entries queued or being written, never more than the capacity (lag)
+		std::size_t highWater = 0;		// Largest depth seen since the sink was created
+	};
+
 	/**
 	 * @brief Class used to store data within to be dispatched to the UTK logger system
+	 * 
+	 * @note Each sink is serviced by its own worker thread and bounded queue, so a stalled
+	 *		 sink(e.g. a blocked terminal) never delays the output of the other sinks.
 	 */
 	class logDispatcher {
 	private:
 		using loggerEntryQueue = std::queue<UTK::Types::LogEntry::logEntry>;
+		using OperationFilters = std::array<std::atomic<std::uint32_t>, loggerCount>;
 
 		std::mutex _mutex;
 		loggerEntryQueue _logQueue;
+		OperationFilters _operationFilters;		// Bit per Operations value, indexed by Logger
+		std::unique_ptr<logController> _controller;
+		std::unique_ptr<flightRecorder> _recorder;
+		std::unique_ptr<collectorClient> _publisher;
+
+		mutable std::mutex _routeMutex;							// Guards _routes
+		std::shared_ptr<const routeTable> _routes;				// Null until routes are set, entries then go to entry.lg
+		std::atomic<std::uint64_t> _routesVersion = 0;			// Version of _routes, 0 while there are none
+
+		/// The current routes, lock-free while the calling thread already holds this version, null when unset
+		const routeTable* currentRoutes() const;
+
+		/// Sinks whose operation filter lets op through
+		sinkMask enabledSinks(UTK::Types::States::Operations op) const noexcept;
+
+		/// Sinks an entry goes to once routes and operation filters are applied
+		sinkMask sinksFor(const UTK::Types::LogEntry::logEntry& entry) const noexcept;
+
+		/// Filters, records and publishes an entry, true if it still belongs on the local queue
+		bool admit(UTK::Types::LogEntry::logEntry& entry);
 	public:
+		/**
+		 * @param sinkCapacity: Maximum number of entries each sink queue can hold.
+		 * @param policy:		Action taken when a sink queue is full(default: DROP the new entries).
+		 */
+		explicit logDispatcher(
+			std::size_t sinkCapacity = 4096,
+			UTK::Types::States::Backpressure policy = UTK::Types::States::Backpressure::DROP);
+		~logDispatcher();
+
+		logDispatcher(const logDispatcher&) = delete;
+		logDispatcher& operator=(const logDispatcher&) = delete;
+
 		/**
 		 * @brief Adds entries to the dispatcher internal queue
 		 * 
@@ -38,8 +98,93 @@ namespace UTK::Dispatch {
 		void pushEntry(UTK::Types::LogEntry::logEntry entry);
 
 		/**
-		 * @brief Evaluates each item in the queue and dispatches each to the logging system
+		 * @brief Adds a batch of entries, taking the internal queue's lock once for the whole batch
+		 */
+		void pushEntries(std::vector<UTK::Types::LogEntry::logEntry> entries);
+
+		/**
+		 * @brief Whether an entry for this sink and operation could reach a sink whose operation filter passes it
+		 *
+		 * @note Lets callers skip building entries that pushEntry would discard. With routes set, lg is the
+		 *		 producer's choice that applies only when no rule matches.
+		 */
+		bool isEnabled(UTK::Types::States::Logger lg, UTK::Types::States::Operations op) const;
+
+		/**
+		 * @brief Mirrors every pushed entry into a memory-mapped ring file that survives a crash
+		 * 
+		 * @param path:		 Location of the ring file, recover it with flightRecorder::recover or utkrecover.
+		 * @param slotCount: Number of most recent entries the ring keeps.
+		 * 
+		 * @note Enable before producers start pushing, entries pushed beforehand are not recorded.
+		 */
+		void enableFlightRecorder(const std::string& path, std::uint32_t slotCount = 8192);
+
+		/**
+		 * @brief Publishes every pushed entry into a shared-memory ring drained by a local utklogd
+		 *		  collector, instead of writing to this process's own sinks
+		 * 
+		 * @param socketPath: Path of the collector's registration socket.
+		 * @param slotCount:  Number of entries the ring holds, entries pushed while it is full are dropped.
+		 * 
+		 * @note Enable before producers start pushing. Throws if the collector cannot be reached.
+		 */
+		void enableCollector(const std::string& socketPath, std::uint32_t slotCount = 8192);
+
+		/**
+		 * @brief Starts the ARCHIVE sink, writing entries routed to it into a block-compressed archive
+		 *
+		 * @param path:	   Archive file, continued if it already exists. Read it back with archiveReader.
+		 * @param options: Block size and the executor blocks are compressed on.
+		 *
+		 * @note Without this the ARCHIVE sink writes to "utk.archive" in the working directory. Throws if the
+		 *		 archive cannot be opened, or if the sink has already started.
+		 */
+		void enableArchive(const std::string& path, const archiveOptions& options = {});
+
+		/**
+		 * @brief Restricts a sink to the listed operations, entries for any other operation are discarded on push
+		 * 
+		 * @note Every operation is enabled until a filter is set, an empty list silences the sink. Safe to
+		 *		 call while producers are pushing.
+		 */
+		void setOperationFilter(UTK::Types::States::Logger lg, const std::vector<UTK::Types::States::Operations>& enabled);
+
+		/**
+		 * @brief Routes entries to sinks by rule instead of by the sink each producer chose
+		 *
+		 * @note Compiled once into a table indexed by operation, see routeTable. Operation filters still apply
+		 *		 to each sink an entry is routed to. An empty list goes back to routing by entry.lg. Safe to call
+		 *		 while producers are pushing, entries already queued are routed by the rules set at dispatch.
+		 *		 Each thread keeps the last few tables it read, a replaced table is freed once every thread
+		 *		 has moved on from it, so routes can be reapplied any number of times.
+		 */
+		void setRoutes(const std::vector<routeRule>& rules);
+
+		/**
+		 * @brief Changes a sink's queue capacity and backpressure policy
+		 * 
+		 * @note Applies straight away to a running sink, or when the sink is first used. Safe to call while a
+		 *		 dispatchLogs() is blocked on the sink, the blocked dispatch wakes and re-checks against the new
+		 *		 capacity, or queues what fits and drops the rest if the policy is now DROP.
+		 */
+		void configureSink(UTK::Types::States::Logger lg, std::size_t capacity, UTK::Types::States::Backpressure policy);
+
+		/**
+		 * @brief Evaluates each item in the queue and hands each to the queue of its sink
 		 */
 		void dispatchLogs();
+
+		/**
+		 * @brief Blocks until every sink has written all the entries handed to it
+		 *
+		 * @note The ARCHIVE sink also seals its open block, so everything flushed is on disk.
+		 */
+		void flush();
+
+		/**
+		 * @brief Returns the lag and backpressure accounting of each active sink
+		 */
+		std::vector<sinkStats> getSinkStats() const;
 	};
 }
\ No newline at end of file
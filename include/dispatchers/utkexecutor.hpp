@@ -0,0 +1,343 @@
+//===================================================================================================================================
+// @file	utkexecutor.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the work-stealing task executor shared by UTK modules.
+//
+// @note    Each worker owns a Chase-Lev deque. A worker pushes and pops its own deque from the bottom without
+//          locking, idle workers steal from the top of the others, so work spawned by a task stays on the
+//          warm core until another core runs dry. Tasks submitted from outside the pool go through a single
+//          injection queue. Waiting on a task from any thread runs queued work instead of blocking, so tasks
+//          may wait on the tasks they spawn without starving the pool.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include <type_traits>
+#include <functional>
+#include <algorithm>
+#include <exception>
+#include <optional>
+#include <variant>
+#include <cstddef>
+#include <utility>
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <mutex>
+
+namespace UTK::Dispatch {
+
+	class taskExecutor;
+
+	namespace Internal {
+
+		class executorCore;
+
+		/**
+		 * @brief Unit of work held by the deques, deleted by the executor once run
+		 */
+		struct job {
+			virtual ~job() = default;
+			virtual void run() noexcept = 0;
+		};
+
+		/**
+		 * @brief Completion state shared by a task handle and the job producing it
+		 */
+		struct taskStateBase {
+			std::mutex lock;
+			std::vector<job*> continuations;	// Scheduled once the state completes
+			std::exception_ptr error;
+			std::atomic<bool> done = false;
+		};
+
+		template<typename T>
+		struct taskState : taskStateBase {
+			std::conditional_t<std::is_void_v<T>, std::monostate, std::optional<T>> value;
+		};
+
+		/// Result of a continuation, which takes no argument after a void task
+		template<typename F, typename T>
+		struct continuationResult {
+			using type = std::invoke_result_t<F&, T>;
+		};
+
+		template<typename F>
+		struct continuationResult<F, void> {
+			using type = std::invoke_result_t<F&>;
+		};
+
+		/// Runs fn and stores its result or exception in state, without completing it
+		template<typename T, typename F, typename... Args>
+		void fulfil(taskState<T>& state, F& fn, Args&&... args) noexcept {
+			try {
+				if constexpr (std::is_void_v<T>) {
+					std::invoke(fn, std::forward<Args>(args)...);
+				}
+				else {
+					state.value.emplace(std::invoke(fn, std::forward<Args>(args)...));
+				}
+			}
+			catch (...) {
+				state.error = std::current_exception();
+			}
+		}
+	}
+
+	/**
+	 * @brief Construction options for a taskExecutor
+	 */
+	struct executorOptions {
+		std::size_t workers = 0;				// 0 uses one worker per hardware thread
+		bool pinWorkers = false;				// Pins worker i to the i-th CPU the process may run on(Linux only)
+		std::size_t dequeCapacity = 256;		// Initial slots per worker deque, grows on demand
+	};
+
+	/**
+	 * @brief Handle to the result of a task run on a taskExecutor
+	 *
+	 * @note Handles are cheap to copy and share the one result. Waiting from a worker of the same executor
+	 *		 runs other queued tasks meanwhile.
+	 */
+	template<typename T>
+	class task {
+	private:
+		std::shared_ptr<Internal::taskState<T>> _state;
+		taskExecutor* _executor = nullptr;
+
+		friend class taskExecutor;
+		template<typename U> friend class task;
+
+		task(std::shared_ptr<Internal::taskState<T>> state, taskExecutor* executor) : _state(std::move(state)), _executor(executor) {}
+
+	public:
+		task() = default;
+
+		bool valid() const noexcept { return _state != nullptr; }
+		bool ready() const noexcept { return _state && _state->done.load(std::memory_order_acquire); }
+
+		/**
+		 * @brief Blocks until the task has finished, running queued work while it waits
+		 */
+		void wait() const;
+
+		/**
+		 * @brief Waits for the task and returns its result, rethrowing anything the task threw
+		 *
+		 * @note The result is moved out, call get() once per task.
+		 */
+		T get();
+
+		/**
+		 * @brief Schedules fn to run with this task's result once it finishes
+		 *
+		 * @note The result is moved into fn, use the returned task rather than get() on this one. If this
+		 *		 task throws, fn is skipped and the returned task rethrows the same exception.
+		 */
+		template<typename F>
+		auto then(F&& fn);
+	};
+
+	/**
+	 * @brief Pool of worker threads balancing tasks between them by work stealing
+	 *
+	 * @note Thread safe. Destroying the executor runs every task already queued, including continuations
+	 *		 and tasks those spawn, before joining the workers.
+	 */
+	class taskExecutor {
+	private:
+		std::unique_ptr<Internal::executorCore> _core;
+
+		template<typename U> friend class task;
+
+		/// Queues a job, on the calling worker's own deque when called from inside the pool
+		void schedule(Internal::job* work);
+
+		/// Marks the state done and schedules its continuations
+		void complete(Internal::taskStateBase& state);
+
+		/// Schedules work once state completes, straight away if it already has
+		void chain(Internal::taskStateBase& state, Internal::job* work);
+
+		/// Runs queued work until state completes
+		void waitFor(const Internal::taskStateBase& state);
+
+		/// Runs one queued job if any thread has one to give, false when every queue was empty
+		bool runPending();
+
+		/// Runs queued work until counter reaches zero
+		void waitForZero(const std::atomic<std::size_t>& counter);
+
+	public:
+		explicit taskExecutor(const executorOptions& options = {});
+		~taskExecutor();
+
+		taskExecutor(const taskExecutor&) = delete;
+		taskExecutor& operator=(const taskExecutor&) = delete;
+
+		/**
+		 * @brief Process-wide executor sized to the machine, for modules that would otherwise start their own threads
+		 */
+		static taskExecutor& shared();
+
+		std::size_t workerCount() const noexcept;
+
+		/**
+		 * @brief Queues fn to run on a worker
+		 *
+		 * @return A task holding fn's result, or the exception it threw.
+		 */
+		template<typename F>
+		auto submit(F&& fn) -> task<std::invoke_result_t<std::decay_t<F>&>>;
+
+		/**
+		 * @brief Calls fn(i) for every i in [begin, end) across the pool, returning once all calls have finished
+		 *
+		 * @param grain: Most indices one job runs before splitting, 0 picks a grain giving each worker several jobs.
+		 *
+		 * @note The calling thread takes part. If any call throws, the remaining indices are skipped and the
+		 *		 first exception is rethrown here.
+		 */
+		template<typename F>
+		void parallelFor(std::size_t begin, std::size_t end, F&& fn, std::size_t grain = 0);
+	};
+
+	//===============================================================================================================================
+	//												TASK METHOD IMPLEMENTATIONS
+	//===============================================================================================================================
+
+	template<typename T>
+	void task<T>::wait() const {
+		if (!ready()) _executor->waitFor(*_state);
+	}
+
+	template<typename T>
+	T task<T>::get() {
+		wait();
+		if (_state->error) std::rethrow_exception(_state->error);
+		if constexpr (!std::is_void_v<T>) return std::move(*_state->value);
+	}
+
+	template<typename T>
+	template<typename F>
+	auto task<T>::then(F&& fn) {
+
+		using Fn = std::decay_t<F>;
+		using R = typename Internal::continuationResult<Fn, T>::type;
+
+		struct continuation final : Internal::job {
+			std::shared_ptr<Internal::taskState<T>> parent;
+			std::shared_ptr<Internal::taskState<R>> state;
+			taskExecutor* executor;
+			Fn fn;
+
+			continuation(std::shared_ptr<Internal::taskState<T>> p, std::shared_ptr<Internal::taskState<R>> s, taskExecutor* e, F&& f)
+				: parent(std::move(p)), state(std::move(s)), executor(e), fn(std::forward<F>(f)) {}
+
+			void run() noexcept override {
+				if (parent->error) {
+					state->error = parent->error;
+				}
+				else if constexpr (std::is_void_v<T>) {
+					Internal::fulfil(*state, fn);
+				}
+				else {
+					Internal::fulfil(*state, fn, std::move(*parent->value));
+				}
+				executor->complete(*state);
+			}
+		};
+
+		auto state = std::make_shared<Internal::taskState<R>>();
+		_executor->chain(*_state, new continuation(_state, state, _executor, std::forward<F>(fn)));
+		return task<R>(std::move(state), _executor);
+	}
+
+	//===============================================================================================================================
+	//											TASK EXECUTOR TEMPLATE IMPLEMENTATIONS
+	//===============================================================================================================================
+
+	template<typename F>
+	auto taskExecutor::submit(F&& fn) -> task<std::invoke_result_t<std::decay_t<F>&>> {
+
+		using Fn = std::decay_t<F>;
+		using R = std::invoke_result_t<Fn&>;
+
+		struct submitted final : Internal::job {
+			std::shared_ptr<Internal::taskState<R>> state;
+			taskExecutor* executor;
+			Fn fn;
+
+			submitted(std::shared_ptr<Internal::taskState<R>> s, taskExecutor* e, F&& f)
+				: state(std::move(s)), executor(e), fn(std::forward<F>(f)) {}
+
+			void run() noexcept override {
+				Internal::fulfil(*state, fn);
+				executor->complete(*state);
+			}
+		};
+
+		auto state = std::make_shared<Internal::taskState<R>>();
+		schedule(new submitted(state, this, std::forward<F>(fn)));
+		return task<R>(std::move(state), this);
+	}
+
+	template<typename F>
+	void taskExecutor::parallelFor(std::size_t begin, std::size_t end, F&& fn, std::size_t grain) {
+
+		if (begin >= end) return;
+
+		const std::size_t count = end - begin;
+		if (grain == 0) grain = std::max<std::size_t>(1, count / (workerCount() * 8));
+
+		// Shared with the range jobs, a job may still be returning after the last index is counted off
+		struct rangeState {
+			F& fn;
+			std::size_t grain;
+			std::atomic<std::size_t> remaining;
+			std::atomic<bool> failed = false;
+			std::exception_ptr error;
+		};
+
+		struct rangeJob final : Internal::job {
+			std::shared_ptr<rangeState> shared;
+			taskExecutor* executor;
+			std::size_t from, to;
+
+			rangeJob(std::shared_ptr<rangeState> s, taskExecutor* e, std::size_t f, std::size_t t)
+				: shared(std::move(s)), executor(e), from(f), to(t) {}
+
+			void run() noexcept override {
+
+				// Hand the upper half of the range back to the pool until a grain is left, so thieves take big pieces
+				while (to - from > shared->grain) {
+					const std::size_t middle = from + (to - from) / 2;
+					executor->schedule(new rangeJob(shared, executor, middle, to));
+					to = middle;
+				}
+
+				if (!shared->failed.load(std::memory_order_relaxed)) {
+					try {
+						for (std::size_t i = from; i < to; i++) shared->fn(i);
+					}
+					catch (...) {
+						if (!shared->failed.exchange(true)) shared->error = std::current_exception();
+					}
+				}
+
+				if (shared->remaining.fetch_sub(to - from, std::memory_order_acq_rel) == to - from) {
+					shared->remaining.notify_all();
+				}
+			}
+		};
+
+		auto shared = std::make_shared<rangeState>(fn, grain, count);
+		rangeJob(shared, this, begin, end).run();
+		waitForZero(shared->remaining);
+
+		if (shared->error) std::rethrow_exception(shared->error);
+	}
+}
\ No newline at end of file
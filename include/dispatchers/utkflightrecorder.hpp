@@ -0,0 +1,120 @@
+//===================================================================================================================================
+// @file	utkflightrecorder.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the crash-surviving flight recorder used by logDispatcher
+//			to mirror entries into a memory-mapped ring file.
+//
+// @note    The ring file is mapped shared, so every recorded entry lives in the page cache as
+//          soon as it is copied in. If the process dies the kernel still writes the pages out,
+//          and the last entries can be pulled back out with recover(), or the utkrecover tool.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include "types/utkstates.hpp"
+#include "types/utklogentry.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace UTK::Dispatch {
+
+	/**
+	 * @brief A single entry read back out of a flight recorder ring file
+	 */
+	struct flightRecord {
+		std::uint64_t sequence = 0;
+		std::int64_t timeStamp = 0;		// Nanoseconds since the system clock epoch
+		UTK::Types::States::Logger lg = UTK::Types::States::Logger::TERMINAL;
+		UTK::Types::States::Operations op = UTK::Types::States::Operations::LG_NOP;
+		int fileLine = -1;
+		bool truncated = false;			// Set when the entry did not fit in its slot
+		std::string fileName;
+		std::string funcName;
+		FormatStrings formatKeys;
+		FormatStrings formatValues;
+	};
+
+	/**
+	 * @brief The crash a ring file recorded before it was reopened by a later run
+	 */
+	struct crashMarker {
+		int signal = 0;					// 0 if the earlier run did not crash
+		std::uint64_t sequence = 0;		// Entries from this sequence on were recorded after the restart
+	};
+
+	/**
+	 * @brief File-backed ring buffer of fixed size binary slots, written with a memcpy per field
+	 */
+	class flightRecorder {
+	private:
+		std::string _path;
+		std::byte* _base = nullptr;
+		std::size_t _size = 0;
+		std::uint32_t _slotCount = 0;
+	#if defined(__WINDOWS__)
+		void* _file = nullptr;
+		void* _mapping = nullptr;
+	#else
+		int _fd = -1;
+	#endif
+
+	public:
+		/// Size in bytes of every slot in the ring, including its fixed header
+		static constexpr std::size_t slotSize = 512;
+
+		/**
+		 * @brief Maps the ring file, creating it or resetting it if its layout does not match
+		 *
+		 * @note Reopening a ring left by a crash keeps its entries, and moves its crash signal to the
+		 *		 previous crash marker read by recover().
+		 *
+		 * @param path:		 Location of the ring file.
+		 * @param slotCount: Number of entries the ring holds before the oldest is overwritten.
+		 */
+		explicit flightRecorder(const std::string& path, std::uint32_t slotCount = 8192);
+		~flightRecorder();
+
+		flightRecorder(const flightRecorder&) = delete;
+		flightRecorder& operator=(const flightRecorder&) = delete;
+
+		/**
+		 * @brief Copies an entry into the next slot of the ring. Safe to call from many threads.
+		 *
+		 * @param entry: The entry to record, strings that overflow the slot are truncated.
+		 */
+		void record(const UTK::Types::LogEntry::logEntry& entry) noexcept;
+
+		/**
+		 * @brief Synchronously writes the mapped ring back to its file
+		 */
+		void flush() noexcept;
+
+		/**
+		 * @brief Installs handlers for fatal signals that mark every live ring with the signal number,
+		 *		  then restore the handler that was installed before them and raise the signal again.
+		 *
+		 * @note The handlers only touch the mapped memory and issue async-signal-safe calls. Whatever
+		 *		 handled the signals before, the default action or an application handler, still runs
+		 *		 afterwards. Calling this more than once has no further effect.
+		 */
+		static void installCrashHandlers();
+
+		/**
+		 * @brief Reads the newest entries out of a ring file, oldest first
+		 *
+		 * @param path:  Location of the ring file.
+		 * @param count: Maximum number of entries to return.
+		 * @param crashSignal:	 Optional output for the signal that ended the run that last had the ring open(0 if none).
+		 * @param previousCrash: Optional output for the crash of an earlier run, kept when a later run reopened the ring.
+		 *
+		 * @return The recovered entries, slots that were mid-write at the time of the crash are skipped.
+		 */
+		static std::vector<flightRecord> recover(const std::string& path, std::size_t count, int* crashSignal = nullptr,
+			crashMarker* previousCrash = nullptr);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+//===================================================================================================================================
+// @file	utkfollower.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the log follower, the rolling aggregates it feeds and the local service
+//			that hands snapshots of them to the dashboard(utktaild).
+//
+// @note    The follower watches the directories holding sink output with inotify and only reads the
+//          files an event names, starting at the offset it stopped at last time. TERMINAL output(stdout
+//          redirected to a file) is read as newly appended bytes and parsed a line at a time, ARCHIVE
+//          files are read as newly appended blocks. Offsets are saved to a small state file, so a restart
+//          carries on where the last run stopped instead of reading every file again. A file replaced by
+//          rotation or truncated in place is read again from its start.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include "types/utklogentry.hpp"
+#include "dispatchers/utkrouting.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <deque>
+#include <array>
+#include <memory>
+
+namespace UTK::Dispatch {
+
+	namespace Internal {
+		class followerState;
+	}
+
+	/**
+	 * @brief A log entry read back out of a followed file, along with the time it was logged
+	 */
+	struct followedEntry {
+		std::int64_t timeStamp;		// Nanoseconds since the system clock epoch, whole seconds for TERMINAL output
+		UTK::Types::LogEntry::logEntry entry;
+	};
+
+	/**
+	 * @brief Progress through one followed file
+	 */
+	struct followedFile {
+		std::string path;
+		UTK::Types::States::Logger format;
+		std::uint64_t position;		// Bytes consumed for TERMINAL output, blocks consumed for an ARCHIVE
+		std::uint64_t entries;		// Entries read since the follower started
+		std::uint64_t unparsed;		// TERMINAL lines that did not look like the sink's output
+		bool open;					// False while the file does not exist or is not readable yet
+	};
+
+	/**
+	 * @brief Reads only what has been appended to sink output files since they were last read
+	 *
+	 * @note Not thread safe. Only Linux has inotify, elsewhere the constructor throws.
+	 */
+	class logFollower {
+	private:
+		std::unique_ptr<Internal::followerState> _state;
+
+	public:
+		/**
+		 * @param offsetsPath: File the read offsets are saved to and resumed from, empty to keep them in memory only.
+		 *
+		 * @note Throws std::runtime_error if inotify is unavailable.
+		 */
+		explicit logFollower(const std::string& offsetsPath = {});
+
+		/// Saves the offsets one last time
+		~logFollower();
+
+		logFollower(const logFollower&) = delete;
+		logFollower& operator=(const logFollower&) = delete;
+
+		/**
+		 * @brief Starts following the output of a sink
+		 *
+		 * @param path:		 File the sink writes to, it does not have to exist yet but its directory does.
+		 * @param format:	 TERMINAL for redirected terminal output, or ARCHIVE.
+		 * @param fromStart: Read what is already in the file, rather than only what is appended from now on.
+		 *					 Ignored when the offsets file already has a position for path.
+		 *
+		 * @note Throws std::runtime_error for any other format, or if the directory cannot be watched.
+		 */
+		void follow(const std::string& path, UTK::Types::States::Logger format, bool fromStart = false);
+
+		/**
+		 * @brief The inotify descriptor, readable whenever a followed file may have changed
+		 */
+		int descriptor() const;
+
+		/**
+		 * @brief Reads whatever has been appended to the files changed since the last call, without waiting
+		 *
+		 * @note The offsets file is rewritten at most once a second.
+		 * @return The number of entries appended to out.
+		 */
+		std::size_t read(std::vector<followedEntry>& out);
+
+		/**
+		 * @brief Writes the current offsets to the offsets file now
+		 */
+		void saveOffsets();
+
+		/**
+		 * @brief Progress through every followed file, in the order they were followed
+		 */
+		std::vector<followedFile> files() const;
+	};
+
+	/**
+	 * @brief Per second operation counts over a sliding window, plus the most recent errors
+	 */
+	class rollingAggregates {
+	private:
+		using OperationCounts = std::array<std::uint64_t, operationCount>;
+
+		struct secondCounts {
+			std::int64_t second = INT64_MIN;
+			OperationCounts counts{};
+		};
+
+		std::vector<secondCounts> _seconds;			// Ring indexed by second modulo the window
+		OperationCounts _totals{};
+		std::deque<followedEntry> _errors;
+		std::size_t _errorLimit;
+		std::int64_t _latest = INT64_MIN;			// Newest second seen, the window ends here
+
+	public:
+		/**
+		 * @param windowSeconds: Seconds of per second counts kept.
+		 * @param errorLimit:	 LG_ERR entries kept, the oldest are dropped first.
+		 */
+		explicit rollingAggregates(std::size_t windowSeconds = 300, std::size_t errorLimit = 20);
+
+		/**
+		 * @brief Counts an entry. Entries older than the window only count towards the totals.
+		 */
+		void add(const followedEntry& entry);
+
+		/**
+		 * @brief Writes the aggregates as a JSON object
+		 *
+		 * @param now: Nanoseconds since the system clock epoch, seconds older than the window before it are left out.
+		 */
+		std::string toJson(std::int64_t now) const;
+	};
+
+	/**
+	 * @brief Serves snapshots of the aggregates over a Unix domain socket, keeping them current with a follower
+	 *
+	 * @note Every connection is sent one snapshot, a single line of JSON, and is then closed.
+	 */
+	class tailService {
+	private:
+		std::string _socketPath;
+		int _listener = -1;
+		logFollower& _follower;
+		rollingAggregates& _aggregates;
+		std::vector<followedEntry> _batch;
+
+		void serveClients();
+
+	public:
+		/**
+		 * @param socketPath: Path to bind the snapshot socket to, any stale socket is replaced.
+		 *
+		 * @note Throws std::runtime_error if the socket cannot be bound, or on platforms without Unix domain sockets.
+		 */
+		tailService(const std::string& socketPath, logFollower& follower, rollingAggregates& aggregates);
+		~tailService();
+
+		tailService(const tailService&) = delete;
+		tailService& operator=(const tailService&) = delete;
+
+		/**
+		 * @brief Waits up to timeoutMs for a file change or a client, then reads the new entries and
+		 *		  answers every waiting client
+		 *
+		 * @return The number of entries read.
+		 */
+		std::size_t poll(int timeoutMs);
+
+		/**
+		 * @brief The JSON sent to clients: the followed files and the aggregates as of now
+		 */
+		std::string snapshot() const;
+	};
+}
\ No newline at end of file
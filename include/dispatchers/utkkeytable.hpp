@@ -0,0 +1,102 @@
+//===================================================================================================================================
+// @file	utkkeytable.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the process-wide key interning table used by log entries.
+//
+// @note    Services log against a small, fixed vocabulary of keys. Interning each key once gives it a small
+//          integer id that producers put in logEntry::keyIds instead of a string per key per entry. The
+//          table only ever grows, so looking a key up by id or by name never takes a lock; only adding a
+//          new key does. Each key is formatted for the text sinks when it is interned, and sinks copy those
+//          bytes instead of escaping the key again for every entry.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include "types/utklogentry.hpp"
+#include <string_view>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <mutex>
+
+namespace UTK::Dispatch {
+
+	/**
+	 * @brief An interned key along with the forms the text sinks write it in
+	 */
+	struct internedKey {
+		std::string_view name;
+		std::string_view json;		// Quoted, escaped and followed by a colon
+		std::string_view csv;		// Quoted only when the name holds a comma, quote or newline
+	};
+
+	/**
+	 * @brief Append-only table mapping key names to dense ids
+	 *
+	 * @note Thread safe. Lookups are lock free, intern() locks only to add a key not seen before.
+	 */
+	class keyTable {
+	private:
+		struct record;
+
+		std::unique_ptr<std::atomic<const record*>[]> _records;		// Indexed by id
+		std::unique_ptr<std::atomic<std::uint32_t>[]> _slots;		// Open addressed by name hash, id + 1 or 0 when empty
+		std::atomic<std::uint32_t> _size = 0;
+
+		std::mutex _writeLock;
+		std::vector<std::unique_ptr<record>> _owned;
+
+	public:
+		/// Most keys one table holds
+		static constexpr std::size_t capacity = 4096;
+
+		keyTable();
+		~keyTable();
+
+		keyTable(const keyTable&) = delete;
+		keyTable& operator=(const keyTable&) = delete;
+
+		/**
+		 * @brief The table shared by every producer and sink in the process
+		 */
+		static keyTable& global();
+
+		/**
+		 * @brief Returns the id of name, adding it on first use
+		 *
+		 * @note Throws std::runtime_error once the table holds capacity keys. Intern keys once, at startup or
+		 *		 in a static, and keep the id.
+		 */
+		UTK::Types::LogEntry::KeyId intern(std::string_view name);
+
+		/**
+		 * @brief The id of an already interned name
+		 */
+		std::optional<UTK::Types::LogEntry::KeyId> find(std::string_view name) const noexcept;
+
+		/**
+		 * @brief The key behind an id, nullptr for an id this table never handed out
+		 */
+		const internedKey* lookup(UTK::Types::LogEntry::KeyId id) const noexcept;
+
+		std::size_t size() const noexcept;
+	};
+
+	/**
+	 * @brief Number of keys an entry carries, its interned ids when set, otherwise its formatKeys
+	 */
+	inline std::size_t entryKeyCount(const UTK::Types::LogEntry::logEntry& entry) noexcept {
+		return entry.keyIds.empty() ? entry.formatKeys.size() : entry.keyIds.size();
+	}
+
+	/**
+	 * @brief Name of an entry's key at index, resolving interned ids through the global table
+	 */
+	std::string_view entryKey(const UTK::Types::LogEntry::logEntry& entry, std::size_t index) noexcept;
+}
\ No newline at end of file
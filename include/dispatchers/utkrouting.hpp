@@ -0,0 +1,103 @@
+//===================================================================================================================================
+// @file	utkrouting.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the rule based routing used by logDispatcher to pick the sinks of each entry.
+//
+// @note    Rules are declared once and compiled into a table indexed by operation. Rules that only look at the
+//          operation fold into a single sink mask per operation, so routing most entries costs one array index.
+//          Only the rules that also test a key, a value or the source file are evaluated per entry, and only
+//          for the operations they name.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include "types/utkstates.hpp"
+#include "types/utklogentry.hpp"
+#include <string_view>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <array>
+
+namespace UTK::Dispatch {
+
+	/// Bit per Logger value, bit n set sends the entry to Logger n
+	using sinkMask = std::uint32_t;
+
+	inline constexpr std::size_t loggerCount = static_cast<std::size_t>(UTK::Types::States::Logger::ARCHIVE) + 1;
+	inline constexpr std::size_t operationCount = static_cast<std::size_t>(UTK::Types::States::Operations::LG_NOP) + 1;
+
+	/// Tag the terminal sink prints for each operation, indexed by Operations
+	inline constexpr std::array<std::string_view, operationCount> operationTags {
+		"[WRITE]", "[READ]", "[LOGIN]", "[LOGOUT]", "[IDLE]", "[ERROR]", "[MESSAGE]", ""
+	};
+
+	/// The tag of op, "[UNKNOWN]" for values outside Operations
+	constexpr std::string_view operationTag(UTK::Types::States::Operations op) noexcept {
+		const auto index = static_cast<std::size_t>(op);
+		return (index < operationTags.size()) ? operationTags[index] : std::string_view("[UNKNOWN]");
+	}
+
+	constexpr sinkMask sinkBit(UTK::Types::States::Logger lg) noexcept {
+		return sinkMask(1) << static_cast<std::uint32_t>(lg);
+	}
+
+	/**
+	 * @brief One routing rule, an entry goes to the union of the sinks of every rule it matches
+	 *
+	 * @note An entry matching no rule goes to the sink its producer chose(entry.lg). A matching rule with no
+	 *		 sinks discards the entry unless another rule also matches it.
+	 */
+	struct routeRule {
+		std::vector<UTK::Types::States::Operations> ops;	// Empty matches every operation
+		std::string key;									// Entry must carry this key, empty matches any entry
+		std::optional<std::string> value;					// When set, the key must hold exactly this value
+		std::string file;									// Source file path must end with this, empty matches any
+		sinkMask sinks = 0;
+	};
+
+	/**
+	 * @brief Rules compiled into a dense table indexed by operation
+	 */
+	class routeTable {
+	private:
+		struct condition {
+			std::string key;
+			std::optional<std::string> value;
+			std::string file;
+			sinkMask sinks;
+		};
+
+		struct opRoute {
+			sinkMask always = 0;				// Union of the rules with no condition
+			sinkMask reachable = 0;				// Union of every rule, conditional or not
+			bool covered = false;				// An unconditional rule matches, the producer's sink never applies
+			std::vector<condition> conditions;
+		};
+
+		std::array<opRoute, operationCount> _ops;
+
+		static bool matches(const condition& rule, const UTK::Types::LogEntry::logEntry& entry) noexcept;
+
+	public:
+		/**
+		 * @note Throws std::runtime_error if a rule names a sink outside Logger.
+		 */
+		explicit routeTable(const std::vector<routeRule>& rules);
+
+		/**
+		 * @brief The sinks an entry goes to
+		 */
+		sinkMask route(const UTK::Types::LogEntry::logEntry& entry) const noexcept;
+
+		/**
+		 * @brief Every sink an entry with this producer sink and operation could go to, whatever its keys
+		 */
+		sinkMask reachable(UTK::Types::States::Logger lg, UTK::Types::States::Operations op) const noexcept;
+	};
+}
\ No newline at end of file
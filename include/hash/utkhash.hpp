@@ -0,0 +1,142 @@
+//===================================================================================================================================
+// @file	utkhash.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the fast non-cryptographic hashes provided by UTK::Hash, XXH3 64/128-bit
+//			and CRC32C, with one-shot and streaming interfaces.
+//
+// @note    The hot loops run on a kernel picked once at runtime for the CPU(SSE2/AVX2/AVX-512/NEON for
+//          XXH3, SSE4.2/ARMv8 CRC for CRC32C). Every kernel produces identical output, XXH3 values match
+//          the reference xxHash implementation. None of these are suitable for security purposes.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <array>
+
+namespace UTK::Hash {
+
+	/**
+	 * @brief 128-bit hash value, halves match XXH128_hash_t's low64/high64
+	 */
+	struct hash128 {
+		std::uint64_t low = 0;
+		std::uint64_t high = 0;
+
+		bool operator==(const hash128&) const = default;
+	};
+
+	/**
+	 * @brief One-shot XXH3 64-bit hash
+	 *
+	 * @param data:   Bytes to hash.
+	 * @param length: Number of bytes.
+	 * @param seed:   Optional seed, 0 gives the standard XXH3_64bits value.
+	 */
+	std::uint64_t hash64(const void* data, std::size_t length, std::uint64_t seed = 0);
+
+	/**
+	 * @brief One-shot XXH3 128-bit hash
+	 */
+	hash128 hash128Of(const void* data, std::size_t length, std::uint64_t seed = 0);
+
+	/**
+	 * @brief CRC32C(Castagnoli) checksum, pass a previous result as crc to continue it over more data
+	 */
+	std::uint32_t crc32c(const void* data, std::size_t length, std::uint32_t crc = 0);
+
+	inline std::uint64_t hash64(std::string_view text, std::uint64_t seed = 0) {
+		return hash64(text.data(), text.size(), seed);
+	}
+	inline hash128 hash128Of(std::string_view text, std::uint64_t seed = 0) {
+		return hash128Of(text.data(), text.size(), seed);
+	}
+	inline std::uint32_t crc32c(std::string_view text, std::uint32_t crc = 0) {
+		return crc32c(text.data(), text.size(), crc);
+	}
+
+	/**
+	 * @brief Streaming XXH3, feeding data in any number of pieces gives the same value as the one-shot hash
+	 *
+	 * @note Both digests can be taken from the same state, and taking one does not end the stream.
+	 */
+	class hashStream {
+	private:
+		static constexpr std::size_t bufferSize = 256;
+		static constexpr std::size_t secretSize = 192;
+
+		alignas(64) std::array<std::uint64_t, 8> _acc{};
+		alignas(64) std::array<std::uint8_t, bufferSize> _buffer{};
+		alignas(64) std::array<std::uint8_t, secretSize> _secret{};
+		std::size_t _buffered = 0;
+		std::size_t _stripesSoFar = 0;
+		std::uint64_t _totalLength = 0;
+		std::uint64_t _seed = 0;
+
+		void consumeStripes(std::array<std::uint64_t, 8>& acc, std::size_t& stripesSoFar,
+							const std::uint8_t* input, std::size_t stripes) const;
+		void digestLong(std::array<std::uint64_t, 8>& acc) const;
+
+	public:
+		explicit hashStream(std::uint64_t seed = 0);
+
+		/**
+		 * @brief Restarts the stream, optionally with a new seed
+		 */
+		void reset(std::uint64_t seed = 0);
+
+		void update(const void* data, std::size_t length);
+		void update(std::string_view text) { update(text.data(), text.size()); }
+
+		std::uint64_t digest64() const;
+		hash128 digest128() const;
+	};
+
+	/**
+	 * @brief Streaming CRC32C, equivalent to chaining crc32c() calls
+	 */
+	class crc32cStream {
+	private:
+		std::uint32_t _crc = 0;
+
+	public:
+		void reset() { _crc = 0; }
+		void update(const void* data, std::size_t length) { _crc = crc32c(data, length, _crc); }
+		void update(std::string_view text) { update(text.data(), text.size()); }
+		std::uint32_t digest() const { return _crc; }
+	};
+
+	//===================================================================================================================================
+	//												           KERNEL SELECTION
+	//===================================================================================================================================
+
+	/**
+	 * @brief Names of the kernels currently in use
+	 */
+	struct kernelSet {
+		std::string_view hash;
+		std::string_view crc;
+	};
+
+	kernelSet activeKernels();
+
+	/**
+	 * @brief Kernels the running CPU supports, slowest first
+	 */
+	std::vector<std::string_view> availableHashKernels();
+	std::vector<std::string_view> availableCrcKernels();
+
+	/**
+	 * @brief Overrides the automatically selected kernel, mainly for benchmarking and cross-checking
+	 *
+	 * @return False if the name is unknown or unsupported on this CPU, the current kernel is kept.
+	 */
+	bool selectHashKernel(std::string_view name);
+	bool selectCrcKernel(std::string_view name);
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+//===================================================================================================================================
+// @file	utkinterop.h
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	C header exposing UTK's logging dispatcher through a stable extern "C" ABI.
+//
+// @note    Every string crosses the boundary as a pointer and a length, so callers in C, Rust, Python(ctypes)
+//          and the like hand over their own buffers without terminating or converting them. Strings are
+//          copied once into the dispatcher's queue before a push returns, the caller may reuse or free its
+//          buffers straight away. utk_log_push_batch takes the queue lock once for the whole batch. No C++
+//          exception crosses this boundary, failures come back as a utk_status with utk_last_error set.
+//===================================================================================================================================
+
+#ifndef UTK_INTEROP_H
+#define UTK_INTEROP_H
+
+#include "core/utkexports.hpp"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Opaque handle owning one logging dispatcher and its sink workers
+typedef struct utk_dispatcher utk_dispatcher;
+
+typedef enum utk_status {
+	UTK_OK = 0,
+	UTK_ERR_INVALID_ARGUMENT = 1,		// Null handle, out of range enum or a null pointer with a non zero length
+	UTK_ERR_OUT_OF_MEMORY = 2,
+	UTK_ERR_INTERNAL = 3				// Failure inside the dispatcher, see utk_last_error
+} utk_status;
+
+/// Mirrors UTK::Types::States::Logger
+typedef enum utk_logger {
+	UTK_LOGGER_TERMINAL = 0,
+	UTK_LOGGER_JSON = 1,
+	UTK_LOGGER_CSV = 2,
+	UTK_LOGGER_ARCHIVE = 3
+} utk_logger;
+
+/// Mirrors UTK::Types::States::Operations
+typedef enum utk_operation {
+	UTK_OP_WR = 0,
+	UTK_OP_RD = 1,
+	UTK_OP_IN = 2,
+	UTK_OP_OUT = 3,
+	UTK_OP_IDL = 4,
+	UTK_OP_ERR = 5,
+	UTK_OP_MSG = 6,
+	UTK_OP_NOP = 7
+} utk_operation;
+
+/// Mirrors UTK::Types::States::Backpressure
+typedef enum utk_backpressure {
+	UTK_BACKPRESSURE_DROP = 0,
+	UTK_BACKPRESSURE_BLOCK = 1
+} utk_backpressure;
+
+/// Borrowed string, need not be null terminated. data may be NULL only when length is 0.
+typedef struct utk_str {
+	const char* data;
+	size_t length;
+} utk_str;
+
+typedef struct utk_kv {
+	utk_str key;
+	utk_str value;
+} utk_kv;
+
+/**
+ * @brief One log entry, every pointer is borrowed for the duration of the push call only
+ */
+typedef struct utk_log_entry {
+	uint32_t logger;					// utk_logger
+	uint32_t op;						// utk_operation
+	const utk_kv* fields;				// fieldCount key:value pairs, may be NULL when fieldCount is 0
+	size_t fieldCount;
+	utk_str file;						// Empty when unknown
+	int32_t line;						// Negative when unknown
+	utk_str function;					// Empty when unknown
+} utk_log_entry;
+
+/**
+ * @brief Creates a dispatcher, NULL on failure with utk_last_error set
+ *
+ * @param sinkCapacity: Entries each sink queue holds before the policy applies.
+ * @param policy: A utk_backpressure value.
+ */
+UTK_API utk_dispatcher* UTK_API_CALL utk_dispatcher_create(size_t sinkCapacity, uint32_t policy);
+
+/**
+ * @brief Writes out everything already dispatched, joins the sink workers and frees the handle. NULL is ignored.
+ *
+ * @note Entries pushed since the last utk_dispatch are discarded, call utk_flush first to keep them.
+ */
+UTK_API void UTK_API_CALL utk_dispatcher_destroy(utk_dispatcher* dispatcher);
+
+/**
+ * @brief Enqueues a single entry
+ */
+UTK_API utk_status UTK_API_CALL utk_log_push(utk_dispatcher* dispatcher, const utk_log_entry* entry);
+
+/**
+ * @brief Enqueues count entries under a single lock of the dispatcher's queue
+ *
+ * @note The batch is validated up front, if any entry is invalid nothing is enqueued and utk_last_error
+ *		 names the first bad index.
+ */
+UTK_API utk_status UTK_API_CALL utk_log_push_batch(utk_dispatcher* dispatcher, const utk_log_entry* entries, size_t count);
+
+/**
+ * @brief Hands queued entries to the sink workers, see logDispatcher::dispatchLogs
+ */
+UTK_API utk_status UTK_API_CALL utk_dispatch(utk_dispatcher* dispatcher);
+
+/**
+ * @brief Dispatches and waits until every sink has written what it was given
+ */
+UTK_API utk_status UTK_API_CALL utk_flush(utk_dispatcher* dispatcher);
+
+/**
+ * @brief Restricts a sink to the listed operations, entries for any other operation are dropped on push
+ *
+ * @param ops: count utk_operation values, may be NULL when count is 0 to silence the sink.
+ */
+UTK_API utk_status UTK_API_CALL utk_set_operation_filter(utk_dispatcher* dispatcher, uint32_t logger, const uint32_t* ops, size_t count);
+
+/**
+ * @brief Resizes a sink's queue and sets its backpressure policy
+ */
+UTK_API utk_status UTK_API_CALL utk_configure_sink(utk_dispatcher* dispatcher, uint32_t logger, size_t capacity, uint32_t policy);
+
+/**
+ * @brief Message for the last failure on the calling thread, empty after a success. Valid until the next call on this thread.
+ */
+UTK_API const char* UTK_API_CALL utk_last_error(void);
+
+/**
+ * @brief UTK_VERSION of the library actually loaded, compare with the header's to catch a mismatch
+ */
+UTK_API uint32_t UTK_API_CALL utk_version(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,302 @@
+//===================================================================================================================================
+// @file	utkjson.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the zero-copy JSON reader provided by UTK::JSON, for config files and
+//			NDJSON log ingestion.
+//
+// @note    Parsing runs in two stages. Stage one classifies the input 64 bytes at a time with SIMD(picked at
+//          runtime, like UTK::Hash) and turns the masks into the offsets of every structural character,
+//          skipping anything inside strings. Stage two walks those offsets once to validate the grammar and
+//          pair up brackets. Nothing is decoded until it is asked for, elements are views into the input,
+//          strings come back as string_view unless they contain escapes and numbers are converted on access.
+//
+//          Documents are limited to 4GB each, NDJSON input of any size is read in batches. UTF-8 inside
+//          strings is passed through without validation.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include "types/schema/Schema.hpp"
+#include <string_view>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace UTK::JSON {
+
+	namespace Internal {
+		struct parsedDocument;
+	}
+
+	enum class kind : std::uint8_t { null, boolean, number, string, array, object };
+
+	class array;
+	class object;
+
+	/**
+	 * @brief A view of one value inside a document, cheap to copy and valid while the document lives
+	 *
+	 * @note Typed accessors throw std::runtime_error when the value is of another kind or out of range.
+	 */
+	class element {
+	private:
+		friend class array;
+		friend class object;
+		friend class document;
+		friend std::size_t forEachDocument(std::string_view, const std::function<void(element)>&, std::size_t);
+
+		const Internal::parsedDocument* _doc = nullptr;
+		std::uint32_t _token = 0;
+
+		element(const Internal::parsedDocument* doc, std::uint32_t token) : _doc(doc), _token(token) {}
+
+	public:
+		element() = default;
+
+		kind type() const;
+		bool isNull() const { return type() == kind::null; }
+
+		bool getBool() const;
+		std::int64_t getInt64() const;
+		std::uint64_t getUint64() const;
+
+		/**
+		 * @brief Nearest double, numbers too small to represent read as zero of the same sign, too large throws
+		 */
+		double getDouble() const;
+
+		/**
+		 * @brief True for numbers written without a fraction or exponent
+		 */
+		bool isInteger() const;
+
+		/**
+		 * @brief String contents with escapes decoded
+		 */
+		std::string getString() const;
+
+		/**
+		 * @brief Zero-copy where possible, returns a view of the input unless the string has escapes, in
+		 *		  which case it is decoded into scratch and the view points there
+		 */
+		std::string_view getString(std::string& scratch) const;
+
+		/**
+		 * @brief String contents exactly as written, escapes left in place
+		 */
+		std::string_view rawString() const;
+
+		array getArray() const;
+		object getObject() const;
+
+		/**
+		 * @brief Object member lookup, throws if the key is missing
+		 */
+		element operator[](std::string_view key) const;
+
+		/**
+		 * @brief Array element by position, walks the array so prefer iteration for more than a few lookups
+		 */
+		element at(std::size_t index) const;
+
+		/**
+		 * @brief The value's full source text, e.g. a whole nested object
+		 */
+		std::string_view raw() const;
+	};
+
+	/**
+	 * @brief An object member, key is the raw key text(escapes left in place)
+	 */
+	struct member {
+		std::string_view key;
+		element value;
+	};
+
+	class array {
+	private:
+		friend class element;
+
+		const Internal::parsedDocument* _doc;
+		std::uint32_t _open;
+
+		array(const Internal::parsedDocument* doc, std::uint32_t open) : _doc(doc), _open(open) {}
+
+	public:
+		class iterator {
+		private:
+			friend class array;
+
+			const Internal::parsedDocument* _doc;
+			std::uint32_t _token;
+
+			iterator(const Internal::parsedDocument* doc, std::uint32_t token) : _doc(doc), _token(token) {}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = element;
+			using difference_type = std::ptrdiff_t;
+
+			iterator() : _doc(nullptr), _token(0) {}
+
+			element operator*() const { return element(_doc, _token); }
+			iterator& operator++();
+			iterator operator++(int) { iterator old = *this; ++*this; return old; }
+			bool operator==(const iterator& other) const { return _token == other._token; }
+		};
+
+		iterator begin() const;
+		iterator end() const;
+		std::size_t size() const;
+		bool empty() const { return begin() == end(); }
+	};
+
+	class object {
+	private:
+		friend class element;
+
+		const Internal::parsedDocument* _doc;
+		std::uint32_t _open;
+
+		object(const Internal::parsedDocument* doc, std::uint32_t open) : _doc(doc), _open(open) {}
+
+	public:
+		class iterator {
+		private:
+			friend class object;
+
+			const Internal::parsedDocument* _doc;
+			std::uint32_t _token;
+
+			iterator(const Internal::parsedDocument* doc, std::uint32_t token) : _doc(doc), _token(token) {}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = member;
+			using difference_type = std::ptrdiff_t;
+
+			iterator() : _doc(nullptr), _token(0) {}
+
+			member operator*() const;
+			iterator& operator++();
+			iterator operator++(int) { iterator old = *this; ++*this; return old; }
+			bool operator==(const iterator& other) const { return _token == other._token; }
+		};
+
+		iterator begin() const;
+		iterator end() const;
+		std::size_t size() const;
+		bool empty() const { return begin() == end(); }
+
+		/**
+		 * @brief Finds a member by decoded key, the first match wins if a key repeats
+		 */
+		std::optional<element> find(std::string_view key) const;
+	};
+
+	/**
+	 * @brief Number of top level values a document accepts
+	 */
+	enum class parseMode : std::uint8_t {
+		single,		// Exactly one value, anything after it is an error
+		many		// Any number of whitespace separated values(NDJSON, concatenated JSON)
+	};
+
+	/**
+	 * @brief A parsed document, owning its structural index and, when loaded from a file, the mapping
+	 */
+	class document {
+	private:
+		std::unique_ptr<Internal::parsedDocument> _parsed;
+
+		explicit document(std::unique_ptr<Internal::parsedDocument> parsed);
+
+	public:
+		document(document&&) noexcept;
+		document& operator=(document&&) noexcept;
+		~document();
+
+		/**
+		 * @brief Parses text the caller keeps alive for as long as the document and its elements are used
+		 *
+		 * @throws std::runtime_error with the line and column of the first error.
+		 */
+		static document parse(std::string_view json, parseMode mode = parseMode::single);
+
+		/**
+		 * @brief Memory-maps a file read-only and parses it in place
+		 */
+		static document load(const std::filesystem::path& path, parseMode mode = parseMode::single);
+
+		/**
+		 * @brief The top level value, the first one in parseMode::many
+		 */
+		element root() const;
+
+		/**
+		 * @brief Top level values, one per line for NDJSON
+		 */
+		std::size_t size() const;
+		element operator[](std::size_t index) const;
+
+		std::string_view text() const;
+	};
+
+	/**
+	 * @brief Streams NDJSON, calling fn with each top level value in order
+	 *
+	 * @note Input is cut into batches of about batchBytes on line boundaries and parsed one batch at a
+	 *		 time, so memory stays flat however large the input. Elements are only valid inside fn.
+	 * @return Number of values visited.
+	 */
+	std::size_t forEachDocument(std::string_view ndjson, const std::function<void(element)>& fn, std::size_t batchBytes = 4 << 20);
+	std::size_t forEachDocument(const std::filesystem::path& path, const std::function<void(element)>& fn, std::size_t batchBytes = 4 << 20);
+
+	//===================================================================================================================================
+	//												          SCHEMA FIELD CONVERSION
+	//===================================================================================================================================
+
+	/**
+	 * @brief Converts a value to the schema Field variant
+	 *
+	 * @note null, bool, string and arrays map directly, numbers must be integers that fit an int. Objects
+	 *		 have no Field form and throw, convert their members with toFields instead.
+	 */
+	Field toField(const element& value);
+
+	/**
+	 * @brief Converts each member of an object, keeping its(decoded) name
+	 */
+	std::vector<std::pair<std::string, Field>> toFields(const object& members);
+
+	//===================================================================================================================================
+	//												           KERNEL SELECTION
+	//===================================================================================================================================
+
+	/**
+	 * @brief Name of the stage one classifier in use
+	 */
+	std::string_view activeKernel();
+
+	/**
+	 * @brief Classifiers the running CPU supports, slowest first
+	 */
+	std::vector<std::string_view> availableKernels();
+
+	/**
+	 * @brief Overrides the automatically selected classifier, mainly for benchmarking and cross-checking
+	 *
+	 * @return False if the name is unknown or unsupported on this CPU, the current kernel is kept.
+	 */
+	bool selectKernel(std::string_view name);
+}
\ No newline at end of file
@@ -0,0 +1,223 @@
+//===================================================================================================================================
+// @file	utkperipheral.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the serial I/O engine and frame decoders provided by UTK::Peripheral.
+//
+// @note    One serialEngine multiplexes any number of serial ports over a single epoll thread. Each port
+//          reads into a ring buffer mapped twice back to back in memory, so the unread bytes are always one
+//          contiguous block however the ring has wrapped. Framers split that block into frames, decoding
+//          in place where needed, and handlers see the frame where it was read without a copy. Writes
+//          queued between two turns of the loop go out in a single write call per port.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include <string_view>
+#include <filesystem>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace UTK::Peripheral {
+
+	namespace Internal {
+		class engineLoop;
+	}
+
+	enum class parity {
+		NONE,
+		EVEN,
+		ODD
+	};
+
+	struct portSettings {
+		std::uint32_t baudRate = 115200;
+		std::uint8_t dataBits = 8;					// 5 to 8
+		parity parityMode = parity::NONE;
+		std::uint8_t stopBits = 1;					// 1 or 2
+		bool hardwareFlowControl = false;			// RTS/CTS
+	};
+
+	/**
+	 * @brief Splits a port's byte stream into frames, each port owns its own instance
+	 *
+	 * @note next() runs on the engine thread and may keep state between calls, encode() may run on any
+	 *		 thread that sends and must not touch that state.
+	 */
+	class IFramer {
+	public:
+		struct scan {
+			std::size_t consumed = 0;		// Bytes to drop from the front, 0 while the next frame is incomplete
+			std::string_view frame;			// Inside the block handed to next(), valid until the handler returns
+			bool found = false;				// False when the consumed bytes held no frame(noise, oversized junk)
+		};
+
+		virtual ~IFramer() = default;
+
+		/**
+		 * @brief Looks for one frame at the front of the unread bytes
+		 *
+		 * @param data: Every unread byte of the port, contiguous and writable so frames can be decoded in place.
+		 * @param size: Number of unread bytes, the same bytes are offered again until some are consumed.
+		 */
+		virtual scan next(char* data, std::size_t size) = 0;
+
+		/**
+		 * @brief Appends payload to out in this framer's wire format
+		 */
+		virtual void encode(std::string_view payload, std::string& out) const = 0;
+
+		/**
+		 * @brief Called after the engine empties a full ring, the next bytes are likely the middle of a frame
+		 */
+		virtual void reset() {}
+	};
+
+	/**
+	 * @brief Frames ending in a delimiter such as "\n" or "\r\n", the delimiter is not part of the frame
+	 */
+	class delimitedFramer final : public IFramer {
+	private:
+		std::string _delimiter;
+		std::size_t _maxFrame;
+		std::size_t _searched = 0;					// Bytes already known not to start a delimiter
+		bool _skipping = false;						// Dropping the rest of a frame that was too long
+
+	public:
+		explicit delimitedFramer(std::string delimiter = "\n", std::size_t maxFrame = 4096);
+
+		scan next(char* data, std::size_t size) override;
+		void encode(std::string_view payload, std::string& out) const override;
+		void reset() override;
+	};
+
+	/**
+	 * @brief Frames led by a 1, 2 or 4 byte unsigned payload length
+	 */
+	class lengthPrefixedFramer final : public IFramer {
+	private:
+		std::size_t _headerBytes;
+		bool _bigEndian;
+		std::size_t _maxFrame;
+
+	public:
+		explicit lengthPrefixedFramer(std::size_t headerBytes = 2, bool bigEndian = true, std::size_t maxFrame = 4096);
+
+		scan next(char* data, std::size_t size) override;
+		void encode(std::string_view payload, std::string& out) const override;
+	};
+
+	/**
+	 * @brief Every frame is exactly frameBytes long
+	 */
+	class fixedFramer final : public IFramer {
+	private:
+		std::size_t _frameBytes;
+
+	public:
+		explicit fixedFramer(std::size_t frameBytes);
+
+		scan next(char* data, std::size_t size) override;
+		void encode(std::string_view payload, std::string& out) const override;
+	};
+
+	/**
+	 * @brief SLIP(RFC 1055) frames, unescaped in place inside the ring
+	 *
+	 * @note Back to back END bytes are skipped rather than read as empty frames, so senders may lead each
+	 *		 frame with an END to flush line noise as the RFC suggests.
+	 */
+	class slipFramer final : public IFramer {
+	private:
+		std::size_t _maxFrame;
+		std::size_t _searched = 0;
+		bool _skipping = false;
+
+	public:
+		explicit slipFramer(std::size_t maxFrame = 4096);
+
+		scan next(char* data, std::size_t size) override;
+		void encode(std::string_view payload, std::string& out) const override;
+		void reset() override;
+	};
+
+	using portId = std::uint32_t;
+
+	/**
+	 * @brief Running totals for one port
+	 */
+	struct portStats {
+		std::uint64_t bytesRead = 0;
+		std::uint64_t bytesWritten = 0;
+		std::uint64_t framesRead = 0;
+		std::uint64_t bytesDiscarded = 0;			// Consumed by the framer without producing a frame
+		std::uint64_t overflows = 0;				// Times the ring filled without a frame and was emptied
+		std::uint64_t writeCalls = 0;				// write(2) calls, compare with bytesWritten to see batching
+	};
+
+	/**
+	 * @brief Event driven engine running many serial ports on one thread
+	 *
+	 * @note Handlers run on the engine thread, a slow handler delays every port. A port that fails(device
+	 *		 unplugged, I/O error) reports through its error handler once and is closed. Thread safe, any
+	 *		 thread may open, write to or close ports.
+	 */
+	class serialEngine {
+	private:
+		std::unique_ptr<Internal::engineLoop> _loop;
+
+	public:
+		using FrameHandler = std::function<void(portId id, std::string_view frame)>;
+		using ErrorHandler = std::function<void(portId id, const std::string& message)>;
+
+		/**
+		 * @param ringBytes: Receive ring per port, rounded up to a power of two of at least a page. Bounds the
+		 *					 largest frame a port can deliver.
+		 */
+		explicit serialEngine(std::size_t ringBytes = 64 * 1024);
+		~serialEngine();
+
+		serialEngine(const serialEngine&) = delete;
+		serialEngine& operator=(const serialEngine&) = delete;
+
+		/**
+		 * @brief Opens a serial device in raw mode and starts reading from it
+		 *
+		 * @note Throws std::runtime_error if the device cannot be opened or does not take the settings.
+		 */
+		portId open(const std::filesystem::path& device, const portSettings& settings, std::unique_ptr<IFramer> framer,
+			FrameHandler onFrame, ErrorHandler onError = {});
+
+		/**
+		 * @brief Takes ownership of an already configured descriptor, such as a pty master or a socket
+		 */
+		portId adopt(int fd, std::unique_ptr<IFramer> framer, FrameHandler onFrame, ErrorHandler onError = {});
+
+		/**
+		 * @brief Closes the port, no handler for it runs once this returns
+		 *
+		 * @note Called from inside a handler the port closes when that handler returns.
+		 */
+		void close(portId id);
+
+		/**
+		 * @brief Queues raw bytes, false if the port is not open
+		 */
+		bool write(portId id, std::string_view bytes);
+
+		/**
+		 * @brief Queues payload encoded by the port's framer, false if the port is not open
+		 */
+		bool send(portId id, std::string_view payload);
+
+		/**
+		 * @brief Totals for an open port, throws std::runtime_error for an unknown id
+		 */
+		portStats stats(portId id) const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+//===================================================================================================================================
+// @file	utkprogressbar.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the progress bars provided by UTK::Progressbar.
+//
+// @note    Workers never print. tick() only bumps a cache-line padded counter picked by the calling
+//          thread, and one renderer thread sums the counters and redraws at a capped rate. When stdout
+//          is not a terminal the renderer switches to a plain status line per bar every few seconds,
+//          so logs and CI output stay readable.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include <condition_variable>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace UTK::Progressbar {
+
+	/**
+	 * @brief Settings for a progressDisplay
+	 */
+	struct progressOptions {
+		std::chrono::milliseconds refreshInterval{ 100 };		// Minimum time between terminal redraws
+		std::chrono::milliseconds quietInterval{ 5000 };		// Time between status lines when not on a terminal
+		std::size_t barWidth = 30;
+		bool forceQuiet = false;								// Use status lines even on a terminal
+	};
+
+	/**
+	 * @brief A single progress bar, created by and owned by a progressDisplay
+	 *
+	 * @note tick() is safe to call from any number of threads. Each thread lands on its own padded
+	 *		 slot, so workers do not contend on one cache line.
+	 */
+	class progressBar {
+	private:
+		friend class progressDisplay;
+
+		struct alignas(64) slot {
+			std::atomic<std::uint64_t> count{ 0 };
+		};
+
+		std::string _name;
+		std::atomic<std::uint64_t> _total;
+		std::atomic<bool> _finished{ false };
+		std::unique_ptr<slot[]> _slots;
+		std::size_t _slotMask;
+		std::size_t _depth;
+		progressBar* _parent;
+
+		// Renderer-only state, touched by the render thread alone
+		std::chrono::steady_clock::time_point _started;
+		std::chrono::steady_clock::time_point _lastSample;
+		std::uint64_t _lastCount = 0;
+		double _rate = 0.0;
+
+		static std::size_t threadSlot();
+
+	public:
+		progressBar(std::string name, std::uint64_t total, progressBar* parent);
+
+		progressBar(const progressBar&) = delete;
+		progressBar& operator=(const progressBar&) = delete;
+
+		void tick(std::uint64_t amount = 1) noexcept {
+			_slots[threadSlot() & _slotMask].count.fetch_add(amount, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Changes the expected total, 0 means unknown(shows count and rate only)
+		 */
+		void setTotal(std::uint64_t total) noexcept { _total.store(total, std::memory_order_relaxed); }
+
+		/**
+		 * @brief Marks the bar complete, finished child bars drop out of the live view
+		 */
+		void finish() noexcept { _finished.store(true, std::memory_order_release); }
+
+		/**
+		 * @brief Sum of every thread's ticks so far
+		 */
+		std::uint64_t count() const noexcept;
+
+		std::uint64_t total() const noexcept { return _total.load(std::memory_order_relaxed); }
+		bool finished() const noexcept { return _finished.load(std::memory_order_acquire); }
+		const std::string& name() const { return _name; }
+	};
+
+	/**
+	 * @brief Owns a set of(optionally nested) bars and the thread that draws them
+	 */
+	class progressDisplay {
+	private:
+		progressOptions _options;
+		bool _terminal;
+
+		std::mutex _mutex;							// Guards _bars and _stopping, never taken by tick()
+		std::condition_variable _wake;
+		std::vector<std::unique_ptr<progressBar>> _bars;	// Kept in display order, children after their parent
+		bool _stopping = false;
+
+		std::string _buffer;
+		std::size_t _linesDrawn = 0;
+		std::chrono::steady_clock::time_point _lastQuiet;
+		std::thread _renderer;
+
+		void renderLoop();
+		void render(bool final);
+		void appendBar(progressBar& bar, std::chrono::steady_clock::time_point now, bool quiet);
+		void writeBuffer();
+
+	public:
+		explicit progressDisplay(progressOptions options = {});
+		~progressDisplay();
+
+		progressDisplay(const progressDisplay&) = delete;
+		progressDisplay& operator=(const progressDisplay&) = delete;
+
+		/**
+		 * @brief Adds a bar, nested under parent when given
+		 *
+		 * @return Reference valid for the lifetime of the display.
+		 */
+		progressBar& addBar(std::string name, std::uint64_t total, progressBar* parent = nullptr);
+
+		/**
+		 * @brief Draws a final frame and stops the renderer, called automatically on destruction
+		 */
+		void stop();
+
+		bool isTerminal() const { return _terminal; }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,428 @@
+//===================================================================================================================================
+// @file	utkrandom.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the pseudo random engines and bulk distributions provided by UTK::Random.
+//
+// @note    Every engine satisfies std::uniform_random_bit_generator, so they drop into the standard
+//          distributions, but the fill* functions below are the fast path: they pull raw bits in blocks
+//          and convert whole spans at once. Jump functions split one seed into non-overlapping streams,
+//          one per thread. None of these engines are suitable for cryptographic use.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include <type_traits>
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <span>
+
+namespace UTK::Random {
+
+	/**
+	 * @brief SplitMix64 step, used to expand a single seed into full engine state
+	 */
+	constexpr std::uint64_t splitMix64(std::uint64_t& state) {
+		std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
+	//===================================================================================================================================
+	//												              ENGINES
+	//===================================================================================================================================
+
+	/**
+	 * @brief xoshiro256++ 1.0, 64-bit output with a period of 2^256 - 1
+	 */
+	class xoshiro256pp {
+	private:
+		std::array<std::uint64_t, 4> _state;
+
+		static constexpr std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+		void jumpBy(const std::array<std::uint64_t, 4>& polynomial);
+
+	public:
+		using result_type = std::uint64_t;
+
+		explicit xoshiro256pp(std::uint64_t seed = 0x5EED5EED5EED5EEDULL) { this->seed(seed); }
+
+		/**
+		 * @brief Restores a state previously read through state(), it must not be all zero
+		 */
+		explicit xoshiro256pp(const std::array<std::uint64_t, 4>& state) : _state(state) {}
+
+		void seed(std::uint64_t seed) {
+			for (auto& word : _state) word = splitMix64(seed);
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+		result_type operator()() {
+			const std::uint64_t result = rotl(_state[0] + _state[3], 23) + _state[0];
+			const std::uint64_t t = _state[1] << 17;
+
+			_state[2] ^= _state[0];
+			_state[3] ^= _state[1];
+			_state[1] ^= _state[2];
+			_state[0] ^= _state[3];
+			_state[2] ^= t;
+			_state[3] = rotl(_state[3], 45);
+
+			return result;
+		}
+
+		/**
+		 * @brief Writes the next out.size() outputs, identical to calling operator() that many times
+		 */
+		void fill(std::span<result_type> out);
+
+		/**
+		 * @brief Advances 2^128 steps, giving 2^128 non-overlapping streams of 2^128 values
+		 */
+		void jump();
+
+		/**
+		 * @brief Advances 2^192 steps, for splitting streams that will themselves be jumped
+		 */
+		void longJump();
+
+		const std::array<std::uint64_t, 4>& state() const { return _state; }
+		bool operator==(const xoshiro256pp&) const = default;
+	};
+
+	/**
+	 * @brief PCG32(XSH-RR), 32-bit output from 64-bit state with selectable stream
+	 */
+	class pcg32 {
+	private:
+		std::uint64_t _state = 0;
+		std::uint64_t _increment = 1;
+
+		static constexpr std::uint64_t multiplier = 6364136223846793005ULL;
+
+	public:
+		using result_type = std::uint32_t;
+
+		/**
+		 * @param seed:	  Starting state.
+		 * @param stream: Sequence selector, engines with different streams never share output order.
+		 */
+		explicit pcg32(std::uint64_t seed = 0x853C49E6748FEA9BULL, std::uint64_t stream = 0xDA3E39CB94B95BDBULL) {
+			this->seed(seed, stream);
+		}
+
+		void seed(std::uint64_t seed, std::uint64_t stream = 0xDA3E39CB94B95BDBULL) {
+			_state = 0;
+			_increment = (stream << 1) | 1;
+			(*this)();
+			_state += seed;
+			(*this)();
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+		result_type operator()() {
+			const std::uint64_t old = _state;
+			_state = old * multiplier + _increment;
+
+			const auto shifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+			const auto rotation = static_cast<unsigned>(old >> 59);
+			return (shifted >> rotation) | (shifted << ((0U - rotation) & 31));
+		}
+
+		void fill(std::span<result_type> out);
+
+		/**
+		 * @brief Skips delta outputs in O(log delta)
+		 */
+		void advance(std::uint64_t delta);
+
+		/**
+		 * @brief Advances 2^48 steps, giving 65536 non-overlapping streams of 2^48 values per sequence
+		 */
+		void jump() { advance(std::uint64_t{ 1 } << 48); }
+
+		bool operator==(const pcg32&) const = default;
+	};
+
+	/**
+	 * @brief Eight interleaved xoshiro256++ lanes, each a jump() apart, advanced together in SIMD registers
+	 *
+	 * @note The output order differs from xoshiro256pp(lane outputs are interleaved), use it where
+	 *		 throughput matters more than reproducing a scalar sequence. fill() runs on AVX-512, AVX2 or SSE2
+	 *		 kernels picked at runtime.
+	 */
+	class xoshiro256ppx8 {
+	public:
+		static constexpr std::size_t lanes = 8;
+
+	private:
+		alignas(64) std::array<std::array<std::uint64_t, lanes>, 4> _state;	// Structure of arrays, [word][lane]
+		alignas(64) std::array<std::uint64_t, lanes> _block{};
+		std::size_t _used = lanes;
+
+		void refill();
+
+	public:
+		using result_type = std::uint64_t;
+
+		explicit xoshiro256ppx8(std::uint64_t seed = 0x5EED5EED5EED5EEDULL) { this->seed(seed); }
+
+		void seed(std::uint64_t seed);
+
+		/**
+		 * @brief Builds the lanes from an existing engine, lane i starts i jumps after base
+		 */
+		explicit xoshiro256ppx8(xoshiro256pp base);
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+		result_type operator()() {
+			if (_used == lanes) refill();
+			return _block[_used++];
+		}
+
+		void fill(std::span<result_type> out);
+
+		/**
+		 * @brief Long-jumps every lane, so repeated calls give each thread its own set of eight streams
+		 */
+		void jump();
+	};
+
+	static_assert(std::uniform_random_bit_generator<xoshiro256pp>);
+	static_assert(std::uniform_random_bit_generator<pcg32>);
+	static_assert(std::uniform_random_bit_generator<xoshiro256ppx8>);
+
+	/**
+	 * @brief Builds count engines whose output streams never overlap, stream i is base jumped i times
+	 */
+	template<typename Engine>
+	std::vector<Engine> makeStreams(Engine base, std::size_t count) {
+		std::vector<Engine> streams;
+		streams.reserve(count);
+		for (std::size_t i = 0; i < count; i++) {
+			streams.push_back(base);
+			base.jump();
+		}
+		return streams;
+	}
+
+	/**
+	 * @brief Name of the kernel xoshiro256ppx8 is using("avx512", "avx2", "sse2" or "scalar")
+	 */
+	const char* activeKernel();
+
+	//===================================================================================================================================
+	//												         BULK DISTRIBUTIONS
+	//===================================================================================================================================
+
+	namespace Internal {
+
+		inline constexpr std::size_t chunkSize = 256;
+
+		/**
+		 * @brief Fills out with 64-bit words from any engine, pairing outputs of 32-bit engines
+		 */
+		template<typename Engine>
+		void fillWords(Engine& engine, std::span<std::uint64_t> out) {
+			using result = typename Engine::result_type;
+
+			if constexpr (std::is_same_v<result, std::uint64_t> && requires { engine.fill(out); }) {
+				engine.fill(out);
+			}
+			else if constexpr (std::is_same_v<result, std::uint32_t> && requires(std::span<std::uint32_t> s) { engine.fill(s); }) {
+				std::array<std::uint32_t, chunkSize * 2> halves;
+				for (std::size_t done = 0; done < out.size(); done += chunkSize) {
+					const std::size_t count = std::min(chunkSize, out.size() - done);
+					engine.fill(std::span<std::uint32_t>(halves.data(), count * 2));
+					for (std::size_t i = 0; i < count; i++) {
+						out[done + i] = (static_cast<std::uint64_t>(halves[i * 2]) << 32) | halves[i * 2 + 1];
+					}
+				}
+			}
+			else {
+				static_assert(Engine::min() == 0 && Engine::max() == std::numeric_limits<std::uint64_t>::max(),
+							  "engines without fill() must produce full 64-bit words");
+				for (auto& word : out) word = engine();
+			}
+		}
+
+		/**
+		 * @brief Maps 64 random bits to [0, 1) through the exponent trick, 52 bits of resolution
+		 */
+		inline double unitInterval(std::uint64_t bits) {
+			const std::uint64_t pattern = (bits >> 12) | 0x3FF0000000000000ULL;
+			double value;
+			static_assert(sizeof(value) == sizeof(pattern));
+			std::memcpy(&value, &pattern, sizeof(value));
+			return value - 1.0;
+		}
+
+		/**
+		 * @brief Float counterpart of unitInterval, 23 bits of resolution so the value is exact in a float
+		 *		  and never rounds up to 1
+		 */
+		inline float unitIntervalFloat(std::uint64_t bits) {
+			const std::uint32_t pattern = static_cast<std::uint32_t>(bits >> 41) | 0x3F800000u;
+			float value;
+			static_assert(sizeof(value) == sizeof(pattern));
+			std::memcpy(&value, &pattern, sizeof(value));
+			return value - 1.0f;
+		}
+
+		/**
+		 * @brief High half of a 64x64 multiply
+		 */
+		inline std::uint64_t multiplyHigh(std::uint64_t a, std::uint64_t b, std::uint64_t& low) {
+		#if defined(__SIZEOF_INT128__)
+			__extension__ typedef unsigned __int128 uint128;
+			const uint128 product = static_cast<uint128>(a) * b;
+			low = static_cast<std::uint64_t>(product);
+			return static_cast<std::uint64_t>(product >> 64);
+		#else
+			const std::uint64_t loLo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+			const std::uint64_t hiLo = (a >> 32) * (b & 0xFFFFFFFF);
+			const std::uint64_t loHi = (a & 0xFFFFFFFF) * (b >> 32);
+			const std::uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+			low = (cross << 32) | (loLo & 0xFFFFFFFF);
+			return (hiLo >> 32) + (cross >> 32) + (a >> 32) * (b >> 32);
+		#endif
+		}
+	}
+
+	/**
+	 * @brief Unbiased integer in [0, bound) using Lemire's multiply-shift rejection, bound must be non zero
+	 */
+	template<typename Engine>
+	std::uint64_t uniformBelow(Engine& engine, std::uint64_t bound) {
+		std::uint64_t bits[1];
+		Internal::fillWords(engine, bits);
+
+		std::uint64_t low;
+		std::uint64_t high = Internal::multiplyHigh(bits[0], bound, low);
+
+		if (low < bound) {
+			const std::uint64_t threshold = (0 - bound) % bound;
+			while (low < threshold) {
+				Internal::fillWords(engine, bits);
+				high = Internal::multiplyHigh(bits[0], bound, low);
+			}
+		}
+		return high;
+	}
+
+	/**
+	 * @brief Fills out with raw 64-bit words
+	 */
+	template<typename Engine>
+	void fillBits(Engine& engine, std::span<std::uint64_t> out) {
+		Internal::fillWords(engine, out);
+	}
+
+	/**
+	 * @brief Fills out with values uniformly distributed over [low, high)
+	 *
+	 * @note high is never returned, values that would round up to it are clamped to the next value below it.
+	 */
+	template<typename Engine, std::floating_point T>
+	void fillUniform(Engine& engine, std::span<T> out, T low, T high) {
+		std::array<std::uint64_t, Internal::chunkSize> bits;
+		const T scale = high - low;
+		const T upper = (low < high) ? std::nextafter(high, low) : low;
+
+		for (std::size_t done = 0; done < out.size(); done += bits.size()) {
+			const std::size_t count = std::min(bits.size(), out.size() - done);
+			Internal::fillWords(engine, std::span<std::uint64_t>(bits.data(), count));
+
+			// Branch free so the conversion loop vectorizes, the clamp compiles to a min
+			for (std::size_t i = 0; i < count; i++) {
+				T unit;
+				if constexpr (std::is_same_v<T, float>) unit = Internal::unitIntervalFloat(bits[i]);
+				else unit = static_cast<T>(Internal::unitInterval(bits[i]));
+
+				out[done + i] = std::min(low + unit * scale, upper);
+			}
+		}
+	}
+
+	/**
+	 * @brief Fills out with integers uniformly distributed over [low, high], inclusive like std::uniform_int_distribution
+	 */
+	template<typename Engine, std::integral T>
+	void fillUniform(Engine& engine, std::span<T> out, T low, T high) {
+		using unsignedT = std::make_unsigned_t<T>;
+		const std::uint64_t range = static_cast<std::uint64_t>(static_cast<unsignedT>(high) - static_cast<unsignedT>(low));
+
+		if (range == std::numeric_limits<std::uint64_t>::max()) {
+			std::array<std::uint64_t, Internal::chunkSize> bits;
+			for (std::size_t done = 0; done < out.size(); done += bits.size()) {
+				const std::size_t count = std::min(bits.size(), out.size() - done);
+				Internal::fillWords(engine, std::span<std::uint64_t>(bits.data(), count));
+				for (std::size_t i = 0; i < count; i++) out[done + i] = static_cast<T>(bits[i]);
+			}
+			return;
+		}
+
+		const std::uint64_t bound = range + 1;
+		const std::uint64_t threshold = (0 - bound) % bound;
+		std::array<std::uint64_t, Internal::chunkSize> bits;
+
+		for (std::size_t done = 0; done < out.size(); done += bits.size()) {
+			const std::size_t count = std::min(bits.size(), out.size() - done);
+			Internal::fillWords(engine, std::span<std::uint64_t>(bits.data(), count));
+
+			for (std::size_t i = 0; i < count; i++) {
+				std::uint64_t lowBits;
+				std::uint64_t value = Internal::multiplyHigh(bits[i], bound, lowBits);
+
+				// Rejection is rare(probability bound / 2^64), redraw singly when it happens
+				while (lowBits < threshold) {
+					std::uint64_t redraw[1];
+					Internal::fillWords(engine, redraw);
+					value = Internal::multiplyHigh(redraw[0], bound, lowBits);
+				}
+				out[done + i] = static_cast<T>(static_cast<unsignedT>(low) + static_cast<unsignedT>(value));
+			}
+		}
+	}
+
+	/**
+	 * @brief Fills out with normally distributed values using the Box-Muller transform on bulk uniforms
+	 */
+	template<typename Engine, std::floating_point T>
+	void fillNormal(Engine& engine, std::span<T> out, T mean = 0, T stddev = 1) {
+		constexpr double twoPi = 6.283185307179586476925286766559;
+		std::array<std::uint64_t, Internal::chunkSize> bits;
+
+		for (std::size_t done = 0; done < out.size(); done += bits.size()) {
+			const std::size_t count = std::min(bits.size(), out.size() - done);
+			const std::size_t pairs = (count + 1) / 2;
+			Internal::fillWords(engine, std::span<std::uint64_t>(bits.data(), pairs * 2));
+
+			for (std::size_t i = 0; i < pairs; i++) {
+				// 1 - u keeps the log argument in (0, 1]
+				const double radius = std::sqrt(-2.0 * std::log(1.0 - Internal::unitInterval(bits[i * 2])));
+				const double angle = twoPi * Internal::unitInterval(bits[i * 2 + 1]);
+
+				out[done + i * 2] = mean + stddev * static_cast<T>(radius * std::cos(angle));
+				if (i * 2 + 1 < count) out[done + i * 2 + 1] = mean + stddev * static_cast<T>(radius * std::sin(angle));
+			}
+		}
+	}
+}
\ No newline at end of file
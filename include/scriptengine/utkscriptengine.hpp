@@ -0,0 +1,176 @@
+//===================================================================================================================================
+// @file	utkscriptengine.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the script engine provided by UTK::ScriptEngine, a small language for test
+//			automation compiled once to register bytecode.
+//
+// @note    Scripts are parsed straight into register based bytecode and run by a computed goto dispatch
+//          loop(a plain switch on compilers without labels as values). Compiled programs are kept in memory
+//          and, when a cache directory is set, written to disk named by the XXH3-128 hash of the source, so
+//          later processes running the same script skip the parser entirely.
+//
+//          The language:
+//              let x = 10                      // Locals are block scoped, assignment needs a prior let
+//              while x > 0 { x = x - 1 }       // if/else, while, break, continue
+//              fn add(a, b) { return a + b }   // Top level only, may be called before its definition
+//              assert(add(1, 2) == 3, "maths") // Anything not declared with fn is a host function
+//          Values are nil, bool, number(double) and string. Only nil and false are falsy, + joins strings.
+//          Functions see their parameters and their own locals, there are no globals or closures.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include "hash/utkhash.hpp"
+#include <unordered_map>
+#include <string_view>
+#include <filesystem>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include <variant>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <span>
+
+namespace UTK::ScriptEngine {
+
+	namespace Internal {
+		struct machine;
+	}
+
+	/**
+	 * @brief A script value, nil, bool, number or string
+	 *
+	 * @note Strings are shared and immutable, copying a value never copies string data.
+	 */
+	class value {
+	private:
+		friend struct Internal::machine;
+
+		std::variant<std::monostate, bool, double, std::shared_ptr<const std::string>> _data;
+
+	public:
+		enum class kind : std::uint8_t { nil, boolean, number, string };
+
+		value() = default;
+		value(bool b) : _data(b) {}
+		value(double n) : _data(n) {}
+		value(int n) : _data(static_cast<double>(n)) {}
+		value(std::string s) : _data(std::make_shared<const std::string>(std::move(s))) {}
+		value(const char* s) : value(std::string(s)) {}
+
+		kind type() const noexcept { return static_cast<kind>(_data.index()); }
+		bool isNil() const noexcept { return _data.index() == 0; }
+		bool isBool() const noexcept { return _data.index() == 1; }
+		bool isNumber() const noexcept { return _data.index() == 2; }
+		bool isString() const noexcept { return _data.index() == 3; }
+
+		/**
+		 * @brief Typed accessors, throw std::runtime_error when the value holds another type
+		 */
+		bool asBool() const;
+		double asNumber() const;
+		const std::string& asString() const;
+
+		/**
+		 * @brief Script truthiness, everything except nil and false is true
+		 */
+		bool truthy() const noexcept {
+			return !(isNil() || (isBool() && *std::get_if<bool>(&_data) == false));
+		}
+
+		/**
+		 * @brief Text form as print() shows it, integral numbers print without a fraction
+		 */
+		std::string toString() const;
+
+		friend bool operator==(const value& left, const value& right);
+	};
+
+	/**
+	 * @brief Same type and same contents, numbers compare by value and strings by text
+	 */
+	bool operator==(const value& left, const value& right);
+
+	/**
+	 * @brief Host function callable from scripts, receives the call's arguments in order
+	 */
+	using nativeFunction = std::function<value(std::span<const value> args)>;
+
+	/**
+	 * @brief Compiled bytecode for one script, immutable and safe to run from several threads at once
+	 */
+	struct program;
+
+	struct engineOptions {
+		std::filesystem::path cacheDirectory;		// Where compiled bytecode is stored, empty disables the disk cache
+		std::size_t maxCallDepth = 200;				// Script function nesting limit before a runtime error
+	};
+
+	struct cacheStats {
+		std::uint64_t memoryHits = 0;		// Served from this engine's in-memory table
+		std::uint64_t diskHits = 0;			// Loaded from the cache directory without parsing
+		std::uint64_t compiles = 0;			// Parsed from source
+	};
+
+	/**
+	 * @brief Compiles, caches and runs scripts against a set of host functions
+	 *
+	 * @note Register host functions before running anything that calls them. Calls are bound by name when
+	 *		 a program runs, so cached bytecode stays valid whatever the host registers.
+	 *		 Built in: print(...), assert(condition, message?), len(string), str(value), num(string), clock().
+	 */
+	class scriptEngine {
+	private:
+		struct hashKey {
+			std::size_t operator()(const Hash::hash128& h) const noexcept { return static_cast<std::size_t>(h.low); }
+		};
+
+		engineOptions _options;
+		std::unordered_map<std::string, nativeFunction> _natives;
+
+		mutable std::mutex _cacheMutex;
+		std::unordered_map<Hash::hash128, std::shared_ptr<const program>, hashKey> _programs;
+		cacheStats _stats;
+
+		std::shared_ptr<const program> loadCached(const Hash::hash128& key);
+		void storeCached(const program& compiled);
+
+	public:
+		explicit scriptEngine(engineOptions options = {});
+		~scriptEngine();
+
+		scriptEngine(const scriptEngine&) = delete;
+		scriptEngine& operator=(const scriptEngine&) = delete;
+
+		/**
+		 * @brief Makes fn callable from scripts as name, replacing any function already registered under it
+		 */
+		void registerFunction(std::string name, nativeFunction fn);
+
+		/**
+		 * @brief Compiles source, or returns the cached program for identical source
+		 *
+		 * @throws std::runtime_error with the offending line on a syntax error.
+		 */
+		std::shared_ptr<const program> compile(std::string_view source);
+		std::shared_ptr<const program> compileFile(const std::filesystem::path& path);
+
+		/**
+		 * @brief Runs a compiled program's top level code
+		 *
+		 * @return The value of a top level return statement, nil otherwise.
+		 * @throws std::runtime_error with the offending line on a runtime error or failed assert().
+		 */
+		value run(const program& compiled) const;
+
+		value runSource(std::string_view source) { return run(*compile(source)); }
+		value runFile(const std::filesystem::path& path) { return run(*compileFile(path)); }
+
+		cacheStats stats() const;
+	};
+}
\ No newline at end of file
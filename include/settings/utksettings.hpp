@@ -0,0 +1,214 @@
+//===================================================================================================================================
+// @file	utksettings.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the hot-reloadable settings store provided by UTK::Settings.
+//
+// @note    Settings are loaded from a JSON file into an immutable snapshot, nested objects flattened into
+//          dotted keys("logger.terminal.capacity"). A reload builds a whole new snapshot off to the side and
+//          publishes it by bumping a version number, readers compare that one atomic load against the
+//          snapshot their thread already holds and only touch shared state when it has changed. Old
+//          snapshots are reclaimed once the last thread still holding one moves on to a newer version.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include <unordered_map>
+#include <string_view>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+#include <variant>
+#include <memory>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace UTK::Dispatch {
+	class logDispatcher;
+}
+
+namespace UTK::Settings {
+
+	namespace Internal {
+		class fileWatcher;
+
+		/**
+		 * @brief Transparent hash so lookups by string_view never build a temporary string
+		 */
+		struct keyHash {
+			using is_transparent = void;
+
+			std::size_t operator()(std::string_view key) const noexcept {
+				return std::hash<std::string_view>{}(key);
+			}
+		};
+	}
+
+	/**
+	 * @brief A single setting, integers and fractional numbers are kept apart as written
+	 */
+	using scalar = std::variant<std::monostate, bool, std::int64_t, double, std::string>;
+
+	/**
+	 * @brief A setting or a list of them, lists may only hold scalars
+	 */
+	using value = std::variant<std::monostate, bool, std::int64_t, double, std::string, std::vector<scalar>>;
+
+	/**
+	 * @brief One immutable version of the settings, safe to read from any number of threads
+	 *
+	 * @note Getters return nullopt(or nullptr) for a missing key and throw std::runtime_error when the key
+	 *		 holds another type. getDouble also accepts integers.
+	 */
+	class snapshot {
+	private:
+		friend class settingsStore;
+
+		using Values = std::unordered_map<std::string, value, Internal::keyHash, std::equal_to<>>;
+
+		Values _values;
+		std::uint64_t _version = 0;
+
+	public:
+		/**
+		 * @brief Builds a snapshot from JSON text, the top level must be an object
+		 *
+		 * @throws std::runtime_error on malformed JSON, keys containing '.' or escapes, or lists of objects.
+		 */
+		static std::shared_ptr<const snapshot> parse(std::string_view json);
+
+		/**
+		 * @brief Unique across every store in the process, a newer snapshot always has a higher version
+		 */
+		std::uint64_t version() const { return _version; }
+		std::size_t size() const { return _values.size(); }
+		bool contains(std::string_view key) const { return _values.find(key) != _values.end(); }
+
+		const value* find(std::string_view key) const;
+
+		std::optional<bool> getBool(std::string_view key) const;
+		std::optional<std::int64_t> getInt(std::string_view key) const;
+		std::optional<double> getDouble(std::string_view key) const;
+
+		/**
+		 * @brief View into the snapshot, valid for as long as the snapshot is
+		 */
+		std::optional<std::string_view> getString(std::string_view key) const;
+		const std::vector<scalar>* getList(std::string_view key) const;
+	};
+
+	/**
+	 * @brief Owns the current snapshot of a settings file and, optionally, reloads it when the file changes
+	 *
+	 * @note Files are watched with inotify on Linux(the directory is watched so editors that save by
+	 *		 renaming a temporary file are caught) and by polling the modification time elsewhere. A
+	 *		 reload that fails keeps the previous snapshot and records the error.
+	 */
+	class settingsStore {
+	private:
+		using Callback = std::function<void(const snapshot&)>;
+
+		std::filesystem::path _path;
+
+		mutable std::mutex _mutex;					// Guards _snapshot and _lastError
+		std::shared_ptr<const snapshot> _snapshot;
+		std::atomic<std::uint64_t> _version;
+		std::string _lastError;
+
+		std::mutex _reloadMutex;					// Serializes reloads and the callbacks they run
+		std::vector<std::pair<std::uint64_t, Callback>> _subscribers;
+		std::uint64_t _nextSubscriber = 1;
+
+		std::unique_ptr<Internal::fileWatcher> _watcher;
+
+		const snapshot& refresh(std::uint64_t version) const;
+
+	public:
+		/**
+		 * @brief Loads the file straight away, throwing if it cannot be read or parsed
+		 *
+		 * @param watch: Starts a background thread that reloads the file whenever it changes.
+		 */
+		explicit settingsStore(std::filesystem::path path, bool watch = true);
+		~settingsStore();
+
+		settingsStore(const settingsStore&) = delete;
+		settingsStore& operator=(const settingsStore&) = delete;
+
+		/**
+		 * @brief The latest snapshot, lock-free and without touching any shared reference count
+		 *
+		 * @note The reference stays valid until the calling thread's next call to current() on any store,
+		 *		 use pin() to hold a snapshot for longer.
+		 */
+		const snapshot& current() const;
+
+		/**
+		 * @brief Shares ownership of the latest snapshot, keeping it alive across reloads
+		 */
+		std::shared_ptr<const snapshot> pin() const;
+
+		/**
+		 * @brief Rereads the file now, on the calling thread
+		 *
+		 * @return False if the file could not be read or parsed, the previous snapshot stays current.
+		 */
+		bool reload();
+
+		/**
+		 * @brief Message of the last failed reload or callback, empty once a reload succeeds
+		 */
+		std::string lastError() const;
+
+		const std::filesystem::path& path() const { return _path; }
+
+		/**
+		 * @brief Calls fn with the current snapshot straight away, then with each newly published one on
+		 *		  the thread that did the reload
+		 *
+		 * @note Callbacks run one reload at a time and in order, so none is missed or applied out of order.
+		 *		 If the first call throws the exception propagates and fn is not subscribed. Must not be
+		 *		 called from inside a callback.
+		 * @return An id to pass to unsubscribe.
+		 */
+		std::uint64_t subscribe(Callback fn);
+
+		/**
+		 * @brief Removes a callback, once this returns it is not running and will not run again
+		 */
+		void unsubscribe(std::uint64_t id);
+	};
+
+	//===================================================================================================================================
+	//												              LOGGER BINDING
+	//===================================================================================================================================
+
+	/**
+	 * @brief Applies the logger section of a snapshot to a dispatcher
+	 *
+	 * @note For each sink("terminal", "json", "csv", "archive") under prefix:
+	 *			operations:   List of Operations names("LG_ERR", ...) the sink accepts, every operation when missing.
+	 *			capacity:     Sink queue capacity.
+	 *			backpressure: "drop" or "block".
+	 *		 Capacity and backpressure are only changed when at least one of them is present, the other
+	 *		 then falls back to logDispatcher's defaults(4096, drop).
+	 * @throws std::runtime_error on an unknown operation name or policy, nothing is applied in that case.
+	 */
+	void applyLoggerSettings(const snapshot& settings, UTK::Dispatch::logDispatcher& dispatcher, std::string_view prefix = "logger");
+
+	/**
+	 * @brief Applies the current snapshot to a dispatcher now and again after every reload
+	 *
+	 * @note The dispatcher must outlive the binding, remove it with settingsStore::unsubscribe. A reload
+	 *		 with bad logger settings leaves the previous ones applied and is reported by lastError.
+	 * @throws std::runtime_error if the current logger settings are invalid.
+	 * @return The subscription id.
+	 */
+	std::uint64_t bindLogger(settingsStore& store, UTK::Dispatch::logDispatcher& dispatcher, std::string prefix = "logger");
+}
\ No newline at end of file
@@ -0,0 +1,195 @@
+//===================================================================================================================================
+// @file	utktrace.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing UTK's scoped span tracer for timing hot paths.
+//
+// @note    UTK_TRACE_SCOPE("name") reads the CPU's tick counter when the scope opens and again when it
+//          closes, then appends the pair to a buffer owned by the calling thread. Nothing is formatted and
+//          no lock is taken while recording; a thread only locks when one of its buffer chunks fills. The
+//          tracer drains every thread's buffers, either to a Chrome trace-event JSON file that opens in
+//          Perfetto or chrome://tracing, or into a logDispatcher as ordinary log entries.
+//
+//          Define UTK_TRACE_DISABLED(CMake: -DUTK_TRACE_DISABLED=ON) and every UTK_TRACE_SCOPE compiles to
+//          nothing. The tracer itself is still there, it just never has any spans to give.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include "types/utkstates.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#if defined(UTK_TRACE_DISABLED)
+#define UTK_TRACE_ENABLED 0
+#else
+#define UTK_TRACE_ENABLED 1
+#endif
+
+namespace UTK::Dispatch {
+	class logDispatcher;
+}
+
+namespace UTK::Trace {
+
+	namespace Internal {
+		class traceRegistry;
+	}
+
+	/**
+	 * @brief Reads the cheapest monotonic counter the CPU offers, the TSC on x86 and the virtual counter on ARM64
+	 *
+	 * @note Only meaningful as a difference or through tracer::toNanoseconds.
+	 */
+	inline std::uint64_t ticks() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#elif defined(__aarch64__)
+		std::uint64_t value;
+		asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+		return value;
+#else
+		return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+	}
+
+	/**
+	 * @brief A finished span, times are in ticks
+	 */
+	struct traceSpan {
+		const char* name;
+		std::uint64_t begin;
+		std::uint64_t end;
+		std::uint32_t thread;		// Index into tracer::threads()
+	};
+
+	/**
+	 * @brief A thread that has recorded spans
+	 */
+	struct traceThread {
+		std::uint32_t index;
+		std::int64_t osId;			// Kernel thread id where the platform has one, otherwise index
+		std::string name;			// Empty unless set with tracer::nameThread
+	};
+
+	/**
+	 * @brief Owns the span buffers of every thread in the process
+	 */
+	class tracer {
+	private:
+		Internal::traceRegistry& _registry;
+
+		tracer();
+
+	public:
+		~tracer();
+
+		tracer(const tracer&) = delete;
+		tracer& operator=(const tracer&) = delete;
+
+		/**
+		 * @brief The tracer UTK_TRACE_SCOPE records into
+		 */
+		static tracer& global();
+
+		/**
+		 * @brief Names the calling thread in exported traces
+		 */
+		void nameThread(std::string name);
+
+		/**
+		 * @brief Caps the spans held between drains, the oldest are dropped past it
+		 *
+		 * @note Applied a whole buffer chunk at a time, so a few thousand spans either side of the limit.
+		 */
+		void setSpanLimit(std::size_t spans);
+
+		/**
+		 * @brief Number of spans dropped because the limit was reached before they were drained
+		 */
+		std::uint64_t dropped() const;
+
+		/**
+		 * @brief Moves every span recorded since the last drain into out
+		 *
+		 * @return The number of spans appended to out.
+		 */
+		std::size_t drain(std::vector<traceSpan>& out);
+
+		/**
+		 * @brief Every thread that has recorded spans, including threads that have since exited
+		 */
+		std::vector<traceThread> threads() const;
+
+		/**
+		 * @brief Converts a tick count to nanoseconds since the tracer started
+		 *
+		 * @note The tick rate is measured against the steady clock, so it settles as the process runs.
+		 */
+		std::int64_t toNanoseconds(std::uint64_t tick) const;
+
+		/**
+		 * @brief Drains every span and writes them to path as Chrome trace-event JSON
+		 *
+		 * @note Throws std::runtime_error if path cannot be written.
+		 * @return The number of spans written.
+		 */
+		std::size_t exportChromeTrace(const std::string& path);
+
+		/**
+		 * @brief Drains every span into dispatcher as log entries, keyed span, thread, start_ns and duration_ns
+		 *
+		 * @return The number of entries pushed.
+		 */
+		std::size_t dispatchTo(
+			UTK::Dispatch::logDispatcher& dispatcher,
+			UTK::Types::States::Logger lg,
+			UTK::Types::States::Operations op = UTK::Types::States::Operations::LG_MSG);
+	};
+
+	/**
+	 * @brief Appends a span to the calling thread's buffer
+	 *
+	 * @param name: Must outlive the tracer, a string literal in practice. Only the pointer is kept.
+	 */
+	void recordSpan(const char* name, std::uint64_t begin, std::uint64_t end) noexcept;
+
+	/**
+	 * @brief Records a span covering its own lifetime, see UTK_TRACE_SCOPE
+	 */
+	class scopedSpan {
+	private:
+		const char* _name;
+		std::uint64_t _begin;
+
+	public:
+		explicit scopedSpan(const char* name) noexcept : _name(name), _begin(ticks()) {}
+		~scopedSpan() { recordSpan(_name, _begin, ticks()); }
+
+		scopedSpan(const scopedSpan&) = delete;
+		scopedSpan& operator=(const scopedSpan&) = delete;
+	};
+}
+
+#define UTK_TRACE_CONCAT_INNER(a, b) a##b
+#define UTK_TRACE_CONCAT(a, b) UTK_TRACE_CONCAT_INNER(a, b)
+
+#if UTK_TRACE_ENABLED
+/// Times the rest of the enclosing scope as a span called name, which must be a string literal
+#define UTK_TRACE_SCOPE(name) ::UTK::Trace::scopedSpan UTK_TRACE_CONCAT(_utkTraceSpan, __COUNTER__){ name }
+#else
+#define UTK_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
\ No newline at end of file
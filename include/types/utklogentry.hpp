@@ -13,6 +13,7 @@
 #include "types/utkstates.hpp"
 #include "schema/Schema.hpp"
 #include <optional>
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -20,6 +21,10 @@ using FormatStrings = std::vector<std::string>;
 
 namespace UTK::Types::LogEntry {
 
+	/// Id of a key interned in UTK::Dispatch::keyTable
+	using KeyId = std::uint32_t;
+	using KeyIds = std::vector<KeyId>;
+
 	/**
 	 * @brief Data container holding message data for UTK loggers.
 	 */
@@ -33,6 +38,7 @@ namespace UTK::Types::LogEntry {
 		std::optional<std::string> fileName = std::nullopt;
 		std::optional<int> fileLine = std::nullopt;
 		std::optional<std::string> funcName = std::nullopt;
+		KeyIds keyIds = {};		// Interned keys, used in place of formatKeys when not empty
 	};
 
 	inline namespace LogHelpers {
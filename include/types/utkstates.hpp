@@ -17,7 +17,8 @@ namespace UTK::Types::States {
 	enum class Logger {
 		TERMINAL,
 		JSON,
-		CSV
+		CSV,
+		ARCHIVE
 	};
 
 	/**
@@ -33,4 +34,12 @@ namespace UTK::Types::States {
 		LG_MSG,
 		LG_NOP
 	};
+
+	/**
+	 *	@brief Enumeration of the actions a sink queue takes once it reaches capacity.
+	 */
+	enum class Backpressure {
+		DROP,
+		BLOCK
+	};
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+//===================================================================================================================================
+// @file	utkuuid.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Header file containing the UUID type and the version 4/7 generators provided by UTK::UUID.
+//
+// @note    Generation never takes a lock. Each thread owns its random state and v7 sequence, the only
+//          shared state is the newest millisecond timestamp handed out, which keeps v7 values from going
+//          backwards if the system clock is stepped. Random bits come from a fast non-cryptographic
+//          generator, so the values are unique but should not be relied on to be unguessable.
+//===================================================================================================================================
+
+#pragma once
+
+#include "core/utkexports.hpp"
+#include <string_view>
+#include <functional>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+#include <compare>
+#include <string>
+#include <array>
+#include <span>
+
+namespace UTK::UUID {
+
+	/**
+	 * @brief 128-bit UUID stored in network(big endian) byte order, as in RFC 9562
+	 */
+	struct uuid {
+		std::array<std::uint8_t, 16> bytes{};
+
+		/**
+		 * @brief Version nibble(4 for random, 7 for time-ordered, 0 for the nil UUID)
+		 */
+		constexpr unsigned version() const { return bytes[6] >> 4; }
+
+		/**
+		 * @brief Unix timestamp in milliseconds carried by a v7 UUID
+		 */
+		constexpr std::uint64_t timestamp() const {
+			std::uint64_t ms = 0;
+			for (std::size_t i = 0; i < 6; i++) ms = (ms << 8) | bytes[i];
+			return ms;
+		}
+
+		constexpr bool isNil() const { return *this == uuid{}; }
+
+		constexpr auto operator<=>(const uuid&) const = default;
+		constexpr bool operator==(const uuid&) const = default;
+	};
+
+	/// Length of the canonical text form, "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx"
+	inline constexpr std::size_t textLength = 36;
+
+	/**
+	 * @brief Generates a random(version 4) UUID
+	 */
+	uuid generateV4();
+
+	/**
+	 * @brief Generates a time-ordered(version 7) UUID
+	 *
+	 * @note Values from one thread are strictly increasing. Values from different threads are ordered by
+	 *		 millisecond and unique, but not interleaved in call order within the same millisecond.
+	 */
+	uuid generateV7();
+
+	/**
+	 * @brief Fills every element with a new version 4 UUID
+	 */
+	void generateV4(std::span<uuid> out);
+
+	/**
+	 * @brief Fills every element with a new version 7 UUID, reading the clock once for the whole batch
+	 */
+	void generateV7(std::span<uuid> out);
+
+	/**
+	 * @brief Writes the lower case canonical form of id into exactly textLength chars, no terminator
+	 */
+	void format(const uuid& id, char* out);
+
+	/**
+	 * @brief Formats a batch back to back, out must hold ids.size() * textLength chars
+	 */
+	void format(std::span<const uuid> ids, char* out);
+
+	std::string toString(const uuid& id);
+
+	/**
+	 * @brief Parses the canonical 36 char form, either letter case
+	 *
+	 * @return std::nullopt if the text is not a canonical UUID.
+	 */
+	std::optional<uuid> parse(std::string_view text);
+}
+
+template<>
+struct std::hash<UTK::UUID::uuid> {
+	std::size_t operator()(const UTK::UUID::uuid& id) const noexcept {
+		// The random bits are already uniform, folding the two halves is enough
+		std::uint64_t high = 0, low = 0;
+		for (std::size_t i = 0; i < 8; i++) {
+			high = (high << 8) | id.bytes[i];
+			low = (low << 8) | id.bytes[i + 8];
+		}
+		return static_cast<std::size_t>(high ^ (low * 0x9E3779B97F4A7C15ULL));
+	}
+};
\ No newline at end of file
@@ -0,0 +1,126 @@
+# ==================================================================================================
+# @file        utk_dashboard.py
+# @brief       Terminal dashboard showing live log activity served by utktaild.
+# @author      Jac Jenkins
+# @date        18/10/2026
+#
+# @description
+#   Asks a running utktaild for a snapshot over its Unix domain socket and renders the operation
+#   counts of the last minute, the totals and the latest errors. utktaild only reads what sinks
+#   have appended since its last look, so refreshing costs the new data rather than the whole log.
+#
+#   Usage: python3 scripts/utk_dashboard.py [--socket PATH] [--interval SECONDS] [--once]
+# ==================================================================================================
+
+from typing import Any, Dict, List
+from datetime import datetime
+import argparse
+import socket
+import json
+import time
+
+SPARK_CHARS = " ▁▂▃▄▅▆▇█"
+
+def fetch_snapshot(socket_path: str) -> Dict[str, Any]:
+    """
+    Read one snapshot from utktaild.
+
+    Args:
+        socket_path (str): Path of the socket utktaild is serving on.
+
+    Returns:
+        Dict[str, Any]: The decoded snapshot.
+    """
+
+    with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as client:
+        client.settimeout(5)
+        client.connect(socket_path)
+
+        chunks = []
+        while chunk := client.recv(65536):
+            chunks.append(chunk)
+
+    return json.loads(b"".join(chunks))
+
+def sparkline(values: List[int]) -> str:
+    """
+    Render counts as a row of block characters scaled to the largest count.
+    """
+
+    peak = max(values, default=0)
+    if peak == 0:
+        return SPARK_CHARS[0] * len(values)
+    return "".join(SPARK_CHARS[round(v / peak * (len(SPARK_CHARS) - 1))] for v in values)
+
+def render(snapshot: Dict[str, Any], seconds: int = 60) -> str:
+    """
+    Format a snapshot as plain text.
+
+    Args:
+        snapshot (Dict[str, Any]): Snapshot returned by fetch_snapshot.
+        seconds (int): Number of most recent seconds to chart.
+
+    Returns:
+        str: The dashboard text.
+    """
+
+    aggregates = snapshot["aggregates"]
+    operations = aggregates["operations"]
+    now = snapshot["time"] // 1_000_000_000
+
+    # Seconds without entries are left out of the snapshot, so fill them back in with zeros
+    per_second = {s["second"]: s["counts"] for s in aggregates["seconds"]}
+    recent = [per_second.get(second, [0] * len(operations)) for second in range(now - seconds + 1, now + 1)]
+
+    lines = [f"UTK log activity  {datetime.fromtimestamp(now):%d/%m/%Y %H:%M:%S}", ""]
+
+    lines.append(f"{'Operation':<10} {'Total':>10} {'Last ' + str(seconds) + 's':>10}  Per second")
+    for index, name in enumerate(operations):
+        column = [counts[index] for counts in recent]
+        total = aggregates["totals"][index]
+        if total == 0 and sum(column) == 0:
+            continue
+        lines.append(f"{name:<10} {total:>10} {sum(column):>10}  {sparkline(column)}")
+
+    lines += ["", "Files"]
+    for file in snapshot["files"]:
+        state = "" if file["open"] else "  (waiting)"
+        unparsed = f", {file['unparsed']} unparsed" if file["unparsed"] else ""
+        lines.append(f"  {file['format']:<8} {file['path']}  {file['entries']} entries{unparsed}{state}")
+
+    lines += ["", "Latest errors"]
+    if not aggregates["errors"]:
+        lines.append("  none")
+    for error in sorted(aggregates["errors"], key=lambda e: e["time"], reverse=True):
+        stamp = datetime.fromtimestamp(error["time"] / 1_000_000_000)
+        pairs = " ".join(f"{k}={v}" for k, v in zip(error["keys"], error["values"]))
+        lines.append(f"  {stamp:%H:%M:%S} {error['file']}:{error['line']}:{error['function']}  {pairs}")
+
+    return "\n".join(lines)
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description="Live view of the logs followed by utktaild.")
+    parser.add_argument("--socket", default="/tmp/utktaild.sock", help="socket utktaild is serving on")
+    parser.add_argument("--interval", type=float, default=1.0, help="seconds between refreshes")
+    parser.add_argument("--once", action="store_true", help="print one snapshot and exit")
+    args = parser.parse_args()
+
+    try:
+        while True:
+            try:
+                text = render(fetch_snapshot(args.socket))
+            except OSError as error:
+                text = f"Unable to reach utktaild on {args.socket}: {error}"
+
+            if args.once:
+                print(text)
+                return
+
+            # Clear the screen and home the cursor before redrawing
+            print("\x1b[2J\x1b[H" + text, flush=True)
+            time.sleep(args.interval)
+    except KeyboardInterrupt:
+        pass
+
+if __name__ == "__main__":
+    main()
\ No newline at end of file
@@ -0,0 +1,50 @@
+//===================================================================================================================================
+// @file	utkcaching.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+// 
+// @brief   Source file containing the non-template helpers shared by the UTK::Caching caches.
+//===================================================================================================================================
+
+#include "caching/utkcaching.hpp"
+#include <thread>
+
+using namespace std;
+using namespace UTK::Caching;
+
+//===================================================================================================================================
+//													 CACHE STATS IMPLEMENTATIONS
+//===================================================================================================================================
+
+cacheStats& cacheStats::operator+=(const cacheStats& other) {
+
+	hits += other.hits;
+	misses += other.misses;
+	insertions += other.insertions;
+	evictions += other.evictions;
+	expirations += other.expirations;
+	rejections += other.rejections;
+
+	return *this;
+}
+
+double cacheStats::hitRate() const {
+
+	const uint64_t lookups = hits + misses;
+	return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+}
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+size_t UTK::Caching::defaultShardCount() {
+
+	// Four shards per hardware thread keeps the odds of two threads sharing a lock low
+	const size_t threads = max<size_t>(thread::hardware_concurrency(), 1);
+	
+	size_t shards = 1;
+	while (shards < threads * 4) shards <<= 1;
+
+	return shards;
+}
\ No newline at end of file
@@ -0,0 +1,259 @@
+//===================================================================================================================================
+// @file	utkttlcache.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the timing wheel, frequency sketch and policy evaluation used by
+//			the UTK::Caching time-bounded cache.
+//===================================================================================================================================
+
+#include "caching/utkttlcache.hpp"
+#include <algorithm>
+#include <limits>
+#include <bit>
+
+using namespace std;
+using namespace UTK::Caching;
+
+//===================================================================================================================================
+//												   TIMING WHEEL METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+timingWheel::timingWheel(uint64_t startTick) : _current(startTick) {
+
+	for (auto& level : _slots) {
+		for (auto& sentinel : level) {
+			sentinel.timerPrev = sentinel.timerNext = &sentinel;
+		}
+	}
+	_due.timerPrev = _due.timerNext = &_due;
+}
+
+void timingWheel::linkBefore(timerNode& sentinel, timerNode* n) {
+
+	n->timerNext = &sentinel;
+	n->timerPrev = sentinel.timerPrev;
+	sentinel.timerPrev->timerNext = n;
+	sentinel.timerPrev = n;
+}
+
+void timingWheel::unlink(timerNode* n) {
+
+	n->timerPrev->timerNext = n->timerNext;
+	n->timerNext->timerPrev = n->timerPrev;
+	n->timerPrev = n->timerNext = nullptr;
+}
+
+void timingWheel::place(timerNode* n) {
+
+	if (n->expiry <= _current) {
+		linkBefore(_due, n);
+		return;
+	}
+
+	// The lowest level whose higher bits match the current tick will reach the timer's slot before wrapping
+	size_t level = 0;
+	while (level + 1 < levels && (n->expiry >> (levelBits * (level + 1))) != (_current >> (levelBits * (level + 1)))) {
+		level++;
+	}
+
+	const size_t slot = static_cast<size_t>(n->expiry >> (levelBits * level)) & (levelSlots - 1);
+	linkBefore(_slots[level][slot], n);
+	_occupied[level] |= uint64_t{ 1 } << slot;
+	_pending++;
+}
+
+void timingWheel::cascade(size_t level, size_t slot) {
+
+	timerNode& sentinel = _slots[level][slot];
+
+	// Detach the whole slot first, timers beyond the wheel's range can land back in the same slot
+	timerNode* n = sentinel.timerNext;
+	sentinel.timerPrev->timerNext = nullptr;
+	sentinel.timerPrev = sentinel.timerNext = &sentinel;
+	_occupied[level] &= ~(uint64_t{ 1 } << slot);
+
+	while (n && n != &sentinel) {
+		timerNode* next = n->timerNext;
+		_pending--;
+		place(n);
+		n = next;
+	}
+}
+
+uint64_t timingWheel::nextEvent() {
+
+	uint64_t next = numeric_limits<uint64_t>::max();
+
+	for (size_t level = 0; level < levels; level++) {
+		const unsigned shift = static_cast<unsigned>(levelBits * level);
+		const size_t index = static_cast<size_t>(_current >> shift) & (levelSlots - 1);
+		const uint64_t revolution = (_current >> (shift + levelBits)) << (shift + levelBits);
+
+		// Slots after the current one come round in this revolution of the level. Below the top level
+		// every other slot is empty, the top level also holds timers past the wheel's range for the next.
+		uint64_t& bits = _occupied[level];
+		while (bits) {
+			const uint64_t ahead = (index + 1 < levelSlots) ? bits & (~uint64_t{ 0 } << (index + 1)) : 0;
+			if (!ahead && level + 1 < levels) break;
+
+			const size_t slot = static_cast<size_t>(countr_zero(ahead ? ahead : bits));
+			timerNode& sentinel = _slots[level][slot];
+			if (sentinel.timerNext == &sentinel) {
+				bits &= ~(uint64_t{ 1 } << slot);	// Emptied by cancel() since it was set
+				continue;
+			}
+
+			const uint64_t base = ahead ? revolution : revolution + (uint64_t{ 1 } << (shift + levelBits));
+			next = min(next, base | (static_cast<uint64_t>(slot) << shift));
+			break;
+		}
+	}
+	return next;
+}
+
+void timingWheel::step(uint64_t tick) {
+
+	// Nothing can fire before the next occupied slot or cascade, jump straight there(or to the target)
+	const uint64_t next = (_pending == 0) ? numeric_limits<uint64_t>::max() : nextEvent();
+	if (next > tick) {
+		_current = tick;
+		return;
+	}
+
+	_current = next;
+
+	// Cascade from the highest level that wrapped so timers filter down through every level in one tick
+	for (size_t level = levels - 1; level > 0; level--) {
+		const uint64_t lowerMask = (uint64_t{ 1 } << (levelBits * level)) - 1;
+		if ((_current & lowerMask) == 0) {
+			cascade(level, static_cast<size_t>(_current >> (levelBits * level)) & (levelSlots - 1));
+		}
+	}
+
+	const size_t slot = static_cast<size_t>(_current) & (levelSlots - 1);
+	timerNode& sentinel = _slots[0][slot];
+	while (sentinel.timerNext != &sentinel) {
+		timerNode* n = sentinel.timerNext;
+		unlink(n);
+		_pending--;
+		linkBefore(_due, n);
+	}
+	_occupied[0] &= ~(uint64_t{ 1 } << slot);
+}
+
+void timingWheel::schedule(timerNode* n, uint64_t expiryTick) {
+
+	cancel(n);
+	n->expiry = expiryTick;
+	place(n);
+}
+
+void timingWheel::cancel(timerNode* n) {
+
+	if (!n->timerNext) return;
+
+	// Slots only ever hold timers ahead of the current tick, anything at or behind it sits on the due list
+	if (n->expiry > _current) _pending--;
+
+	unlink(n);
+}
+
+timerNode* timingWheel::popExpired(uint64_t tick) {
+
+	while (_due.timerNext == &_due && _current < tick) {
+		step(tick);
+	}
+
+	if (_due.timerNext == &_due) return nullptr;
+
+	timerNode* n = _due.timerNext;
+	unlink(n);
+	return n;
+}
+
+//===================================================================================================================================
+//												FREQUENCY SKETCH METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+frequencySketch::frequencySketch(size_t capacity) {
+
+	size_t width = 16;
+	while (width < capacity) width <<= 1;
+
+	_counters.assign(width * depth, 0);
+	_mask = width - 1;
+	_sampleSize = static_cast<uint64_t>(width) * 10;
+}
+
+size_t frequencySketch::indexOf(uint64_t hash, size_t row) const {
+
+	// Independent row hashes from one input by re-mixing with a per row seed
+	static constexpr array<uint64_t, depth> seeds{
+		0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL
+	};
+
+	const uint64_t mixed = mixHash(hash + seeds[row]);
+	return row * (_mask + 1) + static_cast<size_t>(mixed & _mask);
+}
+
+void frequencySketch::increment(uint64_t hash) {
+
+	bool added = false;
+	for (size_t row = 0; row < depth; row++) {
+		uint8_t& counter = _counters[indexOf(hash, row)];
+		if (counter < 15) {
+			counter++;
+			added = true;
+		}
+	}
+
+	if (added && ++_additions >= _sampleSize) age();
+}
+
+unsigned frequencySketch::frequency(uint64_t hash) const {
+
+	unsigned result = 15;
+	for (size_t row = 0; row < depth; row++) {
+		result = min<unsigned>(result, _counters[indexOf(hash, row)]);
+	}
+	return result;
+}
+
+void frequencySketch::age() {
+
+	// Halving keeps the sketch tracking recent popularity rather than all-time counts
+	for (auto& counter : _counters) {
+		counter = static_cast<uint8_t>(counter >> 1);
+	}
+	_additions /= 2;
+}
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+vector<policyResult> UTK::Caching::evaluatePolicies(span<const uint64_t> trace, size_t capacity) {
+
+	struct traceHash {
+		size_t operator()(uint64_t key) const noexcept { return static_cast<size_t>(mixHash(key)); }
+	};
+
+	vector<policyResult> results;
+
+	for (cachePolicy policy : { cachePolicy::LRU, cachePolicy::WINDOW_TINY_LFU }) {
+		ttlOptions options;
+		options.maxEntries = capacity;
+		options.policy = policy;
+
+		ttlCache<uint64_t, char, traceHash> cache(options);
+
+		for (uint64_t key : trace) {
+			if (!cache.get(key)) cache.put(key, 0);
+		}
+
+		results.push_back({ policy, cache.stats() });
+	}
+
+	return results;
+}
\ No newline at end of file
@@ -0,0 +1,767 @@
+//===================================================================================================================================
+// @file	utkclient.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the event loop, connection pools and public entry points of UTK::Client.
+//
+// @note    All socket work happens on the loop thread, callers only build the request bytes and hand them
+//          over through a mutex guarded queue and an eventfd. Each connection reads into a 64KB slab that
+//          completed responses share ownership of, once a response still references the slab the next
+//          read starts a fresh one rather than moving bytes out from under it.
+//===================================================================================================================================
+
+#include "client/utkclient.hpp"
+#include "utkhttpparser.hpp"
+#include <unordered_map>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <deque>
+#include <mutex>
+
+#if defined(__linux__)
+#include <netinet/tcp.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <cerrno>
+#endif
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Client;
+using namespace UTK::Client::Internal;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	bool equalsIgnoreCase(string_view a, string_view b) {
+		return a.size() == b.size() && equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+			return (x | 0x20) == (y | 0x20);
+		});
+	}
+
+	bool hasLineBreak(string_view text) {
+		return text.find_first_of("\r\n") != string_view::npos;
+	}
+
+	struct pendingRequest {
+		string wire;							// Serialized request, kept until answered so it can be resent
+		bool pipelinable = false;				// GET and HEAD, safe to pipeline and to resend
+		bool head = false;
+		int attempts = 0;
+		steady_clock::time_point deadline;
+		promise<response> result;
+	};
+
+	using RequestPtr = unique_ptr<pendingRequest>;
+
+	/// Builds the request bytes on the caller's thread so the loop only ever copies them to a socket
+	void serialize(const request& req, const url& target, pendingRequest& out) {
+
+		if (req.method.empty() || req.method.find_first_of(" \r\n") != string::npos) throw runtime_error("Invalid HTTP method: " + req.method);
+
+		bool hasHost = false, hasLength = false;
+		for (const auto& [name, value] : req.headers) {
+			if (name.empty() || name.find_first_of(" :\r\n") != string::npos || hasLineBreak(value)) {
+				throw runtime_error("Invalid HTTP header: " + name);
+			}
+			hasHost |= equalsIgnoreCase(name, "host");
+			hasLength |= equalsIgnoreCase(name, "content-length");
+		}
+
+		string& wire = out.wire;
+		wire.reserve(req.method.size() + target.target.size() + target.authority.size() + req.body.size() + 64);
+		wire.append(req.method).append(" ").append(target.target).append(" HTTP/1.1\r\n");
+
+		if (!hasHost) wire.append("Host: ").append(target.authority).append("\r\n");
+		for (const auto& [name, value] : req.headers) {
+			wire.append(name).append(": ").append(value).append("\r\n");
+		}
+
+		const bool bodyExpected = !req.body.empty() || req.method == "POST" || req.method == "PUT" || req.method == "PATCH";
+		if (bodyExpected && !hasLength) wire.append("Content-Length: ").append(to_string(req.body.size())).append("\r\n");
+
+		wire.append("\r\n").append(req.body);
+
+		out.head = req.method == "HEAD";
+		out.pipelinable = out.head || req.method == "GET";
+	}
+}
+
+//===================================================================================================================================
+//											            RESPONSE METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+optional<string_view> response::header(string_view name) const {
+
+	for (const auto& [field, value] : _headers) {
+		if (equalsIgnoreCase(field, name)) return value;
+	}
+	return nullopt;
+}
+
+//===================================================================================================================================
+//													    EVENT LOOP DEFINITION
+//===================================================================================================================================
+
+#if defined(__linux__)
+
+namespace {
+
+	constexpr size_t slabSize = 64 * 1024;
+	constexpr milliseconds sweepInterval{ 100 };
+
+	/// Attempts allowed for a request whose connection dropped before it was answered
+	constexpr int maxAttempts = 2;
+
+	struct hostPool;
+
+	struct connection {
+		int fd = -1;
+		hostPool* pool = nullptr;
+		bool connected = false;
+		uint32_t interest = 0;					// epoll events currently registered
+
+		deque<RequestPtr> inFlight;				// Written or waiting to be written, answered in this order
+		string out;
+		size_t outPos = 0;
+
+		shared_ptr<char[]> slab;
+		size_t capacity = 0;
+		size_t begin = 0;						// First byte of the response being parsed
+		size_t end = 0;							// End of the bytes read so far
+
+		responseParser parser;
+		steady_clock::time_point idleSince;
+
+		explicit connection(size_t maxBytes) : parser(maxBytes) {}
+	};
+
+	struct hostPool {
+		string host;
+		uint16_t port = 0;
+		sockaddr_storage address{};
+		socklen_t addressLength = 0;			// Resolved on the first connect and reused after
+		bool noPipelining = false;				// Learnt once the server closes a connection with requests queued on it
+
+		deque<RequestPtr> waiting;
+		vector<unique_ptr<connection>> connections;
+	};
+
+	struct submission {
+		string poolKey;
+		url target;
+		RequestPtr request;
+	};
+}
+
+class UTK::Client::Internal::eventLoop {
+private:
+	const clientOptions _options;
+	int _epoll = -1;
+	int _wake = -1;
+
+	mutex _mutex;
+	vector<submission> _incoming;
+	bool _stopping = false;
+
+	unordered_map<string, unique_ptr<hostPool>> _pools;
+	vector<unique_ptr<connection>> _graveyard;		// Closed this iteration, freed once no event can refer to them
+
+	atomic<uint64_t> _connectionsOpened{ 0 };
+	atomic<uint64_t> _requestsSent{ 0 };
+	atomic<uint64_t> _responsesReceived{ 0 };
+	atomic<uint64_t> _retries{ 0 };
+	atomic<uint64_t> _failures{ 0 };
+	atomic<size_t> _maxInFlight{ 0 };
+
+	thread _thread;
+
+	void fail(RequestPtr& req, const string& message) {
+		// Counted first, so stats() read after the future completes always includes it
+		_failures.fetch_add(1, memory_order_relaxed);
+		req->result.set_exception(make_exception_ptr(runtime_error("HTTP request failed: " + message)));
+	}
+
+	void watch(connection& conn) {
+		const bool wantWrite = !conn.connected || conn.outPos < conn.out.size();
+		const uint32_t interest = EPOLLIN | (wantWrite ? EPOLLOUT : 0u);
+		if (interest == conn.interest) return;
+
+		epoll_event event{};
+		event.events = interest;
+		event.data.ptr = &conn;
+		epoll_ctl(_epoll, conn.interest ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, conn.fd, &event);
+		conn.interest = interest;
+	}
+
+	bool resolve(hostPool& pool, string& error) {
+		if (pool.addressLength) return true;
+
+		// Resolution blocks the loop, it only happens once per host
+		addrinfo hints{};
+		hints.ai_family = AF_UNSPEC;
+		hints.ai_socktype = SOCK_STREAM;
+		addrinfo* found = nullptr;
+
+		const int status = getaddrinfo(pool.host.c_str(), to_string(pool.port).c_str(), &hints, &found);
+		if (status != 0 || !found) {
+			error = "cannot resolve " + pool.host + ": " + gai_strerror(status);
+			return false;
+		}
+
+		memcpy(&pool.address, found->ai_addr, found->ai_addrlen);
+		pool.addressLength = found->ai_addrlen;
+		freeaddrinfo(found);
+		return true;
+	}
+
+	connection* open(hostPool& pool, string& error) {
+		if (!resolve(pool, error)) return nullptr;
+
+		const int fd = socket(pool.address.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		if (fd < 0) {
+			error = string("socket failed: ") + strerror(errno);
+			return nullptr;
+		}
+
+		const int one = 1;
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+		if (::connect(fd, reinterpret_cast<const sockaddr*>(&pool.address), pool.addressLength) != 0 && errno != EINPROGRESS) {
+			error = "connect to " + pool.host + " failed: " + strerror(errno);
+			close(fd);
+			return nullptr;
+		}
+
+		auto conn = make_unique<connection>(_options.maxResponseBytes);
+		conn->fd = fd;
+		conn->pool = &pool;
+		conn->idleSince = steady_clock::now();
+		watch(*conn);
+
+		_connectionsOpened.fetch_add(1, memory_order_relaxed);
+		pool.connections.push_back(move(conn));
+		return pool.connections.back().get();
+	}
+
+	void send(connection& conn, RequestPtr req) {
+		conn.out.append(req->wire);
+		req->attempts++;
+
+		if (conn.inFlight.empty()) conn.parser.reset(req->head);
+		conn.inFlight.push_back(move(req));
+
+		_requestsSent.fetch_add(1, memory_order_relaxed);
+		if (conn.inFlight.size() > _maxInFlight.load(memory_order_relaxed)) _maxInFlight.store(conn.inFlight.size(), memory_order_relaxed);
+	}
+
+	/// Hands waiting requests to connections, spreading them over new connections before pipelining deeper
+	void dispatch(hostPool& pool) {
+
+		const size_t depth = pool.noPipelining ? 1 : _options.maxPipelineDepth;
+
+		while (!pool.waiting.empty()) {
+			RequestPtr& req = pool.waiting.front();
+			connection* best = nullptr;
+
+			for (auto& conn : pool.connections) {
+				if (conn->inFlight.size() >= depth) continue;
+				if (!conn->inFlight.empty() && (!req->pipelinable || !conn->inFlight.back()->pipelinable)) continue;
+				if (!best || conn->inFlight.size() < best->inFlight.size()) best = conn.get();
+			}
+
+			if ((!best || !best->inFlight.empty()) && pool.connections.size() < _options.maxConnectionsPerHost) {
+				string error;
+				connection* opened = open(pool, error);
+
+				if (!opened) {
+					for (auto& waiting : pool.waiting) fail(waiting, error);
+					pool.waiting.clear();
+					break;
+				}
+				best = opened;
+			}
+			if (!best) break;
+
+			send(*best, move(req));
+			pool.waiting.pop_front();
+		}
+
+		// One write per connection for everything queued above
+		for (size_t i = 0; i < pool.connections.size(); i++) {
+			connection& conn = *pool.connections[i];
+			if (conn.connected && conn.outPos < conn.out.size() && !flush(conn)) i--;
+		}
+	}
+
+	/// Drops a connection, requests it still owed an answer go back to the front of the queue or fail
+	void drop(connection& conn, const string& message, bool countAttempt = true) {
+
+		hostPool& pool = *conn.pool;
+
+		epoll_ctl(_epoll, EPOLL_CTL_DEL, conn.fd, nullptr);
+		close(conn.fd);
+
+		while (!conn.inFlight.empty()) {
+			RequestPtr req = move(conn.inFlight.back());
+			conn.inFlight.pop_back();
+
+			if (!countAttempt) req->attempts--;
+			if (req->pipelinable && req->attempts < maxAttempts) {
+				if (countAttempt) _retries.fetch_add(1, memory_order_relaxed);
+				pool.waiting.push_front(move(req));
+			}
+			else {
+				fail(req, message);
+			}
+		}
+
+		auto owned = find_if(pool.connections.begin(), pool.connections.end(), [&](const auto& entry) { return entry.get() == &conn; });
+		_graveyard.push_back(move(*owned));
+		pool.connections.erase(owned);
+
+		dispatch(pool);
+	}
+
+	/// Writes as much as the socket takes, false if the connection was dropped
+	bool flush(connection& conn) {
+
+		while (conn.outPos < conn.out.size()) {
+			const ssize_t written = ::send(conn.fd, conn.out.data() + conn.outPos, conn.out.size() - conn.outPos, MSG_NOSIGNAL);
+			if (written < 0) {
+				if (errno == EINTR) continue;
+				if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+
+				drop(conn, string("send failed: ") + strerror(errno));
+				return false;
+			}
+			conn.outPos += static_cast<size_t>(written);
+		}
+
+		if (conn.outPos == conn.out.size()) {
+			conn.out.clear();
+			conn.outPos = 0;
+		}
+		watch(conn);
+		return true;
+	}
+
+	/// Makes room after end, starting a new slab when completed responses still point into the current one
+	void reserve(connection& conn) {
+
+		// use_count is a relaxed load, the fence orders our writes after whatever the last response's owner read
+		const bool exclusive = conn.slab && conn.slab.use_count() == 1;
+		if (exclusive) atomic_thread_fence(memory_order_acquire);
+		if (exclusive && conn.begin == conn.end) conn.begin = conn.end = 0;
+		if (conn.end < conn.capacity) return;
+
+		const size_t pending = conn.end - conn.begin;
+		const size_t needed = max(slabSize, pending * 2);
+
+		if (exclusive && needed <= conn.capacity) {
+			memmove(conn.slab.get(), conn.slab.get() + conn.begin, pending);
+		}
+		else {
+			shared_ptr<char[]> fresh(new char[needed]);
+			if (pending) memcpy(fresh.get(), conn.slab.get() + conn.begin, pending);
+			conn.slab = move(fresh);
+			conn.capacity = needed;
+		}
+		conn.begin = 0;
+		conn.end = pending;
+	}
+
+	response build(const connection& conn) {
+
+		const responseParser& parsed = conn.parser;
+		const char* base = conn.slab.get() + conn.begin;
+		auto view = [base](byteRange range) { return string_view(base + range.offset, range.length); };
+
+		response result;
+		result._storage = conn.slab;
+		result._status = parsed.status;
+		result._reason = view(parsed.reason);
+		result._body = view(parsed.body);
+
+		result._headers.reserve(parsed.headers.size());
+		for (const auto& [name, value] : parsed.headers) {
+			result._headers.emplace_back(view(name), view(value));
+		}
+		return result;
+	}
+
+	/// Completes every response the buffer holds, false if the connection was dropped
+	bool deliver(connection& conn, bool eof) {
+
+		while (!conn.inFlight.empty()) {
+			// Closed before a byte of the next response, usually a pooled connection the server timed out
+			if (eof && conn.begin == conn.end) break;
+
+			const auto state = conn.parser.feed(conn.slab.get() + conn.begin, conn.end - conn.begin, eof);
+
+			if (state == responseParser::state::incomplete) return true;
+			if (state == responseParser::state::failed) {
+				// The stream cannot be trusted past a malformed response, only the request it answered fails outright
+				RequestPtr req = move(conn.inFlight.front());
+				conn.inFlight.pop_front();
+				fail(req, "malformed response from " + conn.pool->host + ", " + conn.parser.error());
+				drop(conn, conn.parser.error());
+				return false;
+			}
+
+			if (conn.parser.interim) {
+				conn.begin += conn.parser.consumed;
+				conn.parser.reset(conn.inFlight.front()->head);
+				continue;
+			}
+
+			response result = build(conn);
+			const bool keepAlive = conn.parser.keepAlive;
+			conn.begin += conn.parser.consumed;
+
+			RequestPtr req = move(conn.inFlight.front());
+			conn.inFlight.pop_front();
+			_responsesReceived.fetch_add(1, memory_order_relaxed);
+			req->result.set_value(move(result));
+
+			if (!conn.inFlight.empty()) conn.parser.reset(conn.inFlight.front()->head);
+
+			if (!keepAlive) {
+				// A server closing after this response never processed the ones pipelined behind it
+				if (!conn.inFlight.empty()) conn.pool->noPipelining = true;
+				drop(conn, "connection closed by " + conn.pool->host, false);
+				return false;
+			}
+		}
+
+		if (conn.begin < conn.end || eof) {
+			drop(conn, eof ? "connection closed" : "unexpected data from " + conn.pool->host);
+			return false;
+		}
+
+		conn.idleSince = steady_clock::now();
+		if (!conn.pool->waiting.empty()) dispatch(*conn.pool);
+		return true;
+	}
+
+	void receive(connection& conn) {
+
+		for (;;) {
+			reserve(conn);
+			const ssize_t length = ::recv(conn.fd, conn.slab.get() + conn.end, conn.capacity - conn.end, 0);
+
+			if (length > 0) {
+				conn.end += static_cast<size_t>(length);
+				if (!deliver(conn, false)) return;
+				continue;
+			}
+			if (length == 0) {
+				deliver(conn, true);
+				return;
+			}
+			if (errno == EINTR) continue;
+			if (errno != EAGAIN && errno != EWOULDBLOCK) drop(conn, string("receive failed: ") + strerror(errno));
+			return;
+		}
+	}
+
+	void handle(connection& conn, uint32_t events) {
+
+		if (!conn.connected) {
+			int error = 0;
+			socklen_t length = sizeof(error);
+			getsockopt(conn.fd, SOL_SOCKET, SO_ERROR, &error, &length);
+
+			if (error) {
+				drop(conn, "connect to " + conn.pool->host + " failed: " + strerror(error));
+				return;
+			}
+			if (!(events & (EPOLLOUT | EPOLLIN))) return;
+
+			conn.connected = true;
+		}
+
+		if ((events & EPOLLOUT) && !flush(conn)) return;
+		if (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) receive(conn);
+	}
+
+	void takeIncoming() {
+
+		uint64_t count;
+		[[maybe_unused]] auto drained = ::read(_wake, &count, sizeof(count));
+
+		vector<submission> incoming;
+		{
+			lock_guard<mutex> lock(_mutex);
+			swap(incoming, _incoming);
+		}
+
+		vector<hostPool*> touched;
+		for (auto& item : incoming) {
+			auto& pool = _pools[item.poolKey];
+			if (!pool) {
+				pool = make_unique<hostPool>();
+				pool->host = item.target.host;
+				pool->port = item.target.port;
+			}
+
+			if (pool->waiting.empty()) touched.push_back(pool.get());
+			pool->waiting.push_back(move(item.request));
+		}
+
+		for (hostPool* pool : touched) dispatch(*pool);
+	}
+
+	/// Fails requests past their deadline and closes connections idle for too long
+	void sweep() {
+
+		const auto now = steady_clock::now();
+
+		for (auto& [key, pool] : _pools) {
+			for (auto it = pool->waiting.begin(); it != pool->waiting.end(); ) {
+				if ((*it)->deadline > now) {
+					++it;
+					continue;
+				}
+				fail(*it, "timed out waiting for a connection to " + pool->host);
+				it = pool->waiting.erase(it);
+			}
+
+			for (size_t i = 0; i < pool->connections.size(); i++) {
+				connection& conn = *pool->connections[i];
+
+				if (!conn.inFlight.empty() && conn.inFlight.front()->deadline <= now) {
+					// The answer to everything behind it is stuck behind the late one, so they are resent elsewhere
+					RequestPtr late = move(conn.inFlight.front());
+					conn.inFlight.pop_front();
+					fail(late, "timed out waiting for " + pool->host);
+					drop(conn, "timed out", false);
+					i--;
+				}
+				else if (conn.inFlight.empty() && now - conn.idleSince > _options.idleTimeout) {
+					drop(conn, "idle");
+					i--;
+				}
+			}
+		}
+	}
+
+	void shutdown() {
+
+		{
+			lock_guard<mutex> lock(_mutex);
+			for (auto& item : _incoming) fail(item.request, "client destroyed");
+			_incoming.clear();
+		}
+
+		for (auto& [key, pool] : _pools) {
+			for (auto& req : pool->waiting) fail(req, "client destroyed");
+			for (auto& conn : pool->connections) {
+				for (auto& req : conn->inFlight) fail(req, "client destroyed");
+				close(conn->fd);
+			}
+		}
+		_pools.clear();
+	}
+
+	void run() {
+
+		epoll_event events[128];
+		auto lastSweep = steady_clock::now();
+
+		for (;;) {
+			const bool busy = any_of(_pools.begin(), _pools.end(), [](const auto& entry) {
+				return !entry.second->waiting.empty() || !entry.second->connections.empty();
+			});
+
+			const int ready = epoll_wait(_epoll, events, 128, busy ? static_cast<int>(sweepInterval.count()) : -1);
+
+			for (int i = 0; i < ready; i++) {
+				if (!events[i].data.ptr) {
+					takeIncoming();
+					continue;
+				}
+
+				// A connection dropped earlier in this batch is in the graveyard and no longer in any pool
+				auto* conn = static_cast<connection*>(events[i].data.ptr);
+				const bool closed = any_of(_graveyard.begin(), _graveyard.end(), [conn](const auto& dead) { return dead.get() == conn; });
+				if (!closed) handle(*conn, events[i].events);
+			}
+			_graveyard.clear();
+
+			{
+				lock_guard<mutex> lock(_mutex);
+				if (_stopping) break;
+			}
+
+			if (steady_clock::now() - lastSweep >= sweepInterval) {
+				sweep();
+				_graveyard.clear();
+				lastSweep = steady_clock::now();
+			}
+		}
+
+		shutdown();
+	}
+
+public:
+	explicit eventLoop(const clientOptions& options) : _options(options) {
+
+		if (_options.maxConnectionsPerHost == 0 || _options.maxPipelineDepth == 0) throw runtime_error("HTTP client needs at least one connection and a pipeline depth of one");
+		if (_options.maxResponseBytes > UINT32_MAX) throw runtime_error("HTTP client responses are limited to 4GB");
+
+		_epoll = epoll_create1(EPOLL_CLOEXEC);
+		_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (_epoll < 0 || _wake < 0) {
+			if (_epoll >= 0) close(_epoll);
+			if (_wake >= 0) close(_wake);
+			throw runtime_error("Failed to create the HTTP client event loop");
+		}
+
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.ptr = nullptr;
+		epoll_ctl(_epoll, EPOLL_CTL_ADD, _wake, &event);
+
+		_thread = thread(&eventLoop::run, this);
+	}
+
+	~eventLoop() {
+		{
+			lock_guard<mutex> lock(_mutex);
+			_stopping = true;
+		}
+		wake();
+
+		if (_thread.joinable()) _thread.join();
+		close(_wake);
+		close(_epoll);
+	}
+
+	eventLoop(const eventLoop&) = delete;
+	eventLoop& operator=(const eventLoop&) = delete;
+
+	void wake() {
+		const uint64_t one = 1;
+		[[maybe_unused]] auto written = ::write(_wake, &one, sizeof(one));
+	}
+
+	void submit(vector<submission>& batch) {
+		{
+			lock_guard<mutex> lock(_mutex);
+			if (_stopping) {
+				for (auto& item : batch) fail(item.request, "client destroyed");
+				return;
+			}
+			for (auto& item : batch) _incoming.push_back(move(item));
+		}
+		wake();
+	}
+
+	const clientOptions& options() const { return _options; }
+
+	clientStats stats() const {
+		clientStats result;
+		result.connectionsOpened = _connectionsOpened.load(memory_order_relaxed);
+		result.requestsSent = _requestsSent.load(memory_order_relaxed);
+		result.responsesReceived = _responsesReceived.load(memory_order_relaxed);
+		result.retries = _retries.load(memory_order_relaxed);
+		result.failures = _failures.load(memory_order_relaxed);
+		result.maxInFlight = _maxInFlight.load(memory_order_relaxed);
+		return result;
+	}
+};
+
+#else
+
+namespace {
+	struct submission {
+		string poolKey;
+		url target;
+		RequestPtr request;
+	};
+}
+
+class UTK::Client::Internal::eventLoop {
+private:
+	clientOptions _options;
+
+public:
+	explicit eventLoop(const clientOptions& options) : _options(options) {
+		throw runtime_error("The HTTP client requires epoll and is not supported on this platform");
+	}
+
+	void submit(vector<submission>&) {}
+	const clientOptions& options() const { return _options; }
+	clientStats stats() const { return {}; }
+};
+
+#endif
+
+//===================================================================================================================================
+//											           HTTP CLIENT METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+httpClient::httpClient(clientOptions options) : _loop(make_unique<Internal::eventLoop>(options)) {}
+
+httpClient::~httpClient() = default;
+
+future<response> httpClient::fetch(request req) {
+
+	vector<request> single;
+	single.push_back(move(req));
+	return move(fetchAll(move(single)).front());
+}
+
+vector<future<response>> httpClient::fetchAll(vector<request> requests) {
+
+	vector<future<response>> futures;
+	vector<submission> batch;
+	futures.reserve(requests.size());
+	batch.reserve(requests.size());
+
+	const auto deadline = steady_clock::now() + _loop->options().timeout;
+
+	for (auto& req : requests) {
+		auto pending = make_unique<pendingRequest>();
+		futures.push_back(pending->result.get_future());
+
+		// A request that cannot be sent fails through its own future rather than aborting the batch
+		try {
+			url target = parseUrl(req.url);
+			serialize(req, target, *pending);
+			pending->deadline = deadline;
+
+			string key = target.host + ":" + to_string(target.port);
+			batch.push_back({ move(key), move(target), move(pending) });
+		}
+		catch (...) {
+			pending->result.set_exception(current_exception());
+		}
+	}
+
+	if (!batch.empty()) _loop->submit(batch);
+	return futures;
+}
+
+response httpClient::get(string_view url) {
+
+	request req;
+	req.url = string(url);
+	return fetch(move(req)).get();
+}
+
+clientStats httpClient::stats() const {
+	return _loop->stats();
+}
\ No newline at end of file
@@ -0,0 +1,297 @@
+//===================================================================================================================================
+// @file	utkhttpparser.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the URL parser and the incremental HTTP/1.1 response parser used by
+//			UTK::Client.
+//===================================================================================================================================
+
+#include "utkhttpparser.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+using namespace std;
+using namespace UTK::Client::Internal;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	/// Headers larger than this are treated as a broken or hostile server
+	constexpr size_t maxHeaderBytes = 64 * 1024;
+
+	bool equalsIgnoreCase(string_view a, string_view b) {
+		return a.size() == b.size() && equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+			return (x | 0x20) == (y | 0x20);
+		});
+	}
+
+	string_view trim(string_view text) {
+		while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+		while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1);
+		return text;
+	}
+
+	/// Matches one entry of a comma separated header value such as Connection or Transfer-Encoding
+	bool containsToken(string_view list, string_view token) {
+		while (!list.empty()) {
+			const size_t comma = list.find(',');
+			if (equalsIgnoreCase(trim(list.substr(0, comma)), token)) return true;
+
+			if (comma == string_view::npos) break;
+			list.remove_prefix(comma + 1);
+		}
+		return false;
+	}
+
+	size_t findCrlf(const char* data, size_t from, size_t size) {
+		for (size_t i = from; i + 1 < size; i++) {
+			const void* hit = memchr(data + i, '\r', size - i - 1);
+			if (!hit) return string_view::npos;
+
+			i = static_cast<size_t>(static_cast<const char*>(hit) - data);
+			if (data[i + 1] == '\n') return i;
+		}
+		return string_view::npos;
+	}
+}
+
+//===================================================================================================================================
+//											                URL PARSING
+//===================================================================================================================================
+
+url UTK::Client::Internal::parseUrl(string_view text) {
+
+	constexpr string_view scheme = "http://";
+	if (text.size() < scheme.size() || !equalsIgnoreCase(text.substr(0, scheme.size()), scheme)) {
+		throw runtime_error("Only http:// URLs are supported: " + string(text));
+	}
+	text.remove_prefix(scheme.size());
+
+	const size_t pathStart = text.find_first_of("/?");
+	string_view authority = text.substr(0, pathStart);
+	url parsed;
+	parsed.target = (pathStart == string_view::npos) ? "/" : string(text.substr(pathStart));
+	if (parsed.target.front() == '?') parsed.target.insert(0, "/");
+
+	if (authority.find('@') != string_view::npos) throw runtime_error("URLs with credentials are not supported: " + string(text));
+	parsed.authority = string(authority);
+
+	string_view port;
+	if (!authority.empty() && authority.front() == '[') {
+		// IPv6 literal, the port follows the closing bracket
+		const size_t close = authority.find(']');
+		if (close == string_view::npos) throw runtime_error("Malformed IPv6 address in URL: " + string(text));
+
+		parsed.host = string(authority.substr(1, close - 1));
+		if (close + 1 < authority.size()) {
+			if (authority[close + 1] != ':') throw runtime_error("Malformed URL authority: " + string(text));
+			port = authority.substr(close + 2);
+		}
+	}
+	else {
+		const size_t colon = authority.find(':');
+		parsed.host = string(authority.substr(0, colon));
+		if (colon != string_view::npos) port = authority.substr(colon + 1);
+	}
+
+	if (parsed.host.empty()) throw runtime_error("URL has no host: " + string(text));
+	if (!port.empty()) {
+		auto [end, ec] = from_chars(port.data(), port.data() + port.size(), parsed.port);
+		if (ec != errc() || end != port.data() + port.size() || parsed.port == 0) throw runtime_error("Invalid port in URL: " + string(text));
+	}
+
+	return parsed;
+}
+
+//===================================================================================================================================
+//											          RESPONSE PARSER METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+void responseParser::reset(bool headRequest) {
+
+	_head = headRequest;
+	_headersDone = false;
+	_scanned = 0;
+	_headerEnd = 0;
+	_framing = framing::none;
+	_contentLength = 0;
+	_chunkPos = 0;
+	_chunks.clear();
+	_error.clear();
+
+	status = 0;
+	interim = false;
+	keepAlive = true;
+	consumed = 0;
+	reason = {};
+	body = {};
+	headers.clear();
+}
+
+responseParser::state responseParser::fail(string message) {
+	_error = move(message);
+	return state::failed;
+}
+
+responseParser::state responseParser::parseHeaders(const char* data, size_t size) {
+
+	// Resume the search a few bytes back in case the terminator straddled the previous read
+	const size_t from = _scanned > 3 ? _scanned - 3 : 0;
+	const size_t end = string_view(data, size).find("\r\n\r\n", from);
+
+	if (end == string_view::npos) {
+		_scanned = size;
+		return size > maxHeaderBytes ? fail("response headers exceed 64KB") : state::incomplete;
+	}
+	_headerEnd = end + 4;
+
+	// Status line: HTTP/1.x SP code SP reason
+	const size_t lineEnd = findCrlf(data, 0, _headerEnd);
+	const string_view statusLine(data, lineEnd);
+	if (statusLine.size() < 12 || statusLine.substr(0, 7) != "HTTP/1." || statusLine[8] != ' ') return fail("malformed status line");
+
+	auto [codeEnd, ec] = from_chars(statusLine.data() + 9, statusLine.data() + 12, status);
+	if (ec != errc() || codeEnd != statusLine.data() + 12 || status < 100) return fail("malformed status code");
+
+	const bool http10 = statusLine[7] == '0';
+	keepAlive = !http10;
+	if (statusLine.size() > 13) reason = { 13, static_cast<uint32_t>(statusLine.size() - 13) };
+
+	bool chunked = false;
+	bool haveLength = false;
+
+	for (size_t at = lineEnd + 2; at < _headerEnd - 2; ) {
+		const size_t next = findCrlf(data, at, _headerEnd);
+		const string_view line(data + at, next - at);
+
+		const size_t colon = line.find(':');
+		if (colon == string_view::npos || colon == 0) return fail("malformed header line");
+
+		const string_view name = line.substr(0, colon);
+		const string_view value = trim(line.substr(colon + 1));
+		const auto valueOffset = static_cast<uint32_t>(value.data() - data);
+		headers.push_back({ { static_cast<uint32_t>(at), static_cast<uint32_t>(colon) }, { valueOffset, static_cast<uint32_t>(value.size()) } });
+
+		if (equalsIgnoreCase(name, "content-length")) {
+			size_t length = 0;
+			auto [lengthEnd, lengthEc] = from_chars(value.data(), value.data() + value.size(), length);
+			if (lengthEc != errc() || lengthEnd != value.data() + value.size()) return fail("invalid Content-Length");
+			if (haveLength && length != _contentLength) return fail("conflicting Content-Length headers");
+
+			_contentLength = length;
+			haveLength = true;
+		}
+		else if (equalsIgnoreCase(name, "transfer-encoding")) {
+			chunked = containsToken(value, "chunked");
+		}
+		else if (equalsIgnoreCase(name, "connection")) {
+			if (containsToken(value, "close")) keepAlive = false;
+			else if (containsToken(value, "keep-alive")) keepAlive = true;
+		}
+
+		at = next + 2;
+	}
+
+	_headersDone = true;
+	interim = status < 200;
+
+	if (interim || _head || status == 204 || status == 304) _framing = framing::none;
+	else if (chunked) _framing = framing::chunked;
+	else if (haveLength) _framing = framing::length;
+	else _framing = framing::untilClose;
+
+	if (_framing == framing::length && _headerEnd + _contentLength > _maxBytes) return fail("response larger than the configured limit");
+	if (_framing == framing::untilClose) keepAlive = false;
+
+	_chunkPos = _headerEnd;
+	return state::complete;
+}
+
+responseParser::state responseParser::parseChunks(char* data, size_t size) {
+
+	for (;;) {
+		const size_t lineEnd = findCrlf(data, _chunkPos, size);
+		if (lineEnd == string_view::npos) return size > _maxBytes ? fail("response larger than the configured limit") : state::incomplete;
+
+		// Chunk extensions after ';' are ignored
+		size_t length = 0;
+		const char* digits = data + _chunkPos;
+		auto [digitsEnd, ec] = from_chars(digits, data + lineEnd, length, 16);
+		if (ec != errc() || digitsEnd == digits || (digitsEnd != data + lineEnd && *digitsEnd != ';' && *digitsEnd != ' ')) return fail("malformed chunk size");
+
+		const size_t dataStart = lineEnd + 2;
+
+		if (length == 0) {
+			// Either an empty line right away, or trailer fields ending in an empty line
+			size_t end;
+			if (size >= dataStart + 2 && data[dataStart] == '\r' && data[dataStart + 1] == '\n') {
+				end = dataStart + 2;
+			}
+			else {
+				const size_t trailers = string_view(data, size).find("\r\n\r\n", dataStart);
+				if (trailers == string_view::npos) return state::incomplete;
+				end = trailers + 4;
+			}
+
+			// Slide every chunk down over the framing in front of it, the decoded body only ever shrinks
+			size_t write = _headerEnd;
+			for (const byteRange& chunk : _chunks) {
+				memmove(data + write, data + chunk.offset, chunk.length);
+				write += chunk.length;
+			}
+
+			body = { static_cast<uint32_t>(_headerEnd), static_cast<uint32_t>(write - _headerEnd) };
+			consumed = end;
+			return state::complete;
+		}
+
+		if (length > _maxBytes || dataStart + length > _maxBytes) return fail("response larger than the configured limit");
+		if (size < dataStart + length + 2) return state::incomplete;
+		if (data[dataStart + length] != '\r' || data[dataStart + length + 1] != '\n') return fail("chunk not terminated by CRLF");
+
+		_chunks.push_back({ static_cast<uint32_t>(dataStart), static_cast<uint32_t>(length) });
+		_chunkPos = dataStart + length + 2;
+	}
+}
+
+responseParser::state responseParser::feed(char* data, size_t size, bool eof) {
+
+	if (!_headersDone) {
+		const state headerState = parseHeaders(data, size);
+		if (headerState != state::complete) {
+			return (headerState == state::incomplete && eof) ? fail("connection closed mid-response") : headerState;
+		}
+	}
+
+	switch (_framing) {
+	case framing::none:
+		consumed = _headerEnd;
+		return state::complete;
+
+	case framing::length:
+		if (size - _headerEnd < _contentLength) return eof ? fail("connection closed mid-response") : state::incomplete;
+		body = { static_cast<uint32_t>(_headerEnd), static_cast<uint32_t>(_contentLength) };
+		consumed = _headerEnd + _contentLength;
+		return state::complete;
+
+	case framing::chunked: {
+		const state chunkState = parseChunks(data, size);
+		return (chunkState == state::incomplete && eof) ? fail("connection closed mid-response") : chunkState;
+	}
+
+	case framing::untilClose:
+		if (size > _maxBytes) return fail("response larger than the configured limit");
+		if (!eof) return state::incomplete;
+		body = { static_cast<uint32_t>(_headerEnd), static_cast<uint32_t>(size - _headerEnd) };
+		consumed = size;
+		return state::complete;
+	}
+
+	return state::incomplete;
+}
\ No newline at end of file
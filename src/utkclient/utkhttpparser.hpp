@@ -0,0 +1,97 @@
+//===================================================================================================================================
+// @file	utkhttpparser.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Internal header shared by the UTK::Client sources, declares the URL parser and the incremental
+//			HTTP/1.1 response parser.
+//===================================================================================================================================
+
+#pragma once
+
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace UTK::Client::Internal {
+
+	struct url {
+		std::string host;			// Without brackets for IPv6 literals, ready for getaddrinfo
+		std::uint16_t port = 80;
+		std::string target;			// Path and query sent on the request line
+		std::string authority;		// Host header value
+	};
+
+	/**
+	 * @brief Splits an http:// URL, throws std::runtime_error for anything else
+	 */
+	url parseUrl(std::string_view text);
+
+	/**
+	 * @brief Byte range relative to the first byte of a response
+	 */
+	struct byteRange {
+		std::uint32_t offset = 0;
+		std::uint32_t length = 0;
+	};
+
+	/**
+	 * @brief Parses one response at a time from the front of a connection's receive buffer
+	 *
+	 * @note The buffer may be moved between calls, so everything is kept as offsets from the start of the
+	 *		 response. Chunked bodies are decoded in place once the last chunk arrives, leaving the body
+	 *		 contiguous straight after the headers.
+	 */
+	class responseParser {
+	public:
+		enum class state { incomplete, complete, failed };
+
+	private:
+		enum class framing { none, length, chunked, untilClose };
+
+		std::size_t _maxBytes;
+		bool _head = false;
+
+		bool _headersDone = false;
+		std::size_t _scanned = 0;
+		std::size_t _headerEnd = 0;
+		framing _framing = framing::none;
+		std::size_t _contentLength = 0;
+
+		std::size_t _chunkPos = 0;
+		std::vector<byteRange> _chunks;
+
+		std::string _error;
+
+		state fail(std::string message);
+		state parseHeaders(const char* data, std::size_t size);
+		state parseChunks(char* data, std::size_t size);
+
+	public:
+		int status = 0;
+		bool interim = false;		// A 1xx response, skipped before the real one
+		bool keepAlive = true;
+		std::size_t consumed = 0;	// Bytes of the stream this response took up, set once complete
+		byteRange reason;
+		byteRange body;
+		std::vector<std::pair<byteRange, byteRange>> headers;
+
+		explicit responseParser(std::size_t maxBytes) : _maxBytes(maxBytes) {}
+
+		/**
+		 * @brief Prepares for the next response, HEAD responses never carry a body
+		 */
+		void reset(bool headRequest);
+
+		/**
+		 * @brief Parses as much as the size bytes at data allow
+		 *
+		 * @param eof: The peer has closed, completes a response delimited by the connection closing.
+		 */
+		state feed(char* data, std::size_t size, bool eof);
+
+		const std::string& error() const { return _error; }
+	};
+}
\ No newline at end of file
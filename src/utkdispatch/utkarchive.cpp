@@ -0,0 +1,775 @@
+//===================================================================================================================================
+// @file	utkarchive.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the block-compressed archive writer, its seek table and the streaming reader.
+//
+// @note    Each frame header carries an XXH3-64 checksum of the stored payload. A frame whose payload does not
+//          match it is treated exactly like one cut short by a crash: scanning stops there, and readers drop it
+//          and everything after it until refresh() finds it whole.
+//===================================================================================================================================
+
+#include "dispatchers/utkarchive.hpp"
+#include "dispatchers/utkexecutor.hpp"
+#include "dispatchers/utkkeytable.hpp"
+#include "hash/utkhash.hpp"
+#include "utklzcodec.hpp"
+#include <unordered_map>
+#include <system_error>
+#include <string_view>
+#include <filesystem>
+#include <stdexcept>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <limits>
+#include <deque>
+
+using namespace std;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+using namespace UTK::Types::LogEntry;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	constexpr char fileMagic[8] = { 'U', 'T', 'K', 'A', 'R', 'C', 'H', '1' };
+	constexpr char footerMagic[8] = { 'U', 'T', 'K', 'I', 'N', 'D', 'E', 'X' };
+	constexpr uint32_t frameMagic = 0x424B5455;		// "UTKB" read as a little endian word
+	constexpr uint32_t formatVersion = 2;
+
+	constexpr size_t minBlockBytes = 4 * 1024;
+	constexpr size_t maxBlockBytes = 64 * 1024 * 1024;
+
+	/// Start of the file, the block size is informational only, readers take sizes from each frame
+	struct fileHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t blockBytes;
+	};
+
+	/// Precedes every block, enough on its own to rebuild the seek table
+	struct frameHeader {
+		uint32_t magic;
+		uint32_t storedBytes;
+		uint32_t rawBytes;
+		uint32_t entries;
+		int64_t earliest;
+		int64_t latest;
+		uint64_t checksum;			// XXH3-64 of the stored payload
+	};
+
+	/// One seek table row, written after the last block when the archive is closed
+	struct tableEntry {
+		uint64_t offset;
+		uint32_t storedBytes;
+		uint32_t rawBytes;
+		uint32_t entries;
+		uint32_t reserved;
+		int64_t earliest;
+		int64_t latest;
+	};
+
+	/// Last bytes of a closed archive
+	struct fileFooter {
+		uint64_t tableOffset;
+		uint32_t blockCount;
+		uint32_t version;
+		char magic[8];
+	};
+
+	static_assert(sizeof(fileHeader) == 16, "Archive header layout must stay fixed");
+	static_assert(sizeof(frameHeader) == 40, "Archive frame layout must stay fixed");
+	static_assert(sizeof(tableEntry) == 40, "Archive seek table layout must stay fixed");
+	static_assert(sizeof(fileFooter) == 24, "Archive footer layout must stay fixed");
+
+	template<typename T>
+	bool readAt(ifstream& file, uint64_t offset, T& out) {
+		file.clear();
+		file.seekg(static_cast<streamoff>(offset));
+		return static_cast<bool>(file.read(reinterpret_cast<char*>(&out), sizeof(T)));
+	}
+
+	/// Reads the frame at offset, false if it is torn: cut short, not a frame at all, or failing its checksum
+	bool readFrame(ifstream& file, uint64_t offset, uint64_t fileSize, frameHeader& frame, string& payload) {
+
+		if (offset + sizeof(frameHeader) > fileSize || !readAt(file, offset, frame)) return false;
+		if (frame.magic != frameMagic || frame.storedBytes > frame.rawBytes) return false;
+		if (offset + sizeof(frameHeader) + frame.storedBytes > fileSize) return false;
+
+		payload.resize(frame.storedBytes);
+		if (!file.read(payload.data(), static_cast<streamsize>(payload.size()))) return false;
+
+		return UTK::Hash::hash64(payload) == frame.checksum;
+	}
+
+	/// Walks frames from offset until one is torn or missing, or is not a frame at all, such as a seek table
+	/// @return Offset just past the last whole block found
+	uint64_t scanFrames(ifstream& file, uint64_t offset, uint64_t fileSize, vector<archiveBlock>& blocks) {
+
+		frameHeader frame{};
+		string payload;
+		while (readFrame(file, offset, fileSize, frame, payload)) {
+			blocks.push_back({ offset, frame.storedBytes, frame.rawBytes, frame.entries, frame.earliest, frame.latest });
+			offset += sizeof(frameHeader) + frame.storedBytes;
+		}
+
+		return offset;
+	}
+
+	/// Reads the header and seek table of an archive, rebuilding the table from frame headers when there is no footer
+	/// @return Offset just past the last whole block, where new blocks or the seek table go
+	uint64_t loadIndex(ifstream& file, uint64_t fileSize, vector<archiveBlock>& blocks, bool& complete) {
+
+		fileHeader header{};
+		if (!readAt(file, 0, header) || memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0) {
+			throw runtime_error("Not a UTK archive");
+		}
+		if (header.version != formatVersion) {
+			throw runtime_error("Unsupported UTK archive version: " + to_string(header.version));
+		}
+
+		blocks.clear();
+		complete = false;
+
+		fileFooter footer{};
+		if (fileSize >= sizeof(fileHeader) + sizeof(fileFooter) && readAt(file, fileSize - sizeof(fileFooter), footer)
+			&& memcmp(footer.magic, footerMagic, sizeof(footerMagic)) == 0
+			&& footer.tableOffset >= sizeof(fileHeader)
+			&& footer.tableOffset + uint64_t(footer.blockCount) * sizeof(tableEntry) == fileSize - sizeof(fileFooter))
+		{
+			vector<tableEntry> table(footer.blockCount);
+			file.clear();
+			file.seekg(static_cast<streamoff>(footer.tableOffset));
+			if (file.read(reinterpret_cast<char*>(table.data()), static_cast<streamsize>(table.size() * sizeof(tableEntry)))) {
+				for (const auto& row : table) {
+					blocks.push_back({ row.offset, row.storedBytes, row.rawBytes, row.entries, row.earliest, row.latest });
+				}
+				complete = true;
+				return footer.tableOffset;
+			}
+		}
+
+		// No usable footer, the writer died before closing
+		return scanFrames(file, sizeof(fileHeader), fileSize, blocks);
+	}
+
+	void appendVarint(string& out, uint64_t value) {
+		while (value >= 0x80) {
+			out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<char>(value));
+	}
+
+	inline uint64_t zigzag(int64_t value) {
+		return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+	}
+
+	inline int64_t unzigzag(uint64_t value) {
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+
+	/// Optional strings are written as length + 1, with 0 standing for no value
+	void appendOptional(string& out, const optional<string>& value) {
+		if (!value) {
+			out.push_back(0);
+			return;
+		}
+		appendVarint(out, value->size() + 1);
+		out.append(*value);
+	}
+
+	/// Bounds checked reads over a decompressed block
+	class blockCursor {
+	private:
+		const string* _data = nullptr;
+		size_t _pos = 0;
+
+		[[noreturn]] static void corrupt() {
+			throw runtime_error("UTK archive block is corrupt");
+		}
+
+	public:
+		void reset(const string& data) {
+			_data = &data;
+			_pos = 0;
+		}
+
+		uint64_t varint() {
+			uint64_t value = 0;
+			for (unsigned shift = 0; shift < 64; shift += 7) {
+				if (_pos >= _data->size()) corrupt();
+				const auto byte = static_cast<unsigned char>((*_data)[_pos++]);
+				value |= uint64_t(byte & 0x7F) << shift;
+				if (!(byte & 0x80)) return value;
+			}
+			corrupt();
+		}
+
+		uint8_t byte() {
+			if (_pos >= _data->size()) corrupt();
+			return static_cast<uint8_t>((*_data)[_pos++]);
+		}
+
+		string text(uint64_t length) {
+			if (length > _data->size() - _pos) corrupt();
+			string value(_data->data() + _pos, static_cast<size_t>(length));
+			_pos += static_cast<size_t>(length);
+			return value;
+		}
+
+		optional<string> optionalText() {
+			const uint64_t length = varint();
+			if (!length) return nullopt;
+			return text(length - 1);
+		}
+	};
+
+	/// Decompresses one block and decodes its entries in order
+	class blockDecoder {
+	private:
+		string _stored;
+		string _raw;
+		blockCursor _cursor;
+		vector<string> _keys;
+		uint32_t _remaining = 0;
+		int64_t _previous = 0;
+
+	public:
+		/// False, with nothing loaded, if the block's frame is torn
+		bool load(ifstream& file, const archiveBlock& block) {
+
+			_remaining = 0;
+
+			frameHeader frame{};
+			if (!readFrame(file, block.offset, numeric_limits<uint64_t>::max(), frame, _stored) || frame.storedBytes != block.storedBytes) {
+				return false;
+			}
+
+			if (block.storedBytes == block.rawBytes) {
+				swap(_raw, _stored);
+			}
+			else {
+				_raw.resize(block.rawBytes);
+				if (!Codec::lzDecompress(_stored, _raw.data(), _raw.size())) throw runtime_error("UTK archive block is corrupt");
+			}
+
+			_cursor.reset(_raw);
+			_keys.resize(static_cast<size_t>(min<uint64_t>(_cursor.varint(), block.rawBytes)));
+			for (auto& key : _keys) {
+				key = _cursor.text(_cursor.varint());
+			}
+
+			_remaining = block.entries;
+			_previous = 0;
+			return true;
+		}
+
+		uint32_t remaining() const {
+			return _remaining;
+		}
+
+		void clear() {
+			_remaining = 0;
+		}
+
+		void decode(archivedEntry& out) {
+
+			_remaining--;
+			out.timeStamp = _previous + unzigzag(_cursor.varint());
+			_previous = out.timeStamp;
+
+			logEntry& entry = out.entry;
+			entry.lg = static_cast<Logger>(_cursor.byte());
+			entry.op = static_cast<Operations>(_cursor.byte());
+
+			const uint64_t line = _cursor.varint();
+			entry.fileLine = line ? optional<int>(static_cast<int>(unzigzag(line - 1))) : nullopt;
+			entry.fileName = _cursor.optionalText();
+			entry.funcName = _cursor.optionalText();
+
+			entry.keyIds.clear();
+			entry.formatKeys.resize(static_cast<size_t>(min<uint64_t>(_cursor.varint(), _raw.size())));
+			for (auto& key : entry.formatKeys) {
+				const uint64_t index = _cursor.varint();
+				if (index >= _keys.size()) throw runtime_error("UTK archive block is corrupt");
+				key = _keys[index];
+			}
+
+			entry.formatValues.resize(static_cast<size_t>(min<uint64_t>(_cursor.varint(), _raw.size())));
+			for (auto& value : entry.formatValues) {
+				value = _cursor.text(_cursor.varint());
+			}
+		}
+	};
+}
+
+//===================================================================================================================================
+//											      ARCHIVE SINK DEFINITION
+//===================================================================================================================================
+
+class UTK::Dispatch::Internal::archiveSink {
+private:
+	/// A sealed block on its way through the compressor, the task yields its frame header and payload
+	struct pendingBlock {
+		task<string> frame;
+		archiveBlock block;
+	};
+
+	/// Where an interned key sits in the open block's dictionary, valid while generation matches
+	struct localKey {
+		uint64_t generation = 0;
+		uint32_t index = 0;
+	};
+
+	const string _path;
+	const size_t _blockBytes;
+	taskExecutor& _executor;
+	const size_t _maxPending;
+
+	ofstream _file;
+	uint64_t _offset = 0;				// Where the next frame goes
+	bool _closed = false;
+	vector<archiveBlock> _blocks;
+	deque<pendingBlock> _pending;
+
+	// The open block: records, the dictionary of keys they refer to, and its running stats
+	string _records;
+	deque<string> _keyNames;						// Deque so the map's views stay put as keys are added
+	unordered_map<string_view, uint32_t> _keyIndex;
+	vector<localKey> _internedIndex;				// Shortcut for interned keys, indexed by KeyId
+	uint64_t _generation = 1;
+	uint32_t _entries = 0;
+	int64_t _previous = 0;
+	int64_t _earliest = 0;
+	int64_t _latest = 0;
+
+	void open() {
+
+		const bool exists = filesystem::exists(_path) && filesystem::file_size(_path) > 0;
+
+		if (exists) {
+			ifstream existing(_path, ios::binary);
+			if (!existing) throw runtime_error("Unable to open UTK archive: " + _path);
+
+			bool complete = false;
+			const uint64_t end = loadIndex(existing, filesystem::file_size(_path), _blocks, complete);
+			existing.close();
+
+			// Cut off the seek table, or whatever part of a block a crash left behind
+			filesystem::resize_file(_path, end);
+			_offset = end;
+		}
+
+		_file.open(_path, ios::binary | ios::app);
+		if (!_file) throw runtime_error("Unable to open UTK archive: " + _path);
+
+		if (!exists) {
+			fileHeader header{};
+			memcpy(header.magic, fileMagic, sizeof(fileMagic));
+			header.version = formatVersion;
+			header.blockBytes = static_cast<uint32_t>(_blockBytes);
+
+			writeBytes(reinterpret_cast<const char*>(&header), sizeof(header));
+		}
+	}
+
+	void writeBytes(const char* data, size_t size) {
+		if (!_file.write(data, static_cast<streamsize>(size))) throw runtime_error("Unable to write UTK archive: " + _path);
+		_offset += size;
+	}
+
+	/// Writes the oldest pending block, waiting for its compression if needed
+	void writeFront() {
+
+		pendingBlock pending = move(_pending.front());
+		_pending.pop_front();
+
+		const string frame = pending.frame.get();
+
+		archiveBlock block = pending.block;
+		block.offset = _offset;
+		block.storedBytes = static_cast<uint32_t>(frame.size() - sizeof(frameHeader));
+
+		writeBytes(frame.data(), frame.size());
+		_blocks.push_back(block);
+	}
+
+	/// Index of key in the open block's dictionary, adding it on first use
+	uint32_t keyIndex(const logEntry& entry, size_t i) {
+
+		if (!entry.keyIds.empty()) {
+			const KeyId id = entry.keyIds[i];
+			if (id < _internedIndex.size() && _internedIndex[id].generation == _generation) return _internedIndex[id].index;
+
+			const uint32_t index = keyIndex(entryKey(entry, i));
+			if (id < _internedIndex.size()) _internedIndex[id] = { _generation, index };
+			return index;
+		}
+
+		return keyIndex(entryKey(entry, i));
+	}
+
+	uint32_t keyIndex(string_view name) {
+
+		if (auto it = _keyIndex.find(name); it != _keyIndex.end()) return it->second;
+
+		const auto index = static_cast<uint32_t>(_keyNames.size());
+		_keyNames.emplace_back(name);
+		_keyIndex.emplace(_keyNames.back(), index);
+		return index;
+	}
+
+	/// Hands the open block to the executor to compress, then starts a new one
+	void seal() {
+
+		if (!_entries) return;
+
+		// The dictionary goes first so a reader can resolve keys as it streams the records
+		string raw;
+		raw.reserve(_records.size() + _keyNames.size() * 16 + 8);
+		appendVarint(raw, _keyNames.size());
+		for (const auto& name : _keyNames) {
+			appendVarint(raw, name.size());
+			raw.append(name);
+		}
+		raw.append(_records);
+
+		if (raw.size() > numeric_limits<uint32_t>::max()) throw runtime_error("UTK archive block is too large");
+
+		archiveBlock block{ 0, 0, static_cast<uint32_t>(raw.size()), _entries, _earliest, _latest };
+
+		auto frame = _executor.submit([raw = move(raw), block]() {
+
+			string compressed;
+			Codec::lzCompress(raw, compressed);
+
+			// Text that does not compress is stored as is, marked by the stored size equalling the raw size
+			const string& payload = compressed.size() < raw.size() ? compressed : raw;
+
+			frameHeader header{ frameMagic, static_cast<uint32_t>(payload.size()), block.rawBytes, block.entries,
+				block.earliest, block.latest, UTK::Hash::hash64(payload) };
+
+			string result;
+			result.reserve(sizeof(header) + payload.size());
+			result.append(reinterpret_cast<const char*>(&header), sizeof(header));
+			result.append(payload);
+			return result;
+		});
+		_pending.push_back({ move(frame), block });
+
+		_records.clear();
+		_keyNames.clear();
+		_keyIndex.clear();
+		_generation++;
+		_entries = 0;
+
+		// Bounds the memory held by blocks still compressing when the file cannot keep up
+		while (_pending.size() > _maxPending) writeFront();
+	}
+
+	/// Truncates the seek table written by close() so new blocks can follow the last one
+	void reopen() {
+
+		_file.close();
+		filesystem::resize_file(_path, _offset);
+
+		_file.open(_path, ios::binary | ios::app);
+		if (!_file) throw runtime_error("Unable to open UTK archive: " + _path);
+
+		_closed = false;
+	}
+
+public:
+	archiveSink(const string& path, const archiveOptions& options)
+		: _path(path),
+		  _blockBytes(clamp(options.blockBytes, minBlockBytes, maxBlockBytes)),
+		  _executor(options.executor ? *options.executor : taskExecutor::shared()),
+		  _maxPending(_executor.workerCount() + 2),
+		  _internedIndex(keyTable::capacity)
+	{
+		_records.reserve(_blockBytes + _blockBytes / 8);
+		open();
+	}
+
+	~archiveSink() {
+		try {
+			close();
+		}
+		catch (...) {
+			// Blocks already written stay readable, readers rebuild the seek table from the frames
+		}
+	}
+
+	void append(const logEntry& entry, int64_t timeStamp) {
+
+		if (_closed) reopen();
+
+		if (!_entries) {
+			_earliest = _latest = timeStamp;
+			_previous = 0;
+		}
+		_earliest = min(_earliest, timeStamp);
+		_latest = max(_latest, timeStamp);
+
+		// [time delta][lg][op][line][file][function][key count][key indexes][value count][values]
+		appendVarint(_records, zigzag(timeStamp - _previous));
+		_previous = timeStamp;
+
+		_records.push_back(static_cast<char>(entry.lg));
+		_records.push_back(static_cast<char>(entry.op));
+		appendVarint(_records, entry.fileLine ? zigzag(*entry.fileLine) + 1 : 0);
+		appendOptional(_records, entry.fileName);
+		appendOptional(_records, entry.funcName);
+
+		const size_t keyCount = entryKeyCount(entry);
+		appendVarint(_records, keyCount);
+		for (size_t i = 0; i < keyCount; i++) {
+			appendVarint(_records, keyIndex(entry, i));
+		}
+
+		appendVarint(_records, entry.formatValues.size());
+		for (const auto& value : entry.formatValues) {
+			appendVarint(_records, value.size());
+			_records.append(value);
+		}
+
+		_entries++;
+		if (_records.size() >= _blockBytes) seal();
+	}
+
+	void drain() {
+		while (!_pending.empty() && _pending.front().frame.ready()) writeFront();
+	}
+
+	void flush() {
+
+		if (_closed) return;
+
+		seal();
+		while (!_pending.empty()) writeFront();
+
+		if (!_file.flush()) throw runtime_error("Unable to write UTK archive: " + _path);
+	}
+
+	void close() {
+
+		if (_closed) return;
+
+		flush();
+
+		vector<tableEntry> table;
+		table.reserve(_blocks.size());
+		for (const auto& block : _blocks) {
+			table.push_back({ block.offset, block.storedBytes, block.rawBytes, block.entries, 0, block.earliest, block.latest });
+		}
+
+		fileFooter footer{ _offset, static_cast<uint32_t>(_blocks.size()), formatVersion, {} };
+		memcpy(footer.magic, footerMagic, sizeof(footerMagic));
+
+		// The table and footer are not counted in _offset, the next block overwrites them
+		const uint64_t tableOffset = _offset;
+		writeBytes(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(tableEntry));
+		writeBytes(reinterpret_cast<const char*>(&footer), sizeof(footer));
+		_offset = tableOffset;
+
+		if (!_file.flush()) throw runtime_error("Unable to write UTK archive: " + _path);
+		_closed = true;
+	}
+
+	const vector<archiveBlock>& blocks() const {
+		return _blocks;
+	}
+};
+
+//===================================================================================================================================
+//											     ARCHIVE SOURCE DEFINITION
+//===================================================================================================================================
+
+class UTK::Dispatch::Internal::archiveSource {
+private:
+	const string _path;
+	ifstream _file;
+	vector<archiveBlock> _blocks;
+	uint64_t _end = 0;				// Just past the last whole block, where refresh() looks for more
+	bool _complete = false;
+
+	int64_t _from = INT64_MIN;
+	int64_t _to = INT64_MAX;
+
+	// Streaming position: the next block to load, and what is left of the loaded one
+	size_t _nextBlock = 0;
+	blockDecoder _stream;
+
+	/// Forgets a torn block and every block after it, refresh() finds them again once they are whole
+	void tornAt(size_t index) {
+		_end = _blocks[index].offset;
+		_blocks.resize(index);
+		_complete = false;
+		_nextBlock = min(_nextBlock, index);
+		_stream.clear();
+	}
+
+	uint64_t fileSize() const {
+
+		error_code error;
+		const uintmax_t size = filesystem::file_size(_path, error);
+		if (error) throw runtime_error("Unable to open UTK archive: " + _path);
+
+		return size;
+	}
+
+public:
+	explicit archiveSource(const string& path) : _path(path), _file(path, ios::binary) {
+
+		if (!_file) throw runtime_error("Unable to open UTK archive: " + path);
+		_end = loadIndex(_file, fileSize(), _blocks, _complete);
+	}
+
+	const vector<archiveBlock>& blocks() const {
+		return _blocks;
+	}
+
+	bool complete() const {
+		return _complete;
+	}
+
+	size_t refresh() {
+
+		const uint64_t size = fileSize();
+		if (size < _end) throw runtime_error("UTK archive was truncated or replaced: " + _path);
+
+		const size_t before = _blocks.size();
+		_end = scanFrames(_file, _end, size, _blocks);
+
+		// A writer that reopened a closed archive has cut its seek table off
+		if (_blocks.size() != before) _complete = false;
+		return _blocks.size() - before;
+	}
+
+	void readBlock(size_t index, vector<archivedEntry>& out) {
+
+		if (index >= _blocks.size()) throw out_of_range("UTK archive has no block " + to_string(index));
+
+		blockDecoder decoder;
+		if (!decoder.load(_file, _blocks[index])) {
+			tornAt(index);
+			throw runtime_error("UTK archive block " + to_string(index) + " is torn");
+		}
+
+		out.reserve(out.size() + decoder.remaining());
+		while (decoder.remaining()) {
+			archivedEntry entry{};
+			decoder.decode(entry);
+			out.push_back(move(entry));
+		}
+	}
+
+	void seek(int64_t from, int64_t to) {
+		_from = from;
+		_to = to;
+		_nextBlock = 0;
+		_stream.clear();
+	}
+
+	bool next(archivedEntry& out) {
+
+		for (;;) {
+			while (_stream.remaining()) {
+				_stream.decode(out);
+				if (out.timeStamp >= _from && out.timeStamp <= _to) return true;
+			}
+
+			// Only blocks whose time span overlaps the range are read and decompressed
+			while (_nextBlock < _blocks.size() && (_blocks[_nextBlock].latest < _from || _blocks[_nextBlock].earliest > _to)) {
+				_nextBlock++;
+			}
+			if (_nextBlock == _blocks.size()) return false;
+
+			if (!_stream.load(_file, _blocks[_nextBlock])) {
+				tornAt(_nextBlock);
+				return false;
+			}
+			_nextBlock++;
+		}
+	}
+};
+
+//===================================================================================================================================
+//											    ARCHIVE WRITER METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+archiveWriter::archiveWriter(const string& path, const archiveOptions& options)
+	: _sink(make_unique<Internal::archiveSink>(path, options)) {}
+
+archiveWriter::~archiveWriter() = default;
+
+void archiveWriter::append(const logEntry& entry, int64_t timeStamp) {
+	_sink->append(entry, timeStamp);
+}
+
+void archiveWriter::drain() {
+	_sink->drain();
+}
+
+void archiveWriter::flush() {
+	_sink->flush();
+}
+
+void archiveWriter::close() {
+	_sink->close();
+}
+
+const vector<archiveBlock>& archiveWriter::blocks() const {
+	return _sink->blocks();
+}
+
+//===================================================================================================================================
+//											    ARCHIVE READER METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+archiveReader::archiveReader(const string& path) : _source(make_unique<Internal::archiveSource>(path)) {}
+
+archiveReader::~archiveReader() = default;
+
+const vector<archiveBlock>& archiveReader::blocks() const {
+	return _source->blocks();
+}
+
+bool archiveReader::complete() const {
+	return _source->complete();
+}
+
+void archiveReader::seek(int64_t from, int64_t to) {
+	_source->seek(from, to);
+}
+
+bool archiveReader::next(archivedEntry& out) {
+	return _source->next(out);
+}
+
+size_t archiveReader::refresh() {
+	return _source->refresh();
+}
+
+void archiveReader::readBlock(size_t index, vector<archivedEntry>& out) {
+	_source->readBlock(index, out);
+}
+
+vector<archivedEntry> archiveReader::range(int64_t from, int64_t to) {
+
+	seek(from, to);
+
+	vector<archivedEntry> result;
+	archivedEntry entry{};
+	while (next(entry)) {
+		result.push_back(move(entry));
+	}
+
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,472 @@
+//===================================================================================================================================
+// @file	utkcollector.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the shared-memory rings, the publisher registration and the
+//			collector used by utklogd.
+//===================================================================================================================================
+
+#include "dispatchers/utkcollector.hpp"
+#include "dispatchers/utkdispatch.hpp"
+#include "utkentrycodec.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cerrno>
+#include <atomic>
+#include <chrono>
+
+#if !defined(__WINDOWS__)
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#endif
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Dispatch;
+using namespace UTK::Dispatch::Codec;
+using namespace UTK::Types::LogEntry;
+
+//===================================================================================================================================
+//													   SHARED RING LAYOUT
+//===================================================================================================================================
+
+/// Control block at the start of the shared memory object, producer and consumer counters on separate cache lines
+struct ringControl {
+	uint64_t magic;
+	uint32_t version;
+	uint32_t slotCount;
+	alignas(64) uint64_t tail;		// Next position claimed by a publisher
+	alignas(64) uint64_t head;		// Next position read by the collector
+	alignas(64) uint64_t dropped;
+};
+
+static constexpr uint64_t sharedMagic = 0x3130474e52534b55;		// "UKSRNG01"
+static constexpr uint32_t sharedVersion = 1;
+static constexpr size_t controlSize = 256;
+
+/// Every ring a collectorClient creates is named prefix + pid + "." + index
+static constexpr string_view ringPrefix = "/utk."sv;
+
+static_assert(sizeof(ringControl) <= controlSize, "Ring control block must fit before the first slot");
+static_assert(atomic_ref<uint64_t>::is_always_lock_free, "Shared ring counters must be lock free across processes");
+
+//===================================================================================================================================
+//												  SHARED RING METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+#if defined(__WINDOWS__)
+
+sharedRing::sharedRing(string name, std::byte* base, size_t size, bool owner)
+	: _name(move(name)), _base(base), _size(size), _owner(owner) {}
+sharedRing::~sharedRing() = default;
+
+unique_ptr<sharedRing> sharedRing::create(const string&, uint32_t) {
+	throw runtime_error("Shared memory log collection is not supported on this platform");
+}
+unique_ptr<sharedRing> sharedRing::attach(const string&) {
+	throw runtime_error("Shared memory log collection is not supported on this platform");
+}
+bool sharedRing::publish(const logEntry&) noexcept { return false; }
+size_t sharedRing::drain(vector<collectedEntry>&, size_t) { return 0; }
+uint64_t sharedRing::dropped() const { return 0; }
+
+collectorClient::collectorClient(const string&, uint32_t) {
+	throw runtime_error("Shared memory log collection is not supported on this platform");
+}
+collectorClient::~collectorClient() = default;
+
+logCollector::logCollector(const string&, logDispatcher& dispatcher, int) : _dispatcher(dispatcher) {
+	throw runtime_error("Shared memory log collection is not supported on this platform");
+}
+logCollector::~logCollector() = default;
+size_t logCollector::poll(int) { return 0; }
+size_t logCollector::ringCount() const { return 0; }
+
+#else
+
+sharedRing::sharedRing(string name, std::byte* base, size_t size, bool owner)
+	: _name(move(name)), _base(base), _size(size), _owner(owner)
+{
+	_slotCount = reinterpret_cast<ringControl*>(_base)->slotCount;
+}
+
+sharedRing::~sharedRing() {
+
+	munmap(_base, _size);
+	if (_owner) shm_unlink(_name.c_str());
+}
+
+unique_ptr<sharedRing> sharedRing::create(const string& name, uint32_t slotCount) {
+
+	slotCount = max<uint32_t>(slotCount, 1);
+	const size_t size = controlSize + static_cast<size_t>(slotCount) * slotSize;
+
+	int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+	if (fd < 0) {
+		throw runtime_error("Failed to create shared ring: " + name);
+	}
+
+	if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+		close(fd);
+		shm_unlink(name.c_str());
+		throw runtime_error("Failed to size shared ring: " + name);
+	}
+
+	void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED) {
+		shm_unlink(name.c_str());
+		throw runtime_error("Failed to map shared ring: " + name);
+	}
+
+	auto* base = static_cast<std::byte*>(mapped);
+	auto* control = reinterpret_cast<ringControl*>(base);
+	control->version = sharedVersion;
+	control->slotCount = slotCount;
+
+	// Each slot starts out expecting the position it will first be claimed at
+	for (uint32_t i = 0; i < slotCount; i++) {
+		reinterpret_cast<recordSlot*>(base + controlSize)[i].sequence = i;
+	}
+
+	atomic_ref<uint64_t>(control->magic).store(sharedMagic, memory_order_release);
+
+	return unique_ptr<sharedRing>(new sharedRing(name, base, size, true));
+}
+
+unique_ptr<sharedRing> sharedRing::attach(const string& name) {
+
+	int fd = shm_open(name.c_str(), O_RDWR, 0);
+	if (fd < 0) {
+		throw runtime_error("Failed to open shared ring: " + name);
+	}
+
+	struct stat info{};
+	if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < controlSize) {
+		close(fd);
+		throw runtime_error("Invalid shared ring: " + name);
+	}
+
+	const size_t size = static_cast<size_t>(info.st_size);
+	void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED) {
+		throw runtime_error("Failed to map shared ring: " + name);
+	}
+
+	auto* base = static_cast<std::byte*>(mapped);
+	auto* control = reinterpret_cast<ringControl*>(base);
+
+	if (atomic_ref<uint64_t>(control->magic).load(memory_order_acquire) != sharedMagic ||
+		control->version != sharedVersion ||
+		controlSize + static_cast<size_t>(control->slotCount) * slotSize > size)
+	{
+		munmap(mapped, size);
+		throw runtime_error("Invalid shared ring: " + name);
+	}
+
+	return unique_ptr<sharedRing>(new sharedRing(name, base, size, false));
+}
+
+bool sharedRing::publish(const logEntry& entry) noexcept {
+
+	auto* control = reinterpret_cast<ringControl*>(_base);
+	auto* slots = reinterpret_cast<recordSlot*>(_base + controlSize);
+	atomic_ref<uint64_t> tail(control->tail);
+
+	uint64_t position = tail.load(memory_order_relaxed);
+	recordSlot* slot = nullptr;
+
+	// Claim a slot whose sequence matches the position, a lower sequence means the collector has not freed it yet
+	for (;;) {
+		slot = &slots[position % _slotCount];
+		const uint64_t sequence = atomic_ref<uint64_t>(slot->sequence).load(memory_order_acquire);
+		const auto difference = static_cast<int64_t>(sequence - position);
+
+		if (difference == 0) {
+			if (tail.compare_exchange_weak(position, position + 1, memory_order_relaxed)) break;
+		}
+		else if (difference < 0) {
+			atomic_ref<uint64_t>(control->dropped).fetch_add(1, memory_order_relaxed);
+			return false;
+		}
+		else {
+			position = tail.load(memory_order_relaxed);
+		}
+	}
+
+	encodeEntry(*slot, entry, duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+	atomic_ref<uint64_t>(slot->sequence).store(position + 1, memory_order_release);
+
+	return true;
+}
+
+size_t sharedRing::drain(vector<collectedEntry>& out, size_t maxEntries) {
+
+	auto* control = reinterpret_cast<ringControl*>(_base);
+	auto* slots = reinterpret_cast<recordSlot*>(_base + controlSize);
+	atomic_ref<uint64_t> head(control->head);
+
+	uint64_t position = head.load(memory_order_relaxed);
+	size_t count = 0;
+
+	while (count < maxEntries) {
+		recordSlot& slot = slots[position % _slotCount];
+		atomic_ref<uint64_t> sequence(slot.sequence);
+
+		if (sequence.load(memory_order_acquire) != position + 1) break;
+
+		out.push_back({ slot.timeStamp, decodeEntry(slot) });
+
+		// Hand the slot back to publishers for the next lap of the ring
+		sequence.store(position + _slotCount, memory_order_release);
+		position++;
+		count++;
+	}
+
+	head.store(position, memory_order_relaxed);
+	return count;
+}
+
+uint64_t sharedRing::dropped() const {
+	return atomic_ref<uint64_t>(reinterpret_cast<ringControl*>(_base)->dropped).load(memory_order_relaxed);
+}
+
+//===================================================================================================================================
+//												COLLECTOR CLIENT METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+static sockaddr_un makeSocketAddress(const string& socketPath) {
+
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+
+	if (socketPath.size() >= sizeof(address.sun_path)) {
+		throw runtime_error("Collector socket path is too long: " + socketPath);
+	}
+	memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+	return address;
+}
+
+collectorClient::collectorClient(const string& socketPath, uint32_t slotCount) {
+
+	static atomic<uint32_t> ringIndex{ 0 };
+	_ring = sharedRing::create(string(ringPrefix) + to_string(getpid()) + "." + to_string(ringIndex++), slotCount);
+
+	sockaddr_un address = makeSocketAddress(socketPath);
+
+	_socket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (_socket < 0 || connect(_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+		if (_socket >= 0) close(_socket);
+		throw runtime_error("Failed to connect to log collector: " + socketPath);
+	}
+
+	// Registration is a single line holding the ring name, the connection then stays open as a liveness signal
+	const string registration = _ring->name() + "\n";
+	if (send(_socket, registration.data(), registration.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(registration.size())) {
+		close(_socket);
+		throw runtime_error("Failed to register with log collector: " + socketPath);
+	}
+}
+
+collectorClient::~collectorClient() {
+	if (_socket >= 0) close(_socket);
+}
+
+//===================================================================================================================================
+//												  LOG COLLECTOR METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+/// True if name is a ring a collectorClient in the process on the other end of fd would have created. The
+/// collector unlinks the rings it releases, so a client must not be able to name any other shared memory object.
+static bool isClientRing(const string& name, int fd) {
+
+	if (name.compare(0, ringPrefix.size(), ringPrefix) != 0) return false;
+
+	const char* first = name.data() + ringPrefix.size();
+	const char* last = name.data() + name.size();
+
+	pid_t pid = 0;
+	auto [dot, pidError] = from_chars(first, last, pid);
+	if (pidError != errc{} || dot == first || dot == last || *dot != '.') return false;
+
+	uint32_t index = 0;
+	auto [end, indexError] = from_chars(dot + 1, last, index);
+	if (indexError != errc{} || end == dot + 1 || end != last) return false;
+
+#if defined(__LINUX__)
+	// The pid in the name has to be the process that registered it
+	ucred peer{};
+	socklen_t length = sizeof(peer);
+	if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &peer, &length) != 0 || peer.pid != pid) return false;
+#else
+	(void)fd;
+#endif
+
+	return true;
+}
+
+logCollector::logCollector(const string& socketPath, logDispatcher& dispatcher, int reorderWindowMs)
+	: _socketPath(socketPath), _dispatcher(dispatcher), _reorderWindow(static_cast<int64_t>(max(reorderWindowMs, 0)) * 1'000'000)
+{
+	sockaddr_un address = makeSocketAddress(socketPath);
+
+	_listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (_listener < 0) {
+		throw runtime_error("Failed to create collector socket");
+	}
+
+	unlink(socketPath.c_str());
+	if (::bind(_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(_listener, 64) != 0) {
+		close(_listener);
+		throw runtime_error("Failed to listen on collector socket: " + socketPath);
+	}
+}
+
+logCollector::~logCollector() {
+
+	// Drain whatever the remaining publishers left behind before letting go of their rings
+	_batch.clear();
+	while (!_clients.empty()) {
+		releaseClient(_clients.begin()->first);
+	}
+	dispatchBatch(true);
+
+	close(_listener);
+	unlink(_socketPath.c_str());
+}
+
+void logCollector::acceptClients() {
+
+	for (;;) {
+		int fd = accept4(_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0) return;
+
+		_clients.emplace(fd, registration{});
+	}
+}
+
+bool logCollector::readRegistration(int fd, registration& client) {
+
+	char buffer[256];
+
+	for (;;) {
+		ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+
+		if (received == 0) return false;					// Publisher exited or closed its dispatcher
+		if (received < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+
+		// Anything after the registration line is ignored, the socket only signals liveness
+		if (client.ring) continue;
+
+		client.pending.append(buffer, static_cast<size_t>(received));
+		auto end = client.pending.find('\n');
+		if (end == string::npos) {
+			if (client.pending.size() > 255) return false;
+			continue;
+		}
+
+		const string name = client.pending.substr(0, end);
+		if (!isClientRing(name, fd)) return false;
+
+		try {
+			client.ring = sharedRing::attach(name);
+		}
+		catch (const std::exception&) {
+			return false;
+		}
+		client.pending.clear();
+	}
+}
+
+void logCollector::releaseClient(int fd) {
+
+	auto it = _clients.find(fd);
+	if (it == _clients.end()) return;
+
+	if (it->second.ring) {
+		it->second.ring->drain(_batch);
+		shm_unlink(it->second.ring->name().c_str());	// The publisher may have crashed without unlinking
+	}
+
+	close(fd);
+	_clients.erase(it);
+}
+
+size_t logCollector::dispatchBatch(bool everything) {
+
+	auto earlier = [](const collectedEntry& a, const collectedEntry& b) { return a.timeStamp < b.timeStamp; };
+
+	// Each ring is already in order, a stable sort merges them into one timeline. Held entries were
+	// collected first, so merging the batch in after them keeps equal stamps in collection order.
+	stable_sort(_batch.begin(), _batch.end(), earlier);
+
+	const auto heldCount = static_cast<ptrdiff_t>(_held.size());
+	_held.insert(_held.end(), make_move_iterator(_batch.begin()), make_move_iterator(_batch.end()));
+	inplace_merge(_held.begin(), _held.begin() + heldCount, _held.end(), earlier);
+	_batch.clear();
+
+	// Entries younger than the window stay behind, a slower ring may still hand over something stamped before them
+	auto ready = _held.end();
+	if (!everything && _reorderWindow > 0) {
+		const int64_t cutoff = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count() - _reorderWindow;
+		ready = partition_point(_held.begin(), _held.end(), [cutoff](const collectedEntry& held) { return held.timeStamp <= cutoff; });
+	}
+
+	for (auto it = _held.begin(); it != ready; ++it) {
+		_dispatcher.pushEntry(move(it->entry));
+	}
+
+	const auto dispatched = static_cast<size_t>(ready - _held.begin());
+	_held.erase(_held.begin(), ready);
+	if (dispatched > 0) _dispatcher.dispatchLogs();
+
+	return dispatched;
+}
+
+size_t logCollector::poll(int timeoutMs) {
+
+	vector<pollfd> fds;
+	fds.reserve(_clients.size() + 1);
+	fds.push_back({ _listener, POLLIN, 0 });
+	for (const auto& [fd, client] : _clients) {
+		fds.push_back({ fd, POLLIN, 0 });
+	}
+
+	::poll(fds.data(), fds.size(), timeoutMs);
+
+	if (fds[0].revents & POLLIN) acceptClients();
+
+	_batch.clear();
+
+	for (size_t i = 1; i < fds.size(); i++) {
+		if (!fds[i].revents) continue;
+
+		auto it = _clients.find(fds[i].fd);
+		if (it != _clients.end() && !readRegistration(fds[i].fd, it->second)) {
+			releaseClient(fds[i].fd);
+		}
+	}
+
+	for (auto& [fd, client] : _clients) {
+		if (client.ring) client.ring->drain(_batch);
+	}
+
+	return dispatchBatch();
+}
+
+size_t logCollector::ringCount() const {
+	return static_cast<size_t>(count_if(_clients.begin(), _clients.end(),
+		[](const auto& client) { return client.second.ring != nullptr; }));
+}
+
+#endif
\ No newline at end of file
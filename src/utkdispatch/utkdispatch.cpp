@@ -8,16 +8,21 @@
 //===================================================================================================================================
 
 #include "dispatchers/utkdispatch.hpp"
-#include <unordered_map>
-#include <filesystem>
+#include "core/utkconsole.hpp"
+#include <condition_variable>
+#include <algorithm>
 #include <iostream>
-#include <sstream>
 #include <fstream>
+#include <charconv>
+#include <optional>
 #include <numeric>
-#include <format>
 #include <memory>
 #include <chrono>
+#include <thread>
+#include <array>
 #include <ctime>
+#include <span>
+#include <bit>
 
 using namespace std;
 using namespace chrono;
@@ -27,34 +32,24 @@ using namespace UTK::Types::Metadata;
 using namespace UTK::Types::LogEntry;
 
 using StringVector = vector<string>;
-using OperationsMap = unordered_map<Operations, string_view>;
 
 //===================================================================================================================================
 //											        HELPER FUNCTIONS & UTILITIES
 //===================================================================================================================================
 
-static const string_view getOpsToSuffix(const Operations& opKey) {
-
-	/// Local map that only gets instantiated once between calls
-	static const OperationsMap opsToSuffix {
-		{ Operations::LG_RD,  "[READ]"sv },
-		{ Operations::LG_WR,  "[WRITE]"sv },
-		{ Operations::LG_IN,  "[LOGIN]"sv },
-		{ Operations::LG_ERR, "[ERROR]"sv },
-		{ Operations::LG_OUT, "[LOGOUT]"sv },
-		{ Operations::LG_IDL, "[IDLE]"sv },
-		{ Operations::LG_MSG, "[MESSAGE]"sv },
-		{ Operations::LG_NOP, ""sv }
-	};
-	
-	/// Check if operation is present in map
-	auto it = opsToSuffix.find(opKey);
-	if (it != opsToSuffix.end()) {
-		return it->second;
-	}
-	
-	return "[UNKNOWN]"sv;
-}
+/// File the ARCHIVE sink writes to unless logDispatcher::enableArchive picks another
+static constexpr string_view defaultArchivePath = "utk.archive"sv;
+
+/// Route tables are numbered across every dispatcher, so a thread's cache can tell them apart by version alone
+static atomic<uint64_t> nextRoutesVersion{ 1 };
+
+struct heldRoutes {
+	uint64_t version = 0;
+	shared_ptr<const routeTable> pinned;
+};
+
+/// Route tables this thread has read, most recently used first. A replaced table lives until no thread holds it here.
+static thread_local array<heldRoutes, 4> routesCache;
 
 //===================================================================================================================================
 //													  STANDARD LOGGER INTEFACE 
@@ -66,6 +61,16 @@ public:
 	virtual void createLog(logEntry& entry) = 0;
 	virtual ~IKeyValueLogger() = default;
 
+	/// Writes a batch of entries, loggers that can coalesce their output should override this
+	virtual void createLogs(span<logEntry> entries) {
+		for (auto& entry : entries) {
+			createLog(entry);
+		}
+	}
+
+	/// Pushes anything the logger is still holding on to out to its destination
+	virtual void flush() {}
+
 protected:
 	virtual string getTimeStamp() const {
 		return "";
@@ -79,86 +84,139 @@ protected:
 class terminalLogger : public IKeyValueLogger {
 
 private:
-	string _prefix;
-	string _suffix;
-	const int _fixedPrefixWidth = 60;
+	using ColourTable = array<string_view, static_cast<size_t>(Operations::LG_NOP) + 1>;
+
+	string _buffer;
+	const size_t _fixedPrefixWidth = 60;
+	const bool _colour = UTK::Core::Internal::stdoutIsTerminal();
+
+	/// ANSI colour applied to the operation tag, indexed by Operations
+	static constexpr ColourTable _opColours {
+		"\x1b[34m"sv,	// LG_WR
+		"\x1b[36m"sv,	// LG_RD
+		"\x1b[32m"sv,	// LG_IN
+		"\x1b[35m"sv,	// LG_OUT
+		"\x1b[90m"sv,	// LG_IDL
+		"\x1b[31m"sv,	// LG_ERR
+		"\x1b[37m"sv,	// LG_MSG
+		""sv			// LG_NOP
+	};
+	static constexpr string_view _colourReset = "\x1b[0m"sv;
 
 	string getTimeStamp() const override {
 
 		/// Acquire current time point
 		time_t now_t{ system_clock::to_time_t(system_clock::now()) };
 
-		/// Convert to local time(Windows version, because it forces you to use _s equivalent...)
+		/// Convert to local time(Windows forces you to use the _s equivalent...)
 		tm tt;
+#if defined(__WINDOWS__)
 		localtime_s(&tt, &now_t);
+#else
+		localtime_r(&now_t, &tt);
+#endif
 
 		/// Convert time to string
-		stringstream ss;
-		ss << put_time(&tt, "%d/%m/%Y %H:%M:%S");
+		char stamp[32];
+		size_t length = strftime(stamp, sizeof(stamp), "%d/%m/%Y %H:%M:%S", &tt);
 
-		return ss.str();
+		return string(stamp, length);
 	};
 
 	// TO-DO: Possibly refactor this function when the schema side of things is completed
-	string joinFormatData(const StringVector& Keys, const StringVector& Values) {
-		
-		/// Reserve memory to prevent constant reinitializations in lambda
-		string infoString;
-		infoString.reserve(300);
+	void joinFormatData(const logEntry& entry) {
+
+		const StringVector& Values = entry.formatValues;
 
 		/// Lambda to format the info string 
-		auto append_fn = [&infoString](string_view f, string_view d) {
-			if (!f.empty()) infoString.append(f).append(" ");
-			if (!d.empty()) infoString.append(d).append(" ");
+		auto append_fn = [this](string_view f, string_view d) {
+			if (!f.empty()) _buffer.append(f).append(" ");
+			if (!d.empty()) _buffer.append(d).append(" ");
 			};
 
 		/// Combine format and Values args together & account for differing lengths
-		size_t max_size = max(Keys.size(), Values.size());
+		size_t max_size = max(entryKeyCount(entry), Values.size());
+		size_t start = _buffer.size();
 
 		for (size_t i = 0; i < max_size; i++) {
-			string_view _format = (i < Keys.size()) ? string_view(Keys[i]) : string_view{};
+			string_view _format = entryKey(entry, i);
 			string_view _Values = (i < Values.size()) ? string_view(Values[i]) : string_view{};
 
 			append_fn(_format, _Values);
 		}
 
-		/// Cleanup final character and optimize memory from prior reservation
-		if (!infoString.empty()) infoString.pop_back();
-		//string(infoString).swap(infoString);		// UNECESSARY: Modern compilers will use NVRO/move schemantics
+		/// Cleanup final separator appended by this entry
+		if (_buffer.size() > start) _buffer.pop_back();
+	}
+	void appendPrefix(string_view timeStamp, string_view fileName, int fileLine, string_view funcName) {
 
-		return infoString;
+		size_t start = _buffer.size();
+
+		char line[16];
+		auto [end, ec] = to_chars(begin(line), std::end(line), fileLine);
+
+		_buffer.append(timeStamp).append(" ").append(fileName).append(":");
+		_buffer.append(line, end).append(":").append(funcName);
+
+		/// Pad the prefix in place so every suffix lines up
+		size_t width = _buffer.size() - start;
+		if (width < _fixedPrefixWidth) _buffer.append(_fixedPrefixWidth - width, ' ');
 	}
-	void generatePrefix(string_view fileName, int fileLine, string_view funcName) {
+	void appendSuffix(const logEntry& entry) {
+
+		string_view tag = operationTag(entry.op);
+		size_t index = static_cast<size_t>(entry.op);
+
+		if (_colour && !tag.empty() && index < _opColours.size() && !_opColours[index].empty()) {
+			_buffer.append(_opColours[index]).append(tag).append(_colourReset);
+		}
+		else {
+			_buffer.append(tag);
+		}
+
+		_buffer.append(" ");
+		joinFormatData(entry);
+	}
+	void appendEntry(const logEntry& entry, string_view timeStamp) {
+
+		string_view file = entry.fileName ? string_view(*entry.fileName) : "<unknown_file>"sv;
+		string_view func = entry.funcName ? string_view(*entry.funcName) : "<unknown_func>"sv;
+		int line = entry.fileLine.value_or(-1);
+
+		// Shorten file path to just be file name
+		if (auto pos = file.find_last_of("/\\"); pos != string_view::npos) {
+			file.remove_prefix(pos + 1);
+		}
 
-		_prefix = format("{} {}:{}:{}", getTimeStamp(), fileName, fileLine, funcName);
+		appendPrefix(timeStamp, file, line, func);
+		_buffer.append(" ");
+		appendSuffix(entry);
+		_buffer.append("\n");
 	}
-	void generateSuffix(Operations op, const StringVector& Keys, const StringVector& Values) {
 
-		_suffix = format("{} {}", getOpsToSuffix(op), joinFormatData(Keys, Values));
+	/// Hands the whole buffer to the OS directly, bypassing iostream synchronization. A non-blocking
+	/// stdout that fills up is waited on, the batch is only lost if the write itself fails
+	void writeBuffer() {
+		UTK::Core::Internal::writeStdout(_buffer.data(), _buffer.size());
 	}
 
 public:
 
 	void createLog(logEntry& entry) noexcept override {
-		try {
-			auto file = entry.fileName.value_or("<unknown_file>");
-			auto func = entry.funcName.value_or("<unknown_func>");
-			auto line = entry.fileLine.value_or(-1);
-
-			// Shorten file path to just be file name
-			file = filesystem::path(file).filename().string();
+		createLogs(span<logEntry>(&entry, 1));
+	}
 
-			// These methods create the string for the prefix and suffix members
-			generatePrefix(file, line, func);
-			generateSuffix(entry.op, entry.formatKeys, entry.formatValues);
+	void createLogs(span<logEntry> entries) noexcept override {
+		try {
+			// One timestamp, one buffer and one syscall for the whole batch
+			const string timeStamp = getTimeStamp();
 
-			/// Print only the suffix if no prefix, or print the aligned prefix and suffix
-			if (_prefix.empty()) {
-				cout << _suffix << "\n";
-			}
-			else {
-				cout << format("{:<{}} {}", _prefix, _fixedPrefixWidth, _suffix) << "\n";
+			_buffer.clear();
+			for (const auto& entry : entries) {
+				appendEntry(entry, timeStamp);
 			}
+
+			writeBuffer();
 		}
 		catch (const std::exception& e) {
 			cerr << "[Terminal Logger Error] " << e.what() << "\n";
@@ -251,6 +309,50 @@ public:
 	csvLogger& operator=(const csvLogger&) = delete;
 };
 
+class archiveLogger : public IKeyValueLogger {
+
+private:
+	archiveWriter _writer;
+
+	static int64_t now() {
+		return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+	}
+
+public:
+	archiveLogger(const string& path, const archiveOptions& options) : _writer(path, options) {}
+
+	void createLog(logEntry& entry) override {
+		createLogs(span<logEntry>(&entry, 1));
+	}
+
+	/// One timestamp covers the batch, entries in a batch were dispatched together
+	void createLogs(span<logEntry> entries) override {
+
+		try {
+			const int64_t stamp = now();
+			for (const auto& entry : entries) {
+				_writer.append(entry, stamp);
+			}
+
+			// Compression runs on the executor, only write out the blocks that are already done
+			_writer.drain();
+		}
+		catch (const exception& e) {
+			cerr << "[Archive Logger Error] " << e.what() << "\n";
+		}
+	}
+
+	void flush() override {
+
+		try {
+			_writer.flush();
+		}
+		catch (const exception& e) {
+			cerr << "[Archive Logger Error] " << e.what() << "\n";
+		}
+	}
+};
+
 //===================================================================================================================================
 //													 LOGGER FACTORY DEFINITION
 //===================================================================================================================================
@@ -268,42 +370,308 @@ public:
 				//return make_unqiue<jsonLogger>();
 			case Logger::CSV:
 				return make_unique<csvLogger>();
+			case Logger::ARCHIVE:
+				return make_unique<archiveLogger>(string(defaultArchivePath), archiveOptions{});
 			case Logger::TERMINAL:
 			default:
 				return make_unique<terminalLogger>();
 				break;
 		}
 	}
+
+	static unique_ptr<IKeyValueLogger> getArchiveLogger(const string& path, const archiveOptions& options) {
+		return make_unique<archiveLogger>(path, options);
+	}
 };
 
 //===================================================================================================================================
-//													 LOG CONTROLLER DEFINITION
+//													   SINK WORKER DEFINITION
 //===================================================================================================================================
 
-class logController {
+class sinkWorker {
 private:
-	using LoggerCache = unordered_map<Logger, unique_ptr<IKeyValueLogger>>;
+	using EntryQueue = vector<logEntry>;
+
+	const Logger _lgType;
+	size_t _capacity;				// Capacity and policy are guarded by _mutex so they can be reconfigured live
+	Backpressure _policy;
+	unique_ptr<IKeyValueLogger> _logger;
+
+	mutable mutex _mutex;
+	condition_variable _ready;		// Signalled when entries arrive or the worker should stop
+	condition_variable _drained;	// Signalled when the worker frees queue space or goes idle
+	EntryQueue _queue;
+	size_t _inFlight = 0;			// Taken off the queue but not yet written, still counted against the capacity
+	bool _busy = false;
+	bool _stopping = false;
+	bool _flushRequested = false;	// Set by flush() so the worker flushes the logger itself
+
+	uint64_t _enqueued = 0;
+	uint64_t _written = 0;
+	uint64_t _dropped = 0;
+	size_t _highWater = 0;
+
+	thread _worker;
+
+	/// Entries written between releasing queue space, so producers blocked on a full queue resume mid batch
+	static constexpr size_t writeSlice = 256;
+
+	size_t pending() const {
+		return _queue.size() + _inFlight;
+	}
 
-	LoggerCache cache;
-	IKeyValueLogger& getLogger(Logger lgType) {
-		
-		auto lg = cache.find(lgType);
-		if (lg != cache.end()) {
-			return *(lg->second);
+	void run() {
+
+		EntryQueue batch;
+
+		for (;;) {
+			bool flushing = false;
+			{
+				unique_lock<mutex> lock(_mutex);
+				_ready.wait(lock, [this] { return _stopping || _flushRequested || !_queue.empty(); });
+
+				if (_queue.empty() && !_flushRequested) return;		// Only reached once stopping and fully drained
+
+				swap(batch, _queue);
+				swap(flushing, _flushRequested);
+				_inFlight = batch.size();
+				_busy = true;
+			}
+
+			// Logger output happens outside the lock so producers are never held by a slow sink
+			for (size_t start = 0; start < batch.size(); start += writeSlice) {
+				const size_t count = min(writeSlice, batch.size() - start);
+				_logger->createLogs(span<logEntry>(batch).subspan(start, count));
+
+				{
+					lock_guard<mutex> lock(_mutex);
+					_written += count;
+					_inFlight -= count;
+				}
+				_drained.notify_all();
+			}
+			if (flushing) _logger->flush();
+
+			{
+				lock_guard<mutex> lock(_mutex);
+				_busy = false;
+			}
+			_drained.notify_all();
+			batch.clear();
+		}
+	}
+
+public:
+	sinkWorker(Logger lgType, unique_ptr<IKeyValueLogger> logger, size_t capacity, Backpressure policy)
+		: _lgType(lgType), _capacity(max<size_t>(capacity, 1)), _policy(policy), _logger(move(logger))
+	{
+		_worker = thread(&sinkWorker::run, this);
+	}
+	~sinkWorker() {
+		{
+			lock_guard<mutex> lock(_mutex);
+			_stopping = true;
+		}
+		_ready.notify_one();
+		_drained.notify_all();
+
+		if (_worker.joinable()) _worker.join();
+	}
+
+	sinkWorker(const sinkWorker&) = delete;
+	sinkWorker& operator=(const sinkWorker&) = delete;
+
+	/**
+	 * Moves entries from batch[next] onwards onto the sink queue, applying the backpressure policy when full.
+	 * A full BLOCK sink waits at most wait for space, then returns with the rest left for the caller to retry.
+	 *
+	 * @return True once the whole batch has been queued or dropped.
+	 */
+	bool enqueue(vector<logEntry>& batch, size_t& next, milliseconds wait) {
+
+		while (next < batch.size()) {
+			{
+				unique_lock<mutex> lock(_mutex);
+
+				// The policy is part of the predicate, so a sink reconfigured to DROP releases its waiters at once
+				if (_policy == Backpressure::BLOCK
+					&& !_drained.wait_for(lock, wait, [this] { return _stopping || _policy != Backpressure::BLOCK || pending() < _capacity; }))
+				{
+					return false;
+				}
+
+				size_t space = (pending() < _capacity) ? _capacity - pending() : 0;
+				size_t count = min(space, batch.size() - next);
+
+				for (size_t i = 0; i < count; i++, next++) {
+					_queue.push_back(move(batch[next]));
+				}
+				_enqueued += count;
+				_highWater = max(_highWater, pending());
+
+				if (_policy == Backpressure::DROP || _stopping) {
+					_dropped += batch.size() - next;
+					next = batch.size();
+				}
+			}
+			_ready.notify_one();
+		}
+
+		return true;
+	}
+
+	/// Applies a new queue bound and policy, producers blocked on the old bound wake to re-check against both
+	void reconfigure(size_t capacity, Backpressure policy) {
+		{
+			lock_guard<mutex> lock(_mutex);
+			_capacity = max<size_t>(capacity, 1);
+			_policy = policy;
 		}
+		_drained.notify_all();
+	}
+
+	/// Waits for the worker to finish writing everything queued so far and flush its logger
+	void flush() {
+		{
+			lock_guard<mutex> lock(_mutex);
+			if (_stopping) return;
+			_flushRequested = true;
+		}
+		_ready.notify_one();
+
+		unique_lock<mutex> lock(_mutex);
+		_drained.wait(lock, [this] { return _stopping || (_queue.empty() && !_busy && !_flushRequested); });
+	}
+
+	sinkStats stats() const {
+		lock_guard<mutex> lock(_mutex);
+		return { _lgType, _enqueued, _written, _dropped, pending(), _highWater };
+	}
+};
 
-		// Lazy init to create a logger instance and store in the cache for future lookup
-		auto logger = lgFactory::getLogger(lgType);
-		IKeyValueLogger& ref = *logger;
-		cache.emplace(lgType, move(logger));
+//===================================================================================================================================
+//													 LOG CONTROLLER DEFINITION
+//===================================================================================================================================
 
-		return ref;
+class UTK::Dispatch::logController {
+private:
+	using SinkCache = array<unique_ptr<sinkWorker>, loggerCount>;
+	using SinkBatches = array<vector<logEntry>, loggerCount>;
+	using SinkConfigs = array<optional<pair<size_t, Backpressure>>, loggerCount>;
+
+	const size_t _capacity;
+	const Backpressure _policy;
+	mutable mutex _mutex;
+	SinkCache cache;
+	SinkConfigs _configs;		// Per sink overrides of the capacity and policy given at construction
+
+	sinkWorker& getSink(size_t index) {
+
+		auto& sink = cache[index];
+		if (sink) return *sink;
+
+		// Lazy init to create a logger and its worker, then store in the cache for future lookup
+		const Logger lgType = static_cast<Logger>(index);
+		auto [capacity, policy] = _configs[index].value_or(pair(_capacity, _policy));
+
+		sink = make_unique<sinkWorker>(lgType, lgFactory::getLogger(lgType), capacity, policy);
+		return *sink;
+	}
+
+	/// Sinks are never destroyed before the controller, so the pointers stay valid once the lock is released
+	vector<sinkWorker*> activeSinks() const {
+
+		lock_guard<mutex> lock(_mutex);
+
+		vector<sinkWorker*> sinks;
+		for (const auto& sink : cache) {
+			if (sink) sinks.push_back(sink.get());
+		}
+		return sinks;
 	}
 
 public:
-	void logEntry(logEntry&& entry) {
-		IKeyValueLogger& lg = getLogger(entry.lg);
-		lg.createLog(entry);
+	logController(size_t capacity, Backpressure policy) : _capacity(capacity), _policy(policy) {}
+
+	/// Groups the entries by sink so each sink queue is only locked once per dispatch
+	void logEntries(vector<logEntry>&& entries, const vector<sinkMask>& routes) {
+
+		SinkBatches batches;
+		for (size_t i = 0; i < entries.size(); i++) {
+
+			// Every sink but the last gets a copy, the last takes the entry itself
+			for (sinkMask sinks = routes[i]; sinks; ) {
+				const auto index = static_cast<size_t>(countr_zero(sinks));
+				sinks &= sinks - 1;
+
+				if (sinks) batches[index].push_back(entries[i]);
+				else batches[index].push_back(move(entries[i]));
+			}
+		}
+
+		// The lock only covers finding the sinks, enqueueing may block and must not hold up configure() or stats()
+		array<sinkWorker*, loggerCount> sinks{};
+		{
+			lock_guard<mutex> lock(_mutex);
+			for (size_t index = 0; index < batches.size(); index++) {
+				if (!batches[index].empty()) sinks[index] = &getSink(index);
+			}
+		}
+
+		// Sinks are offered their entries in turns, waiting only briefly on a full BLOCK sink before moving to the
+		// next, so a stalled sink holds back its own entries and not those of the sinks after it
+		array<size_t, loggerCount> next{};
+		for (milliseconds wait{ 0 };; wait = milliseconds(1)) {
+			bool waiting = false;
+
+			for (size_t index = 0; index < sinks.size(); index++) {
+				if (!sinks[index]) continue;
+
+				if (sinks[index]->enqueue(batches[index], next[index], wait)) sinks[index] = nullptr;
+				else waiting = true;
+			}
+
+			if (!waiting) return;
+		}
+	}
+
+	/// Starts the archive sink on a chosen file, in place of the default one getSink would open
+	void enableArchive(const string& path, const archiveOptions& options) {
+
+		const size_t index = static_cast<size_t>(Logger::ARCHIVE);
+
+		lock_guard<mutex> lock(_mutex);
+		if (cache[index]) throw runtime_error("Archive sink has already started");
+
+		auto [capacity, policy] = _configs[index].value_or(pair(_capacity, _policy));
+		cache[index] = make_unique<sinkWorker>(Logger::ARCHIVE, lgFactory::getArchiveLogger(path, options), capacity, policy);
+	}
+
+	void configure(Logger lgType, size_t capacity, Backpressure policy) {
+
+		const size_t index = static_cast<size_t>(lgType);
+		if (index >= loggerCount) return;
+
+		lock_guard<mutex> lock(_mutex);
+		_configs[index] = pair(capacity, policy);
+
+		if (cache[index]) cache[index]->reconfigure(capacity, policy);
+	}
+
+	void flush() {
+		for (sinkWorker* sink : activeSinks()) {
+			sink->flush();
+		}
+	}
+
+	vector<sinkStats> stats() const {
+
+		vector<sinkStats> result;
+		for (const sinkWorker* sink : activeSinks()) {
+			result.push_back(sink->stats());
+		}
+
+		return result;
 	}
 };
 
@@ -311,16 +679,152 @@ public:
 //												  DISPATCHER METHOD IMPLEMENTATIONS
 //===================================================================================================================================
 
+logDispatcher::logDispatcher(size_t sinkCapacity, Backpressure policy)
+	: _controller(make_unique<logController>(sinkCapacity, policy))
+{
+	for (auto& filter : _operationFilters) {
+		filter.store(UINT32_MAX, memory_order_relaxed);
+	}
+}
+
+// Destroying the controller joins each sink worker once its queue has been written out
+logDispatcher::~logDispatcher() = default;
+
+sinkMask logDispatcher::enabledSinks(Operations op) const noexcept {
+
+	sinkMask sinks = 0;
+	for (size_t sink = 0; sink < _operationFilters.size(); sink++) {
+		if (_operationFilters[sink].load(memory_order_relaxed) & (1u << static_cast<uint32_t>(op))) sinks |= sinkMask(1) << sink;
+	}
+	return sinks;
+}
+
+const routeTable* logDispatcher::currentRoutes() const {
+
+	const uint64_t version = _routesVersion.load(memory_order_acquire);
+	if (!version) return nullptr;
+	if (routesCache[0].version == version) return routesCache[0].pinned.get();
+
+	// Another dispatcher's table may sit at the front, look further back before pinning a new one
+	auto held = find_if(routesCache.begin() + 1, routesCache.end(), [version](const heldRoutes& entry) {
+		return entry.version == version;
+	});
+
+	if (held == routesCache.end()) {
+		held = routesCache.end() - 1;
+
+		lock_guard<mutex> lock(_routeMutex);
+		held->pinned = _routes;
+		held->version = _routesVersion.load(memory_order_relaxed);
+	}
+
+	rotate(routesCache.begin(), held, held + 1);
+	return routesCache[0].pinned.get();
+}
+
+sinkMask logDispatcher::sinksFor(const logEntry& entry) const noexcept {
+
+	const routeTable* routes = currentRoutes();
+	const sinkMask sinks = routes ? routes->route(entry) : sinkBit(entry.lg);
+	return sinks & enabledSinks(entry.op);
+}
+
+bool logDispatcher::isEnabled(Logger lg, Operations op) const {
+
+	const size_t sink = static_cast<size_t>(lg);
+	if (sink >= _operationFilters.size()) return true;
+
+	// Without routes only the producer's sink matters, a single filter load
+	const routeTable* routes = currentRoutes();
+	if (!routes) return _operationFilters[sink].load(memory_order_relaxed) & (1u << static_cast<uint32_t>(op));
+
+	return (routes->reachable(lg, op) & enabledSinks(op)) != 0;
+}
+
+bool logDispatcher::admit(logEntry& entry) {
+
+	// Filtered operations are discarded before they cost a recorder slot or a queue push
+	if (!isEnabled(entry.lg, entry.op)) return false;
+
+	// Recorded before queueing so the entry survives even if the process dies before dispatch
+	if (_recorder) _recorder->record(entry);
+
+	// Entries owned by the collector never touch the local queue or sinks
+	if (_publisher) {
+		_publisher->publish(entry);
+		return false;
+	}
+
+	return true;
+}
+
 void logDispatcher::pushEntry(logEntry entry) {
 
+	if (!admit(entry)) return;
+
+	lock_guard<mutex> lock(_mutex);
+	_logQueue.push(move(entry));
+}
+
+void logDispatcher::pushEntries(vector<logEntry> entries) {
+
+	// Compact the entries that survive admission so the lock only covers the moves onto the queue
+	size_t kept = 0;
+	for (size_t i = 0; i < entries.size(); i++) {
+		if (!admit(entries[i])) continue;
+		if (kept != i) entries[kept] = move(entries[i]);
+		kept++;
+	}
+	if (!kept) return;
+
 	lock_guard<mutex> lock(_mutex);
-	_logQueue.push(entry);
+	for (size_t i = 0; i < kept; i++) {
+		_logQueue.push(move(entries[i]));
+	}
+}
+
+void logDispatcher::enableFlightRecorder(const string& path, uint32_t slotCount) {
+
+	_recorder = make_unique<flightRecorder>(path, slotCount);
+	flightRecorder::installCrashHandlers();
+}
+
+void logDispatcher::enableCollector(const string& socketPath, uint32_t slotCount) {
+	_publisher = make_unique<collectorClient>(socketPath, slotCount);
+}
+
+void logDispatcher::enableArchive(const string& path, const archiveOptions& options) {
+	_controller->enableArchive(path, options);
+}
+
+void logDispatcher::setOperationFilter(Logger lg, const vector<Operations>& enabled) {
+
+	uint32_t mask = 0;
+	for (Operations op : enabled) {
+		mask |= 1u << static_cast<uint32_t>(op);
+	}
+
+	const size_t sink = static_cast<size_t>(lg);
+	if (sink < _operationFilters.size()) _operationFilters[sink].store(mask, memory_order_relaxed);
+}
+
+void logDispatcher::setRoutes(const vector<routeRule>& rules) {
+
+	// Compiled before taking the lock, routeTable throws on a bad rule and readers only ever wait on a swap
+	shared_ptr<const routeTable> table = rules.empty() ? nullptr : make_shared<const routeTable>(rules);
+
+	lock_guard<mutex> lock(_routeMutex);
+	_routes = move(table);
+	_routesVersion.store(_routes ? nextRoutesVersion.fetch_add(1, memory_order_relaxed) : 0, memory_order_release);
+}
+
+void logDispatcher::configureSink(Logger lg, size_t capacity, Backpressure policy) {
+	_controller->configure(lg, capacity, policy);
 }
 
 void logDispatcher::dispatchLogs() {
 
 	loggerEntryQueue localQueue;
-	unique_ptr<logController> dispatchController = make_unique<logController>();
 
 	// Lock the thread for the copy to improve performance in single and multithreaded use
 	{
@@ -328,9 +832,25 @@ void logDispatcher::dispatchLogs() {
 		swap(localQueue, _logQueue);	// Effectively copies the queue to the local queue and clears the _logQueue member
 	}
 
+	vector<logEntry> entries;
+	vector<sinkMask> routes;
+	entries.reserve(localQueue.size());
+	routes.reserve(localQueue.size());
+
 	while (!localQueue.empty()) {
 
-		dispatchController->logEntry(move(localQueue.front()));
+		routes.push_back(sinksFor(localQueue.front()));
+		entries.push_back(move(localQueue.front()));
 		localQueue.pop();
 	}
+
+	_controller->logEntries(move(entries), routes);
+}
+
+void logDispatcher::flush() {
+	_controller->flush();
+}
+
+vector<sinkStats> logDispatcher::getSinkStats() const {
+	return _controller->stats();
 }
\ No newline at end of file
@@ -0,0 +1,123 @@
+//===================================================================================================================================
+// @file	utkentrycodec.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Internal header containing the fixed size binary slot that log entries are copied
+//			into by the memory-mapped rings(flight recorder and shared-memory collector).
+//===================================================================================================================================
+
+#pragma once
+
+#include "types/utklogentry.hpp"
+#include "dispatchers/utkkeytable.hpp"
+#include <string_view>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace UTK::Dispatch::Codec {
+
+	inline constexpr std::size_t slotSize = 512;
+
+	/// Fixed size slot, the payload holds [uint16 length][bytes] fields: file, function, then key/value pairs
+	struct recordSlot {
+		std::uint64_t sequence;			// Commit marker, meaning is defined by the ring that owns the slot
+		std::int64_t timeStamp;			// Nanoseconds since the system clock epoch
+		std::int32_t fileLine;
+		std::uint8_t lg;
+		std::uint8_t op;
+		std::uint16_t fieldCount;
+		std::uint16_t payloadSize;
+		std::uint8_t truncated;
+		std::uint8_t reserved[5];
+		char payload[slotSize - 32];
+	};
+
+	static_assert(sizeof(recordSlot) == slotSize, "Ring slot layout must stay fixed");
+
+	/// Appends a length-prefixed field, returns false once the slot has no room for all of it
+	inline bool appendField(recordSlot& slot, std::size_t& offset, std::string_view field) {
+
+		const std::size_t room = sizeof(slot.payload) - offset;
+		if (room < sizeof(std::uint16_t)) return false;
+
+		const std::size_t length = std::min(field.size(), room - sizeof(std::uint16_t));
+		const std::uint16_t prefix = static_cast<std::uint16_t>(length);
+
+		std::memcpy(slot.payload + offset, &prefix, sizeof(prefix));
+		std::memcpy(slot.payload + offset + sizeof(prefix), field.data(), length);
+
+		offset += sizeof(prefix) + length;
+		slot.fieldCount++;
+
+		return length == field.size();
+	}
+
+	inline std::string readField(const recordSlot& slot, std::size_t& offset) {
+
+		std::uint16_t length = 0;
+		if (offset + sizeof(length) > slot.payloadSize) return {};
+
+		std::memcpy(&length, slot.payload + offset, sizeof(length));
+		offset += sizeof(length);
+
+		length = static_cast<std::uint16_t>(std::min<std::size_t>(length, slot.payloadSize - offset));
+		std::string field(slot.payload + offset, length);
+		offset += length;
+
+		return field;
+	}
+
+	/// Copies everything but the commit marker of an entry into a slot, strings that overflow are truncated
+	inline void encodeEntry(recordSlot& slot, const UTK::Types::LogEntry::logEntry& entry, std::int64_t timeStamp) noexcept {
+
+		using std::string_view;
+
+		slot.timeStamp = timeStamp;
+		slot.fileLine = entry.fileLine.value_or(-1);
+		slot.lg = static_cast<std::uint8_t>(entry.lg);
+		slot.op = static_cast<std::uint8_t>(entry.op);
+		slot.fieldCount = 0;
+
+		std::size_t offset = 0;
+		bool complete = appendField(slot, offset, entry.fileName ? string_view(*entry.fileName) : string_view{})
+			&& appendField(slot, offset, entry.funcName ? string_view(*entry.funcName) : string_view{});
+
+		// Interned keys are written out by name, the reader may be another process with its own table
+		const std::size_t pairs = std::max(entryKeyCount(entry), entry.formatValues.size());
+		for (std::size_t i = 0; complete && i < pairs; i++) {
+			complete = appendField(slot, offset, entryKey(entry, i))
+				&& appendField(slot, offset, i < entry.formatValues.size() ? string_view(entry.formatValues[i]) : string_view{});
+		}
+
+		slot.payloadSize = static_cast<std::uint16_t>(offset);
+		slot.truncated = complete ? 0 : 1;
+	}
+
+	/// Rebuilds a log entry from a committed slot
+	inline UTK::Types::LogEntry::logEntry decodeEntry(const recordSlot& slot) {
+
+		using namespace UTK::Types;
+
+		LogEntry::logEntry entry{ static_cast<States::Logger>(slot.lg), static_cast<States::Operations>(slot.op), {}, {} };
+		entry.fileLine = slot.fileLine;
+
+		if (slot.payloadSize > sizeof(slot.payload)) return entry;
+
+		std::size_t offset = 0;
+		entry.fileName = readField(slot, offset);
+		entry.funcName = readField(slot, offset);
+
+		for (std::uint32_t field = 2; field + 1 < slot.fieldCount; field += 2) {
+			entry.formatKeys.push_back(readField(slot, offset));
+			entry.formatValues.push_back(readField(slot, offset));
+		}
+		if (slot.fieldCount > 2 && slot.fieldCount % 2 != 0) {
+			entry.formatKeys.push_back(readField(slot, offset));
+		}
+
+		return entry;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,395 @@
+//===================================================================================================================================
+// @file	utkexecutor.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the work-stealing deques and worker threads behind taskExecutor.
+//===================================================================================================================================
+
+#include "dispatchers/utkexecutor.hpp"
+#include <functional>
+#include <cstdint>
+#include <thread>
+#include <deque>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+using namespace UTK::Dispatch;
+using namespace UTK::Dispatch::Internal;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	/// Failed searches for work before a worker stops yielding and goes to sleep
+	constexpr unsigned spinRounds = 64;
+
+	size_t roundUpPowerOfTwo(size_t value) {
+		size_t result = 2;
+		while (result < value) result <<= 1;
+		return result;
+	}
+
+	/// Cheap per-thread generator for picking a victim to steal from
+	uint32_t nextRandom() {
+		thread_local uint32_t state = static_cast<uint32_t>(hash<thread::id>{}(this_thread::get_id())) | 1u;
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	/**
+	 * @brief Chase-Lev work-stealing deque, in the C11 formulation of Le, Pop, Cohen and Zappa Nardelli(2013)
+	 *
+	 * @note Only the owning worker may push and pop, any thread may steal. Rings replaced by a grow are kept
+	 *		 until the deque is destroyed, a thief may still be reading from one.
+	 */
+	class workDeque {
+	private:
+		struct ring {
+			size_t mask;
+			unique_ptr<atomic<job*>[]> slots;
+
+			explicit ring(size_t capacity) : mask(capacity - 1), slots(make_unique<atomic<job*>[]>(capacity)) {}
+
+			job* get(int64_t index) const { return slots[static_cast<size_t>(index) & mask].load(memory_order_relaxed); }
+			void put(int64_t index, job* work) { slots[static_cast<size_t>(index) & mask].store(work, memory_order_relaxed); }
+		};
+
+		alignas(64) atomic<int64_t> _top = 0;		// Next slot a thief takes
+		alignas(64) atomic<int64_t> _bottom = 0;	// Next slot the owner fills
+		atomic<ring*> _ring;
+		vector<unique_ptr<ring>> _rings;			// Owner only, the live ring is the last
+
+		ring* grow(ring* current, int64_t top, int64_t bottom) {
+			_rings.push_back(make_unique<ring>((current->mask + 1) * 2));
+			ring* larger = _rings.back().get();
+
+			for (int64_t i = top; i < bottom; i++) larger->put(i, current->get(i));
+			_ring.store(larger, memory_order_release);
+			return larger;
+		}
+
+	public:
+		explicit workDeque(size_t capacity) {
+			_rings.push_back(make_unique<ring>(roundUpPowerOfTwo(capacity)));
+			_ring.store(_rings.back().get(), memory_order_relaxed);
+		}
+
+		void push(job* work) {
+			const int64_t bottom = _bottom.load(memory_order_relaxed);
+			const int64_t top = _top.load(memory_order_acquire);
+			ring* current = _ring.load(memory_order_relaxed);
+
+			if (bottom - top > static_cast<int64_t>(current->mask)) current = grow(current, top, bottom);
+
+			// Release publishes the job to thieves that acquire bottom before reading the slot
+			current->put(bottom, work);
+			_bottom.store(bottom + 1, memory_order_release);
+		}
+
+		job* pop() {
+			const int64_t bottom = _bottom.load(memory_order_relaxed) - 1;
+			ring* current = _ring.load(memory_order_relaxed);
+
+			// Claim the bottom slot before looking at top, so a thief and the owner never both take it
+			_bottom.store(bottom, memory_order_relaxed);
+			atomic_thread_fence(memory_order_seq_cst);
+			int64_t top = _top.load(memory_order_relaxed);
+
+			if (top > bottom) {
+				_bottom.store(bottom + 1, memory_order_relaxed);
+				return nullptr;
+			}
+
+			job* work = current->get(bottom);
+			if (top == bottom) {
+				// Last job left, race the thieves for it through top
+				if (!_top.compare_exchange_strong(top, top + 1, memory_order_seq_cst, memory_order_relaxed)) work = nullptr;
+				_bottom.store(bottom + 1, memory_order_relaxed);
+			}
+			return work;
+		}
+
+		job* steal() {
+			for (;;) {
+				int64_t top = _top.load(memory_order_acquire);
+				atomic_thread_fence(memory_order_seq_cst);
+				const int64_t bottom = _bottom.load(memory_order_acquire);
+
+				if (top >= bottom) return nullptr;
+
+				job* work = _ring.load(memory_order_acquire)->get(top);
+				if (_top.compare_exchange_strong(top, top + 1, memory_order_seq_cst, memory_order_relaxed)) return work;
+			}
+		}
+	};
+
+	void execute(job* work) {
+		work->run();
+		delete work;
+	}
+}
+
+//===================================================================================================================================
+//												   EXECUTOR CORE DEFINITION
+//===================================================================================================================================
+
+namespace UTK::Dispatch::Internal {
+
+	class executorCore {
+	private:
+		struct worker {
+			workDeque deque;
+			thread runner;
+
+			explicit worker(size_t capacity) : deque(capacity) {}
+		};
+
+		vector<unique_ptr<worker>> _workers;
+		vector<int> _cpus;							// CPUs to pin to, empty when not pinning
+
+		mutex _injectLock;
+		std::deque<job*> _injected;				// Jobs from threads outside the pool
+		atomic<size_t> _injectedCount = 0;
+
+		alignas(64) atomic<uint32_t> _epoch = 0;	// Bumped to wake sleeping workers
+		atomic<uint32_t> _sleepers = 0;
+		atomic<bool> _stopping = false;
+
+		static thread_local executorCore* _current;
+		static thread_local size_t _currentIndex;
+
+		job* popInjected() {
+			if (_injectedCount.load(memory_order_acquire) == 0) return nullptr;
+
+			lock_guard<mutex> lock(_injectLock);
+			if (_injected.empty()) return nullptr;
+
+			job* work = _injected.front();
+			_injected.pop_front();
+			_injectedCount.fetch_sub(1, memory_order_relaxed);
+			return work;
+		}
+
+		job* stealAny(size_t self) {
+			const size_t count = _workers.size();
+			const size_t start = nextRandom() % count;
+
+			for (size_t i = 0; i < count; i++) {
+				const size_t victim = (start + i) % count;
+				if (victim == self) continue;
+				if (job* work = _workers[victim]->deque.steal()) return work;
+			}
+			return nullptr;
+		}
+
+		void pin(size_t index) {
+#if defined(__linux__)
+			if (_cpus.empty()) return;
+
+			// Best effort, a worker that cannot be pinned still runs unpinned
+			cpu_set_t target;
+			CPU_ZERO(&target);
+			CPU_SET(_cpus[index % _cpus.size()], &target);
+			pthread_setaffinity_np(pthread_self(), sizeof(target), &target);
+#else
+			(void)index;
+#endif
+		}
+
+		void workerLoop(size_t index) {
+
+			_current = this;
+			_currentIndex = index;
+			pin(index);
+
+			unsigned idle = 0;
+			for (;;) {
+				if (job* work = findWork()) {
+					execute(work);
+					idle = 0;
+					continue;
+				}
+
+				if (++idle < spinRounds) {
+					this_thread::yield();
+					continue;
+				}
+
+				// Count ourselves asleep before the last look, a schedule() landing after that look then sees us and wakes us
+				_sleepers.fetch_add(1, memory_order_seq_cst);
+				atomic_thread_fence(memory_order_seq_cst);
+				const uint32_t seen = _epoch.load(memory_order_seq_cst);
+
+				job* work = findWork();
+				if (!work) {
+					if (_stopping.load(memory_order_seq_cst)) {
+						_sleepers.fetch_sub(1, memory_order_relaxed);
+						return;
+					}
+					_epoch.wait(seen, memory_order_seq_cst);
+				}
+				_sleepers.fetch_sub(1, memory_order_relaxed);
+
+				if (work) execute(work);
+				idle = 0;
+			}
+		}
+
+	public:
+		explicit executorCore(const executorOptions& options) {
+
+			size_t count = options.workers ? options.workers : thread::hardware_concurrency();
+			if (count == 0) count = 1;
+
+#if defined(__linux__)
+			if (options.pinWorkers) {
+				cpu_set_t allowed;
+				CPU_ZERO(&allowed);
+				if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+					for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+						if (CPU_ISSET(cpu, &allowed)) _cpus.push_back(cpu);
+					}
+				}
+			}
+#endif
+
+			// Every deque exists before any worker starts, so thieves never see a partly built pool
+			_workers.reserve(count);
+			for (size_t i = 0; i < count; i++) _workers.push_back(make_unique<worker>(options.dequeCapacity));
+			for (size_t i = 0; i < count; i++) _workers[i]->runner = thread(&executorCore::workerLoop, this, i);
+		}
+
+		~executorCore() {
+			_stopping.store(true, memory_order_seq_cst);
+			_epoch.fetch_add(1, memory_order_seq_cst);
+			_epoch.notify_all();
+
+			for (auto& w : _workers) {
+				if (w->runner.joinable()) w->runner.join();
+			}
+		}
+
+		size_t workerCount() const noexcept {
+			return _workers.size();
+		}
+
+		void schedule(job* work) {
+
+			if (_current == this) {
+				_workers[_currentIndex]->deque.push(work);
+			}
+			else {
+				lock_guard<mutex> lock(_injectLock);
+				_injected.push_back(work);
+				_injectedCount.fetch_add(1, memory_order_release);
+			}
+
+			// Pairs with the fence in workerLoop, either the sleeper's last look finds this job or we see the sleeper
+			atomic_thread_fence(memory_order_seq_cst);
+			if (_sleepers.load(memory_order_relaxed) == 0) return;
+
+			_epoch.fetch_add(1, memory_order_seq_cst);
+			_epoch.notify_one();
+		}
+
+		/// Own deque first for locality, then outside submissions, then other workers
+		job* findWork() {
+			const bool inPool = (_current == this);
+
+			if (inPool) {
+				if (job* work = _workers[_currentIndex]->deque.pop()) return work;
+			}
+			if (job* work = popInjected()) return work;
+
+			return stealAny(inPool ? _currentIndex : SIZE_MAX);
+		}
+
+		bool runOne() {
+			job* work = findWork();
+			if (!work) return false;
+
+			execute(work);
+			return true;
+		}
+	};
+
+	thread_local executorCore* executorCore::_current = nullptr;
+	thread_local size_t executorCore::_currentIndex = 0;
+}
+
+//===================================================================================================================================
+//											    TASK EXECUTOR METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+taskExecutor::taskExecutor(const executorOptions& options) : _core(make_unique<executorCore>(options)) {}
+
+// Destroying the core drains every queue and joins the workers
+taskExecutor::~taskExecutor() = default;
+
+taskExecutor& taskExecutor::shared() {
+	static taskExecutor instance;
+	return instance;
+}
+
+size_t taskExecutor::workerCount() const noexcept {
+	return _core->workerCount();
+}
+
+void taskExecutor::schedule(job* work) {
+	_core->schedule(work);
+}
+
+void taskExecutor::complete(taskStateBase& state) {
+
+	vector<job*> next;
+	{
+		lock_guard<mutex> lock(state.lock);
+		state.done.store(true, memory_order_release);
+		next.swap(state.continuations);
+	}
+	state.done.notify_all();
+
+	for (job* work : next) schedule(work);
+}
+
+void taskExecutor::chain(taskStateBase& state, job* work) {
+	{
+		lock_guard<mutex> lock(state.lock);
+		if (!state.done.load(memory_order_relaxed)) {
+			state.continuations.push_back(work);
+			return;
+		}
+	}
+	schedule(work);
+}
+
+bool taskExecutor::runPending() {
+	return _core->runOne();
+}
+
+void taskExecutor::waitFor(const taskStateBase& state) {
+
+	while (!state.done.load(memory_order_acquire)) {
+		if (runPending()) continue;
+
+		// Nothing left to help with, the task is running on another thread
+		state.done.wait(false, memory_order_acquire);
+	}
+}
+
+void taskExecutor::waitForZero(const atomic<size_t>& counter) {
+
+	for (size_t left = counter.load(memory_order_acquire); left != 0; left = counter.load(memory_order_acquire)) {
+		if (runPending()) continue;
+		counter.wait(left, memory_order_acquire);
+	}
+}
\ No newline at end of file
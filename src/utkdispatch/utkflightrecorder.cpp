@@ -0,0 +1,319 @@
+//===================================================================================================================================
+// @file	utkflightrecorder.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the memory-mapped flight recorder ring and its crash
+//			recovery reader.
+//===================================================================================================================================
+
+#include "dispatchers/utkflightrecorder.hpp"
+#include "utkentrycodec.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <csignal>
+#include <atomic>
+#include <chrono>
+#include <array>
+
+#if defined(__WINDOWS__)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Dispatch;
+using namespace UTK::Dispatch::Codec;
+using namespace UTK::Types::States;
+using namespace UTK::Types::LogEntry;
+
+//===================================================================================================================================
+//													    RING FILE LAYOUT
+//===================================================================================================================================
+
+/// File header, occupies the first page of the ring file
+struct ringHeader {
+	uint64_t magic;
+	uint32_t version;
+	uint32_t slotSize;
+	uint32_t slotCount;
+	int32_t crashSignal;		// Written by the crash handler, 0 while the process is healthy
+	uint64_t nextSequence;		// Only accessed through atomic_ref
+	int32_t lastCrashSignal;	// crashSignal of the run before this one, moved here when the ring is reopened
+	uint32_t reserved;
+	uint64_t lastCrashSequence;	// nextSequence when the crashed ring was reopened, later entries are from the new run
+};
+
+static constexpr uint64_t ringMagic = 0x3130524b46544b55;	// "UTKFKR01"
+static constexpr uint32_t ringVersion = 2;
+static constexpr size_t headerSize = 4096;
+
+static_assert(sizeof(ringHeader) <= headerSize, "Ring header must fit in its page");
+static_assert(Codec::slotSize == flightRecorder::slotSize, "Ring slot layout must stay fixed");
+static_assert(atomic_ref<uint64_t>::is_always_lock_free, "Ring sequences must be lock free to be signal safe");
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	struct liveRing {
+		atomic<std::byte*> base{ nullptr };
+		atomic<size_t> size{ 0 };
+	};
+
+	/// Rings visible to the crash handler, fixed size so the handler never allocates
+	array<liveRing, 8> liveRings;
+
+	constexpr array<int, 5> fatalSignals{ SIGSEGV, SIGILL, SIGFPE, SIGABRT,
+#if defined(__WINDOWS__)
+		SIGTERM
+#else
+		SIGBUS
+#endif
+	};
+
+	/// Dispositions in place before installCrashHandlers, indexed like fatalSignals
+#if defined(__WINDOWS__)
+	array<void (*)(int), fatalSignals.size()> previousHandlers;
+#else
+	array<struct sigaction, fatalSignals.size()> previousActions;
+#endif
+	atomic<bool> handlersInstalled{ false };
+
+	void registerRing(std::byte* base, size_t size) {
+		for (auto& ring : liveRings) {
+			std::byte* expected = nullptr;
+			if (ring.base.compare_exchange_strong(expected, base)) {
+				ring.size.store(size);
+				return;
+			}
+		}
+	}
+
+	void unregisterRing(std::byte* base) {
+		for (auto& ring : liveRings) {
+			std::byte* expected = base;
+			if (ring.base.compare_exchange_strong(expected, nullptr)) return;
+		}
+	}
+
+	/// Only marks the rings, the mapping is shared so the kernel writes the pages out even after the process dies
+	extern "C" void onFatalSignal(int signal) {
+
+		for (auto& ring : liveRings) {
+			std::byte* base = ring.base.load(memory_order_relaxed);
+			if (!base) continue;
+
+			reinterpret_cast<ringHeader*>(base)->crashSignal = signal;
+		}
+
+		// Put back whatever handled the signal before us, raising again hands it over. That is the
+		// default action(terminating the process) unless the application installed its own handler.
+		for (size_t i = 0; i < fatalSignals.size(); i++) {
+			if (fatalSignals[i] != signal) continue;
+#if defined(__WINDOWS__)
+			std::signal(signal, previousHandlers[i]);
+#else
+			sigaction(signal, &previousActions[i], nullptr);
+#endif
+		}
+		raise(signal);
+	}
+}
+
+//===================================================================================================================================
+//											   FLIGHT RECORDER METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+flightRecorder::flightRecorder(const string& path, uint32_t slotCount)
+	: _path(path), _slotCount(max<uint32_t>(slotCount, 1))
+{
+	_size = headerSize + static_cast<size_t>(_slotCount) * slotSize;
+
+#if defined(__WINDOWS__)
+	_file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (_file == INVALID_HANDLE_VALUE) {
+		throw runtime_error("Failed to open flight recorder file: " + path);
+	}
+
+	_mapping = CreateFileMappingA(_file, nullptr, PAGE_READWRITE,
+		static_cast<DWORD>(static_cast<uint64_t>(_size) >> 32), static_cast<DWORD>(_size & 0xFFFFFFFF), nullptr);
+	if (!_mapping) {
+		CloseHandle(_file);
+		throw runtime_error("Failed to map flight recorder file: " + path);
+	}
+
+	_base = static_cast<std::byte*>(MapViewOfFile(_mapping, FILE_MAP_ALL_ACCESS, 0, 0, _size));
+	if (!_base) {
+		CloseHandle(_mapping);
+		CloseHandle(_file);
+		throw runtime_error("Failed to map flight recorder file: " + path);
+	}
+#else
+	_fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+	if (_fd < 0) {
+		throw runtime_error("Failed to open flight recorder file: " + path);
+	}
+
+	struct stat info{};
+	if (fstat(_fd, &info) != 0 || (static_cast<size_t>(info.st_size) != _size && ftruncate(_fd, static_cast<off_t>(_size)) != 0)) {
+		close(_fd);
+		throw runtime_error("Failed to size flight recorder file: " + path);
+	}
+
+	void* mapped = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+	if (mapped == MAP_FAILED) {
+		close(_fd);
+		throw runtime_error("Failed to map flight recorder file: " + path);
+	}
+	_base = static_cast<std::byte*>(mapped);
+#endif
+
+	// Keep the previous run's entries when the layout matches, so a restart does not wipe a crash record
+	auto* header = reinterpret_cast<ringHeader*>(_base);
+	if (header->magic != ringMagic || header->version != ringVersion ||
+		header->slotSize != slotSize || header->slotCount != _slotCount)
+	{
+		memset(_base, 0, _size);
+		header->version = ringVersion;
+		header->slotSize = static_cast<uint32_t>(slotSize);
+		header->slotCount = _slotCount;
+		header->magic = ringMagic;
+	}
+	else if (header->crashSignal != 0) {
+		// The last run crashed, move its marker aside rather than erasing it before anyone recovered it
+		header->lastCrashSignal = header->crashSignal;
+		header->lastCrashSequence = atomic_ref<uint64_t>(header->nextSequence).load(memory_order_relaxed);
+		header->crashSignal = 0;
+	}
+
+	registerRing(_base, _size);
+}
+
+flightRecorder::~flightRecorder() {
+
+	unregisterRing(_base);
+	flush();
+
+#if defined(__WINDOWS__)
+	UnmapViewOfFile(_base);
+	CloseHandle(_mapping);
+	CloseHandle(_file);
+#else
+	munmap(_base, _size);
+	close(_fd);
+#endif
+}
+
+void flightRecorder::record(const logEntry& entry) noexcept {
+
+	auto* header = reinterpret_cast<ringHeader*>(_base);
+	const uint64_t sequence = atomic_ref<uint64_t>(header->nextSequence).fetch_add(1, memory_order_relaxed);
+
+	auto& slot = *reinterpret_cast<recordSlot*>(_base + headerSize + (sequence % _slotCount) * slotSize);
+	atomic_ref<uint64_t> committed(slot.sequence);
+
+	// Mark the slot as in-flight so a crash mid-copy leaves it unreadable rather than torn
+	committed.store(0, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+
+	encodeEntry(slot, entry, duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+
+	committed.store(sequence + 1, memory_order_release);
+}
+
+void flightRecorder::flush() noexcept {
+#if defined(__WINDOWS__)
+	FlushViewOfFile(_base, 0);
+	FlushFileBuffers(_file);
+#else
+	msync(_base, _size, MS_SYNC);
+#endif
+}
+
+void flightRecorder::installCrashHandlers() {
+
+	// A second install would save our own handler as the previous one and loop on the signal forever
+	if (handlersInstalled.exchange(true)) return;
+
+	for (size_t i = 0; i < fatalSignals.size(); i++) {
+#if defined(__WINDOWS__)
+		previousHandlers[i] = std::signal(fatalSignals[i], onFatalSignal);
+		if (previousHandlers[i] == SIG_ERR) previousHandlers[i] = SIG_DFL;
+#else
+		struct sigaction action{};
+		action.sa_handler = onFatalSignal;
+		action.sa_flags = SA_NODEFER;
+		sigemptyset(&action.sa_mask);
+		sigaction(fatalSignals[i], &action, &previousActions[i]);
+#endif
+	}
+}
+
+vector<flightRecord> flightRecorder::recover(const string& path, size_t count, int* crashSignal, crashMarker* previousCrash) {
+
+	ifstream file(path, ios::binary);
+	if (!file.is_open()) {
+		throw runtime_error("Failed to open flight recorder file: " + path);
+	}
+
+	ringHeader header{};
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!file || header.magic != ringMagic || header.version != ringVersion || header.slotSize != slotSize) {
+		throw runtime_error("Not a flight recorder file: " + path);
+	}
+	if (crashSignal) *crashSignal = header.crashSignal;
+	if (previousCrash) *previousCrash = { header.lastCrashSignal, header.lastCrashSequence };
+
+	// slotCount comes from a file that may be damaged, never allocate for more slots than it actually holds
+	file.seekg(0, ios::end);
+	const auto fileSize = static_cast<uint64_t>(max<streamoff>(file.tellg(), 0));
+	const uint64_t slotsOnDisk = (fileSize > headerSize) ? (fileSize - headerSize) / slotSize : 0;
+
+	vector<recordSlot> slots(static_cast<size_t>(min<uint64_t>(header.slotCount, slotsOnDisk)));
+	file.seekg(static_cast<streamoff>(headerSize));
+	file.read(reinterpret_cast<char*>(slots.data()), static_cast<streamsize>(slots.size() * slotSize));
+	slots.resize(static_cast<size_t>(file.gcount()) / slotSize);
+
+	// Newest entries first, so only the requested amount gets decoded
+	vector<const recordSlot*> live;
+	for (const auto& slot : slots) {
+		if (slot.sequence != 0 && slot.payloadSize <= sizeof(slot.payload)) live.push_back(&slot);
+	}
+	sort(live.begin(), live.end(), [](const recordSlot* a, const recordSlot* b) { return a->sequence > b->sequence; });
+	if (live.size() > count) live.resize(count);
+
+	vector<flightRecord> records;
+	records.reserve(live.size());
+
+	for (auto it = live.rbegin(); it != live.rend(); ++it) {
+		const recordSlot& slot = **it;
+
+		logEntry entry = decodeEntry(slot);
+
+		flightRecord record;
+		record.sequence = slot.sequence - 1;
+		record.timeStamp = slot.timeStamp;
+		record.lg = entry.lg;
+		record.op = entry.op;
+		record.fileLine = entry.fileLine.value_or(-1);
+		record.truncated = slot.truncated != 0;
+		record.fileName = move(entry.fileName).value_or("");
+		record.funcName = move(entry.funcName).value_or("");
+		record.formatKeys = move(entry.formatKeys);
+		record.formatValues = move(entry.formatValues);
+
+		records.push_back(move(record));
+	}
+
+	return records;
+}
\ No newline at end of file
@@ -0,0 +1,875 @@
+//===================================================================================================================================
+// @file	utkfollower.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the log follower, the rolling aggregates and the snapshot service used
+//			by utktaild.
+//===================================================================================================================================
+
+#include "dispatchers/utkfollower.hpp"
+#include "dispatchers/utkarchive.hpp"
+#include <unordered_map>
+#include <string_view>
+#include <filesystem>
+#include <stdexcept>
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <ctime>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#endif
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+using namespace UTK::Types::LogEntry;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	constexpr int64_t nanosPerSecond = 1'000'000'000;
+
+	/// Operation names used in snapshots, indexed by Operations
+	constexpr array<string_view, operationCount> opNames {
+		"write"sv, "read"sv, "login"sv, "logout"sv, "idle"sv, "error"sv, "message"sv, "none"sv
+	};
+
+	int64_t now() {
+		return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+	}
+
+	/// Whole seconds, rounded towards negative infinity
+	int64_t secondOf(int64_t timeStamp) {
+		return timeStamp / nanosPerSecond - ((timeStamp % nanosPerSecond) < 0 ? 1 : 0);
+	}
+
+	void appendJsonString(string& out, string_view text) {
+
+		static constexpr char hex[] = "0123456789abcdef";
+
+		out.push_back('"');
+		for (const char c : text) {
+			const auto byte = static_cast<unsigned char>(c);
+			if (c == '"' || c == '\\') {
+				out.push_back('\\');
+				out.push_back(c);
+			}
+			else if (byte < 0x20) {
+				out.append("\\u00");
+				out.push_back(hex[byte >> 4]);
+				out.push_back(hex[byte & 0xF]);
+			}
+			else {
+				out.push_back(c);
+			}
+		}
+		out.push_back('"');
+	}
+
+	void appendJsonStrings(string& out, const vector<string>& values) {
+
+		out.push_back('[');
+		for (size_t i = 0; i < values.size(); i++) {
+			if (i) out.push_back(',');
+			appendJsonString(out, values[i]);
+		}
+		out.push_back(']');
+	}
+
+	template<typename Counts>
+	void appendJsonCounts(string& out, const Counts& counts) {
+
+		out.push_back('[');
+		for (size_t i = 0; i < counts.size(); i++) {
+			if (i) out.push_back(',');
+			out.append(to_string(counts[i]));
+		}
+		out.push_back(']');
+	}
+
+	/// Turns lines written by the terminal sink back into entries
+	class terminalParser {
+	private:
+		string _scratch;
+		string _lastStamp;				// mktime is slow, and most lines share their second with the one before
+		int64_t _lastTime = 0;
+
+		/// Drops ANSI colour sequences, which are only there when the sink's stdout was a terminal
+		string_view stripColour(string_view line) {
+
+			if (line.find('\x1b') == string_view::npos) return line;
+
+			_scratch.clear();
+			for (size_t i = 0; i < line.size(); i++) {
+				if (line[i] == '\x1b' && i + 1 < line.size() && line[i + 1] == '[') {
+					i += 2;
+					while (i < line.size() && (line[i] < '@' || line[i] > '~')) i++;
+					continue;
+				}
+				_scratch.push_back(line[i]);
+			}
+			return _scratch;
+		}
+
+		/// Local time written as "dd/mm/YYYY HH:MM:SS"
+		bool parseTimeStamp(string_view text, int64_t& out) {
+
+			if (text == _lastStamp) {
+				out = _lastTime;
+				return true;
+			}
+
+			auto number = [text](size_t at, size_t width, int& value) {
+				const char* end = text.data() + at + width;
+				return from_chars(text.data() + at, end, value).ptr == end;
+			};
+
+			tm fields{};
+			if (!number(0, 2, fields.tm_mday) || text[2] != '/' || !number(3, 2, fields.tm_mon) || text[5] != '/'
+				|| !number(6, 4, fields.tm_year) || text[10] != ' ' || !number(11, 2, fields.tm_hour) || text[13] != ':'
+				|| !number(14, 2, fields.tm_min) || text[16] != ':' || !number(17, 2, fields.tm_sec))
+			{
+				return false;
+			}
+
+			fields.tm_mon -= 1;
+			fields.tm_year -= 1900;
+			fields.tm_isdst = -1;
+
+			const time_t seconds = mktime(&fields);
+			if (seconds == -1) return false;
+
+			_lastStamp.assign(text);
+			_lastTime = static_cast<int64_t>(seconds) * nanosPerSecond;
+			out = _lastTime;
+			return true;
+		}
+
+	public:
+		/**
+		 * @note Keys and values are split on spaces, so a value that itself holds spaces is split across
+		 *		 the pairs that follow it.
+		 */
+		bool parse(string_view line, followedEntry& out) {
+
+			constexpr size_t stampWidth = 19;
+
+			if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+			line = stripColour(line);
+			if (line.size() <= stampWidth || !parseTimeStamp(line.substr(0, stampWidth), out.timeStamp)) return false;
+
+			// The location is file:line:func, padded out to the sink's fixed prefix width
+			string_view rest = line.substr(stampWidth + 1);
+			const size_t locationEnd = rest.find(' ');
+			const string_view location = rest.substr(0, locationEnd);
+			rest = (locationEnd == string_view::npos) ? string_view{} : rest.substr(locationEnd);
+
+			const size_t fileEnd = location.find(':');
+			const size_t lineEnd = (fileEnd == string_view::npos) ? string_view::npos : location.find(':', fileEnd + 1);
+			if (lineEnd == string_view::npos) return false;
+
+			int fileLine = -1;
+			if (from_chars(location.data() + fileEnd + 1, location.data() + lineEnd, fileLine).ptr != location.data() + lineEnd) {
+				return false;
+			}
+
+			logEntry& entry = out.entry;
+			const string_view file = location.substr(0, fileEnd);
+			const string_view func = location.substr(lineEnd + 1);
+
+			entry.lg = Logger::TERMINAL;
+			entry.op = Operations::LG_NOP;
+			entry.fileName = (file == "<unknown_file>"sv) ? nullopt : optional<string>(file);
+			entry.fileLine = (fileLine >= 0) ? optional<int>(fileLine) : nullopt;
+			entry.funcName = (func == "<unknown_func>"sv) ? nullopt : optional<string>(func);
+			entry.formatKeys.clear();
+			entry.formatValues.clear();
+			entry.keyIds.clear();
+
+			rest.remove_prefix(min(rest.find_first_not_of(' '), rest.size()));
+
+			// LG_NOP writes no tag at all
+			if (rest.starts_with('[')) {
+				const size_t tagEnd = rest.find(']');
+				if (tagEnd != string_view::npos) {
+					const auto tag = find(operationTags.begin(), operationTags.end(), rest.substr(0, tagEnd + 1));
+					if (tag != operationTags.end()) entry.op = static_cast<Operations>(tag - operationTags.begin());
+					rest.remove_prefix(tagEnd + 1);
+				}
+			}
+
+			bool key = true;
+			while (!rest.empty()) {
+				const size_t start = rest.find_first_not_of(' ');
+				if (start == string_view::npos) break;
+
+				rest.remove_prefix(start);
+				const size_t end = min(rest.find(' '), rest.size());
+
+				(key ? entry.formatKeys : entry.formatValues).emplace_back(rest.substr(0, end));
+				rest.remove_prefix(end);
+				key = !key;
+			}
+
+			return true;
+		}
+	};
+}
+
+//===================================================================================================================================
+//												ROLLING AGGREGATES METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+rollingAggregates::rollingAggregates(size_t windowSeconds, size_t errorLimit)
+	: _seconds(max<size_t>(windowSeconds, 1)), _errorLimit(errorLimit) {}
+
+void rollingAggregates::add(const followedEntry& entry) {
+
+	const size_t op = min(static_cast<size_t>(entry.entry.op), operationCount - 1);
+	_totals[op]++;
+
+	if (entry.entry.op == Operations::LG_ERR && _errorLimit) {
+		if (_errors.size() == _errorLimit) _errors.pop_front();
+		_errors.push_back(entry);
+	}
+
+	const int64_t window = static_cast<int64_t>(_seconds.size());
+	const int64_t second = secondOf(entry.timeStamp);
+	if (_latest != INT64_MIN && second <= _latest - window) return;
+
+	_latest = max(_latest, second);
+
+	secondCounts& bucket = _seconds[static_cast<size_t>(((second % window) + window) % window)];
+	if (bucket.second != second) {
+		bucket.second = second;
+		bucket.counts = {};
+	}
+	bucket.counts[op]++;
+}
+
+string rollingAggregates::toJson(int64_t current) const {
+
+	const int64_t window = static_cast<int64_t>(_seconds.size());
+	const int64_t last = secondOf(current);
+
+	vector<const secondCounts*> seconds;
+	for (const auto& bucket : _seconds) {
+		if (bucket.second != INT64_MIN && bucket.second > last - window && bucket.second <= last) {
+			seconds.push_back(&bucket);
+		}
+	}
+	sort(seconds.begin(), seconds.end(), [](const secondCounts* a, const secondCounts* b) { return a->second < b->second; });
+
+	string out;
+	out.append("{\"window\":").append(to_string(window));
+
+	out.append(",\"operations\":[");
+	for (size_t i = 0; i < opNames.size(); i++) {
+		if (i) out.push_back(',');
+		appendJsonString(out, opNames[i]);
+	}
+	out.append("],\"totals\":");
+	appendJsonCounts(out, _totals);
+
+	// Seconds without entries are left out
+	out.append(",\"seconds\":[");
+	for (size_t i = 0; i < seconds.size(); i++) {
+		if (i) out.push_back(',');
+		out.append("{\"second\":").append(to_string(seconds[i]->second)).append(",\"counts\":");
+		appendJsonCounts(out, seconds[i]->counts);
+		out.push_back('}');
+	}
+
+	out.append("],\"errors\":[");
+	for (size_t i = 0; i < _errors.size(); i++) {
+		const followedEntry& error = _errors[i];
+		const logEntry& entry = error.entry;
+
+		if (i) out.push_back(',');
+		out.append("{\"time\":").append(to_string(error.timeStamp));
+		out.append(",\"file\":");
+		appendJsonString(out, entry.fileName.value_or(""));
+		out.append(",\"line\":").append(to_string(entry.fileLine.value_or(-1)));
+		out.append(",\"function\":");
+		appendJsonString(out, entry.funcName.value_or(""));
+		out.append(",\"keys\":");
+		appendJsonStrings(out, entry.formatKeys);
+		out.append(",\"values\":");
+		appendJsonStrings(out, entry.formatValues);
+		out.push_back('}');
+	}
+	out.append("]}");
+
+	return out;
+}
+
+//===================================================================================================================================
+//												  LOG FOLLOWER METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+#if !defined(__linux__)
+
+class UTK::Dispatch::Internal::followerState {};
+
+logFollower::logFollower(const string&) {
+	throw runtime_error("Following log files is not supported on this platform");
+}
+logFollower::~logFollower() = default;
+void logFollower::follow(const string&, Logger, bool) {}
+int logFollower::descriptor() const { return -1; }
+size_t logFollower::read(vector<followedEntry>&) { return 0; }
+void logFollower::saveOffsets() {}
+vector<followedFile> logFollower::files() const { return {}; }
+
+tailService::tailService(const string&, logFollower& follower, rollingAggregates& aggregates)
+	: _follower(follower), _aggregates(aggregates)
+{
+	throw runtime_error("The tail service is not supported on this platform");
+}
+tailService::~tailService() = default;
+void tailService::serveClients() {}
+size_t tailService::poll(int) { return 0; }
+string tailService::snapshot() const { return {}; }
+
+#else
+
+class UTK::Dispatch::Internal::followerState {
+private:
+	struct trackedFile {
+		string path;					// Absolute, matched against inotify events
+		Logger format;
+		int fd = -1;					// TERMINAL output only
+		unique_ptr<archiveReader> archive;
+		uint64_t inode = 0;				// File the position belongs to, 0 before it is first opened
+		uint64_t position = 0;			// Bytes read, or blocks read for an ARCHIVE
+		bool skipToEnd = false;			// Position at the end of the file once it is opened
+		bool changed = true;			// Named by an event since it was last read
+		string pending;					// Partial line at the end of the bytes read so far
+		uint64_t entries = 0;
+		uint64_t unparsed = 0;
+	};
+
+	struct savedOffset {
+		uint64_t inode;
+		uint64_t position;
+	};
+
+	static constexpr size_t maxLineBytes = 1 << 20;
+
+	const string _offsetsPath;
+	int _inotify = -1;
+	unordered_map<int, string> _watches;			// Watch descriptor to the directory it watches
+	vector<trackedFile> _files;
+	unordered_map<string, size_t> _byPath;
+	unordered_map<string, savedOffset> _saved;
+	terminalParser _parser;
+	vector<char> _chunk = vector<char>(64 * 1024);
+	vector<archivedEntry> _blockEntries;
+	bool _offsetsChanged = false;
+	steady_clock::time_point _lastSave = steady_clock::now();
+
+	void loadOffsets() {
+
+		ifstream file(_offsetsPath);
+		string line;
+
+		// One "<inode> <position> <path>" line per file, the path last so it may hold spaces
+		while (getline(file, line)) {
+			const char* data = line.data();
+			const char* end = data + line.size();
+
+			uint64_t inode = 0, position = 0;
+			auto [afterInode, inodeError] = from_chars(data, end, inode);
+			if (inodeError != errc{} || afterInode == end || *afterInode != ' ') continue;
+
+			auto [afterPosition, positionError] = from_chars(afterInode + 1, end, position);
+			if (positionError != errc{} || afterPosition == end || *afterPosition != ' ') continue;
+
+			_saved[string(afterPosition + 1, end)] = { inode, position };
+		}
+	}
+
+	/// Marks the followed file at path as changed, or every file if the kernel dropped events
+	void markChanged(const inotify_event& event) {
+
+		if (event.mask & IN_Q_OVERFLOW) {
+			for (auto& file : _files) file.changed = true;
+			return;
+		}
+
+		auto watch = _watches.find(event.wd);
+		if (watch == _watches.end() || !event.len) return;
+
+		auto followed = _byPath.find((filesystem::path(watch->second) / event.name).string());
+		if (followed != _byPath.end()) _files[followed->second].changed = true;
+	}
+
+	void readEvents() {
+
+		alignas(inotify_event) char buffer[16 * 1024];
+
+		for (;;) {
+			const ssize_t received = ::read(_inotify, buffer, sizeof(buffer));
+			if (received <= 0) return;
+
+			// Each event's name is padded so the next event stays aligned
+			for (ssize_t at = 0; at < received;) {
+				const auto* event = reinterpret_cast<const inotify_event*>(buffer + at);
+				markChanged(*event);
+				at += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+			}
+		}
+	}
+
+	void closeFile(trackedFile& file) {
+
+		if (file.fd >= 0) ::close(file.fd);
+		file.fd = -1;
+		file.archive.reset();
+		file.pending.clear();
+	}
+
+	/// Starts over on a file that was replaced or truncated
+	void restart(trackedFile& file) {
+		file.pending.clear();
+		file.position = 0;
+		_offsetsChanged = true;
+	}
+
+	bool openTerminal(trackedFile& file) {
+
+		const int fd = ::open(file.path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) return false;
+
+		struct stat status{};
+		if (fstat(fd, &status) != 0) {
+			::close(fd);
+			return false;
+		}
+
+		// Replaced while nobody was following it
+		if (file.inode && file.inode != status.st_ino) restart(file);
+		if (file.skipToEnd) file.position = static_cast<uint64_t>(status.st_size);
+
+		file.inode = status.st_ino;
+		file.skipToEnd = false;
+		file.fd = fd;
+		return true;
+	}
+
+	void parseLine(trackedFile& file, string_view line, vector<followedEntry>& out) {
+
+		followedEntry parsed{};
+		if (_parser.parse(line, parsed)) {
+			out.push_back(move(parsed));
+			file.entries++;
+		}
+		else if (!line.empty()) {
+			file.unparsed++;
+		}
+	}
+
+	void parseLines(trackedFile& file, string_view data, vector<followedEntry>& out) {
+
+		size_t start = 0;
+		for (size_t end = data.find('\n'); end != string_view::npos; end = data.find('\n', start)) {
+			if (file.pending.empty()) {
+				parseLine(file, data.substr(start, end - start), out);
+			}
+			else {
+				file.pending.append(data.substr(start, end - start));
+				parseLine(file, file.pending, out);
+				file.pending.clear();
+			}
+			start = end + 1;
+		}
+
+		file.pending.append(data.substr(start));
+		if (file.pending.size() > maxLineBytes) {
+			file.pending.clear();
+			file.unparsed++;
+		}
+	}
+
+	/// Reads from the saved position up to the current end of the file
+	void readAppended(trackedFile& file, vector<followedEntry>& out) {
+
+		struct stat status{};
+		if (fstat(file.fd, &status) != 0) return;
+
+		// Truncated in place, copytruncate style rotation
+		if (static_cast<uint64_t>(status.st_size) < file.position) restart(file);
+
+		for (;;) {
+			const ssize_t received = ::pread(file.fd, _chunk.data(), _chunk.size(), static_cast<off_t>(file.position));
+			if (received < 0 && errno == EINTR) continue;
+			if (received <= 0) return;
+
+			file.position += static_cast<uint64_t>(received);
+			_offsetsChanged = true;
+			parseLines(file, string_view(_chunk.data(), static_cast<size_t>(received)), out);
+		}
+	}
+
+	void readTerminal(trackedFile& file, vector<followedEntry>& out) {
+
+		if (file.fd < 0 && !openTerminal(file)) return;
+
+		// The path naming another file means it was rotated, finish the old file before moving on
+		struct stat status{};
+		const bool replaced = ::stat(file.path.c_str(), &status) != 0 || status.st_ino != file.inode;
+
+		readAppended(file, out);
+
+		if (replaced) {
+			closeFile(file);
+			restart(file);
+			if (openTerminal(file)) readAppended(file, out);
+		}
+	}
+
+	bool openArchive(trackedFile& file) {
+
+		struct stat status{};
+		if (::stat(file.path.c_str(), &status) != 0) return false;
+
+		try {
+			file.archive = make_unique<archiveReader>(file.path);
+		}
+		catch (const std::exception&) {
+			return false;				// Not created, or the writer has not finished its header yet
+		}
+
+		const uint64_t blockCount = file.archive->blocks().size();
+		if ((file.inode && file.inode != status.st_ino) || file.position > blockCount) restart(file);
+		if (file.skipToEnd) file.position = blockCount;
+
+		file.inode = status.st_ino;
+		file.skipToEnd = false;
+		return true;
+	}
+
+	void readArchive(trackedFile& file, vector<followedEntry>& out) {
+
+		struct stat status{};
+		if (file.archive && (::stat(file.path.c_str(), &status) != 0 || status.st_ino != file.inode)) {
+			closeFile(file);
+			restart(file);
+		}
+
+		if (!file.archive) {
+			if (!openArchive(file)) return;
+		}
+		else {
+			try {
+				file.archive->refresh();
+			}
+			catch (const std::exception&) {
+				// Shrunk below the blocks already read, so it is no longer the same archive
+				closeFile(file);
+				restart(file);
+				if (!openArchive(file)) return;
+			}
+		}
+
+		// blocks() shrinks when a block turns out to be torn, it comes back once refresh() finds it whole
+		for (; file.position < file.archive->blocks().size(); file.position++) {
+			_blockEntries.clear();
+			try {
+				file.archive->readBlock(static_cast<size_t>(file.position), _blockEntries);
+			}
+			catch (const std::exception&) {
+				if (file.position >= file.archive->blocks().size()) break;
+				file.unparsed++;
+				continue;
+			}
+
+			for (auto& archived : _blockEntries) {
+				out.push_back({ archived.timeStamp, move(archived.entry) });
+			}
+			file.entries += _blockEntries.size();
+			_offsetsChanged = true;
+		}
+	}
+
+public:
+	explicit followerState(const string& offsetsPath) : _offsetsPath(offsetsPath) {
+
+		_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (_inotify < 0) throw runtime_error("Failed to initialise inotify: " + string(strerror(errno)));
+
+		if (!_offsetsPath.empty()) loadOffsets();
+	}
+
+	~followerState() {
+
+		try {
+			saveOffsets();
+		}
+		catch (const std::exception&) {}
+
+		for (auto& file : _files) closeFile(file);
+		::close(_inotify);
+	}
+
+	followerState(const followerState&) = delete;
+	followerState& operator=(const followerState&) = delete;
+
+	int descriptor() const {
+		return _inotify;
+	}
+
+	void follow(const string& path, Logger format, bool fromStart) {
+
+		if (format != Logger::TERMINAL && format != Logger::ARCHIVE) {
+			throw runtime_error("Only TERMINAL and ARCHIVE output can be followed: " + path);
+		}
+
+		const filesystem::path absolute = filesystem::absolute(path).lexically_normal();
+		const string key = absolute.string();
+		if (_byPath.count(key)) return;
+
+		// Watching the directory rather than the file also catches the file being created, replaced or renamed
+		const string directory = absolute.parent_path().string();
+		const int watch = inotify_add_watch(_inotify, directory.c_str(),
+			IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE);
+		if (watch < 0) throw runtime_error("Failed to watch " + directory + ": " + strerror(errno));
+		_watches[watch] = directory;
+
+		trackedFile file;
+		file.path = key;
+		file.format = format;
+
+		if (auto saved = _saved.find(key); saved != _saved.end()) {
+			file.inode = saved->second.inode;
+			file.position = saved->second.position;
+		}
+		else {
+			file.skipToEnd = !fromStart;
+		}
+
+		_byPath.emplace(key, _files.size());
+		_files.push_back(move(file));
+
+		// Opened now so the end is taken as of this call. A file that does not exist yet has no end to skip to,
+		// everything written to it once it appears is new.
+		trackedFile& added = _files.back();
+		if (added.skipToEnd) {
+			if (added.format == Logger::ARCHIVE) openArchive(added);
+			else openTerminal(added);
+			added.skipToEnd = false;
+		}
+	}
+
+	size_t read(vector<followedEntry>& out) {
+
+		readEvents();
+
+		const size_t before = out.size();
+		for (auto& file : _files) {
+			if (!file.changed) continue;
+
+			file.changed = false;
+			if (file.format == Logger::ARCHIVE) readArchive(file, out);
+			else readTerminal(file, out);
+		}
+
+		if (_offsetsChanged && steady_clock::now() - _lastSave >= seconds(1)) saveOffsets();
+
+		return out.size() - before;
+	}
+
+	void saveOffsets() {
+
+		_lastSave = steady_clock::now();
+		if (_offsetsPath.empty() || !_offsetsChanged) return;
+
+		// Offsets for files no longer followed are kept, they may be followed again next time
+		for (const auto& file : _files) {
+			if (file.inode) _saved[file.path] = { file.inode, file.position - file.pending.size() };
+		}
+
+		// Written aside and renamed over the old file, so a crash never leaves half a file behind
+		const string temporary = _offsetsPath + ".tmp";
+		{
+			ofstream out(temporary, ios::trunc);
+			for (const auto& [path, saved] : _saved) {
+				out << saved.inode << ' ' << saved.position << ' ' << path << '\n';
+			}
+			if (!out.flush()) throw runtime_error("Unable to write follower offsets: " + temporary);
+		}
+
+		if (::rename(temporary.c_str(), _offsetsPath.c_str()) != 0) {
+			throw runtime_error("Unable to replace follower offsets: " + _offsetsPath);
+		}
+		_offsetsChanged = false;
+	}
+
+	vector<followedFile> files() const {
+
+		vector<followedFile> result;
+		result.reserve(_files.size());
+
+		for (const auto& file : _files) {
+			result.push_back({ file.path, file.format, file.position - file.pending.size(), file.entries, file.unparsed,
+				file.fd >= 0 || file.archive != nullptr });
+		}
+
+		return result;
+	}
+};
+
+logFollower::logFollower(const string& offsetsPath) : _state(make_unique<Internal::followerState>(offsetsPath)) {}
+
+logFollower::~logFollower() = default;
+
+void logFollower::follow(const string& path, Logger format, bool fromStart) {
+	_state->follow(path, format, fromStart);
+}
+
+int logFollower::descriptor() const {
+	return _state->descriptor();
+}
+
+size_t logFollower::read(vector<followedEntry>& out) {
+	return _state->read(out);
+}
+
+void logFollower::saveOffsets() {
+	_state->saveOffsets();
+}
+
+vector<followedFile> logFollower::files() const {
+	return _state->files();
+}
+
+//===================================================================================================================================
+//												  TAIL SERVICE METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+static sockaddr_un makeSocketAddress(const string& socketPath) {
+
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+
+	if (socketPath.size() >= sizeof(address.sun_path)) {
+		throw runtime_error("Tail socket path is too long: " + socketPath);
+	}
+	memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+	return address;
+}
+
+tailService::tailService(const string& socketPath, logFollower& follower, rollingAggregates& aggregates)
+	: _socketPath(socketPath), _follower(follower), _aggregates(aggregates)
+{
+	sockaddr_un address = makeSocketAddress(socketPath);
+
+	_listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (_listener < 0) {
+		throw runtime_error("Failed to create tail socket");
+	}
+
+	unlink(socketPath.c_str());
+	if (::bind(_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(_listener, 64) != 0) {
+		close(_listener);
+		throw runtime_error("Failed to listen on tail socket: " + socketPath);
+	}
+}
+
+tailService::~tailService() {
+	close(_listener);
+	unlink(_socketPath.c_str());
+}
+
+void tailService::serveClients() {
+
+	string response;
+
+	for (;;) {
+		const int fd = accept4(_listener, nullptr, nullptr, SOCK_CLOEXEC);
+		if (fd < 0) return;
+
+		// Built once per wakeup, however many dashboards are waiting
+		if (response.empty()) response = snapshot().append("\n");
+
+		// A dashboard that stops reading is dropped rather than stalling the follower
+		const timeval timeout{ 0, 200'000 };
+		setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+		for (size_t sent = 0; sent < response.size();) {
+			const ssize_t written = send(fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+			if (written < 0 && errno == EINTR) continue;
+			if (written <= 0) break;
+			sent += static_cast<size_t>(written);
+		}
+
+		close(fd);
+	}
+}
+
+size_t tailService::poll(int timeoutMs) {
+
+	pollfd fds[2] = {
+		{ _listener, POLLIN, 0 },
+		{ _follower.descriptor(), POLLIN, 0 }
+	};
+
+	::poll(fds, 2, timeoutMs);
+
+	// Cheap when nothing changed, only files named by an event are read
+	_batch.clear();
+	const size_t count = _follower.read(_batch);
+	for (const auto& entry : _batch) {
+		_aggregates.add(entry);
+	}
+
+	if (fds[0].revents & POLLIN) serveClients();
+
+	return count;
+}
+
+string tailService::snapshot() const {
+
+	const int64_t current = now();
+
+	string out;
+	out.append("{\"time\":").append(to_string(current)).append(",\"files\":[");
+
+	const auto files = _follower.files();
+	for (size_t i = 0; i < files.size(); i++) {
+		const followedFile& file = files[i];
+
+		if (i) out.push_back(',');
+		out.append("{\"path\":");
+		appendJsonString(out, file.path);
+		out.append(",\"format\":");
+		appendJsonString(out, (file.format == Logger::ARCHIVE) ? "archive"sv : "terminal"sv);
+		out.append(",\"position\":").append(to_string(file.position));
+		out.append(",\"entries\":").append(to_string(file.entries));
+		out.append(",\"unparsed\":").append(to_string(file.unparsed));
+		out.append(",\"open\":").append(file.open ? "true" : "false");
+		out.push_back('}');
+	}
+
+	out.append("],\"aggregates\":").append(_aggregates.toJson(current)).push_back('}');
+	return out;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,159 @@
+//===================================================================================================================================
+// @file	utkkeytable.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the lock-free key interning table shared by log producers and sinks.
+//===================================================================================================================================
+
+#include "dispatchers/utkkeytable.hpp"
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::LogEntry;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	/// Twice the key capacity keeps probe chains short, a power of two so the probe wraps with a mask
+	constexpr size_t slotCount = keyTable::capacity * 2;
+	constexpr size_t slotMask = slotCount - 1;
+
+	static_assert((slotCount & slotMask) == 0, "Key table slot count must be a power of two");
+
+	string jsonKey(string_view name) {
+
+		static constexpr char hex[] = "0123456789abcdef";
+
+		string result;
+		result.reserve(name.size() + 3);
+		result.push_back('"');
+
+		for (const char c : name) {
+			const auto byte = static_cast<unsigned char>(c);
+			if (c == '"' || c == '\\') {
+				result.push_back('\\');
+				result.push_back(c);
+			}
+			else if (byte < 0x20) {
+				result.append("\\u00");
+				result.push_back(hex[byte >> 4]);
+				result.push_back(hex[byte & 0xF]);
+			}
+			else {
+				result.push_back(c);
+			}
+		}
+
+		result.append("\":");
+		return result;
+	}
+
+	string csvKey(string_view name) {
+
+		if (name.find_first_of(",\"\n") == string_view::npos) return string(name);
+
+		string result;
+		result.reserve(name.size() + 2);
+		result.push_back('"');
+		for (const char c : name) {
+			if (c == '"') result.push_back('"');
+			result.push_back(c);
+		}
+		result.push_back('"');
+
+		return result;
+	}
+}
+
+//===================================================================================================================================
+//												   KEY TABLE METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+/// Owns the strings an internedKey views, never moved once published
+struct keyTable::record {
+	string name;
+	string json;
+	string csv;
+	internedKey view;
+
+	explicit record(string_view key) : name(key), json(jsonKey(key)), csv(csvKey(key)), view{ name, json, csv } {}
+};
+
+keyTable::keyTable()
+	: _records(make_unique<atomic<const record*>[]>(capacity)), _slots(make_unique<atomic<uint32_t>[]>(slotCount)) {}
+
+keyTable::~keyTable() = default;
+
+keyTable& keyTable::global() {
+	static keyTable table;
+	return table;
+}
+
+optional<KeyId> keyTable::find(string_view name) const noexcept {
+
+	for (size_t probe = hash<string_view>{}(name);; probe++) {
+		const uint32_t slot = _slots[probe & slotMask].load(memory_order_acquire);
+		if (slot == 0) return nullopt;
+
+		// A record is always published before the slot pointing at it
+		const record* key = _records[slot - 1].load(memory_order_acquire);
+		if (key->name == name) return slot - 1;
+	}
+}
+
+KeyId keyTable::intern(string_view name) {
+
+	if (auto id = find(name)) return *id;
+
+	lock_guard<mutex> lock(_writeLock);
+
+	// Another thread may have added it between the lock-free miss and taking the lock
+	if (auto id = find(name)) return *id;
+
+	const uint32_t id = _size.load(memory_order_relaxed);
+	if (id >= capacity) throw runtime_error("Key table is full, cannot intern: " + string(name));
+
+	_owned.push_back(make_unique<record>(name));
+	_records[id].store(_owned.back().get(), memory_order_release);
+
+	size_t probe = hash<string_view>{}(name);
+	while (_slots[probe & slotMask].load(memory_order_relaxed) != 0) probe++;
+	_slots[probe & slotMask].store(id + 1, memory_order_release);
+
+	_size.store(id + 1, memory_order_release);
+	return id;
+}
+
+const internedKey* keyTable::lookup(KeyId id) const noexcept {
+
+	if (id >= capacity) return nullptr;
+
+	const record* key = _records[id].load(memory_order_acquire);
+	return key ? &key->view : nullptr;
+}
+
+size_t keyTable::size() const noexcept {
+	return _size.load(memory_order_acquire);
+}
+
+//===================================================================================================================================
+//												 ENTRY KEY HELPER IMPLEMENTATIONS
+//===================================================================================================================================
+
+string_view UTK::Dispatch::entryKey(const logEntry& entry, size_t index) noexcept {
+
+	if (entry.keyIds.empty()) {
+		return index < entry.formatKeys.size() ? string_view(entry.formatKeys[index]) : string_view{};
+	}
+	if (index >= entry.keyIds.size()) return {};
+
+	const internedKey* key = keyTable::global().lookup(entry.keyIds[index]);
+	return key ? key->name : "<unknown_key>"sv;
+}
\ No newline at end of file
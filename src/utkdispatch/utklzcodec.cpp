@@ -0,0 +1,173 @@
+//===================================================================================================================================
+// @file	utklzcodec.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the LZ77 block compressor and bounds checked decompressor used by the archive sink.
+//===================================================================================================================================
+
+#include "utklzcodec.hpp"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	constexpr size_t minMatch = 4;
+	constexpr size_t maxOffset = 65535;
+	constexpr size_t hashBits = 14;
+
+	// Matches never start in the last bytes of a block, so the final sequence is always literals
+	constexpr size_t tailLiterals = 12;
+
+	inline uint32_t read32(const char* at) {
+		uint32_t value;
+		memcpy(&value, at, sizeof(value));
+		return value;
+	}
+
+	inline uint32_t hashOf(const char* at) {
+		return (read32(at) * 2654435761u) >> (32 - hashBits);
+	}
+
+	/// Lengths past the 4 bit nibble continue in bytes of 255, ended by a byte below 255
+	void appendLength(string& out, size_t length) {
+		while (length >= 255) {
+			out.push_back(static_cast<char>(255));
+			length -= 255;
+		}
+		out.push_back(static_cast<char>(length));
+	}
+
+	void appendSequence(string& out, const char* literals, size_t literalCount, size_t offset, size_t matchLength) {
+
+		const size_t matchCode = matchLength ? matchLength - minMatch : 0;
+		const auto token = static_cast<unsigned char>((min<size_t>(literalCount, 15) << 4) | min<size_t>(matchCode, 15));
+		out.push_back(static_cast<char>(token));
+
+		if (literalCount >= 15) appendLength(out, literalCount - 15);
+		out.append(literals, literalCount);
+
+		if (!matchLength) return;
+
+		out.push_back(static_cast<char>(offset & 0xFF));
+		out.push_back(static_cast<char>(offset >> 8));
+		if (matchCode >= 15) appendLength(out, matchCode - 15);
+	}
+
+	/// Reads a continued length, false if it runs past the input
+	bool readLength(const unsigned char*& in, const unsigned char* end, size_t& length) {
+		for (;;) {
+			if (in == end) return false;
+			const unsigned char byte = *in++;
+			length += byte;
+			if (byte != 255) return true;
+		}
+	}
+}
+
+//===================================================================================================================================
+//													LZ CODEC IMPLEMENTATIONS
+//===================================================================================================================================
+
+void UTK::Dispatch::Codec::lzCompress(string_view input, string& out) {
+
+	const char* const base = input.data();
+	const size_t size = input.size();
+
+	out.reserve(out.size() + size + size / 255 + 16);
+
+	size_t anchor = 0;		// Start of literals not yet written
+	if (size > tailLiterals + minMatch) {
+
+		vector<uint32_t> table(size_t(1) << hashBits, 0);		// Position + 1 of the last four bytes with each hash
+		const size_t matchLimit = size - tailLiterals;
+
+		size_t pos = 0;
+		unsigned misses = 0;
+		while (pos < matchLimit) {
+
+			const uint32_t hash = hashOf(base + pos);
+			const size_t candidate = table[hash];
+			table[hash] = static_cast<uint32_t>(pos + 1);
+
+			if (!candidate || pos + 1 - candidate > maxOffset || read32(base + candidate - 1) != read32(base + pos)) {
+				// Step further the longer nothing matches, incompressible data is skipped over quickly
+				pos += 1 + (misses++ >> 6);
+				continue;
+			}
+			misses = 0;
+
+			size_t match = candidate - 1;
+			size_t length = minMatch;
+			while (pos + length < matchLimit && base[match + length] == base[pos + length]) length++;
+
+			// Extend backwards into literals the scan skipped over
+			while (pos > anchor && match > 0 && base[pos - 1] == base[match - 1]) {
+				pos--;
+				match--;
+				length++;
+			}
+
+			appendSequence(out, base + anchor, pos - anchor, pos - match, length);
+			pos += length;
+			anchor = pos;
+
+			// Seed the table inside the match so the next repeat can find it
+			if (pos - 2 < matchLimit) table[hashOf(base + pos - 2)] = static_cast<uint32_t>(pos - 1);
+		}
+	}
+
+	appendSequence(out, base + anchor, size - anchor, 0, 0);
+}
+
+bool UTK::Dispatch::Codec::lzDecompress(string_view input, char* out, size_t rawSize) noexcept {
+
+	auto in = reinterpret_cast<const unsigned char*>(input.data());
+	const auto inEnd = in + input.size();
+	size_t written = 0;
+
+	while (in < inEnd) {
+
+		const unsigned char token = *in++;
+
+		size_t literals = token >> 4;
+		if (literals == 15 && !readLength(in, inEnd, literals)) return false;
+		if (literals > static_cast<size_t>(inEnd - in) || literals > rawSize - written) return false;
+
+		memcpy(out + written, in, literals);
+		in += literals;
+		written += literals;
+
+		// The last sequence holds only literals
+		if (in == inEnd) break;
+
+		if (inEnd - in < 2) return false;
+		const size_t offset = in[0] | (size_t(in[1]) << 8);
+		in += 2;
+
+		size_t length = token & 0x0F;
+		if (length == 15 && !readLength(in, inEnd, length)) return false;
+		length += minMatch;
+
+		if (offset == 0 || offset > written || length > rawSize - written) return false;
+
+		// Byte by byte when the match overlaps what it is copying, which repeats a short run
+		const char* from = out + written - offset;
+		if (offset >= length) {
+			memcpy(out + written, from, length);
+		}
+		else {
+			for (size_t i = 0; i < length; i++) out[written + i] = from[i];
+		}
+		written += length;
+	}
+
+	return written == rawSize;
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+//===================================================================================================================================
+// @file	utklzcodec.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Internal header containing the LZ77 block codec used by the archive sink.
+//
+// @note    The format follows LZ4's block layout: each sequence is a token holding the literal and match
+//          lengths, the literals, then a two byte offset back into the last 64KiB. Matching is greedy over
+//          a single hash of the next four bytes, trading some ratio for speed, which suits log text where
+//          most repeats are whole keys, paths and timestamps.
+//===================================================================================================================================
+
+#pragma once
+
+#include <string_view>
+#include <cstddef>
+#include <string>
+
+namespace UTK::Dispatch::Codec {
+
+	/**
+	 * @brief Appends the compressed form of input to out
+	 */
+	void lzCompress(std::string_view input, std::string& out);
+
+	/**
+	 * @brief Decompresses input into exactly rawSize bytes at out
+	 *
+	 * @return False if input is corrupt or does not decode to exactly rawSize bytes.
+	 */
+	bool lzDecompress(std::string_view input, char* out, std::size_t rawSize) noexcept;
+}
\ No newline at end of file
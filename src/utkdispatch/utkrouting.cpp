@@ -0,0 +1,106 @@
+//===================================================================================================================================
+// @file	utkrouting.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the routing table compiler and per entry lookup used by logDispatcher.
+//===================================================================================================================================
+
+#include "dispatchers/utkrouting.hpp"
+#include "dispatchers/utkkeytable.hpp"
+#include <stdexcept>
+#include <string_view>
+
+using namespace std;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+using namespace UTK::Types::LogEntry;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	constexpr sinkMask allSinks = (sinkMask(1) << loggerCount) - 1;
+}
+
+//===================================================================================================================================
+//											        ROUTE TABLE METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+routeTable::routeTable(const vector<routeRule>& rules) {
+
+	for (const auto& rule : rules) {
+		if (rule.sinks & ~allSinks) throw runtime_error("Route rule names an unknown sink");
+
+		const bool conditional = !rule.key.empty() || rule.value || !rule.file.empty();
+
+		// An empty op list stands for every operation, expand it so each op's slot holds everything it needs
+		vector<Operations> ops = rule.ops;
+		if (ops.empty()) {
+			for (size_t op = 0; op < operationCount; op++) ops.push_back(static_cast<Operations>(op));
+		}
+
+		for (Operations op : ops) {
+			const size_t index = static_cast<size_t>(op);
+			if (index >= operationCount) throw runtime_error("Route rule names an unknown operation");
+
+			opRoute& slot = _ops[index];
+			slot.reachable |= rule.sinks;
+
+			if (conditional) {
+				slot.conditions.push_back({ rule.key, rule.value, rule.file, rule.sinks });
+			}
+			else {
+				slot.always |= rule.sinks;
+				slot.covered = true;
+			}
+		}
+	}
+}
+
+bool routeTable::matches(const condition& rule, const logEntry& entry) noexcept {
+
+	if (!rule.file.empty()) {
+		if (!entry.fileName || !string_view(*entry.fileName).ends_with(rule.file)) return false;
+	}
+
+	if (rule.key.empty()) return true;
+
+	for (size_t i = 0; i < entryKeyCount(entry); i++) {
+		if (entryKey(entry, i) != rule.key) continue;
+		if (!rule.value) return true;
+		if (i < entry.formatValues.size() && entry.formatValues[i] == *rule.value) return true;
+	}
+
+	return false;
+}
+
+sinkMask routeTable::route(const logEntry& entry) const noexcept {
+
+	const size_t index = static_cast<size_t>(entry.op);
+	if (index >= operationCount) return sinkBit(entry.lg);
+
+	const opRoute& slot = _ops[index];
+	sinkMask sinks = slot.always;
+	bool matched = slot.covered;
+
+	for (const auto& rule : slot.conditions) {
+		if (matches(rule, entry)) {
+			sinks |= rule.sinks;
+			matched = true;
+		}
+	}
+
+	return matched ? sinks : sinkBit(entry.lg);
+}
+
+sinkMask routeTable::reachable(Logger lg, Operations op) const noexcept {
+
+	const size_t index = static_cast<size_t>(op);
+	if (index >= operationCount) return sinkBit(lg);
+
+	const opRoute& slot = _ops[index];
+	return slot.covered ? slot.reachable : slot.reachable | sinkBit(lg);
+}
\ No newline at end of file
@@ -0,0 +1,511 @@
+//===================================================================================================================================
+// @file	utkhash.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the XXH3 64/128-bit hash and CRC32C front ends provided by UTK::Hash.
+//
+// @note    Follows the XXH3 specification from xxHash 0.8. Short inputs(<= 240 bytes) are handled by
+//			fixed mixing paths here, anything longer goes through the runtime selected kernels.
+//===================================================================================================================================
+
+#include "utkhashkernels.hpp"
+#include "hash/utkhash.hpp"
+#include <algorithm>
+#include <cstring>
+#include <bit>
+
+using namespace std;
+using namespace UTK::Hash;
+using namespace UTK::Hash::Kernels;
+
+static_assert(endian::native == endian::little, "UTK::Hash assumes a little endian target");
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	constexpr uint32_t prime32_1 = 0x9E3779B1U;
+	constexpr uint32_t prime32_2 = 0x85EBCA77U;
+	constexpr uint32_t prime32_3 = 0xC2B2AE3DU;
+	constexpr uint64_t prime64_1 = 0x9E3779B185EBCA87ULL;
+	constexpr uint64_t prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+	constexpr uint64_t prime64_3 = 0x165667B19E3779F9ULL;
+	constexpr uint64_t prime64_4 = 0x85EBCA77C2B2AE63ULL;
+	constexpr uint64_t prime64_5 = 0x27D4EB2F165667C5ULL;
+	constexpr uint64_t primeMx1 = 0x165667919E3779F9ULL;
+	constexpr uint64_t primeMx2 = 0x9FB21C651E98DF25ULL;
+
+	constexpr size_t secretSize = 192;
+	constexpr size_t secretSizeMin = 136;
+	constexpr size_t midSizeMax = 240;
+	constexpr size_t stripesPerBlock = (secretSize - stripeLength) / secretConsumeRate;
+	constexpr size_t blockLength = stripeLength * stripesPerBlock;
+
+	// Default secret from the XXH3 specification
+	alignas(64) constexpr uint8_t defaultSecret[secretSize] = {
+		0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+		0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+		0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+		0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+		0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+		0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+		0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+		0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+		0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+		0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+		0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+		0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+	};
+
+	using accumulators = array<uint64_t, 8>;
+
+	constexpr accumulators initialAcc{
+		prime32_3, prime64_1, prime64_2, prime64_3, prime64_4, prime32_2, prime64_5, prime32_1
+	};
+
+	inline uint64_t read64(const uint8_t* p) {
+		uint64_t value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	inline uint32_t read32(const uint8_t* p) {
+		uint32_t value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	inline void write64(uint8_t* p, uint64_t value) {
+		memcpy(p, &value, sizeof(value));
+	}
+
+	inline uint64_t swap64(uint64_t x) {
+		x = ((x & 0x00FF00FF00FF00FFULL) << 8) | ((x >> 8) & 0x00FF00FF00FF00FFULL);
+		x = ((x & 0x0000FFFF0000FFFFULL) << 16) | ((x >> 16) & 0x0000FFFF0000FFFFULL);
+		return (x << 32) | (x >> 32);
+	}
+
+	inline uint32_t swap32(uint32_t x) {
+		return ((x << 24) & 0xFF000000U) | ((x << 8) & 0x00FF0000U) | ((x >> 8) & 0x0000FF00U) | ((x >> 24) & 0x000000FFU);
+	}
+
+#if defined(__SIZEOF_INT128__)
+	__extension__ typedef unsigned __int128 uint128;
+#endif
+
+	inline hash128 multiply128(uint64_t a, uint64_t b) {
+	#if defined(__SIZEOF_INT128__)
+		const uint128 product = static_cast<uint128>(a) * b;
+		return { static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64) };
+	#else
+		// Portable 64x64 -> 128 from four 32x32 products
+		const uint64_t loLo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+		const uint64_t hiLo = (a >> 32) * (b & 0xFFFFFFFF);
+		const uint64_t loHi = (a & 0xFFFFFFFF) * (b >> 32);
+		const uint64_t hiHi = (a >> 32) * (b >> 32);
+		const uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+		return { (cross << 32) | (loLo & 0xFFFFFFFF), (hiLo >> 32) + (cross >> 32) + hiHi };
+	#endif
+	}
+
+	inline uint64_t foldedMultiply(uint64_t a, uint64_t b) {
+		const hash128 product = multiply128(a, b);
+		return product.low ^ product.high;
+	}
+
+	inline uint64_t xxh64Avalanche(uint64_t h) {
+		h ^= h >> 33;
+		h *= prime64_2;
+		h ^= h >> 29;
+		h *= prime64_3;
+		return h ^ (h >> 32);
+	}
+
+	inline uint64_t avalanche(uint64_t h) {
+		h ^= h >> 37;
+		h *= primeMx1;
+		return h ^ (h >> 32);
+	}
+
+	inline uint64_t rrmxmx(uint64_t h, uint64_t length) {
+		h ^= rotl(h, 49) ^ rotl(h, 24);
+		h *= primeMx2;
+		h ^= (h >> 35) + length;
+		h *= primeMx2;
+		return h ^ (h >> 28);
+	}
+
+	inline uint64_t mix16(const uint8_t* input, const uint8_t* secret, uint64_t seed) {
+		return foldedMultiply(read64(input) ^ (read64(secret) + seed), read64(input + 8) ^ (read64(secret + 8) - seed));
+	}
+
+	inline void mix32(hash128& acc, const uint8_t* first, const uint8_t* second, const uint8_t* secret, uint64_t seed) {
+		acc.low += mix16(first, secret, seed);
+		acc.low ^= read64(second) + read64(second + 8);
+		acc.high += mix16(second, secret + 16, seed);
+		acc.high ^= read64(first) + read64(first + 8);
+	}
+
+	void deriveSecret(uint8_t* out, uint64_t seed) {
+		for (size_t i = 0; i < secretSize; i += 16) {
+			write64(out + i, read64(defaultSecret + i) + seed);
+			write64(out + i + 8, read64(defaultSecret + i + 8) - seed);
+		}
+	}
+
+	uint64_t mergeAccumulators(const uint64_t* acc, const uint8_t* secret, uint64_t start) {
+		uint64_t result = start;
+		for (size_t i = 0; i < 4; i++) {
+			result += foldedMultiply(acc[i * 2] ^ read64(secret + i * 16), acc[i * 2 + 1] ^ read64(secret + i * 16 + 8));
+		}
+		return avalanche(result);
+	}
+
+	/**
+	 * @brief Runs every full block and stripe of a long input, leaving the merge to the caller
+	 */
+	void hashLong(accumulators& acc, const uint8_t* input, size_t length, const uint8_t* secret) {
+		const hashKernel& kernel = activeHash();
+		const size_t blocks = (length - 1) / blockLength;
+
+		for (size_t b = 0; b < blocks; b++) {
+			kernel.accumulate(acc.data(), input + b * blockLength, secret, stripesPerBlock);
+			kernel.scramble(acc.data(), secret + secretSize - stripeLength);
+		}
+
+		const size_t stripes = ((length - 1) - blocks * blockLength) / stripeLength;
+		kernel.accumulate(acc.data(), input + blocks * blockLength, secret, stripes);
+
+		// The last stripe always ends on the final byte, overlapping the previous one if needed
+		kernel.accumulate(acc.data(), input + length - stripeLength, secret + secretSize - stripeLength - 7, 1);
+	}
+
+	//===================================================================================================================================
+	//											             64-BIT SHORT PATHS
+	//===================================================================================================================================
+
+	uint64_t hash64Short(const uint8_t* input, size_t length, const uint8_t* secret, uint64_t seed) {
+		if (length > 8) {
+			const uint64_t flipLow = (read64(secret + 24) ^ read64(secret + 32)) + seed;
+			const uint64_t flipHigh = (read64(secret + 40) ^ read64(secret + 48)) - seed;
+			const uint64_t low = read64(input) ^ flipLow;
+			const uint64_t high = read64(input + length - 8) ^ flipHigh;
+			return avalanche(length + swap64(low) + high + foldedMultiply(low, high));
+		}
+		if (length >= 4) {
+			seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+			const uint64_t flip = (read64(secret + 8) ^ read64(secret + 16)) - seed;
+			const uint64_t combined = read32(input + length - 4) + (static_cast<uint64_t>(read32(input)) << 32);
+			return rrmxmx(combined ^ flip, length);
+		}
+		if (length > 0) {
+			const uint32_t combined = (static_cast<uint32_t>(input[0]) << 16) | (static_cast<uint32_t>(input[length >> 1]) << 24) |
+									  static_cast<uint32_t>(input[length - 1]) | (static_cast<uint32_t>(length) << 8);
+			const uint64_t flip = (read32(secret) ^ read32(secret + 4)) + seed;
+			return xxh64Avalanche(combined ^ flip);
+		}
+		return xxh64Avalanche(seed ^ read64(secret + 56) ^ read64(secret + 64));
+	}
+
+	uint64_t hash64Mid(const uint8_t* input, size_t length, const uint8_t* secret, uint64_t seed) {
+		uint64_t acc = length * prime64_1;
+
+		if (length <= 128) {
+			if (length > 32) {
+				if (length > 64) {
+					if (length > 96) {
+						acc += mix16(input + 48, secret + 96, seed);
+						acc += mix16(input + length - 64, secret + 112, seed);
+					}
+					acc += mix16(input + 32, secret + 64, seed);
+					acc += mix16(input + length - 48, secret + 80, seed);
+				}
+				acc += mix16(input + 16, secret + 32, seed);
+				acc += mix16(input + length - 32, secret + 48, seed);
+			}
+			acc += mix16(input, secret, seed);
+			acc += mix16(input + length - 16, secret + 16, seed);
+			return avalanche(acc);
+		}
+
+		const size_t rounds = length / 16;
+		for (size_t i = 0; i < 8; i++) {
+			acc += mix16(input + i * 16, secret + i * 16, seed);
+		}
+		acc = avalanche(acc);
+		for (size_t i = 8; i < rounds; i++) {
+			acc += mix16(input + i * 16, secret + (i - 8) * 16 + 3, seed);
+		}
+		acc += mix16(input + length - 16, secret + secretSizeMin - 17, seed);
+		return avalanche(acc);
+	}
+
+	uint64_t hash64Small(const uint8_t* input, size_t length, uint64_t seed) {
+		return (length <= 16) ? hash64Short(input, length, defaultSecret, seed) : hash64Mid(input, length, defaultSecret, seed);
+	}
+
+	//===================================================================================================================================
+	//											             128-BIT SHORT PATHS
+	//===================================================================================================================================
+
+	hash128 hash128Short(const uint8_t* input, size_t length, const uint8_t* secret, uint64_t seed) {
+		if (length > 8) {
+			const uint64_t flipLow = (read64(secret + 32) ^ read64(secret + 40)) - seed;
+			const uint64_t flipHigh = (read64(secret + 48) ^ read64(secret + 56)) + seed;
+			const uint64_t inputLow = read64(input);
+			uint64_t inputHigh = read64(input + length - 8);
+
+			hash128 m = multiply128(inputLow ^ inputHigh ^ flipLow, prime64_1);
+			m.low += static_cast<uint64_t>(length - 1) << 54;
+			inputHigh ^= flipHigh;
+			m.high += inputHigh + (inputHigh & 0xFFFFFFFF) * (prime32_2 - 1);
+			m.low ^= swap64(m.high);
+
+			hash128 h = multiply128(m.low, prime64_2);
+			h.high += m.high * prime64_2;
+			return { avalanche(h.low), avalanche(h.high) };
+		}
+		if (length >= 4) {
+			seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+			const uint64_t combined = read32(input) + (static_cast<uint64_t>(read32(input + length - 4)) << 32);
+			const uint64_t flip = (read64(secret + 16) ^ read64(secret + 24)) + seed;
+
+			hash128 m = multiply128(combined ^ flip, prime64_1 + (length << 2));
+			m.high += m.low << 1;
+			m.low ^= m.high >> 3;
+			m.low ^= m.low >> 35;
+			m.low *= primeMx2;
+			m.low ^= m.low >> 28;
+			m.high = avalanche(m.high);
+			return m;
+		}
+		if (length > 0) {
+			const uint32_t combinedLow = (static_cast<uint32_t>(input[0]) << 16) | (static_cast<uint32_t>(input[length >> 1]) << 24) |
+										 static_cast<uint32_t>(input[length - 1]) | (static_cast<uint32_t>(length) << 8);
+			const uint32_t combinedHigh = rotl(swap32(combinedLow), 13);
+			const uint64_t flipLow = (read32(secret) ^ read32(secret + 4)) + seed;
+			const uint64_t flipHigh = (read32(secret + 8) ^ read32(secret + 12)) - seed;
+			return { xxh64Avalanche(combinedLow ^ flipLow), xxh64Avalanche(combinedHigh ^ flipHigh) };
+		}
+		return {
+			xxh64Avalanche(seed ^ read64(secret + 64) ^ read64(secret + 72)),
+			xxh64Avalanche(seed ^ read64(secret + 80) ^ read64(secret + 88))
+		};
+	}
+
+	hash128 hash128Mid(const uint8_t* input, size_t length, const uint8_t* secret, uint64_t seed) {
+		hash128 acc{ length * prime64_1, 0 };
+
+		if (length <= 128) {
+			if (length > 32) {
+				if (length > 64) {
+					if (length > 96) {
+						mix32(acc, input + 48, input + length - 64, secret + 96, seed);
+					}
+					mix32(acc, input + 32, input + length - 48, secret + 64, seed);
+				}
+				mix32(acc, input + 16, input + length - 32, secret + 32, seed);
+			}
+			mix32(acc, input, input + length - 16, secret, seed);
+		}
+		else {
+			const size_t rounds = length / 32;
+			for (size_t i = 0; i < 4; i++) {
+				mix32(acc, input + i * 32, input + i * 32 + 16, secret + i * 32, seed);
+			}
+			acc.low = avalanche(acc.low);
+			acc.high = avalanche(acc.high);
+			for (size_t i = 4; i < rounds; i++) {
+				mix32(acc, input + i * 32, input + i * 32 + 16, secret + (i - 4) * 32 + 3, seed);
+			}
+			mix32(acc, input + length - 16, input + length - 32, secret + secretSizeMin - 17 - 16, 0 - seed);
+		}
+
+		const uint64_t low = acc.low + acc.high;
+		const uint64_t high = acc.low * prime64_1 + acc.high * prime64_4 + (length - seed) * prime64_2;
+		return { avalanche(low), 0 - avalanche(high) };
+	}
+
+	hash128 hash128Small(const uint8_t* input, size_t length, uint64_t seed) {
+		return (length <= 16) ? hash128Short(input, length, defaultSecret, seed) : hash128Mid(input, length, defaultSecret, seed);
+	}
+
+	//===================================================================================================================================
+	//											              LONG INPUT DIGESTS
+	//===================================================================================================================================
+
+	uint64_t digest64Long(const accumulators& acc, const uint8_t* secret, uint64_t length) {
+		return mergeAccumulators(acc.data(), secret + 11, length * prime64_1);
+	}
+
+	hash128 digest128Long(const accumulators& acc, const uint8_t* secret, uint64_t length) {
+		return {
+			mergeAccumulators(acc.data(), secret + 11, length * prime64_1),
+			mergeAccumulators(acc.data(), secret + secretSize - stripeLength - 11, ~(length * prime64_2))
+		};
+	}
+}
+
+//===================================================================================================================================
+//											            ONE-SHOT FUNCTIONS
+//===================================================================================================================================
+
+uint64_t UTK::Hash::hash64(const void* data, size_t length, uint64_t seed) {
+
+	const uint8_t* input = static_cast<const uint8_t*>(data);
+	if (length <= midSizeMax) return hash64Small(input, length, seed);
+
+	alignas(64) uint8_t custom[secretSize];
+	const uint8_t* secret = defaultSecret;
+	if (seed != 0) {
+		deriveSecret(custom, seed);
+		secret = custom;
+	}
+
+	alignas(64) accumulators acc = initialAcc;
+	hashLong(acc, input, length, secret);
+	return digest64Long(acc, secret, length);
+}
+
+hash128 UTK::Hash::hash128Of(const void* data, size_t length, uint64_t seed) {
+
+	const uint8_t* input = static_cast<const uint8_t*>(data);
+	if (length <= midSizeMax) return hash128Small(input, length, seed);
+
+	alignas(64) uint8_t custom[secretSize];
+	const uint8_t* secret = defaultSecret;
+	if (seed != 0) {
+		deriveSecret(custom, seed);
+		secret = custom;
+	}
+
+	alignas(64) accumulators acc = initialAcc;
+	hashLong(acc, input, length, secret);
+	return digest128Long(acc, secret, length);
+}
+
+uint32_t UTK::Hash::crc32c(const void* data, size_t length, uint32_t crc) {
+
+	return ~activeCrc().update(~crc, static_cast<const uint8_t*>(data), length);
+}
+
+//===================================================================================================================================
+//											         HASH STREAM METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+hashStream::hashStream(uint64_t seed) {
+
+	reset(seed);
+}
+
+void hashStream::reset(uint64_t seed) {
+
+	_acc = initialAcc;
+	_buffered = 0;
+	_stripesSoFar = 0;
+	_totalLength = 0;
+	_seed = seed;
+
+	if (seed == 0) memcpy(_secret.data(), defaultSecret, secretSize);
+	else deriveSecret(_secret.data(), seed);
+}
+
+void hashStream::consumeStripes(array<uint64_t, 8>& acc, size_t& stripesSoFar, const uint8_t* input, size_t stripes) const {
+
+	const hashKernel& kernel = activeHash();
+
+	// Stripes draw on the secret at an offset that advances per stripe and wraps with a scramble each block
+	while (stripes > 0) {
+		const size_t toBlockEnd = stripesPerBlock - stripesSoFar;
+		const size_t count = min(stripes, toBlockEnd);
+
+		kernel.accumulate(acc.data(), input, _secret.data() + stripesSoFar * secretConsumeRate, count);
+		input += count * stripeLength;
+		stripes -= count;
+		stripesSoFar += count;
+
+		if (stripesSoFar == stripesPerBlock) {
+			kernel.scramble(acc.data(), _secret.data() + secretSize - stripeLength);
+			stripesSoFar = 0;
+		}
+	}
+}
+
+void hashStream::update(const void* data, size_t length) {
+
+	if (length == 0) return;
+
+	const uint8_t* input = static_cast<const uint8_t*>(data);
+	_totalLength += length;
+
+	// Always keep at least one byte buffered so the digest can see the final stripe
+	if (_buffered + length <= bufferSize) {
+		memcpy(_buffer.data() + _buffered, input, length);
+		_buffered += length;
+		return;
+	}
+
+	if (_buffered > 0) {
+		const size_t fill = bufferSize - _buffered;
+		memcpy(_buffer.data() + _buffered, input, fill);
+		input += fill;
+		length -= fill;
+		consumeStripes(_acc, _stripesSoFar, _buffer.data(), bufferSize / stripeLength);
+		_buffered = 0;
+	}
+
+	if (length > bufferSize) {
+		const size_t stripes = (length - 1) / stripeLength;
+		consumeStripes(_acc, _stripesSoFar, input, stripes);
+		input += stripes * stripeLength;
+		length -= stripes * stripeLength;
+
+		// Keep the last consumed stripe at the end of the buffer for a short final partial stripe
+		memcpy(_buffer.data() + bufferSize - stripeLength, input - stripeLength, stripeLength);
+	}
+
+	memcpy(_buffer.data(), input, length);
+	_buffered = length;
+}
+
+void hashStream::digestLong(array<uint64_t, 8>& acc) const {
+
+	const hashKernel& kernel = activeHash();
+	const uint8_t* lastSecret = _secret.data() + secretSize - stripeLength - 7;
+
+	if (_buffered >= stripeLength) {
+		size_t stripesSoFar = _stripesSoFar;
+		const size_t stripes = (_buffered - 1) / stripeLength;
+		consumeStripes(acc, stripesSoFar, _buffer.data(), stripes);
+		kernel.accumulate(acc.data(), _buffer.data() + _buffered - stripeLength, lastSecret, 1);
+	}
+	else {
+		// Stitch the tail of the previous stripe onto the buffered bytes to make one full stripe
+		alignas(64) uint8_t lastStripe[stripeLength];
+		const size_t carried = stripeLength - _buffered;
+		memcpy(lastStripe, _buffer.data() + bufferSize - carried, carried);
+		memcpy(lastStripe + carried, _buffer.data(), _buffered);
+		kernel.accumulate(acc.data(), lastStripe, lastSecret, 1);
+	}
+}
+
+uint64_t hashStream::digest64() const {
+
+	if (_totalLength <= midSizeMax) return hash64Small(_buffer.data(), static_cast<size_t>(_totalLength), _seed);
+
+	alignas(64) accumulators acc = _acc;
+	digestLong(acc);
+	return digest64Long(acc, _secret.data(), _totalLength);
+}
+
+hash128 hashStream::digest128() const {
+
+	if (_totalLength <= midSizeMax) return hash128Small(_buffer.data(), static_cast<size_t>(_totalLength), _seed);
+
+	alignas(64) accumulators acc = _acc;
+	digestLong(acc);
+	return digest128Long(acc, _secret.data(), _totalLength);
+}
\ No newline at end of file
@@ -0,0 +1,509 @@
+//===================================================================================================================================
+// @file	utkhashkernels.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the scalar and SIMD kernels behind UTK::Hash, and the CPU feature
+//			detection that picks between them.
+//
+// @note    SIMD kernels are compiled with per-function target attributes rather than global flags, so
+//			one binary carries every kernel and only the ones the CPU reports are ever called.
+//===================================================================================================================================
+
+#include "utkhashkernels.hpp"
+#include "hash/utkhash.hpp"
+#include <algorithm>
+#include <cstring>
+#include <atomic>
+#include <array>
+
+#if defined(ARCH_x64)
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <immintrin.h>
+	#endif
+#elif defined(ARCH_ARM64)
+	#include <arm_neon.h>
+	#if defined(__ARM_FEATURE_CRC32)
+		#include <arm_acle.h>
+	#endif
+#endif
+
+#if defined(_MSC_VER)
+	#define UTK_TARGET(features)
+#else
+	#define UTK_TARGET(features) __attribute__((target(features)))
+#endif
+
+using namespace std;
+using namespace UTK::Hash::Kernels;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	constexpr uint32_t prime32_1 = 0x9E3779B1U;
+	constexpr uint32_t castagnoli = 0x82F63B78U;	// Reflected CRC32C polynomial
+
+	inline uint64_t read64(const uint8_t* p) {
+		uint64_t value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	inline uint32_t read32(const uint8_t* p) {
+		uint32_t value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	constexpr array<array<uint32_t, 256>, 8> makeCrcTables() {
+		array<array<uint32_t, 256>, 8> tables{};
+
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t crc = i;
+			for (int bit = 0; bit < 8; bit++) {
+				crc = (crc & 1) ? (crc >> 1) ^ castagnoli : crc >> 1;
+			}
+			tables[0][i] = crc;
+		}
+		for (size_t t = 1; t < 8; t++) {
+			for (size_t i = 0; i < 256; i++) {
+				tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xFF];
+			}
+		}
+
+		return tables;
+	}
+
+	constexpr auto crcTables = makeCrcTables();
+
+	/**
+	 * @brief Multiplies two polynomials modulo the CRC polynomial, both in reflected form
+	 */
+	uint32_t multiplyModP(uint32_t a, uint32_t b) {
+		uint32_t product = 0;
+		for (uint32_t m = 1U << 31; m; m >>= 1) {
+			if (a & m) product ^= b;
+			b = (b & 1) ? (b >> 1) ^ castagnoli : b >> 1;
+		}
+		return product;
+	}
+
+	/**
+	 * @brief x^(8 * length) modulo the CRC polynomial, multiplying a raw CRC by it appends length zero bytes
+	 */
+	uint32_t shiftConstant(size_t length) {
+		uint32_t result = 1U << 31;		// x^0
+		uint32_t power = 1U << 23;		// x^8, one byte
+		while (length) {
+			if (length & 1) result = multiplyModP(power, result);
+			power = multiplyModP(power, power);
+			length >>= 1;
+		}
+		return result;
+	}
+}
+
+//===================================================================================================================================
+//											                 SCALAR KERNELS
+//===================================================================================================================================
+
+namespace {
+
+	void accumulateScalar(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t stripes) {
+		for (size_t s = 0; s < stripes; s++) {
+			const uint8_t* in = input + s * stripeLength;
+			const uint8_t* key = secret + s * secretConsumeRate;
+
+			for (size_t lane = 0; lane < 8; lane++) {
+				const uint64_t data = read64(in + lane * 8);
+				const uint64_t keyed = data ^ read64(key + lane * 8);
+				acc[lane ^ 1] += data;
+				acc[lane] += (keyed & 0xFFFFFFFFULL) * (keyed >> 32);
+			}
+		}
+	}
+
+	void scrambleScalar(uint64_t* acc, const uint8_t* secret) {
+		for (size_t lane = 0; lane < 8; lane++) {
+			uint64_t value = acc[lane];
+			value ^= value >> 47;
+			value ^= read64(secret + lane * 8);
+			acc[lane] = value * prime32_1;
+		}
+	}
+
+	uint32_t crcScalar(uint32_t crc, const uint8_t* data, size_t length) {
+		// Slicing-by-8, eight table lookups per word instead of eight dependent shifts
+		while (length >= 8) {
+			const uint32_t low = crc ^ read32(data);
+			const uint32_t high = read32(data + 4);
+			crc = crcTables[7][low & 0xFF] ^ crcTables[6][(low >> 8) & 0xFF] ^
+				  crcTables[5][(low >> 16) & 0xFF] ^ crcTables[4][low >> 24] ^
+				  crcTables[3][high & 0xFF] ^ crcTables[2][(high >> 8) & 0xFF] ^
+				  crcTables[1][(high >> 16) & 0xFF] ^ crcTables[0][high >> 24];
+			data += 8;
+			length -= 8;
+		}
+		while (length--) {
+			crc = (crc >> 8) ^ crcTables[0][(crc ^ *data++) & 0xFF];
+		}
+		return crc;
+	}
+}
+
+//===================================================================================================================================
+//											                  X86-64 KERNELS
+//===================================================================================================================================
+
+#if defined(ARCH_x64)
+namespace {
+
+	// SSE2 is part of the x86-64 baseline so it needs no target attribute
+	void accumulateSse2(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t stripes) {
+		__m128i* lanes = reinterpret_cast<__m128i*>(acc);
+		__m128i sums[4] = { lanes[0], lanes[1], lanes[2], lanes[3] };
+
+		for (size_t s = 0; s < stripes; s++) {
+			const uint8_t* in = input + s * stripeLength;
+			const uint8_t* key = secret + s * secretConsumeRate;
+
+			for (size_t i = 0; i < 4; i++) {
+				const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in) + i);
+				const __m128i keyed = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key) + i));
+				const __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+				const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+				sums[i] = _mm_add_epi64(sums[i], _mm_add_epi64(product, swapped));
+			}
+		}
+
+		for (size_t i = 0; i < 4; i++) lanes[i] = sums[i];
+	}
+
+	void scrambleSse2(uint64_t* acc, const uint8_t* secret) {
+		__m128i* lanes = reinterpret_cast<__m128i*>(acc);
+		const __m128i prime = _mm_set1_epi32(static_cast<int>(prime32_1));
+
+		for (size_t i = 0; i < 4; i++) {
+			__m128i value = _mm_xor_si128(lanes[i], _mm_srli_epi64(lanes[i], 47));
+			value = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+
+			// 64x32 multiply from two 32x32 halves
+			const __m128i low = _mm_mul_epu32(value, prime);
+			const __m128i high = _mm_mul_epu32(_mm_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+			lanes[i] = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+		}
+	}
+
+	UTK_TARGET("avx2")
+	void accumulateAvx2(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t stripes) {
+		__m256i* lanes = reinterpret_cast<__m256i*>(acc);
+		__m256i sums[2] = { lanes[0], lanes[1] };
+
+		for (size_t s = 0; s < stripes; s++) {
+			const uint8_t* in = input + s * stripeLength;
+			const uint8_t* key = secret + s * secretConsumeRate;
+
+			for (size_t i = 0; i < 2; i++) {
+				const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in) + i);
+				const __m256i keyed = _mm256_xor_si256(data, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key) + i));
+				const __m256i product = _mm256_mul_epu32(keyed, _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+				const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+				sums[i] = _mm256_add_epi64(sums[i], _mm256_add_epi64(product, swapped));
+			}
+		}
+
+		lanes[0] = sums[0];
+		lanes[1] = sums[1];
+	}
+
+	UTK_TARGET("avx2")
+	void scrambleAvx2(uint64_t* acc, const uint8_t* secret) {
+		__m256i* lanes = reinterpret_cast<__m256i*>(acc);
+		const __m256i prime = _mm256_set1_epi32(static_cast<int>(prime32_1));
+
+		for (size_t i = 0; i < 2; i++) {
+			__m256i value = _mm256_xor_si256(lanes[i], _mm256_srli_epi64(lanes[i], 47));
+			value = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+
+			const __m256i low = _mm256_mul_epu32(value, prime);
+			const __m256i high = _mm256_mul_epu32(_mm256_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+			lanes[i] = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+		}
+	}
+
+	// GCC 12's AVX-512 headers trip -Wuninitialized on their own undefined-vector placeholders
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wuninitialized"
+	#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+	UTK_TARGET("avx512f")
+	void accumulateAvx512(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t stripes) {
+		__m512i sums = _mm512_load_si512(acc);
+
+		for (size_t s = 0; s < stripes; s++) {
+			const __m512i data = _mm512_loadu_si512(input + s * stripeLength);
+			const __m512i keyed = _mm512_xor_si512(data, _mm512_loadu_si512(secret + s * secretConsumeRate));
+			const __m512i product = _mm512_mul_epu32(keyed, _mm512_srli_epi64(keyed, 32));
+			const __m512i swapped = _mm512_shuffle_epi32(data, static_cast<_MM_PERM_ENUM>(_MM_SHUFFLE(1, 0, 3, 2)));
+			sums = _mm512_add_epi64(sums, _mm512_add_epi64(product, swapped));
+		}
+
+		_mm512_store_si512(acc, sums);
+	}
+
+	UTK_TARGET("avx512f")
+	void scrambleAvx512(uint64_t* acc, const uint8_t* secret) {
+		const __m512i prime = _mm512_set1_epi32(static_cast<int>(prime32_1));
+
+		__m512i value = _mm512_load_si512(acc);
+		value = _mm512_xor_si512(value, _mm512_srli_epi64(value, 47));
+		value = _mm512_xor_si512(value, _mm512_loadu_si512(secret));
+
+		const __m512i low = _mm512_mul_epu32(value, prime);
+		const __m512i high = _mm512_mul_epu32(_mm512_srli_epi64(value, 32), prime);
+		_mm512_store_si512(acc, _mm512_add_epi64(low, _mm512_slli_epi64(high, 32)));
+	}
+
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic pop
+#endif
+
+	UTK_TARGET("sse4.2")
+	uint32_t crcLinear(uint32_t crc, const uint8_t* data, size_t length) {
+		uint64_t value = crc;
+		while (length >= 8) {
+			value = _mm_crc32_u64(value, read64(data));
+			data += 8;
+			length -= 8;
+		}
+
+		uint32_t result = static_cast<uint32_t>(value);
+		while (length--) {
+			result = _mm_crc32_u8(result, *data++);
+		}
+		return result;
+	}
+
+	UTK_TARGET("sse4.2")
+	uint32_t crcSse42(uint32_t crc, const uint8_t* data, size_t length) {
+		// The crc32 instruction has a latency of three cycles but a throughput of one, so three
+		// independent streams keep the unit busy. The partial results are recombined by shifting
+		// the earlier streams over the bytes that follow them.
+		static constexpr size_t block = 4096;
+		static const uint32_t shiftOne = shiftConstant(block);
+		static const uint32_t shiftTwo = shiftConstant(block * 2);
+
+		while (length >= block * 3) {
+			uint64_t a = crc, b = 0, c = 0;
+			for (size_t i = 0; i < block; i += 8) {
+				a = _mm_crc32_u64(a, read64(data + i));
+				b = _mm_crc32_u64(b, read64(data + block + i));
+				c = _mm_crc32_u64(c, read64(data + block * 2 + i));
+			}
+
+			crc = multiplyModP(shiftTwo, static_cast<uint32_t>(a)) ^
+				  multiplyModP(shiftOne, static_cast<uint32_t>(b)) ^ static_cast<uint32_t>(c);
+			data += block * 3;
+			length -= block * 3;
+		}
+
+		return crcLinear(crc, data, length);
+	}
+
+	struct cpuFeatures {
+		bool sse42 = false;
+		bool avx2 = false;
+		bool avx512 = false;
+	};
+
+	cpuFeatures detectFeatures() {
+		cpuFeatures features;
+	#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		const int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		features.sse42 = (info[2] & (1 << 20)) != 0;
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+
+		if (maxLeaf >= 7) {
+			__cpuidex(info, 7, 0);
+			// The OS must also save the wider registers on context switch
+			features.avx2 = (info[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6;
+			features.avx512 = (info[1] & (1 << 16)) && (xcr0 & 0xE6) == 0xE6;
+		}
+	#else
+		__builtin_cpu_init();
+		features.sse42 = __builtin_cpu_supports("sse4.2");
+		features.avx2 = __builtin_cpu_supports("avx2");
+		features.avx512 = __builtin_cpu_supports("avx512f");
+	#endif
+		return features;
+	}
+}
+#endif
+
+//===================================================================================================================================
+//											                  ARM64 KERNELS
+//===================================================================================================================================
+
+#if defined(ARCH_ARM64)
+namespace {
+
+	// NEON is mandatory on AArch64
+	void accumulateNeon(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t stripes) {
+		uint64x2_t sums[4] = { vld1q_u64(acc), vld1q_u64(acc + 2), vld1q_u64(acc + 4), vld1q_u64(acc + 6) };
+
+		for (size_t s = 0; s < stripes; s++) {
+			const uint8_t* in = input + s * stripeLength;
+			const uint8_t* key = secret + s * secretConsumeRate;
+
+			for (size_t i = 0; i < 4; i++) {
+				const uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(in + i * 16));
+				const uint64x2_t keyed = veorq_u64(data, vreinterpretq_u64_u8(vld1q_u8(key + i * 16)));
+				sums[i] = vaddq_u64(sums[i], vextq_u64(data, data, 1));
+				sums[i] = vmlal_u32(sums[i], vmovn_u64(keyed), vshrn_n_u64(keyed, 32));
+			}
+		}
+
+		for (size_t i = 0; i < 4; i++) vst1q_u64(acc + i * 2, sums[i]);
+	}
+
+	void scrambleNeon(uint64_t* acc, const uint8_t* secret) {
+		const uint32x2_t prime = vdup_n_u32(prime32_1);
+
+		for (size_t i = 0; i < 4; i++) {
+			uint64x2_t value = vld1q_u64(acc + i * 2);
+			value = veorq_u64(value, vshrq_n_u64(value, 47));
+			value = veorq_u64(value, vreinterpretq_u64_u8(vld1q_u8(secret + i * 16)));
+
+			const uint64x2_t high = vshlq_n_u64(vmull_u32(vshrn_n_u64(value, 32), prime), 32);
+			vst1q_u64(acc + i * 2, vmlal_u32(high, vmovn_u64(value), prime));
+		}
+	}
+
+	#if defined(__ARM_FEATURE_CRC32)
+	uint32_t crcArmv8(uint32_t crc, const uint8_t* data, size_t length) {
+		while (length >= 8) {
+			crc = __crc32cd(crc, read64(data));
+			data += 8;
+			length -= 8;
+		}
+		while (length--) {
+			crc = __crc32cb(crc, *data++);
+		}
+		return crc;
+	}
+	#endif
+}
+#endif
+
+//===================================================================================================================================
+//											                 KERNEL DISPATCH
+//===================================================================================================================================
+
+namespace {
+
+	constexpr hashKernel scalarHash{ "scalar", accumulateScalar, scrambleScalar };
+	constexpr crcKernel scalarCrc{ "scalar", crcScalar };
+
+	/**
+	 * @brief Every kernel usable on this CPU, slowest first so the last entry is the default
+	 */
+	vector<const hashKernel*> supportedHash() {
+		vector<const hashKernel*> kernels{ &scalarHash };
+
+	#if defined(ARCH_x64)
+		static constexpr hashKernel sse2{ "sse2", accumulateSse2, scrambleSse2 };
+		static constexpr hashKernel avx2{ "avx2", accumulateAvx2, scrambleAvx2 };
+		static constexpr hashKernel avx512{ "avx512", accumulateAvx512, scrambleAvx512 };
+
+		const cpuFeatures features = detectFeatures();
+		kernels.push_back(&sse2);
+		if (features.avx2) kernels.push_back(&avx2);
+		if (features.avx512) kernels.push_back(&avx512);
+	#elif defined(ARCH_ARM64)
+		static constexpr hashKernel neon{ "neon", accumulateNeon, scrambleNeon };
+		kernels.push_back(&neon);
+	#endif
+
+		return kernels;
+	}
+
+	vector<const crcKernel*> supportedCrc() {
+		vector<const crcKernel*> kernels{ &scalarCrc };
+
+	#if defined(ARCH_x64)
+		static constexpr crcKernel sse42{ "sse4.2", crcSse42 };
+		if (detectFeatures().sse42) kernels.push_back(&sse42);
+	#elif defined(ARCH_ARM64) && defined(__ARM_FEATURE_CRC32)
+		static constexpr crcKernel armv8{ "armv8-crc", crcArmv8 };
+		kernels.push_back(&armv8);
+	#endif
+
+		return kernels;
+	}
+
+	atomic<const hashKernel*>& hashSlot() {
+		static atomic<const hashKernel*> slot{ supportedHash().back() };
+		return slot;
+	}
+
+	atomic<const crcKernel*>& crcSlot() {
+		static atomic<const crcKernel*> slot{ supportedCrc().back() };
+		return slot;
+	}
+
+	template<typename Kernel>
+	bool selectKernel(atomic<const Kernel*>& slot, const vector<const Kernel*>& kernels, string_view name) {
+		auto it = find_if(kernels.begin(), kernels.end(), [&](const Kernel* k) { return name == k->name; });
+		if (it == kernels.end()) return false;
+
+		slot.store(*it, memory_order_release);
+		return true;
+	}
+
+	template<typename Kernel>
+	vector<string_view> kernelNames(const vector<const Kernel*>& kernels) {
+		vector<string_view> names;
+		for (const Kernel* k : kernels) names.emplace_back(k->name);
+		return names;
+	}
+}
+
+const hashKernel& UTK::Hash::Kernels::activeHash() {
+	return *hashSlot().load(memory_order_acquire);
+}
+
+const crcKernel& UTK::Hash::Kernels::activeCrc() {
+	return *crcSlot().load(memory_order_acquire);
+}
+
+UTK::Hash::kernelSet UTK::Hash::activeKernels() {
+	return { activeHash().name, activeCrc().name };
+}
+
+vector<string_view> UTK::Hash::availableHashKernels() {
+	return kernelNames(supportedHash());
+}
+
+vector<string_view> UTK::Hash::availableCrcKernels() {
+	return kernelNames(supportedCrc());
+}
+
+bool UTK::Hash::selectHashKernel(string_view name) {
+	return selectKernel(hashSlot(), supportedHash(), name);
+}
+
+bool UTK::Hash::selectCrcKernel(string_view name) {
+	return selectKernel(crcSlot(), supportedCrc(), name);
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+//===================================================================================================================================
+// @file	utkhashkernels.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Internal header shared by the UTK::Hash sources, declares the runtime selected kernels that
+//			run the XXH3 accumulate/scramble loops and CRC32C.
+//===================================================================================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace UTK::Hash::Kernels {
+
+	inline constexpr std::size_t stripeLength = 64;
+	inline constexpr std::size_t secretConsumeRate = 8;
+
+	/**
+	 * @brief XXH3 long-input loops, acc is eight 64-bit lanes aligned to 64 bytes
+	 */
+	struct hashKernel {
+		const char* name;
+		void (*accumulate)(std::uint64_t* acc, const std::uint8_t* input, const std::uint8_t* secret, std::size_t stripes);
+		void (*scramble)(std::uint64_t* acc, const std::uint8_t* secret);
+	};
+
+	/**
+	 * @brief Raw CRC32C update, no pre/post inversion
+	 */
+	struct crcKernel {
+		const char* name;
+		std::uint32_t (*update)(std::uint32_t crc, const std::uint8_t* data, std::size_t length);
+	};
+
+	const hashKernel& activeHash();
+	const crcKernel& activeCrc();
+}
\ No newline at end of file
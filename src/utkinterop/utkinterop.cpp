@@ -0,0 +1,227 @@
+//===================================================================================================================================
+// @file	utkinterop.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the extern "C" bindings over UTK's logging dispatcher.
+//===================================================================================================================================
+
+#include "interop/utkinterop.h"
+#include "dispatchers/utkdispatch.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <new>
+
+using namespace std;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+using namespace UTK::Types::LogEntry;
+
+//===================================================================================================================================
+//													 UTK DISPATCHER DEFINITION
+//===================================================================================================================================
+
+struct utk_dispatcher {
+	logDispatcher dispatcher;
+
+	utk_dispatcher(size_t sinkCapacity, Backpressure policy) : dispatcher(sinkCapacity, policy) {}
+};
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	thread_local string lastError;
+
+	/// Runs fn, turning anything it throws into a status so no exception unwinds into C
+	template <typename Fn>
+	utk_status guarded(Fn&& fn) noexcept {
+		try {
+			fn();
+			lastError.clear();
+			return UTK_OK;
+		}
+		catch (const invalid_argument& e) {
+			lastError = e.what();
+			return UTK_ERR_INVALID_ARGUMENT;
+		}
+		catch (const bad_alloc&) {
+			lastError = "Out of memory";
+			return UTK_ERR_OUT_OF_MEMORY;
+		}
+		catch (const exception& e) {
+			lastError = e.what();
+			return UTK_ERR_INTERNAL;
+		}
+		catch (...) {
+			lastError = "Unknown error";
+			return UTK_ERR_INTERNAL;
+		}
+	}
+
+	logDispatcher& unwrap(utk_dispatcher* dispatcher) {
+		if (!dispatcher) throw invalid_argument("Dispatcher handle is null");
+		return dispatcher->dispatcher;
+	}
+
+	Logger toLogger(uint32_t logger) {
+		if (logger > static_cast<uint32_t>(Logger::ARCHIVE)) throw invalid_argument("Unknown logger: " + to_string(logger));
+		return static_cast<Logger>(logger);
+	}
+
+	Operations toOperation(uint32_t op) {
+		if (op > static_cast<uint32_t>(Operations::LG_NOP)) throw invalid_argument("Unknown operation: " + to_string(op));
+		return static_cast<Operations>(op);
+	}
+
+	Backpressure toPolicy(uint32_t policy) {
+		if (policy > static_cast<uint32_t>(Backpressure::BLOCK)) throw invalid_argument("Unknown backpressure policy: " + to_string(policy));
+		return static_cast<Backpressure>(policy);
+	}
+
+	bool validString(const utk_str& str) {
+		return str.data || !str.length;
+	}
+
+	/// Checks every pointer an entry carries, so a bad entry fails before anything is copied or queued
+	void validate(const utk_log_entry& entry) {
+		toLogger(entry.logger);
+		toOperation(entry.op);
+
+		if (!entry.fields && entry.fieldCount) throw invalid_argument("Entry has fields but a null field array");
+		for (size_t i = 0; i < entry.fieldCount; i++) {
+			if (!validString(entry.fields[i].key) || !validString(entry.fields[i].value)) {
+				throw invalid_argument("Null string with a non zero length in field " + to_string(i));
+			}
+		}
+		if (!validString(entry.file) || !validString(entry.function)) throw invalid_argument("Null file or function with a non zero length");
+	}
+
+	/// The one copy out of the caller's buffers, the queue must own its strings as dispatch is asynchronous
+	logEntry toEntry(const utk_log_entry& in) {
+
+		logEntry entry{ static_cast<Logger>(in.logger), static_cast<Operations>(in.op), {}, {} };
+
+		entry.formatKeys.reserve(in.fieldCount);
+		entry.formatValues.reserve(in.fieldCount);
+		for (size_t i = 0; i < in.fieldCount; i++) {
+			entry.formatKeys.emplace_back(in.fields[i].key.data, in.fields[i].key.length);
+			entry.formatValues.emplace_back(in.fields[i].value.data, in.fields[i].value.length);
+		}
+
+		if (in.file.length) entry.fileName.emplace(in.file.data, in.file.length);
+		if (in.line >= 0) entry.fileLine = in.line;
+		if (in.function.length) entry.funcName.emplace(in.function.data, in.function.length);
+
+		return entry;
+	}
+
+	/// Filtered entries would be dropped on push, skip building them at all
+	bool wanted(const logDispatcher& dispatcher, const utk_log_entry& entry) {
+		return dispatcher.isEnabled(static_cast<Logger>(entry.logger), static_cast<Operations>(entry.op));
+	}
+}
+
+//===================================================================================================================================
+//											           C API IMPLEMENTATIONS
+//===================================================================================================================================
+
+extern "C" {
+
+	UTK_API utk_dispatcher* UTK_API_CALL utk_dispatcher_create(size_t sinkCapacity, uint32_t policy) {
+
+		utk_dispatcher* created = nullptr;
+		guarded([&] {
+			if (!sinkCapacity) throw invalid_argument("Sink capacity must be at least one entry");
+			created = new utk_dispatcher(sinkCapacity, toPolicy(policy));
+		});
+		return created;
+	}
+
+	UTK_API void UTK_API_CALL utk_dispatcher_destroy(utk_dispatcher* dispatcher) {
+		guarded([&] { delete dispatcher; });
+	}
+
+	UTK_API utk_status UTK_API_CALL utk_log_push(utk_dispatcher* dispatcher, const utk_log_entry* entry) {
+
+		return guarded([&] {
+			logDispatcher& target = unwrap(dispatcher);
+			if (!entry) throw invalid_argument("Entry is null");
+
+			validate(*entry);
+			if (wanted(target, *entry)) target.pushEntry(toEntry(*entry));
+		});
+	}
+
+	UTK_API utk_status UTK_API_CALL utk_log_push_batch(utk_dispatcher* dispatcher, const utk_log_entry* entries, size_t count) {
+
+		return guarded([&] {
+			logDispatcher& target = unwrap(dispatcher);
+			if (!entries && count) throw invalid_argument("Entry array is null");
+
+			// All or nothing, a bad entry halfway through must not leave the first half queued
+			for (size_t i = 0; i < count; i++) {
+				try {
+					validate(entries[i]);
+				}
+				catch (const invalid_argument& e) {
+					throw invalid_argument("Entry " + to_string(i) + ": " + e.what());
+				}
+			}
+
+			vector<logEntry> batch;
+			batch.reserve(count);
+			for (size_t i = 0; i < count; i++) {
+				if (wanted(target, entries[i])) batch.push_back(toEntry(entries[i]));
+			}
+
+			if (!batch.empty()) target.pushEntries(move(batch));
+		});
+	}
+
+	UTK_API utk_status UTK_API_CALL utk_dispatch(utk_dispatcher* dispatcher) {
+		return guarded([&] { unwrap(dispatcher).dispatchLogs(); });
+	}
+
+	UTK_API utk_status UTK_API_CALL utk_flush(utk_dispatcher* dispatcher) {
+		return guarded([&] {
+			logDispatcher& target = unwrap(dispatcher);
+			target.dispatchLogs();
+			target.flush();
+		});
+	}
+
+	UTK_API utk_status UTK_API_CALL utk_set_operation_filter(utk_dispatcher* dispatcher, uint32_t logger, const uint32_t* ops, size_t count) {
+
+		return guarded([&] {
+			logDispatcher& target = unwrap(dispatcher);
+			if (!ops && count) throw invalid_argument("Operation array is null");
+
+			vector<Operations> enabled;
+			enabled.reserve(count);
+			for (size_t i = 0; i < count; i++) enabled.push_back(toOperation(ops[i]));
+
+			target.setOperationFilter(toLogger(logger), enabled);
+		});
+	}
+
+	UTK_API utk_status UTK_API_CALL utk_configure_sink(utk_dispatcher* dispatcher, uint32_t logger, size_t capacity, uint32_t policy) {
+
+		return guarded([&] {
+			logDispatcher& target = unwrap(dispatcher);
+			if (!capacity) throw invalid_argument("Sink capacity must be at least one entry");
+			target.configureSink(toLogger(logger), capacity, toPolicy(policy));
+		});
+	}
+
+	UTK_API const char* UTK_API_CALL utk_last_error(void) {
+		return lastError.c_str();
+	}
+
+	UTK_API uint32_t UTK_API_CALL utk_version(void) {
+		return UTK_VERSION;
+	}
+}
\ No newline at end of file
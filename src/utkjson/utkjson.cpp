@@ -0,0 +1,926 @@
+//===================================================================================================================================
+// @file	utkjson.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the structural indexer, the validating second stage and the lazy element
+//			accessors of UTK::JSON.
+//===================================================================================================================================
+
+#include "json/utkjson.hpp"
+#include "utkjsonkernels.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <climits>
+#include <bit>
+
+#if defined(__WINDOWS__)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+using namespace std;
+using namespace UTK::JSON;
+using namespace UTK::JSON::Kernels;
+
+//===================================================================================================================================
+//											               DOCUMENT STORAGE
+//===================================================================================================================================
+
+namespace UTK::JSON::Internal {
+
+	/**
+	 * @brief A read-only mapping of a whole file, empty files are not mapped at all
+	 */
+	class mappedFile {
+	private:
+		const char* _data = nullptr;
+		std::size_t _size = 0;
+	#if defined(__WINDOWS__)
+		HANDLE _file = INVALID_HANDLE_VALUE;
+		HANDLE _mapping = nullptr;
+	#endif
+
+	public:
+		explicit mappedFile(const filesystem::path& path) {
+		#if defined(__WINDOWS__)
+			_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (_file == INVALID_HANDLE_VALUE) throw runtime_error("Failed to open JSON file: " + path.string());
+
+			LARGE_INTEGER size{};
+			GetFileSizeEx(_file, &size);
+			_size = static_cast<std::size_t>(size.QuadPart);
+			if (_size == 0) return;
+
+			_mapping = CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			_data = _mapping ? static_cast<const char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+			if (!_data) {
+				if (_mapping) CloseHandle(_mapping);
+				CloseHandle(_file);
+				throw runtime_error("Failed to map JSON file: " + path.string());
+			}
+		#else
+			const int fd = open(path.c_str(), O_RDONLY);
+			if (fd < 0) throw runtime_error("Failed to open JSON file: " + path.string());
+
+			struct stat info{};
+			if (fstat(fd, &info) != 0) {
+				close(fd);
+				throw runtime_error("Failed to read JSON file size: " + path.string());
+			}
+
+			_size = static_cast<std::size_t>(info.st_size);
+			if (_size > 0) {
+				void* mapped = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (mapped == MAP_FAILED) {
+					close(fd);
+					throw runtime_error("Failed to map JSON file: " + path.string());
+				}
+				// Both stages read front to back
+				madvise(mapped, _size, MADV_SEQUENTIAL);
+				_data = static_cast<const char*>(mapped);
+			}
+			close(fd);
+		#endif
+		}
+
+		~mappedFile() {
+		#if defined(__WINDOWS__)
+			if (_data) UnmapViewOfFile(_data);
+			if (_mapping) CloseHandle(_mapping);
+			if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+		#else
+			if (_data) munmap(const_cast<char*>(_data), _size);
+		#endif
+		}
+
+		mappedFile(const mappedFile&) = delete;
+		mappedFile& operator=(const mappedFile&) = delete;
+
+		string_view view() const { return { _data, _size }; }
+	};
+
+	struct parsedDocument {
+		string_view json;					// Text this index covers, one batch when streaming
+		string_view whole;					// Complete input, only used to place errors
+		std::size_t origin = 0;				// Offset of json within whole
+
+		unique_ptr<uint32_t[]> positions;	// Byte offset of each structural, plus a sentinel of json.size()
+		unique_ptr<uint32_t[]> matches;		// For an opening bracket, the token index of its closer
+		std::size_t capacity = 0;
+		uint32_t count = 0;
+
+		vector<uint32_t> roots;
+		vector<uint32_t> stack;
+		unique_ptr<mappedFile> file;
+
+		char at(uint32_t token) const { return json[positions[token]]; }
+
+		/// Scalar text up to the next structural, trailing whitespace dropped
+		string_view scalar(uint32_t token) const {
+			const uint32_t begin = positions[token];
+			uint32_t end = positions[token + 1];
+			while (end > begin && (json[end - 1] == ' ' || json[end - 1] == '\t' || json[end - 1] == '\n' || json[end - 1] == '\r')) end--;
+			return json.substr(begin, end - begin);
+		}
+
+		uint32_t skip(uint32_t token) const {
+			const char c = at(token);
+			return (c == '{' || c == '[') ? matches[token] + 1 : token + 1;
+		}
+
+		[[noreturn]] void fail(std::size_t offset, const string& message) const {
+			const std::size_t absolute = min(origin + offset, whole.size());
+			std::size_t line = 1, column = 1;
+			for (std::size_t i = 0; i < absolute; i++) {
+				if (whole[i] == '\n') {
+					line++;
+					column = 1;
+				}
+				else {
+					column++;
+				}
+			}
+			throw runtime_error("JSON error at line " + to_string(line) + ", column " + to_string(column) + ": " + message);
+		}
+
+		[[noreturn]] void failAt(uint32_t token, const string& message) const {
+			fail(positions[token], message);
+		}
+	};
+}
+
+using UTK::JSON::Internal::parsedDocument;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	constexpr uint64_t oddBits = 0xAAAAAAAAAAAAAAAAULL;
+
+	/// Bit i set when an odd number of quotes precede or sit at byte i, i.e. byte i is inside a string
+	inline uint64_t prefixXor(uint64_t bits) {
+		bits ^= bits << 1;
+		bits ^= bits << 2;
+		bits ^= bits << 4;
+		bits ^= bits << 8;
+		bits ^= bits << 16;
+		bits ^= bits << 32;
+		return bits;
+	}
+
+	/**
+	 * @brief Marks the bytes escaped by a backslash, a run of backslashes escapes every other one
+	 *
+	 * @note Subtracting the run starts from the odd bit pattern carries through each run and flips at its
+	 *		 end, which leaves the escaped positions set without a loop. nextEscaped carries a run that
+	 *		 ends exactly on a block boundary into the next block.
+	 */
+	inline uint64_t escapedBytes(uint64_t backslash, uint64_t& nextEscaped) {
+		if (!backslash) {
+			const uint64_t escaped = nextEscaped;
+			nextEscaped = 0;
+			return escaped;
+		}
+
+		const uint64_t potential = backslash & ~nextEscaped;
+		const uint64_t codes = (((potential << 1) | oddBits) - potential) ^ oddBits;
+		const uint64_t escaped = codes ^ (backslash | nextEscaped);
+		nextEscaped = (codes & backslash) >> 63;
+		return escaped;
+	}
+
+	bool validNumber(string_view text) {
+		size_t i = 0;
+		const size_t n = text.size();
+		auto digit = [&](size_t at) { return at < n && text[at] >= '0' && text[at] <= '9'; };
+
+		if (i < n && text[i] == '-') i++;
+		if (!digit(i)) return false;
+		if (text[i] == '0') i++;
+		else while (digit(i)) i++;
+
+		if (i < n && text[i] == '.') {
+			if (!digit(++i)) return false;
+			while (digit(i)) i++;
+		}
+		if (i < n && (text[i] == 'e' || text[i] == 'E')) {
+			i++;
+			if (i < n && (text[i] == '+' || text[i] == '-')) i++;
+			if (!digit(i)) return false;
+			while (digit(i)) i++;
+		}
+		return i == n;
+	}
+
+	void appendUtf8(string& out, uint32_t code) {
+		if (code < 0x80) {
+			out += static_cast<char>(code);
+		}
+		else if (code < 0x800) {
+			out += static_cast<char>(0xC0 | (code >> 6));
+			out += static_cast<char>(0x80 | (code & 0x3F));
+		}
+		else if (code < 0x10000) {
+			out += static_cast<char>(0xE0 | (code >> 12));
+			out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (code & 0x3F));
+		}
+		else {
+			out += static_cast<char>(0xF0 | (code >> 18));
+			out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+			out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+			out += static_cast<char>(0x80 | (code & 0x3F));
+		}
+	}
+
+	uint32_t readHex4(string_view raw, size_t at) {
+		uint32_t code = 0;
+		if (at + 4 > raw.size()) throw runtime_error("JSON string has a truncated \\u escape");
+
+		auto [end, ec] = from_chars(raw.data() + at, raw.data() + at + 4, code, 16);
+		if (ec != errc() || end != raw.data() + at + 4) throw runtime_error("JSON string has a malformed \\u escape");
+		return code;
+	}
+
+	void unescape(string_view raw, string& out) {
+		out.clear();
+		out.reserve(raw.size());
+
+		size_t i = 0;
+		while (i < raw.size()) {
+			// Copy the plain run up to the next escape in one go
+			const size_t slash = raw.find('\\', i);
+			out.append(raw.substr(i, slash == string_view::npos ? string_view::npos : slash - i));
+			if (slash == string_view::npos) break;
+
+			i = slash + 1;
+			if (i >= raw.size()) throw runtime_error("JSON string ends in a lone backslash");
+
+			switch (raw[i++]) {
+			case '"': out += '"'; break;
+			case '\\': out += '\\'; break;
+			case '/': out += '/'; break;
+			case 'b': out += '\b'; break;
+			case 'f': out += '\f'; break;
+			case 'n': out += '\n'; break;
+			case 'r': out += '\r'; break;
+			case 't': out += '\t'; break;
+			case 'u': {
+				uint32_t code = readHex4(raw, i);
+				i += 4;
+
+				// A high surrogate must be followed by an escaped low one, together they make one code point
+				if (code >= 0xD800 && code <= 0xDBFF) {
+					if (i + 6 > raw.size() || raw[i] != '\\' || raw[i + 1] != 'u') throw runtime_error("JSON string has an unpaired surrogate");
+					const uint32_t low = readHex4(raw, i + 2);
+					if (low < 0xDC00 || low > 0xDFFF) throw runtime_error("JSON string has an unpaired surrogate");
+					code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+					i += 6;
+				}
+				else if (code >= 0xDC00 && code <= 0xDFFF) {
+					throw runtime_error("JSON string has an unpaired surrogate");
+				}
+				appendUtf8(out, code);
+				break;
+			}
+			default:
+				throw runtime_error("JSON string has an invalid escape");
+			}
+		}
+	}
+
+	//===================================================================================================================================
+	//											            STAGE ONE, STRUCTURAL INDEX
+	//===================================================================================================================================
+
+	struct scanState {
+		uint64_t nextEscaped = 0;
+		uint64_t inString = 0;				// All ones while a string is open across a block boundary
+		uint64_t previousScalar = 0;
+		size_t controlError = SIZE_MAX;
+		size_t escapeError = SIZE_MAX;
+	};
+
+	inline bool isHex(char c) {
+		return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+	}
+
+	/// Escapes are rare, so their letters are checked byte by byte only in blocks that have any
+	void checkEscapes(const parsedDocument& d, scanState& state, uint64_t escaped, size_t base) {
+		for (; escaped && state.escapeError == SIZE_MAX; escaped &= escaped - 1) {
+			const size_t at = base + static_cast<size_t>(countr_zero(escaped));
+			if (at >= d.json.size()) return;		// Trailing backslash, reported as an unterminated string
+
+			switch (d.json[at]) {
+			case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+				break;
+			case 'u':
+				if (at + 4 >= d.json.size() || !isHex(d.json[at + 1]) || !isHex(d.json[at + 2]) || !isHex(d.json[at + 3]) || !isHex(d.json[at + 4])) {
+					state.escapeError = at - 1;
+				}
+				break;
+			default:
+				state.escapeError = at - 1;
+			}
+		}
+	}
+
+	void growIndex(parsedDocument& d, size_t needed) {
+		if (needed <= d.capacity) return;
+
+		const size_t capacity = max(needed, d.capacity * 2);
+		auto positions = make_unique_for_overwrite<uint32_t[]>(capacity);
+		if (d.count) memcpy(positions.get(), d.positions.get(), d.count * sizeof(uint32_t));
+
+		d.positions = move(positions);
+		d.matches = make_unique_for_overwrite<uint32_t[]>(capacity);
+		d.capacity = capacity;
+	}
+
+	inline void scanBlock(parsedDocument& d, scanState& state, const blockMasks& masks, uint32_t base) {
+		const uint64_t escaped = escapedBytes(masks.backslash, state.nextEscaped);
+		const uint64_t quote = masks.quote & ~escaped;
+		if (escaped) checkEscapes(d, state, escaped, base);
+
+		// Opening quote included, closing quote excluded
+		const uint64_t inString = prefixXor(quote) ^ state.inString;
+		state.inString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+		if ((masks.control & inString) && state.controlError == SIZE_MAX) {
+			state.controlError = base + static_cast<size_t>(countr_zero(masks.control & inString));
+		}
+
+		// A scalar starts where a non-operator, non-space byte follows something that is not part of one
+		const uint64_t scalar = ~(masks.operators | masks.whitespace);
+		const uint64_t plainScalar = scalar & ~quote;
+		const uint64_t followsScalar = (plainScalar << 1) | state.previousScalar;
+		state.previousScalar = plainScalar >> 63;
+
+		const uint64_t stringTail = inString ^ quote;
+		uint64_t structurals = (masks.operators | (scalar & ~followsScalar)) & ~stringTail;
+
+		// Unconditionally writing eight keeps the common case branch free, the count fixes up afterwards
+		uint32_t* out = d.positions.get() + d.count;
+		const int total = popcount(structurals);
+
+		for (int i = 0; i < 8; i++) {
+			out[i] = base + static_cast<uint32_t>(countr_zero(structurals));
+			structurals &= structurals - 1;
+		}
+		if (total > 8) {
+			for (int i = 8; i < 16; i++) {
+				out[i] = base + static_cast<uint32_t>(countr_zero(structurals));
+				structurals &= structurals - 1;
+			}
+			for (int i = 16; structurals; i++) {
+				out[i] = base + static_cast<uint32_t>(countr_zero(structurals));
+				structurals &= structurals - 1;
+			}
+		}
+		d.count += static_cast<uint32_t>(total);
+	}
+
+	void indexStructurals(parsedDocument& d) {
+		const auto* data = reinterpret_cast<const uint8_t*>(d.json.data());
+		const size_t size = d.json.size();
+		if (size > UINT32_MAX - blockSize) d.fail(0, "document larger than 4GB, split it or stream it as NDJSON");
+
+		constexpr size_t batchBlocks = 64;
+		blockMasks masks[batchBlocks];
+		const auto classify = activeScan().classify;
+
+		d.count = 0;
+		growIndex(d, size / 8 + 2 * blockSize);
+
+		scanState state;
+		const size_t fullBlocks = size / blockSize;
+
+		for (size_t b = 0; b < fullBlocks; b += batchBlocks) {
+			const size_t blocks = min(batchBlocks, fullBlocks - b);
+			classify(data + b * blockSize, blocks, masks);
+			growIndex(d, d.count + blocks * blockSize + 1);
+
+			for (size_t i = 0; i < blocks; i++) {
+				scanBlock(d, state, masks[i], static_cast<uint32_t>((b + i) * blockSize));
+			}
+		}
+
+		// The tail is copied into a space padded block so no kernel reads past the input
+		if (const size_t tail = size % blockSize) {
+			uint8_t padded[blockSize];
+			memset(padded, ' ', sizeof(padded));
+			memcpy(padded, data + fullBlocks * blockSize, tail);
+
+			classify(padded, 1, masks);
+			growIndex(d, d.count + blockSize + 1);
+			scanBlock(d, state, masks[0], static_cast<uint32_t>(fullBlocks * blockSize));
+		}
+
+		if (state.controlError != SIZE_MAX) d.fail(state.controlError, "unescaped control character in string");
+		if (state.escapeError != SIZE_MAX) d.fail(state.escapeError, "invalid escape in string");
+		if (state.inString) {
+			// The open string's quote is the last structural that is one
+			uint32_t token = d.count;
+			while (token > 0 && d.at(token - 1) != '"') token--;
+			d.fail(token ? d.positions[token - 1] : size, "unterminated string");
+		}
+
+		d.positions[d.count] = static_cast<uint32_t>(size);
+	}
+
+	//===================================================================================================================================
+	//											           STAGE TWO, GRAMMAR AND BRACKETS
+	//===================================================================================================================================
+
+	void validateScalar(const parsedDocument& d, uint32_t token) {
+		const string_view text = d.scalar(token);
+
+		switch (text[0]) {
+		case '"':
+			return;
+		case 't':
+			if (text != "true") d.failAt(token, "invalid literal '" + string(text) + "'");
+			return;
+		case 'f':
+			if (text != "false") d.failAt(token, "invalid literal '" + string(text) + "'");
+			return;
+		case 'n':
+			if (text != "null") d.failAt(token, "invalid literal '" + string(text) + "'");
+			return;
+		case '}': case ']': case ',': case ':':
+			d.failAt(token, string("expected a value but found '") + text[0] + "'");
+		default:
+			if (!validNumber(text)) d.failAt(token, "invalid value '" + string(text.substr(0, 32)) + "'");
+		}
+	}
+
+	/**
+	 * @brief Checks the token sequence against the JSON grammar and records every bracket's partner
+	 */
+	void validate(parsedDocument& d, parseMode mode) {
+		const uint32_t count = d.count;
+		d.roots.clear();
+
+		uint32_t i = 0;
+		while (i < count) {
+			if (mode == parseMode::single && !d.roots.empty()) d.failAt(i, "unexpected content after the document");
+			d.roots.push_back(i);
+			d.stack.clear();
+
+			// After '{' or ',' inside an object: a string key then a colon, leaves i on the value
+			auto expectKey = [&]() {
+				if (i >= count || d.at(i) != '"') {
+					if (i >= count) d.fail(d.json.size(), "unexpected end of input, expected a key");
+					d.failAt(i, "expected a string key");
+				}
+				if (++i >= count || d.at(i) != ':') {
+					if (i >= count) d.fail(d.json.size(), "unexpected end of input, expected ':'");
+					d.failAt(i, "expected ':' after key");
+				}
+				i++;
+			};
+
+			bool needValue = true;
+			for (;;) {
+				if (needValue) {
+					if (i >= count) d.fail(d.json.size(), "unexpected end of input, expected a value");
+
+					const char c = d.at(i);
+					if (c == '{' || c == '[') {
+						const char close = c == '{' ? '}' : ']';
+						d.stack.push_back(i++);
+
+						if (i < count && d.at(i) == close) {
+							d.matches[d.stack.back()] = i++;
+							d.stack.pop_back();
+						}
+						else {
+							if (c == '{') expectKey();
+							continue;
+						}
+					}
+					else {
+						validateScalar(d, i++);
+					}
+					needValue = false;
+				}
+
+				if (d.stack.empty()) break;
+				if (i >= count) d.failAt(d.stack.back(), string("unclosed '") + d.at(d.stack.back()) + "'");
+
+				const char open = d.at(d.stack.back());
+				const char c = d.at(i);
+
+				if (c == ',') {
+					i++;
+					if (open == '{') expectKey();
+					needValue = true;
+				}
+				else if ((open == '{' && c == '}') || (open == '[' && c == ']')) {
+					d.matches[d.stack.back()] = i++;
+					d.stack.pop_back();
+				}
+				else {
+					d.failAt(i, open == '{' ? "expected ',' or '}'" : "expected ',' or ']'");
+				}
+			}
+		}
+	}
+
+	void parseInto(parsedDocument& d, parseMode mode) {
+		indexStructurals(d);
+		validate(d, mode);
+		if (mode == parseMode::single && d.roots.empty()) d.fail(d.json.size(), "document is empty");
+	}
+
+	const char* kindName(kind type) {
+		switch (type) {
+		case kind::null: return "null";
+		case kind::boolean: return "bool";
+		case kind::number: return "number";
+		case kind::string: return "string";
+		case kind::array: return "array";
+		case kind::object: return "object";
+		}
+		return "value";
+	}
+}
+
+//===================================================================================================================================
+//											             ELEMENT METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+namespace {
+
+	void requireKind(const element& value, kind expected) {
+		if (value.type() != expected) {
+			throw runtime_error(string("JSON value is a ") + kindName(value.type()) + ", not a " + kindName(expected));
+		}
+	}
+
+	/**
+	 * @brief For a validated number from_chars found out of range, true if it is too small rather than too large
+	 *
+	 * @note Compares the decimal exponent of the first significant digit against zero, anything out of range
+	 *		 below 1.0 can only be an underflow. The written exponent saturates, it may have any number of digits.
+	 */
+	bool underflows(string_view text) {
+
+		const size_t at = (text[0] == '-') ? 1 : 0;
+		const size_t integerEnd = min(text.find_first_of(".eE", at), text.size());
+
+		int64_t leading;
+		if (text[at] != '0') {
+			leading = static_cast<int64_t>(integerEnd - at) - 1;
+		} else {
+			// JSON forbids leading zeros, so a zero integer part means the digits start in the fraction. A zero
+			// fraction is never out of range, the first non-zero byte is always a significant digit here.
+			const size_t digit = text.find_first_not_of('0', integerEnd + 1);
+			leading = -static_cast<int64_t>(min(digit, text.size()) - integerEnd);
+		}
+
+		const size_t marker = text.find_first_of("eE", integerEnd);
+		if (marker == string_view::npos) return leading < 0;
+
+		size_t digits = marker + 1;
+		const bool negative = text[digits] == '-';
+		if (text[digits] == '-' || text[digits] == '+') digits++;
+
+		// Past 2^40 the exponent outweighs any digit count a 4GB document can hold
+		int64_t exponent = 0;
+		auto [end, ec] = from_chars(text.data() + digits, text.data() + text.size(), exponent);
+		if (ec == errc::result_out_of_range || exponent > (int64_t{ 1 } << 40)) return negative;
+		return (negative ? leading - exponent : leading + exponent) < 0;
+	}
+}
+
+kind element::type() const {
+
+	switch (_doc->at(_token)) {
+	case '{': return kind::object;
+	case '[': return kind::array;
+	case '"': return kind::string;
+	case 't': case 'f': return kind::boolean;
+	case 'n': return kind::null;
+	default: return kind::number;
+	}
+}
+
+bool element::getBool() const {
+
+	requireKind(*this, kind::boolean);
+	return _doc->at(_token) == 't';
+}
+
+std::int64_t element::getInt64() const {
+
+	requireKind(*this, kind::number);
+	const string_view text = _doc->scalar(_token);
+
+	std::int64_t number = 0;
+	auto [end, ec] = from_chars(text.data(), text.data() + text.size(), number);
+	if (ec != errc() || end != text.data() + text.size()) throw runtime_error("JSON number " + string(text) + " is not a 64-bit integer");
+	return number;
+}
+
+std::uint64_t element::getUint64() const {
+
+	requireKind(*this, kind::number);
+	const string_view text = _doc->scalar(_token);
+
+	std::uint64_t number = 0;
+	auto [end, ec] = from_chars(text.data(), text.data() + text.size(), number);
+	if (ec != errc() || end != text.data() + text.size()) throw runtime_error("JSON number " + string(text) + " is not an unsigned 64-bit integer");
+	return number;
+}
+
+double element::getDouble() const {
+
+	requireKind(*this, kind::number);
+	const string_view text = _doc->scalar(_token);
+
+	double number = 0.0;
+	auto [end, ec] = from_chars(text.data(), text.data() + text.size(), number);
+
+	// Below half the smallest denormal the nearest double is zero, keep the sign like any other rounding would
+	if (ec == errc::result_out_of_range && end == text.data() + text.size() && underflows(text)) {
+		return (text[0] == '-') ? -0.0 : 0.0;
+	}
+	if (ec != errc() || end != text.data() + text.size()) throw runtime_error("JSON number " + string(text) + " is out of range for a double");
+	return number;
+}
+
+bool element::isInteger() const {
+
+	if (type() != kind::number) return false;
+	return _doc->scalar(_token).find_first_of(".eE") == string_view::npos;
+}
+
+string_view element::rawString() const {
+
+	requireKind(*this, kind::string);
+	const string_view text = _doc->scalar(_token);
+	return text.substr(1, text.size() - 2);
+}
+
+string_view element::getString(string& scratch) const {
+
+	const string_view raw = rawString();
+	if (raw.find('\\') == string_view::npos) return raw;
+
+	unescape(raw, scratch);
+	return scratch;
+}
+
+string element::getString() const {
+
+	string scratch;
+	const string_view text = getString(scratch);
+	return text.data() == scratch.data() ? move(scratch) : string(text);
+}
+
+UTK::JSON::array element::getArray() const {
+
+	requireKind(*this, kind::array);
+	return UTK::JSON::array(_doc, _token);
+}
+
+object element::getObject() const {
+
+	requireKind(*this, kind::object);
+	return object(_doc, _token);
+}
+
+element element::operator[](string_view key) const {
+
+	if (auto found = getObject().find(key)) return *found;
+	throw runtime_error("JSON object has no member \"" + string(key) + "\"");
+}
+
+element element::at(std::size_t index) const {
+
+	std::size_t position = 0;
+	for (element item : getArray()) {
+		if (position++ == index) return item;
+	}
+	throw runtime_error("JSON array index " + to_string(index) + " out of range");
+}
+
+string_view element::raw() const {
+
+	const char c = _doc->at(_token);
+	if (c != '{' && c != '[') return _doc->scalar(_token);
+
+	const uint32_t begin = _doc->positions[_token];
+	const uint32_t end = _doc->positions[_doc->matches[_token]] + 1;
+	return _doc->json.substr(begin, end - begin);
+}
+
+//===================================================================================================================================
+//											        ARRAY & OBJECT METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+UTK::JSON::array::iterator& UTK::JSON::array::iterator::operator++() {
+
+	_token = _doc->skip(_token);
+	if (_doc->at(_token) == ',') _token++;
+	return *this;
+}
+
+UTK::JSON::array::iterator UTK::JSON::array::begin() const {
+	return iterator(_doc, _open + 1);
+}
+
+UTK::JSON::array::iterator UTK::JSON::array::end() const {
+	return iterator(_doc, _doc->matches[_open]);
+}
+
+std::size_t UTK::JSON::array::size() const {
+	return static_cast<std::size_t>(distance(begin(), end()));
+}
+
+member object::iterator::operator*() const {
+
+	const string_view key = _doc->scalar(_token);
+	return { key.substr(1, key.size() - 2), element(_doc, _token + 2) };
+}
+
+object::iterator& object::iterator::operator++() {
+
+	_token = _doc->skip(_token + 2);
+	if (_doc->at(_token) == ',') _token++;
+	return *this;
+}
+
+object::iterator object::begin() const {
+	return iterator(_doc, _open + 1);
+}
+
+object::iterator object::end() const {
+	return iterator(_doc, _doc->matches[_open]);
+}
+
+std::size_t object::size() const {
+	return static_cast<std::size_t>(distance(begin(), end()));
+}
+
+optional<element> object::find(string_view key) const {
+
+	string scratch;
+	for (const member entry : *this) {
+		// Keys are nearly always escape free, only decode the ones that are not
+		if (entry.key.find('\\') == string_view::npos) {
+			if (entry.key == key) return entry.value;
+		}
+		else {
+			unescape(entry.key, scratch);
+			if (scratch == key) return entry.value;
+		}
+	}
+	return nullopt;
+}
+
+//===================================================================================================================================
+//											             DOCUMENT METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+document::document(unique_ptr<parsedDocument> parsed) : _parsed(move(parsed)) {}
+document::document(document&&) noexcept = default;
+document& document::operator=(document&&) noexcept = default;
+document::~document() = default;
+
+document document::parse(string_view json, parseMode mode) {
+
+	auto parsed = make_unique<parsedDocument>();
+	parsed->json = parsed->whole = json;
+	parseInto(*parsed, mode);
+	return document(move(parsed));
+}
+
+document document::load(const filesystem::path& path, parseMode mode) {
+
+	auto parsed = make_unique<parsedDocument>();
+	parsed->file = make_unique<Internal::mappedFile>(path);
+	parsed->json = parsed->whole = parsed->file->view();
+	parseInto(*parsed, mode);
+	return document(move(parsed));
+}
+
+element document::root() const {
+
+	if (_parsed->roots.empty()) throw runtime_error("JSON document has no values");
+	return element(_parsed.get(), _parsed->roots.front());
+}
+
+std::size_t document::size() const {
+	return _parsed->roots.size();
+}
+
+element document::operator[](std::size_t index) const {
+
+	if (index >= _parsed->roots.size()) throw runtime_error("JSON document index " + to_string(index) + " out of range");
+	return element(_parsed.get(), _parsed->roots[index]);
+}
+
+string_view document::text() const {
+	return _parsed->json;
+}
+
+//===================================================================================================================================
+//											                 NDJSON STREAMING
+//===================================================================================================================================
+
+std::size_t UTK::JSON::forEachDocument(string_view ndjson, const function<void(element)>& fn, std::size_t batchBytes) {
+
+	parsedDocument d;
+	d.whole = ndjson;
+	batchBytes = max<std::size_t>(batchBytes, blockSize);
+
+	std::size_t visited = 0;
+	std::size_t pos = 0;
+
+	while (pos < ndjson.size()) {
+		// Cut after the last newline in the batch, or the first one past it for a very long line
+		std::size_t end = ndjson.size();
+		if (ndjson.size() - pos > batchBytes) {
+			std::size_t cut = ndjson.rfind('\n', pos + batchBytes - 1);
+			if (cut == string_view::npos || cut < pos) cut = ndjson.find('\n', pos + batchBytes);
+			if (cut != string_view::npos) end = cut + 1;
+		}
+
+		d.json = ndjson.substr(pos, end - pos);
+		d.origin = pos;
+		parseInto(d, parseMode::many);
+
+		for (uint32_t root : d.roots) {
+			fn(element(&d, root));
+			visited++;
+		}
+		pos = end;
+	}
+
+	return visited;
+}
+
+std::size_t UTK::JSON::forEachDocument(const filesystem::path& path, const function<void(element)>& fn, std::size_t batchBytes) {
+
+	Internal::mappedFile file(path);
+	return forEachDocument(file.view(), fn, batchBytes);
+}
+
+//===================================================================================================================================
+//											              SCHEMA FIELD CONVERSION
+//===================================================================================================================================
+
+Field UTK::JSON::toField(const element& value) {
+
+	switch (value.type()) {
+	case kind::null:
+		return Field(monostate{});
+
+	case kind::boolean:
+		return Field(value.getBool());
+
+	case kind::number: {
+		const std::int64_t number = value.isInteger() ? value.getInt64() : INT64_MAX;
+		if (number < INT_MIN || number > INT_MAX) {
+			throw runtime_error("JSON number " + string(value.raw()) + " does not fit an int Field");
+		}
+		return Field(static_cast<int>(number));
+	}
+
+	case kind::string:
+		return Field(value.getString());
+
+	case kind::array: {
+		vector<Field> items;
+		for (element item : value.getArray()) items.push_back(toField(item));
+		return Field(move(items));
+	}
+
+	case kind::object:
+		break;
+	}
+	throw runtime_error("JSON objects have no Field form, convert their members with toFields");
+}
+
+vector<pair<string, Field>> UTK::JSON::toFields(const object& members) {
+
+	vector<pair<string, Field>> fields;
+	string scratch;
+
+	for (const member entry : members) {
+		string name = entry.key.find('\\') == string_view::npos ? string(entry.key) : (unescape(entry.key, scratch), scratch);
+		fields.emplace_back(move(name), toField(entry.value));
+	}
+	return fields;
+}
\ No newline at end of file
@@ -0,0 +1,335 @@
+//===================================================================================================================================
+// @file	utkjsonkernels.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the scalar and SIMD byte classifiers behind UTK::JSON's structural scan,
+//			and the CPU feature detection that picks between them.
+//
+// @note    Classification is the only ISA specific part of the scan, every kernel turns 64 bytes into the
+//			same five bitmasks and the portable code in utkjson.cpp does the rest. Kernels handle a run of
+//			blocks per call so the indirect call is paid per few kilobytes rather than per block.
+//===================================================================================================================================
+
+#include "utkjsonkernels.hpp"
+#include "json/utkjson.hpp"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#if defined(ARCH_x64)
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <immintrin.h>
+	#endif
+#elif defined(ARCH_ARM64)
+	#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+	#define UTK_TARGET(features)
+#else
+	#define UTK_TARGET(features) __attribute__((target(features)))
+#endif
+
+using namespace std;
+using namespace UTK::JSON::Kernels;
+
+//===================================================================================================================================
+//											                 SCALAR KERNEL
+//===================================================================================================================================
+
+namespace {
+
+	void classifyScalar(const uint8_t* data, size_t blocks, blockMasks* out) {
+		for (size_t b = 0; b < blocks; b++, data += blockSize) {
+			blockMasks masks{};
+
+			for (size_t i = 0; i < blockSize; i++) {
+				const uint8_t c = data[i];
+				const uint64_t bit = uint64_t{ 1 } << i;
+
+				if (c == '\\') masks.backslash |= bit;
+				if (c == '"') masks.quote |= bit;
+				if ((c | 0x20) == '{' || (c | 0x20) == '}' || c == ':' || c == ',') masks.operators |= bit;
+				if (c == ' ' || c == '\t' || c == '\n' || c == '\r') masks.whitespace |= bit;
+				if (c < 0x20) masks.control |= bit;
+			}
+			out[b] = masks;
+		}
+	}
+}
+
+//===================================================================================================================================
+//											                  x86-64 KERNELS
+//===================================================================================================================================
+
+#if defined(ARCH_x64)
+namespace {
+
+	inline uint64_t movemask128(__m128i m, int shift) {
+		return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(m))) << shift;
+	}
+
+	UTK_TARGET("avx2")
+	inline uint64_t movemask256(__m256i m, int shift) {
+		return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(m))) << shift;
+	}
+
+	// '[' and ']' differ from '{' and '}' only in bit 0x20, setting it folds four compares into two
+	void classifySse2(const uint8_t* data, size_t blocks, blockMasks* out) {
+		const __m128i backslash = _mm_set1_epi8('\\');
+		const __m128i quote = _mm_set1_epi8('"');
+		const __m128i openBrace = _mm_set1_epi8('{');
+		const __m128i closeBrace = _mm_set1_epi8('}');
+		const __m128i colon = _mm_set1_epi8(':');
+		const __m128i comma = _mm_set1_epi8(',');
+		const __m128i space = _mm_set1_epi8(' ');
+		const __m128i tab = _mm_set1_epi8('\t');
+		const __m128i lineFeed = _mm_set1_epi8('\n');
+		const __m128i carriage = _mm_set1_epi8('\r');
+		const __m128i caseBit = _mm_set1_epi8(0x20);
+		const __m128i controlMax = _mm_set1_epi8(0x1F);
+
+		for (size_t b = 0; b < blocks; b++, data += blockSize) {
+			blockMasks masks{};
+
+			for (int i = 0; i < 4; i++) {
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16));
+				const __m128i folded = _mm_or_si128(v, caseBit);
+				const int shift = i * 16;
+
+				masks.backslash |= movemask128(_mm_cmpeq_epi8(v, backslash), shift);
+				masks.quote |= movemask128(_mm_cmpeq_epi8(v, quote), shift);
+				masks.operators |= movemask128(_mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(folded, openBrace), _mm_cmpeq_epi8(folded, closeBrace)),
+					_mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma))), shift);
+				masks.whitespace |= movemask128(_mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+					_mm_or_si128(_mm_cmpeq_epi8(v, lineFeed), _mm_cmpeq_epi8(v, carriage))), shift);
+				// Unsigned v <= 0x1F, SSE2 has no unsigned byte compare but max does the job
+				masks.control |= movemask128(_mm_cmpeq_epi8(_mm_max_epu8(v, controlMax), controlMax), shift);
+			}
+			out[b] = masks;
+		}
+	}
+
+	UTK_TARGET("avx2")
+	void classifyAvx2(const uint8_t* data, size_t blocks, blockMasks* out) {
+		const __m256i backslash = _mm256_set1_epi8('\\');
+		const __m256i quote = _mm256_set1_epi8('"');
+		const __m256i openBrace = _mm256_set1_epi8('{');
+		const __m256i closeBrace = _mm256_set1_epi8('}');
+		const __m256i colon = _mm256_set1_epi8(':');
+		const __m256i comma = _mm256_set1_epi8(',');
+		const __m256i space = _mm256_set1_epi8(' ');
+		const __m256i tab = _mm256_set1_epi8('\t');
+		const __m256i lineFeed = _mm256_set1_epi8('\n');
+		const __m256i carriage = _mm256_set1_epi8('\r');
+		const __m256i caseBit = _mm256_set1_epi8(0x20);
+		const __m256i controlMax = _mm256_set1_epi8(0x1F);
+
+		for (size_t b = 0; b < blocks; b++, data += blockSize) {
+			blockMasks masks{};
+
+			for (int i = 0; i < 2; i++) {
+				const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i * 32));
+				const __m256i folded = _mm256_or_si256(v, caseBit);
+				const int shift = i * 32;
+
+				masks.backslash |= movemask256(_mm256_cmpeq_epi8(v, backslash), shift);
+				masks.quote |= movemask256(_mm256_cmpeq_epi8(v, quote), shift);
+				masks.operators |= movemask256(_mm256_or_si256(
+					_mm256_or_si256(_mm256_cmpeq_epi8(folded, openBrace), _mm256_cmpeq_epi8(folded, closeBrace)),
+					_mm256_or_si256(_mm256_cmpeq_epi8(v, colon), _mm256_cmpeq_epi8(v, comma))), shift);
+				masks.whitespace |= movemask256(_mm256_or_si256(
+					_mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+					_mm256_or_si256(_mm256_cmpeq_epi8(v, lineFeed), _mm256_cmpeq_epi8(v, carriage))), shift);
+				masks.control |= movemask256(_mm256_cmpeq_epi8(_mm256_max_epu8(v, controlMax), controlMax), shift);
+			}
+			out[b] = masks;
+		}
+	}
+
+	// GCC 12's AVX-512 headers trip -Wuninitialized on their own undefined-vector placeholders
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wuninitialized"
+	#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+	UTK_TARGET("avx512f,avx512bw")
+	void classifyAvx512(const uint8_t* data, size_t blocks, blockMasks* out) {
+		const __m512i backslash = _mm512_set1_epi8('\\');
+		const __m512i quote = _mm512_set1_epi8('"');
+		const __m512i openBrace = _mm512_set1_epi8('{');
+		const __m512i closeBrace = _mm512_set1_epi8('}');
+		const __m512i colon = _mm512_set1_epi8(':');
+		const __m512i comma = _mm512_set1_epi8(',');
+		const __m512i space = _mm512_set1_epi8(' ');
+		const __m512i tab = _mm512_set1_epi8('\t');
+		const __m512i lineFeed = _mm512_set1_epi8('\n');
+		const __m512i carriage = _mm512_set1_epi8('\r');
+		const __m512i caseBit = _mm512_set1_epi8(0x20);
+		const __m512i controlLimit = _mm512_set1_epi8(0x20);
+
+		for (size_t b = 0; b < blocks; b++, data += blockSize) {
+			const __m512i v = _mm512_loadu_si512(data);
+			const __m512i folded = _mm512_or_si512(v, caseBit);
+
+			out[b].backslash = _mm512_cmpeq_epi8_mask(v, backslash);
+			out[b].quote = _mm512_cmpeq_epi8_mask(v, quote);
+			out[b].operators = _mm512_cmpeq_epi8_mask(folded, openBrace) | _mm512_cmpeq_epi8_mask(folded, closeBrace) |
+				_mm512_cmpeq_epi8_mask(v, colon) | _mm512_cmpeq_epi8_mask(v, comma);
+			out[b].whitespace = _mm512_cmpeq_epi8_mask(v, space) | _mm512_cmpeq_epi8_mask(v, tab) |
+				_mm512_cmpeq_epi8_mask(v, lineFeed) | _mm512_cmpeq_epi8_mask(v, carriage);
+			out[b].control = _mm512_cmplt_epu8_mask(v, controlLimit);
+		}
+	}
+
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic pop
+#endif
+
+	struct cpuFeatures {
+		bool avx2 = false;
+		bool avx512 = false;
+	};
+
+	cpuFeatures detectFeatures() {
+		cpuFeatures features;
+	#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		const int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+
+		if (maxLeaf >= 7) {
+			__cpuidex(info, 7, 0);
+			// The OS must also save the wider registers on context switch
+			features.avx2 = (info[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6;
+			features.avx512 = (info[1] & (1 << 16)) && (info[1] & (1 << 30)) && (xcr0 & 0xE6) == 0xE6;
+		}
+	#else
+		__builtin_cpu_init();
+		features.avx2 = __builtin_cpu_supports("avx2");
+		features.avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+	#endif
+		return features;
+	}
+}
+#endif
+
+//===================================================================================================================================
+//											                  ARM64 KERNELS
+//===================================================================================================================================
+
+#if defined(ARCH_ARM64)
+namespace {
+
+	// NEON has no movemask, weight each lane by its bit and fold the four vectors with pairwise adds
+	inline uint64_t movemaskNeon(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3) {
+		static const uint8_t weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+		const uint8x16_t bit = vld1q_u8(weights);
+
+		uint8x16_t sum0 = vpaddq_u8(vandq_u8(m0, bit), vandq_u8(m1, bit));
+		uint8x16_t sum1 = vpaddq_u8(vandq_u8(m2, bit), vandq_u8(m3, bit));
+		sum0 = vpaddq_u8(sum0, sum1);
+		sum0 = vpaddq_u8(sum0, sum0);
+		return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+	}
+
+	// NEON is mandatory on AArch64
+	void classifyNeon(const uint8_t* data, size_t blocks, blockMasks* out) {
+		const uint8x16_t caseBit = vdupq_n_u8(0x20);
+
+		for (size_t b = 0; b < blocks; b++, data += blockSize) {
+			uint8x16_t v[4], folded[4];
+			for (int i = 0; i < 4; i++) {
+				v[i] = vld1q_u8(data + i * 16);
+				folded[i] = vorrq_u8(v[i], caseBit);
+			}
+
+			auto mask = [&](auto&& test) {
+				return movemaskNeon(test(0), test(1), test(2), test(3));
+			};
+
+			out[b].backslash = mask([&](int i) { return vceqq_u8(v[i], vdupq_n_u8('\\')); });
+			out[b].quote = mask([&](int i) { return vceqq_u8(v[i], vdupq_n_u8('"')); });
+			out[b].operators = mask([&](int i) {
+				return vorrq_u8(vorrq_u8(vceqq_u8(folded[i], vdupq_n_u8('{')), vceqq_u8(folded[i], vdupq_n_u8('}'))),
+					vorrq_u8(vceqq_u8(v[i], vdupq_n_u8(':')), vceqq_u8(v[i], vdupq_n_u8(','))));
+			});
+			out[b].whitespace = mask([&](int i) {
+				return vorrq_u8(vorrq_u8(vceqq_u8(v[i], vdupq_n_u8(' ')), vceqq_u8(v[i], vdupq_n_u8('\t'))),
+					vorrq_u8(vceqq_u8(v[i], vdupq_n_u8('\n')), vceqq_u8(v[i], vdupq_n_u8('\r'))));
+			});
+			out[b].control = mask([&](int i) { return vcltq_u8(v[i], vdupq_n_u8(0x20)); });
+		}
+	}
+}
+#endif
+
+//===================================================================================================================================
+//											                 KERNEL DISPATCH
+//===================================================================================================================================
+
+namespace {
+
+	constexpr scanKernel scalarScan{ "scalar", classifyScalar };
+
+	/**
+	 * @brief Every kernel usable on this CPU, slowest first so the last entry is the default
+	 */
+	vector<const scanKernel*> supportedScan() {
+		vector<const scanKernel*> kernels{ &scalarScan };
+
+	#if defined(ARCH_x64)
+		static constexpr scanKernel sse2{ "sse2", classifySse2 };
+		static constexpr scanKernel avx2{ "avx2", classifyAvx2 };
+		static constexpr scanKernel avx512{ "avx512", classifyAvx512 };
+
+		const cpuFeatures features = detectFeatures();
+		kernels.push_back(&sse2);
+		if (features.avx2) kernels.push_back(&avx2);
+		if (features.avx512) kernels.push_back(&avx512);
+	#elif defined(ARCH_ARM64)
+		static constexpr scanKernel neon{ "neon", classifyNeon };
+		kernels.push_back(&neon);
+	#endif
+
+		return kernels;
+	}
+
+	atomic<const scanKernel*>& scanSlot() {
+		static atomic<const scanKernel*> slot{ supportedScan().back() };
+		return slot;
+	}
+}
+
+const scanKernel& UTK::JSON::Kernels::activeScan() {
+	return *scanSlot().load(memory_order_acquire);
+}
+
+string_view UTK::JSON::activeKernel() {
+	return activeScan().name;
+}
+
+vector<string_view> UTK::JSON::availableKernels() {
+	vector<string_view> names;
+	for (const scanKernel* k : supportedScan()) names.emplace_back(k->name);
+	return names;
+}
+
+bool UTK::JSON::selectKernel(string_view name) {
+	const auto kernels = supportedScan();
+	auto it = find_if(kernels.begin(), kernels.end(), [&](const scanKernel* k) { return name == k->name; });
+	if (it == kernels.end()) return false;
+
+	scanSlot().store(*it, memory_order_release);
+	return true;
+}
\ No newline at end of file
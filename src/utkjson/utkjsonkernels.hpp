@@ -0,0 +1,39 @@
+//===================================================================================================================================
+// @file	utkjsonkernels.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Internal header shared by the UTK::JSON sources, declares the runtime selected kernels that
+//			classify input bytes for the structural scan.
+//===================================================================================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace UTK::JSON::Kernels {
+
+	inline constexpr std::size_t blockSize = 64;
+
+	/**
+	 * @brief One bit per input byte of a 64 byte block, bit i is byte i
+	 */
+	struct blockMasks {
+		std::uint64_t backslash;
+		std::uint64_t quote;
+		std::uint64_t operators;		// { } [ ] : ,
+		std::uint64_t whitespace;		// Space, tab, line feed, carriage return
+		std::uint64_t control;			// Bytes below 0x20, never allowed raw inside a string
+	};
+
+	/**
+	 * @brief Classifies whole blocks, data holds blocks * blockSize bytes
+	 */
+	struct scanKernel {
+		const char* name;
+		void (*classify)(const std::uint8_t* data, std::size_t blocks, blockMasks* out);
+	};
+
+	const scanKernel& activeScan();
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+//===================================================================================================================================
+// @file	utklogd.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+// 
+// @brief   Local log collector. Processes that call logDispatcher::enableCollector register their
+//			shared-memory ring here, and their entries are merged into this process's sinks.
+// 
+// @note    Usage: utklogd [socket path(default: /tmp/utklogd.sock)] [poll interval ms(default: 20)]
+//			[reorder window ms(default: 50)]
+//===================================================================================================================================
+
+#include "dispatchers/utkdispatch.hpp"
+#include <iostream>
+#include <csignal>
+#include <atomic>
+#include <string>
+
+using namespace std;
+using namespace UTK::Dispatch;
+
+static atomic<bool> running{ true };
+
+extern "C" void onStopSignal(int) {
+	running = false;
+}
+
+int main(int argc, char* argv[]) {
+
+	const string socketPath = (argc > 1) ? argv[1] : "/tmp/utklogd.sock";
+
+	try {
+		const int interval = (argc > 2) ? stoi(argv[2]) : 20;
+		const int reorderWindow = (argc > 3) ? stoi(argv[3]) : 50;
+
+		signal(SIGINT, onStopSignal);
+		signal(SIGTERM, onStopSignal);
+
+		logDispatcher dispatcher;
+		{
+			logCollector collector(socketPath, dispatcher, reorderWindow);
+			cerr << "[utklogd] Collecting on " << socketPath << "\n";
+
+			while (running) {
+				collector.poll(interval);
+			}
+		}
+
+		dispatcher.flush();
+	}
+	catch (const std::exception& e) {
+		cerr << "[utklogd] " << e.what() << "\n";
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
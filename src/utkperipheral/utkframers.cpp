@@ -0,0 +1,217 @@
+//===================================================================================================================================
+// @file	utkframers.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the frame decoders and encoders provided by UTK::Peripheral.
+//===================================================================================================================================
+
+#include "peripheral/utkperipheral.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+using namespace UTK::Peripheral;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	constexpr unsigned char slipEnd = 0xC0;
+	constexpr unsigned char slipEsc = 0xDB;
+	constexpr unsigned char slipEscEnd = 0xDC;
+	constexpr unsigned char slipEscEsc = 0xDD;
+}
+
+//===================================================================================================================================
+//											          DELIMITED FRAMER METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+delimitedFramer::delimitedFramer(string delimiter, size_t maxFrame) : _delimiter(move(delimiter)), _maxFrame(maxFrame) {
+	if (_delimiter.empty()) throw runtime_error("Frame delimiter must not be empty");
+}
+
+IFramer::scan delimitedFramer::next(char* data, size_t size) {
+
+	const size_t delimiterBytes = _delimiter.size();
+	const size_t at = string_view(data, size).find(_delimiter, _searched);
+
+	if (at == string_view::npos) {
+		if (size > _maxFrame + delimiterBytes) {
+			// Too long to ever be a frame, drop it but keep a tail that may be the start of a delimiter
+			_searched = 0;
+			_skipping = true;
+			return { size - (delimiterBytes - 1), {}, false };
+		}
+
+		_searched = (size >= delimiterBytes) ? size - delimiterBytes + 1 : 0;
+		return {};
+	}
+
+	const bool keep = !_skipping && at <= _maxFrame;
+	_searched = 0;
+	_skipping = false;
+
+	if (!keep) return { at + delimiterBytes, {}, false };
+	return { at + delimiterBytes, string_view(data, at), true };
+}
+
+void delimitedFramer::reset() {
+	_searched = 0;
+	_skipping = true;
+}
+
+void delimitedFramer::encode(string_view payload, string& out) const {
+	out.append(payload).append(_delimiter);
+}
+
+//===================================================================================================================================
+//											        LENGTH PREFIXED FRAMER METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+lengthPrefixedFramer::lengthPrefixedFramer(size_t headerBytes, bool bigEndian, size_t maxFrame)
+	: _headerBytes(headerBytes), _bigEndian(bigEndian), _maxFrame(maxFrame) {
+
+	if (headerBytes != 1 && headerBytes != 2 && headerBytes != 4) throw runtime_error("Length prefix must be 1, 2 or 4 bytes");
+}
+
+IFramer::scan lengthPrefixedFramer::next(char* data, size_t size) {
+
+	if (size < _headerBytes) return {};
+
+	size_t length = 0;
+	for (size_t i = 0; i < _headerBytes; i++) {
+		const auto byte = static_cast<unsigned char>(data[_bigEndian ? i : _headerBytes - 1 - i]);
+		length = (length << 8) | byte;
+	}
+
+	// A length past the limit means the stream is out of step, slide a byte at a time until a plausible header
+	if (length > _maxFrame) return { 1, {}, false };
+	if (size < _headerBytes + length) return {};
+
+	return { _headerBytes + length, string_view(data + _headerBytes, length), true };
+}
+
+void lengthPrefixedFramer::encode(string_view payload, string& out) const {
+
+	const size_t limit = (_headerBytes == 4) ? UINT32_MAX : (size_t(1) << (_headerBytes * 8)) - 1;
+	if (payload.size() > limit || payload.size() > _maxFrame) throw runtime_error("Payload too large for the length prefix");
+
+	for (size_t i = 0; i < _headerBytes; i++) {
+		const size_t shift = 8 * (_bigEndian ? _headerBytes - 1 - i : i);
+		out.push_back(static_cast<char>((payload.size() >> shift) & 0xFF));
+	}
+	out.append(payload);
+}
+
+//===================================================================================================================================
+//											            FIXED FRAMER METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+fixedFramer::fixedFramer(size_t frameBytes) : _frameBytes(frameBytes) {
+	if (frameBytes == 0) throw runtime_error("Fixed frames must be at least one byte");
+}
+
+IFramer::scan fixedFramer::next(char* data, size_t size) {
+
+	if (size < _frameBytes) return {};
+	return { _frameBytes, string_view(data, _frameBytes), true };
+}
+
+void fixedFramer::encode(string_view payload, string& out) const {
+
+	if (payload.size() != _frameBytes) throw runtime_error("Payload does not match the fixed frame size");
+	out.append(payload);
+}
+
+//===================================================================================================================================
+//											             SLIP FRAMER METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+slipFramer::slipFramer(size_t maxFrame) : _maxFrame(maxFrame) {}
+
+IFramer::scan slipFramer::next(char* data, size_t size) {
+
+	// END bytes in front of a frame belong to it, they only flush noise
+	size_t start = 0;
+	while (start < size && static_cast<unsigned char>(data[start]) == slipEnd) start++;
+	if (start == size) return {};
+	if (start) _skipping = false;
+
+	const size_t from = max(_searched, start);
+	const void* hit = memchr(data + from, slipEnd, size - from);
+
+	if (!hit) {
+		// Escaping at most doubles a frame, anything longer without an END is junk
+		if (size - start > 2 * _maxFrame) {
+			_searched = 0;
+			_skipping = true;
+			return { size, {}, false };
+		}
+
+		_searched = size;
+		return {};
+	}
+
+	const auto end = static_cast<size_t>(static_cast<const char*>(hit) - data);
+	const scan dropped{ end + 1, {}, false };
+	_searched = 0;
+
+	if (_skipping) {
+		_skipping = false;
+		return dropped;
+	}
+
+	// Unescape over the encoded bytes, the decoded frame is never longer
+	char* frame = data + start;
+	size_t written = 0;
+	for (size_t i = start; i < end; i++) {
+		auto byte = static_cast<unsigned char>(data[i]);
+
+		if (byte == slipEsc) {
+			if (++i == end) return dropped;
+
+			const auto escaped = static_cast<unsigned char>(data[i]);
+			if (escaped == slipEscEnd) byte = slipEnd;
+			else if (escaped == slipEscEsc) byte = slipEsc;
+			else return dropped;
+		}
+		frame[written++] = static_cast<char>(byte);
+	}
+
+	if (written > _maxFrame) return dropped;
+	return { end + 1, string_view(frame, written), true };
+}
+
+void slipFramer::reset() {
+	_searched = 0;
+	_skipping = true;
+}
+
+void slipFramer::encode(string_view payload, string& out) const {
+
+	if (payload.size() > _maxFrame) throw runtime_error("Payload larger than the SLIP frame limit");
+
+	out.reserve(out.size() + payload.size() + 2);
+	out.push_back(static_cast<char>(slipEnd));
+
+	for (const char c : payload) {
+		const auto byte = static_cast<unsigned char>(c);
+		if (byte == slipEnd) {
+			out.push_back(static_cast<char>(slipEsc));
+			out.push_back(static_cast<char>(slipEscEnd));
+		}
+		else if (byte == slipEsc) {
+			out.push_back(static_cast<char>(slipEsc));
+			out.push_back(static_cast<char>(slipEscEsc));
+		}
+		else {
+			out.push_back(c);
+		}
+	}
+
+	out.push_back(static_cast<char>(slipEnd));
+}
\ No newline at end of file
@@ -0,0 +1,621 @@
+//===================================================================================================================================
+// @file	utkperipheral.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the epoll loop, port setup and mirrored ring buffers behind UTK::Peripheral.
+//
+// @note    The loop thread owns every port's descriptor, ring and framer. Other threads only append to a
+//          port's pending output under the engine mutex and post close requests, the loop takes the mutex
+//          once per turn to collect both. Ports are only ever destroyed by the loop, at the end of a turn.
+//===================================================================================================================================
+
+#include "peripheral/utkperipheral.hpp"
+#include <condition_variable>
+#include <unordered_map>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <bit>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <termios.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#endif
+
+using namespace std;
+using namespace UTK::Peripheral;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+#if defined(__linux__)
+
+namespace {
+
+	/// Reads per port per turn, keeps one busy port from starving the rest
+	constexpr int readsPerTurn = 16;
+
+	speed_t toSpeed(uint32_t baudRate) {
+		switch (baudRate) {
+		case 1200: return B1200;
+		case 2400: return B2400;
+		case 4800: return B4800;
+		case 9600: return B9600;
+		case 19200: return B19200;
+		case 38400: return B38400;
+		case 57600: return B57600;
+		case 115200: return B115200;
+		case 230400: return B230400;
+		case 460800: return B460800;
+		case 500000: return B500000;
+		case 576000: return B576000;
+		case 921600: return B921600;
+		case 1000000: return B1000000;
+		case 1500000: return B1500000;
+		case 2000000: return B2000000;
+		case 3000000: return B3000000;
+		case 4000000: return B4000000;
+		default: throw runtime_error("Unsupported baud rate: " + to_string(baudRate));
+		}
+	}
+
+	/// Raw mode, no echo or line editing, reads return whatever has arrived
+	void configure(int fd, const portSettings& settings, const string& device) {
+
+		termios tio{};
+		if (tcgetattr(fd, &tio) != 0) throw runtime_error("Not a serial device: " + device);
+
+		cfmakeraw(&tio);
+		const speed_t speed = toSpeed(settings.baudRate);
+		cfsetispeed(&tio, speed);
+		cfsetospeed(&tio, speed);
+
+		tio.c_cflag &= ~static_cast<tcflag_t>(CSIZE | PARENB | PARODD | CSTOPB | CRTSCTS);
+		switch (settings.dataBits) {
+		case 5: tio.c_cflag |= CS5; break;
+		case 6: tio.c_cflag |= CS6; break;
+		case 7: tio.c_cflag |= CS7; break;
+		case 8: tio.c_cflag |= CS8; break;
+		default: throw runtime_error("Data bits must be 5 to 8");
+		}
+
+		if (settings.parityMode != parity::NONE) tio.c_cflag |= PARENB;
+		if (settings.parityMode == parity::ODD) tio.c_cflag |= PARODD;
+
+		if (settings.stopBits == 2) tio.c_cflag |= CSTOPB;
+		else if (settings.stopBits != 1) throw runtime_error("Stop bits must be 1 or 2");
+
+		if (settings.hardwareFlowControl) tio.c_cflag |= CRTSCTS;
+		tio.c_cflag |= CLOCAL | CREAD;
+		// VMIN 0 would make an empty read return 0 rather than EAGAIN, indistinguishable from a hangup
+		tio.c_cc[VMIN] = 1;
+		tio.c_cc[VTIME] = 0;
+
+		if (tcsetattr(fd, TCSANOW, &tio) != 0) throw runtime_error("Failed to configure " + device + ": " + strerror(errno));
+
+		// Whatever arrived before the port was configured is line noise
+		tcflush(fd, TCIOFLUSH);
+	}
+
+	/**
+	 * @brief Ring buffer whose pages are mapped twice back to back, a read or write at any offset is contiguous
+	 */
+	class mirroredRing {
+	private:
+		char* _base = nullptr;
+		size_t _capacity = 0;
+		uint64_t _head = 0;
+		uint64_t _tail = 0;
+
+	public:
+		explicit mirroredRing(size_t minimum) {
+
+			const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			_capacity = bit_ceil(max(minimum, page));
+
+			const int fd = memfd_create("utk-serial-ring", MFD_CLOEXEC);
+			if (fd < 0) throw runtime_error(string("Failed to create serial ring buffer: ") + strerror(errno));
+
+			if (ftruncate(fd, static_cast<off_t>(_capacity)) != 0) {
+				close(fd);
+				throw runtime_error(string("Failed to size serial ring buffer: ") + strerror(errno));
+			}
+
+			// Reserve both halves first so nothing else can land in the second
+			void* reserved = mmap(nullptr, 2 * _capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (reserved == MAP_FAILED) {
+				close(fd);
+				throw runtime_error(string("Failed to reserve serial ring buffer: ") + strerror(errno));
+			}
+
+			char* base = static_cast<char*>(reserved);
+			const bool mapped = mmap(base, _capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED
+				&& mmap(base + _capacity, _capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+			close(fd);
+
+			if (!mapped) {
+				munmap(reserved, 2 * _capacity);
+				throw runtime_error(string("Failed to map serial ring buffer: ") + strerror(errno));
+			}
+			_base = base;
+		}
+
+		~mirroredRing() {
+			if (_base) munmap(_base, 2 * _capacity);
+		}
+
+		mirroredRing(const mirroredRing&) = delete;
+		mirroredRing& operator=(const mirroredRing&) = delete;
+
+		char* readPtr() const { return _base + (_head & (_capacity - 1)); }
+		char* writePtr() const { return _base + (_tail & (_capacity - 1)); }
+		size_t used() const { return static_cast<size_t>(_tail - _head); }
+		size_t space() const { return _capacity - used(); }
+
+		void produce(size_t bytes) { _tail += bytes; }
+		void consume(size_t bytes) { _head += bytes; }
+		void clear() { _head = _tail; }
+	};
+
+	struct port {
+		const portId id;
+		const int fd;
+		mirroredRing ring;
+		unique_ptr<IFramer> framer;
+		serialEngine::FrameHandler onFrame;
+		serialEngine::ErrorHandler onError;
+
+		string pending;					// Guarded by the engine mutex
+		bool queued = false;			// Guarded by the engine mutex, already in the dirty list
+
+		string out;						// Loop thread only from here down
+		size_t outPos = 0;
+		bool waitingToWrite = false;
+		bool closing = false;
+
+		atomic<uint64_t> bytesRead{ 0 };
+		atomic<uint64_t> bytesWritten{ 0 };
+		atomic<uint64_t> framesRead{ 0 };
+		atomic<uint64_t> bytesDiscarded{ 0 };
+		atomic<uint64_t> overflows{ 0 };
+		atomic<uint64_t> writeCalls{ 0 };
+
+		port(portId portNumber, int descriptor, size_t ringBytes, unique_ptr<IFramer> portFramer,
+			serialEngine::FrameHandler frameHandler, serialEngine::ErrorHandler errorHandler)
+			: id(portNumber), fd(descriptor), ring(ringBytes), framer(move(portFramer)),
+			onFrame(move(frameHandler)), onError(move(errorHandler)) {}
+
+		~port() {
+			::close(fd);
+		}
+	};
+
+	/// Only the loop thread writes the counters, a plain load and store is all the update needs
+	void bump(atomic<uint64_t>& counter, uint64_t amount) {
+		counter.store(counter.load(memory_order_relaxed) + amount, memory_order_relaxed);
+	}
+}
+
+#endif
+
+//===================================================================================================================================
+//													    ENGINE LOOP DEFINITION
+//===================================================================================================================================
+
+#if defined(__linux__)
+
+class UTK::Peripheral::Internal::engineLoop {
+private:
+	const size_t _ringBytes;
+	int _epoll = -1;
+	int _wake = -1;
+
+	mutable mutex _mutex;
+	condition_variable _closed;
+	unordered_map<portId, unique_ptr<port>> _ports;
+	vector<port*> _dirty;					// Ports with pending output
+	vector<portId> _closeRequests;
+	bool _stopping = false;
+
+	vector<port*> _doomed;					// Loop thread, closed this turn and destroyed at its end
+	atomic<portId> _nextId{ 1 };
+	thread _thread;
+
+	void wake() {
+		const uint64_t one = 1;
+		[[maybe_unused]] auto written = ::write(_wake, &one, sizeof(one));
+	}
+
+	void shut(port& target) {
+		if (target.closing) return;
+		target.closing = true;
+		_doomed.push_back(&target);
+	}
+
+	void report(port& target, const string& message) {
+		if (!target.onError) return;
+		try {
+			target.onError(target.id, message);
+		}
+		catch (...) {}
+	}
+
+	void fail(port& target, const string& message) {
+		if (target.closing) return;
+		shut(target);
+		report(target, message);
+	}
+
+	void watchWrites(port& target, bool enable) {
+		if (target.waitingToWrite == enable) return;
+
+		epoll_event event{};
+		event.events = EPOLLIN | (enable ? EPOLLOUT : 0u);
+		event.data.ptr = &target;
+		epoll_ctl(_epoll, EPOLL_CTL_MOD, target.fd, &event);
+		target.waitingToWrite = enable;
+	}
+
+	void deliver(port& target) {
+
+		while (!target.closing && target.ring.used()) {
+			const size_t available = target.ring.used();
+			const IFramer::scan found = target.framer->next(target.ring.readPtr(), available);
+			if (!found.consumed) break;
+
+			const size_t consumed = min(found.consumed, available);
+			if (found.found) {
+				bump(target.framesRead, 1);
+				try {
+					target.onFrame(target.id, found.frame);
+				}
+				catch (const exception& e) {
+					report(target, string("Frame handler threw: ") + e.what());
+				}
+			}
+			else {
+				bump(target.bytesDiscarded, consumed);
+			}
+
+			target.ring.consume(consumed);
+		}
+	}
+
+	void receive(port& target) {
+
+		for (int reads = 0; reads < readsPerTurn && !target.closing; reads++) {
+			if (!target.ring.space()) {
+				// No frame fits in the ring, drop what it holds and let the framer resynchronise
+				bump(target.overflows, 1);
+				bump(target.bytesDiscarded, target.ring.used());
+				target.ring.clear();
+				target.framer->reset();
+			}
+
+			const ssize_t length = ::read(target.fd, target.ring.writePtr(), target.ring.space());
+			if (length > 0) {
+				target.ring.produce(static_cast<size_t>(length));
+				bump(target.bytesRead, static_cast<uint64_t>(length));
+				deliver(target);
+				continue;
+			}
+
+			if (length == 0) {
+				fail(target, "Device closed");
+				return;
+			}
+			if (errno == EINTR) continue;
+			if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+
+			fail(target, (errno == EIO) ? string("Device disconnected") : string("Read failed: ") + strerror(errno));
+			return;
+		}
+	}
+
+	/// Writes everything queued for the port, picking up anything appended while earlier bytes went out
+	void flush(port& target) {
+
+		for (;;) {
+			if (target.outPos == target.out.size()) {
+				target.out.clear();
+				target.outPos = 0;
+				{
+					lock_guard<mutex> lock(_mutex);
+					swap(target.out, target.pending);
+				}
+				if (target.out.empty()) break;
+			}
+
+			const ssize_t written = ::write(target.fd, target.out.data() + target.outPos, target.out.size() - target.outPos);
+			if (written > 0) {
+				target.outPos += static_cast<size_t>(written);
+				bump(target.bytesWritten, static_cast<uint64_t>(written));
+				bump(target.writeCalls, 1);
+				continue;
+			}
+
+			if (written < 0 && errno == EINTR) continue;
+			if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+				watchWrites(target, true);
+				return;
+			}
+
+			fail(target, string("Write failed: ") + strerror(errno));
+			return;
+		}
+
+		watchWrites(target, false);
+	}
+
+	/// Destroys the ports closed this turn, waking any close() waiting on them
+	void bury() {
+
+		if (_doomed.empty()) return;
+
+		vector<unique_ptr<port>> dead;
+		{
+			lock_guard<mutex> lock(_mutex);
+			for (port* target : _doomed) {
+				epoll_ctl(_epoll, EPOLL_CTL_DEL, target->fd, nullptr);
+				erase(_dirty, target);
+
+				auto owned = _ports.find(target->id);
+				dead.push_back(move(owned->second));
+				_ports.erase(owned);
+			}
+		}
+		_doomed.clear();
+		_closed.notify_all();
+	}
+
+	void run() {
+
+		epoll_event events[64];
+
+		for (;;) {
+			const int ready = epoll_wait(_epoll, events, 64, -1);
+			if (ready < 0 && errno != EINTR) break;
+
+			vector<port*> dirty;
+			vector<portId> closing;
+			bool stopping;
+			{
+				lock_guard<mutex> lock(_mutex);
+				swap(dirty, _dirty);
+				swap(closing, _closeRequests);
+				stopping = _stopping;
+
+				for (port* target : dirty) target->queued = false;
+				for (portId id : closing) {
+					auto it = _ports.find(id);
+					if (it != _ports.end()) shut(*it->second);
+				}
+			}
+			if (stopping) break;
+
+			for (int i = 0; i < ready; i++) {
+				if (!events[i].data.ptr) {
+					uint64_t count;
+					[[maybe_unused]] auto drained = ::read(_wake, &count, sizeof(count));
+					continue;
+				}
+
+				port& target = *static_cast<port*>(events[i].data.ptr);
+				if (target.closing) continue;
+
+				if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) receive(target);
+				if ((events[i].events & EPOLLOUT) && !target.closing) flush(target);
+			}
+
+			for (port* target : dirty) {
+				if (!target->closing) flush(*target);
+			}
+
+			bury();
+		}
+
+		lock_guard<mutex> lock(_mutex);
+		_ports.clear();
+		_dirty.clear();
+	}
+
+public:
+	explicit engineLoop(size_t ringBytes) : _ringBytes(ringBytes) {
+
+		_epoll = epoll_create1(EPOLL_CLOEXEC);
+		_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (_epoll < 0 || _wake < 0) {
+			if (_epoll >= 0) ::close(_epoll);
+			if (_wake >= 0) ::close(_wake);
+			throw runtime_error("Failed to create the serial engine event loop");
+		}
+
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.ptr = nullptr;
+		epoll_ctl(_epoll, EPOLL_CTL_ADD, _wake, &event);
+
+		_thread = thread(&engineLoop::run, this);
+	}
+
+	~engineLoop() {
+		{
+			lock_guard<mutex> lock(_mutex);
+			_stopping = true;
+		}
+		wake();
+
+		if (_thread.joinable()) _thread.join();
+		::close(_wake);
+		::close(_epoll);
+	}
+
+	engineLoop(const engineLoop&) = delete;
+	engineLoop& operator=(const engineLoop&) = delete;
+
+	portId add(int fd, unique_ptr<IFramer> framer, serialEngine::FrameHandler onFrame, serialEngine::ErrorHandler onError) {
+
+		if (!framer) {
+			::close(fd);
+			throw runtime_error("Serial ports need a framer");
+		}
+
+		const int flags = fcntl(fd, F_GETFL);
+		if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+			::close(fd);
+			throw runtime_error(string("Failed to make serial port non-blocking: ") + strerror(errno));
+		}
+
+		unique_ptr<port> created;
+		const portId id = _nextId.fetch_add(1, memory_order_relaxed);
+		try {
+			created = make_unique<port>(id, fd, _ringBytes, move(framer), move(onFrame), move(onError));
+		}
+		catch (...) {
+			::close(fd);
+			throw;
+		}
+
+		lock_guard<mutex> lock(_mutex);
+
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.ptr = created.get();
+		if (epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event) != 0) throw runtime_error(string("Failed to watch serial port: ") + strerror(errno));
+
+		_ports.emplace(id, move(created));
+		return id;
+	}
+
+	void close(portId id) {
+
+		unique_lock<mutex> lock(_mutex);
+		auto it = _ports.find(id);
+		if (it == _ports.end()) return;
+
+		// From a handler the port is already in the loop's hands, it goes once the handler returns
+		if (this_thread::get_id() == _thread.get_id()) {
+			shut(*it->second);
+			return;
+		}
+
+		_closeRequests.push_back(id);
+		wake();
+		_closed.wait(lock, [&] { return !_ports.count(id); });
+	}
+
+	bool write(portId id, string_view bytes, bool encode) {
+
+		lock_guard<mutex> lock(_mutex);
+		auto it = _ports.find(id);
+		if (it == _ports.end()) return false;
+
+		port& target = *it->second;
+		if (encode) target.framer->encode(bytes, target.pending);
+		else target.pending.append(bytes);
+
+		if (!target.queued) {
+			target.queued = true;
+			_dirty.push_back(&target);
+
+			// One wakeup per turn however many writes land before the loop gets to them
+			if (_dirty.size() == 1) wake();
+		}
+		return true;
+	}
+
+	portStats stats(portId id) const {
+
+		lock_guard<mutex> lock(_mutex);
+		auto it = _ports.find(id);
+		if (it == _ports.end()) throw runtime_error("Unknown serial port: " + to_string(id));
+
+		const port& target = *it->second;
+		portStats result;
+		result.bytesRead = target.bytesRead.load(memory_order_relaxed);
+		result.bytesWritten = target.bytesWritten.load(memory_order_relaxed);
+		result.framesRead = target.framesRead.load(memory_order_relaxed);
+		result.bytesDiscarded = target.bytesDiscarded.load(memory_order_relaxed);
+		result.overflows = target.overflows.load(memory_order_relaxed);
+		result.writeCalls = target.writeCalls.load(memory_order_relaxed);
+		return result;
+	}
+};
+
+#else
+
+class UTK::Peripheral::Internal::engineLoop {
+public:
+	explicit engineLoop(size_t) {
+		throw runtime_error("The serial engine requires epoll and is not supported on this platform");
+	}
+
+	portId add(int, unique_ptr<IFramer>, serialEngine::FrameHandler, serialEngine::ErrorHandler) { return 0; }
+	void close(portId) {}
+	bool write(portId, string_view, bool) { return false; }
+	portStats stats(portId) const { return {}; }
+};
+
+#endif
+
+//===================================================================================================================================
+//											          SERIAL ENGINE METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+serialEngine::serialEngine(size_t ringBytes) : _loop(make_unique<Internal::engineLoop>(ringBytes)) {}
+
+serialEngine::~serialEngine() = default;
+
+portId serialEngine::open(const filesystem::path& device, const portSettings& settings, unique_ptr<IFramer> framer,
+	FrameHandler onFrame, ErrorHandler onError) {
+
+#if defined(__linux__)
+	const int fd = ::open(device.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+	if (fd < 0) throw runtime_error("Failed to open serial device " + device.string() + ": " + strerror(errno));
+
+	try {
+		configure(fd, settings, device.string());
+	}
+	catch (...) {
+		::close(fd);
+		throw;
+	}
+
+	return _loop->add(fd, move(framer), move(onFrame), move(onError));
+#else
+	(void)device;
+	(void)settings;
+	return _loop->add(-1, move(framer), move(onFrame), move(onError));
+#endif
+}
+
+portId serialEngine::adopt(int fd, unique_ptr<IFramer> framer, FrameHandler onFrame, ErrorHandler onError) {
+	return _loop->add(fd, move(framer), move(onFrame), move(onError));
+}
+
+void serialEngine::close(portId id) {
+	_loop->close(id);
+}
+
+bool serialEngine::write(portId id, string_view bytes) {
+	return _loop->write(id, bytes, false);
+}
+
+bool serialEngine::send(portId id, string_view payload) {
+	return _loop->write(id, payload, true);
+}
+
+portStats serialEngine::stats(portId id) const {
+	return _loop->stats(id);
+}
\ No newline at end of file
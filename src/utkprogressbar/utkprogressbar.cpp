@@ -0,0 +1,267 @@
+//===================================================================================================================================
+// @file	utkprogressbar.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the progress bar counters and the throttled renderer provided by
+//			UTK::Progressbar.
+//===================================================================================================================================
+
+#include "progressbar/utkprogressbar.hpp"
+#include "core/utkconsole.hpp"
+#include <algorithm>
+#include <bit>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Progressbar;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	atomic<size_t> nextThreadSlot{ 0 };
+
+	/// Appends a count with a k/M/G/T suffix once it passes a thousand
+	void appendQuantity(string& out, double value) {
+		static constexpr const char* suffixes[] = { "", "k", "M", "G", "T" };
+
+		size_t index = 0;
+		while (value >= 1000.0 && index + 1 < size(suffixes)) {
+			value /= 1000.0;
+			index++;
+		}
+
+		char text[32];
+		const int length = (index == 0)
+			? snprintf(text, sizeof(text), "%.0f", value)
+			: snprintf(text, sizeof(text), "%.1f%s", value, suffixes[index]);
+		out.append(text, static_cast<size_t>(max(length, 0)));
+	}
+
+	void appendDuration(string& out, double seconds) {
+		const auto total = static_cast<long long>(max(seconds, 0.0));
+
+		char text[32];
+		const int length = snprintf(text, sizeof(text), "%02lld:%02lld:%02lld", total / 3600, (total / 60) % 60, total % 60);
+		out.append(text, static_cast<size_t>(max(length, 0)));
+	}
+}
+
+//===================================================================================================================================
+//											         PROGRESS BAR METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+progressBar::progressBar(string name, uint64_t total, progressBar* parent)
+	: _name(move(name)), _total(total), _parent(parent) {
+
+	// One slot per hardware thread(power of two for masking) keeps most workers on their own cache line
+	const size_t slots = bit_ceil(clamp<size_t>(thread::hardware_concurrency(), 8, 256));
+	_slots = make_unique<slot[]>(slots);
+	_slotMask = slots - 1;
+	_depth = parent ? parent->_depth + 1 : 0;
+
+	_started = _lastSample = steady_clock::now();
+}
+
+size_t progressBar::threadSlot() {
+
+	thread_local const size_t slot = nextThreadSlot.fetch_add(1, memory_order_relaxed);
+	return slot;
+}
+
+uint64_t progressBar::count() const noexcept {
+
+	uint64_t sum = 0;
+	for (size_t i = 0; i <= _slotMask; i++) {
+		sum += _slots[i].count.load(memory_order_relaxed);
+	}
+	return sum;
+}
+
+//===================================================================================================================================
+//											       PROGRESS DISPLAY METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+progressDisplay::progressDisplay(progressOptions options)
+	: _options(options), _terminal(!options.forceQuiet && UTK::Core::Internal::stdoutIsTerminal()) {
+
+	_lastQuiet = steady_clock::now();
+	if (_terminal) {
+		_buffer = "\x1b[?25l";		// Hide the cursor while bars are live
+		writeBuffer();
+	}
+	_renderer = thread(&progressDisplay::renderLoop, this);
+}
+
+progressDisplay::~progressDisplay() {
+
+	try {
+		stop();
+	}
+	catch (...) {
+		// Destructors must not throw, a failed final frame is not worth terminating over
+	}
+}
+
+progressBar& progressDisplay::addBar(string name, uint64_t total, progressBar* parent) {
+
+	auto bar = make_unique<progressBar>(move(name), total, parent);
+	progressBar& ref = *bar;
+
+	lock_guard<mutex> lock(_mutex);
+
+	// Children go after the parent's last descendant so the tree reads top to bottom
+	auto position = _bars.end();
+	if (parent) {
+		auto it = find_if(_bars.begin(), _bars.end(), [&](const auto& b) { return b.get() == parent; });
+		if (it != _bars.end()) {
+			++it;
+			while (it != _bars.end() && (*it)->_depth > parent->_depth) ++it;
+			position = it;
+		}
+	}
+	_bars.insert(position, move(bar));
+
+	return ref;
+}
+
+void progressDisplay::stop() {
+
+	{
+		lock_guard<mutex> lock(_mutex);
+		if (_stopping) return;
+		_stopping = true;
+	}
+	_wake.notify_all();
+
+	if (_renderer.joinable()) _renderer.join();
+}
+
+void progressDisplay::renderLoop() {
+
+	try {
+		unique_lock<mutex> lock(_mutex);
+
+		while (!_stopping) {
+			_wake.wait_for(lock, _options.refreshInterval, [&] { return _stopping; });
+			if (_stopping) break;
+
+			lock.unlock();
+			render(false);
+			lock.lock();
+		}
+
+		lock.unlock();
+		render(true);
+	}
+	catch (...) {
+		// An exception escaping this thread would terminate the process. If stdout can no longer be
+		// written(closed pipe, full disk) the bars just stop being drawn while the work carries on.
+	}
+}
+
+void progressDisplay::appendBar(progressBar& bar, steady_clock::time_point now, bool quiet) {
+
+	const uint64_t count = bar.count();
+	const uint64_t total = bar.total();
+	const bool finished = bar.finished();
+
+	// Smoothed throughput, an exponential moving average over the samples between frames
+	const double sampleSeconds = duration<double>(now - bar._lastSample).count();
+	if (sampleSeconds > 0.0) {
+		const double instant = static_cast<double>(count - bar._lastCount) / sampleSeconds;
+		bar._rate = (bar._lastCount == 0 && bar._rate == 0.0) ? instant : bar._rate * 0.7 + instant * 0.3;
+		bar._lastSample = now;
+		bar._lastCount = count;
+	}
+
+	_buffer.append(bar._depth * 2, ' ');
+	_buffer += bar._name;
+
+	if (total > 0) {
+		const double fraction = min(1.0, static_cast<double>(count) / static_cast<double>(total));
+
+		if (!quiet) {
+			const auto filled = static_cast<size_t>(fraction * static_cast<double>(_options.barWidth));
+			_buffer += " [";
+			_buffer.append(filled, '#');
+			_buffer.append(_options.barWidth - filled, '-');
+			_buffer += ']';
+		}
+
+		char percent[16];
+		const int length = snprintf(percent, sizeof(percent), " %5.1f%% ", fraction * 100.0);
+		_buffer.append(percent, static_cast<size_t>(max(length, 0)));
+
+		appendQuantity(_buffer, static_cast<double>(count));
+		_buffer += '/';
+		appendQuantity(_buffer, static_cast<double>(total));
+	}
+	else {
+		_buffer += ' ';
+		appendQuantity(_buffer, static_cast<double>(count));
+	}
+
+	_buffer += "  ";
+	appendQuantity(_buffer, bar._rate);
+	_buffer += "/s  ";
+
+	const double elapsed = duration<double>(now - bar._started).count();
+	if (finished) {
+		_buffer += "done in ";
+		appendDuration(_buffer, elapsed);
+	}
+	else if (total > 0 && bar._rate > 0.0 && count < total) {
+		_buffer += "ETA ";
+		appendDuration(_buffer, static_cast<double>(total - count) / bar._rate);
+	}
+	else {
+		_buffer += "elapsed ";
+		appendDuration(_buffer, elapsed);
+	}
+}
+
+void progressDisplay::render(bool final) {
+
+	const auto now = steady_clock::now();
+	const bool quiet = !_terminal;
+
+	if (quiet && !final && now - _lastQuiet < _options.quietInterval) return;
+	_lastQuiet = now;
+
+	_buffer.clear();
+
+	if (!quiet && _linesDrawn > 0) {
+		// Back to the top of the previous frame, the frame is then redrawn over itself
+		_buffer += "\x1b[" + to_string(_linesDrawn) + "F";
+	}
+
+	size_t lines = 0;
+	{
+		lock_guard<mutex> lock(_mutex);
+		for (auto& bar : _bars) {
+			// Finished children leave the live view, top level bars stay as a record
+			if (bar->_parent && bar->finished() && !final) continue;
+
+			if (!quiet) _buffer += "\x1b[2K";
+			appendBar(*bar, now, quiet);
+			_buffer += '\n';
+			lines++;
+		}
+	}
+
+	if (!quiet) {
+		_buffer += "\x1b[J";					// Clear anything left from a taller previous frame
+		if (final) _buffer += "\x1b[?25h";		// Restore the cursor
+		_linesDrawn = lines;
+	}
+
+	writeBuffer();
+}
+
+void progressDisplay::writeBuffer() {
+	UTK::Core::Internal::writeStdout(_buffer.data(), _buffer.size());
+}
\ No newline at end of file
@@ -0,0 +1,339 @@
+//===================================================================================================================================
+// @file	utkrandom.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the jump functions, bulk fills and the SIMD lane kernels behind the
+//			UTK::Random engines.
+//===================================================================================================================================
+
+#include "random/utkrandom.hpp"
+
+#if defined(ARCH_x64)
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <immintrin.h>
+	#endif
+#endif
+
+#if defined(_MSC_VER)
+	#define UTK_TARGET(features)
+#else
+	#define UTK_TARGET(features) __attribute__((target(features)))
+#endif
+
+using namespace std;
+using namespace UTK::Random;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	// Jump polynomials from the xoshiro256++ reference implementation
+	constexpr array<uint64_t, 4> jumpPolynomial{
+		0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+	};
+	constexpr array<uint64_t, 4> longJumpPolynomial{
+		0x76E15D3EFEFDCBBFULL, 0xC5004E441C522FB3ULL, 0x77710069854EE241ULL, 0x39109BB02ACBE635ULL
+	};
+
+	constexpr size_t lanes = xoshiro256ppx8::lanes;
+
+	/**
+	 * @brief Advances every lane one step and writes its output, blocks times over
+	 *
+	 * @param state: Four rows of eight lanes, row major.
+	 * @param out:	 blocks * 8 outputs, lane order within each block.
+	 */
+	using laneKernel = void (*)(uint64_t* state, uint64_t* out, size_t blocks);
+
+	inline uint64_t rotl(uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+
+#if !defined(ARCH_x64)
+	void lanesScalar(uint64_t* state, uint64_t* out, size_t blocks) {
+		uint64_t* s0 = state;
+		uint64_t* s1 = state + lanes;
+		uint64_t* s2 = state + lanes * 2;
+		uint64_t* s3 = state + lanes * 3;
+
+		for (size_t b = 0; b < blocks; b++) {
+			for (size_t l = 0; l < lanes; l++) {
+				out[b * lanes + l] = rotl(s0[l] + s3[l], 23) + s0[l];
+				const uint64_t t = s1[l] << 17;
+				s2[l] ^= s0[l];
+				s3[l] ^= s1[l];
+				s1[l] ^= s2[l];
+				s0[l] ^= s3[l];
+				s2[l] ^= t;
+				s3[l] = rotl(s3[l], 45);
+			}
+		}
+	}
+#else
+	// SSE2 is part of the x86-64 baseline so it needs no target attribute
+	void lanesSse2(uint64_t* state, uint64_t* out, size_t blocks) {
+		constexpr size_t vectors = lanes / 2;
+		__m128i s[4][vectors];
+		for (size_t w = 0; w < 4; w++) {
+			for (size_t v = 0; v < vectors; v++) s[w][v] = _mm_load_si128(reinterpret_cast<const __m128i*>(state + w * lanes) + v);
+		}
+
+		for (size_t b = 0; b < blocks; b++) {
+			for (size_t v = 0; v < vectors; v++) {
+				const __m128i sum = _mm_add_epi64(s[0][v], s[3][v]);
+				const __m128i rotated = _mm_or_si128(_mm_slli_epi64(sum, 23), _mm_srli_epi64(sum, 41));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + b * lanes) + v, _mm_add_epi64(rotated, s[0][v]));
+
+				const __m128i t = _mm_slli_epi64(s[1][v], 17);
+				s[2][v] = _mm_xor_si128(s[2][v], s[0][v]);
+				s[3][v] = _mm_xor_si128(s[3][v], s[1][v]);
+				s[1][v] = _mm_xor_si128(s[1][v], s[2][v]);
+				s[0][v] = _mm_xor_si128(s[0][v], s[3][v]);
+				s[2][v] = _mm_xor_si128(s[2][v], t);
+				s[3][v] = _mm_or_si128(_mm_slli_epi64(s[3][v], 45), _mm_srli_epi64(s[3][v], 19));
+			}
+		}
+
+		for (size_t w = 0; w < 4; w++) {
+			for (size_t v = 0; v < vectors; v++) _mm_store_si128(reinterpret_cast<__m128i*>(state + w * lanes) + v, s[w][v]);
+		}
+	}
+
+	UTK_TARGET("avx2")
+	void lanesAvx2(uint64_t* state, uint64_t* out, size_t blocks) {
+		constexpr size_t vectors = lanes / 4;
+		__m256i s[4][vectors];
+		for (size_t w = 0; w < 4; w++) {
+			for (size_t v = 0; v < vectors; v++) s[w][v] = _mm256_load_si256(reinterpret_cast<const __m256i*>(state + w * lanes) + v);
+		}
+
+		for (size_t b = 0; b < blocks; b++) {
+			for (size_t v = 0; v < vectors; v++) {
+				const __m256i sum = _mm256_add_epi64(s[0][v], s[3][v]);
+				const __m256i rotated = _mm256_or_si256(_mm256_slli_epi64(sum, 23), _mm256_srli_epi64(sum, 41));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + b * lanes) + v, _mm256_add_epi64(rotated, s[0][v]));
+
+				const __m256i t = _mm256_slli_epi64(s[1][v], 17);
+				s[2][v] = _mm256_xor_si256(s[2][v], s[0][v]);
+				s[3][v] = _mm256_xor_si256(s[3][v], s[1][v]);
+				s[1][v] = _mm256_xor_si256(s[1][v], s[2][v]);
+				s[0][v] = _mm256_xor_si256(s[0][v], s[3][v]);
+				s[2][v] = _mm256_xor_si256(s[2][v], t);
+				s[3][v] = _mm256_or_si256(_mm256_slli_epi64(s[3][v], 45), _mm256_srli_epi64(s[3][v], 19));
+			}
+		}
+
+		for (size_t w = 0; w < 4; w++) {
+			for (size_t v = 0; v < vectors; v++) _mm256_store_si256(reinterpret_cast<__m256i*>(state + w * lanes) + v, s[w][v]);
+		}
+	}
+
+	// GCC 12's AVX-512 headers trip -Wuninitialized on their own undefined-vector placeholders
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic push
+	#pragma GCC diagnostic ignored "-Wuninitialized"
+	#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+	UTK_TARGET("avx512f")
+	void lanesAvx512(uint64_t* state, uint64_t* out, size_t blocks) {
+		// AVX-512 has native 64-bit rotates, one register holds all eight lanes of a state word
+		__m512i s0 = _mm512_load_si512(state);
+		__m512i s1 = _mm512_load_si512(state + lanes);
+		__m512i s2 = _mm512_load_si512(state + lanes * 2);
+		__m512i s3 = _mm512_load_si512(state + lanes * 3);
+
+		for (size_t b = 0; b < blocks; b++) {
+			_mm512_storeu_si512(out + b * lanes, _mm512_add_epi64(_mm512_rol_epi64(_mm512_add_epi64(s0, s3), 23), s0));
+
+			const __m512i t = _mm512_slli_epi64(s1, 17);
+			s2 = _mm512_xor_si512(s2, s0);
+			s3 = _mm512_xor_si512(s3, s1);
+			s1 = _mm512_xor_si512(s1, s2);
+			s0 = _mm512_xor_si512(s0, s3);
+			s2 = _mm512_xor_si512(s2, t);
+			s3 = _mm512_rol_epi64(s3, 45);
+		}
+
+		_mm512_store_si512(state, s0);
+		_mm512_store_si512(state + lanes, s1);
+		_mm512_store_si512(state + lanes * 2, s2);
+		_mm512_store_si512(state + lanes * 3, s3);
+	}
+
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic pop
+#endif
+#endif
+
+	struct laneDispatch {
+		const char* name;
+		laneKernel kernel;
+	};
+
+	laneDispatch detectKernel() {
+	#if defined(ARCH_x64)
+		#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		const int maxLeaf = info[0];
+		__cpuid(info, 1);
+		const unsigned long long xcr0 = (info[2] & (1 << 27)) ? _xgetbv(0) : 0;
+
+		if (maxLeaf >= 7) {
+			__cpuidex(info, 7, 0);
+			if ((info[1] & (1 << 16)) && (xcr0 & 0xE6) == 0xE6) return { "avx512", lanesAvx512 };
+			if ((info[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6) return { "avx2", lanesAvx2 };
+		}
+		#else
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f")) return { "avx512", lanesAvx512 };
+		if (__builtin_cpu_supports("avx2")) return { "avx2", lanesAvx2 };
+		#endif
+		return { "sse2", lanesSse2 };
+	#else
+		return { "scalar", lanesScalar };
+	#endif
+	}
+
+	const laneDispatch& activeLanes() {
+		static const laneDispatch dispatch = detectKernel();
+		return dispatch;
+	}
+}
+
+//===================================================================================================================================
+//											        XOSHIRO256++ METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+void xoshiro256pp::jumpBy(const array<uint64_t, 4>& polynomial) {
+
+	array<uint64_t, 4> result{};
+
+	for (uint64_t word : polynomial) {
+		for (int bit = 0; bit < 64; bit++) {
+			if (word & (uint64_t{ 1 } << bit)) {
+				for (size_t i = 0; i < 4; i++) result[i] ^= _state[i];
+			}
+			(*this)();
+		}
+	}
+
+	_state = result;
+}
+
+void xoshiro256pp::fill(span<result_type> out) {
+
+	// Working on locals lets the compiler keep the state in registers across the loop
+	xoshiro256pp local = *this;
+	for (auto& value : out) {
+		value = local();
+	}
+	*this = local;
+}
+
+void xoshiro256pp::jump() {
+
+	jumpBy(jumpPolynomial);
+}
+
+void xoshiro256pp::longJump() {
+
+	jumpBy(longJumpPolynomial);
+}
+
+//===================================================================================================================================
+//											            PCG32 METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+void pcg32::fill(span<result_type> out) {
+
+	pcg32 local = *this;
+	for (auto& value : out) {
+		value = local();
+	}
+	*this = local;
+}
+
+void pcg32::advance(uint64_t delta) {
+
+	// Composes the LCG step with itself by squaring(Brown, "Random number generation with arbitrary strides")
+	uint64_t accMultiplier = 1, accIncrement = 0;
+	uint64_t curMultiplier = multiplier, curIncrement = _increment;
+
+	while (delta > 0) {
+		if (delta & 1) {
+			accMultiplier *= curMultiplier;
+			accIncrement = accIncrement * curMultiplier + curIncrement;
+		}
+		curIncrement = (curMultiplier + 1) * curIncrement;
+		curMultiplier *= curMultiplier;
+		delta >>= 1;
+	}
+
+	_state = accMultiplier * _state + accIncrement;
+}
+
+//===================================================================================================================================
+//											       XOSHIRO256++ X8 METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+xoshiro256ppx8::xoshiro256ppx8(xoshiro256pp base) {
+
+	for (size_t l = 0; l < lanes; l++) {
+		for (size_t w = 0; w < 4; w++) _state[w][l] = base.state()[w];
+		base.jump();
+	}
+	_used = lanes;
+}
+
+void xoshiro256ppx8::seed(uint64_t seed) {
+
+	*this = xoshiro256ppx8(xoshiro256pp(seed));
+}
+
+void xoshiro256ppx8::refill() {
+
+	activeLanes().kernel(_state[0].data(), _block.data(), 1);
+	_used = 0;
+}
+
+void xoshiro256ppx8::fill(span<result_type> out) {
+
+	size_t done = 0;
+
+	// Hand out whatever is left of the current block first so fill and operator() share one sequence
+	while (_used < lanes && done < out.size()) {
+		out[done++] = _block[_used++];
+	}
+
+	const size_t blocks = (out.size() - done) / lanes;
+	if (blocks > 0) {
+		activeLanes().kernel(_state[0].data(), out.data() + done, blocks);
+		done += blocks * lanes;
+	}
+
+	while (done < out.size()) {
+		out[done++] = (*this)();
+	}
+}
+
+void xoshiro256ppx8::jump() {
+
+	for (size_t l = 0; l < lanes; l++) {
+		xoshiro256pp lane({ _state[0][l], _state[1][l], _state[2][l], _state[3][l] });
+		lane.longJump();
+		for (size_t w = 0; w < 4; w++) _state[w][l] = lane.state()[w];
+	}
+	_used = lanes;
+}
+
+const char* UTK::Random::activeKernel() {
+
+	return activeLanes().name;
+}
\ No newline at end of file
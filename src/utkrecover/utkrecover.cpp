@@ -0,0 +1,63 @@
+//===================================================================================================================================
+// @file	utkrecover.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+// 
+// @brief   Command line tool that extracts the last N entries from a flight recorder ring
+//			file left behind by a crashed process.
+// 
+// @note    Usage: utkrecover <ring file> [count(default: 100)]
+//			Entries are printed oldest first as: sequence, timestamp(ns since epoch), origin, operation, key/values
+//===================================================================================================================================
+
+#include "dispatchers/utkflightrecorder.hpp"
+#include "dispatchers/utkrouting.hpp"
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+
+int main(int argc, char* argv[]) {
+
+	if (argc < 2) {
+		cerr << "Usage: " << argv[0] << " <ring file> [count]\n";
+		return 1;
+	}
+
+	try {
+		size_t count = (argc > 2) ? stoul(argv[2]) : 100;
+		int crashSignal = 0;
+		crashMarker previousCrash;
+
+		auto records = flightRecorder::recover(argv[1], count, &crashSignal, &previousCrash);
+
+		if (crashSignal != 0) {
+			cout << "# Process terminated by signal " << crashSignal << "\n";
+		}
+		if (previousCrash.signal != 0) {
+			cout << "# An earlier run was terminated by signal " << previousCrash.signal
+				 << ", entries from sequence " << previousCrash.sequence << " on are from the restart\n";
+		}
+		cout << "# Recovered " << records.size() << " entries\n";
+
+		for (const auto& record : records) {
+			cout << record.sequence << " " << record.timeStamp << " "
+				 << record.fileName << ":" << record.fileLine << ":" << record.funcName << " "
+				 << operationTag(record.op);
+
+			for (size_t i = 0; i < record.formatKeys.size(); i++) {
+				cout << " " << record.formatKeys[i];
+				if (i < record.formatValues.size()) cout << " " << record.formatValues[i];
+			}
+			cout << (record.truncated ? " <truncated>\n" : "\n");
+		}
+	}
+	catch (const std::exception& e) {
+		cerr << "[utkrecover] " << e.what() << "\n";
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
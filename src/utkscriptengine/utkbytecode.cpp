@@ -0,0 +1,259 @@
+//===================================================================================================================================
+// @file	utkbytecode.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the on-disk form of compiled UTK::ScriptEngine programs.
+//
+// @note    Cache files are written in native byte order, the magic number reads back wrong on a machine of
+//          the other endianness and the file is simply recompiled. The header carries an XXH3 checksum of
+//          everything after it, so a torn or corrupted file is rejected before it is parsed. Loaded bytecode
+//          is also checked operand by operand before it is accepted, the interpreter itself does no bounds checking.
+//===================================================================================================================================
+
+#include "utkbytecode.hpp"
+#include "hash/utkhash.hpp"
+#include <cstring>
+
+using namespace std;
+using namespace UTK::ScriptEngine;
+using namespace UTK::ScriptEngine::Internal;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	constexpr uint32_t cacheMagic = 0x424B5455;		// "UTKB"
+	constexpr uint32_t cacheVersion = 2;
+
+	template<typename T>
+	void put(string& out, T number) {
+		char bytes[sizeof(T)];
+		memcpy(bytes, &number, sizeof(T));
+		out.append(bytes, sizeof(T));
+	}
+
+	void putString(string& out, string_view text) {
+		put(out, static_cast<uint32_t>(text.size()));
+		out.append(text);
+	}
+
+	class reader {
+	private:
+		string_view _bytes;
+		size_t _pos = 0;
+
+	public:
+		explicit reader(string_view bytes) : _bytes(bytes) {}
+
+		template<typename T>
+		bool get(T& number) {
+			if (_bytes.size() - _pos < sizeof(T)) return false;
+			memcpy(&number, _bytes.data() + _pos, sizeof(T));
+			_pos += sizeof(T);
+			return true;
+		}
+
+		bool getString(string& text) {
+			uint32_t length;
+			if (!get(length) || _bytes.size() - _pos < length) return false;
+			text.assign(_bytes.data() + _pos, length);
+			_pos += length;
+			return true;
+		}
+
+		/// Rejects counts that could not fit in what is left, before anything is allocated for them
+		bool getCount(uint32_t& count, size_t minimumEach) {
+			return get(count) && static_cast<uint64_t>(count) * minimumEach <= _bytes.size() - _pos;
+		}
+
+		bool done() const { return _pos == _bytes.size(); }
+	};
+
+	bool verify(const program& compiled) {
+		const auto& functions = compiled.functions;
+		if (functions.empty() || functions[0].parameters != 0) return false;
+
+		for (const auto& fn : functions) {
+			const uint32_t regs = fn.registers;
+			const auto size = static_cast<int64_t>(fn.code.size());
+
+			if (regs > maxRegisters || fn.parameters > regs || fn.code.empty() || fn.lines.size() != fn.code.size()) return false;
+
+			const opcode lastOp = opOf(fn.code.back());
+			if (lastOp != opcode::ret && lastOp != opcode::retNil && lastOp != opcode::jump) return false;
+
+			for (int64_t i = 0; i < size; i++) {
+				const uint32_t ins = fn.code[static_cast<size_t>(i)];
+				const uint32_t a = argA(ins), b = argB(ins), c = argC(ins);
+
+				switch (opOf(ins)) {
+				case opcode::move:
+				case opcode::neg:
+				case opcode::logicalNot:
+					if (a >= regs || b >= regs) return false;
+					break;
+
+				case opcode::loadConst:
+					if (a >= regs || argBx(ins) >= compiled.constants.size()) return false;
+					break;
+
+				case opcode::loadInt:
+				case opcode::loadNil:
+				case opcode::loadBool:
+				case opcode::ret:
+					if (a >= regs) return false;
+					break;
+
+				case opcode::add: case opcode::sub: case opcode::mul: case opcode::div: case opcode::mod:
+				case opcode::equal: case opcode::notEqual: case opcode::less: case opcode::lessEqual:
+					if (a >= regs || b >= regs || c >= regs) return false;
+					break;
+
+				case opcode::jump:
+				case opcode::jumpIf:
+				case opcode::jumpIfNot: {
+					const int64_t target = i + 1 + argSBx(ins);
+					if (target < 0 || target >= size) return false;
+					if (opOf(ins) != opcode::jump && a >= regs) return false;
+					break;
+				}
+
+				case opcode::call:
+					if (b == 0 || b >= functions.size() || c != functions[b].parameters) return false;
+					[[fallthrough]];
+				case opcode::callNative:
+					if (opOf(ins) == opcode::callNative && b >= compiled.natives.size()) return false;
+					if (a >= regs || a + c > regs) return false;
+					break;
+
+				case opcode::retNil:
+					break;
+
+				default:
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+}
+
+//===================================================================================================================================
+//											              SERIALIZATION ENTRY POINTS
+//===================================================================================================================================
+
+string UTK::ScriptEngine::Internal::serialize(const program& compiled) {
+
+	string out;
+	put(out, compiled.sourceHash.low);
+	put(out, compiled.sourceHash.high);
+
+	put(out, static_cast<uint32_t>(compiled.constants.size()));
+	for (const auto& constant : compiled.constants) {
+		put(out, static_cast<uint8_t>(constant.type()));
+
+		if (constant.isNumber()) put(out, constant.asNumber());
+		else if (constant.isBool()) put(out, static_cast<uint8_t>(constant.asBool()));
+		else if (constant.isString()) putString(out, constant.asString());
+	}
+
+	put(out, static_cast<uint32_t>(compiled.natives.size()));
+	for (const auto& name : compiled.natives) putString(out, name);
+
+	put(out, static_cast<uint32_t>(compiled.functions.size()));
+	for (const auto& fn : compiled.functions) {
+		putString(out, fn.name);
+		put(out, fn.parameters);
+		put(out, fn.registers);
+
+		put(out, static_cast<uint32_t>(fn.code.size()));
+		out.append(reinterpret_cast<const char*>(fn.code.data()), fn.code.size() * sizeof(uint32_t));
+		out.append(reinterpret_cast<const char*>(fn.lines.data()), fn.lines.size() * sizeof(uint32_t));
+	}
+
+	string file;
+	file.reserve(sizeof(uint32_t) * 2 + sizeof(uint64_t) + out.size());
+	put(file, cacheMagic);
+	put(file, cacheVersion);
+	put(file, UTK::Hash::hash64(out));
+	file.append(out);
+	return file;
+}
+
+bool UTK::ScriptEngine::Internal::deserialize(string_view bytes, program& out) {
+
+	reader header(bytes);
+	uint32_t magic, version;
+	uint64_t checksum;
+	if (!header.get(magic) || !header.get(version) || magic != cacheMagic || version != cacheVersion) return false;
+	if (!header.get(checksum)) return false;
+
+	const string_view payload = bytes.substr(sizeof(uint32_t) * 2 + sizeof(uint64_t));
+	if (UTK::Hash::hash64(payload) != checksum) return false;
+
+	reader in(payload);
+	program compiled;
+
+	if (!in.get(compiled.sourceHash.low) || !in.get(compiled.sourceHash.high)) return false;
+
+	uint32_t count;
+	if (!in.getCount(count, 1)) return false;
+	compiled.constants.reserve(count);
+	for (uint32_t i = 0; i < count; i++) {
+		uint8_t kind;
+		if (!in.get(kind)) return false;
+
+		switch (static_cast<value::kind>(kind)) {
+		case value::kind::nil:
+			compiled.constants.emplace_back();
+			break;
+		case value::kind::boolean: {
+			uint8_t flag;
+			if (!in.get(flag)) return false;
+			compiled.constants.emplace_back(flag != 0);
+			break;
+		}
+		case value::kind::number: {
+			double number;
+			if (!in.get(number)) return false;
+			compiled.constants.emplace_back(number);
+			break;
+		}
+		case value::kind::string: {
+			string text;
+			if (!in.getString(text)) return false;
+			compiled.constants.emplace_back(move(text));
+			break;
+		}
+		default:
+			return false;
+		}
+	}
+
+	if (!in.getCount(count, sizeof(uint32_t))) return false;
+	compiled.natives.resize(count);
+	for (auto& name : compiled.natives) {
+		if (!in.getString(name)) return false;
+	}
+
+	if (!in.getCount(count, sizeof(uint32_t) * 2 + 2)) return false;
+	compiled.functions.resize(count);
+	for (auto& fn : compiled.functions) {
+		uint32_t length;
+		if (!in.getString(fn.name) || !in.get(fn.parameters) || !in.get(fn.registers)) return false;
+		if (!in.getCount(length, sizeof(uint32_t) * 2)) return false;
+
+		fn.code.resize(length);
+		fn.lines.resize(length);
+		for (auto& word : fn.code) in.get(word);
+		for (auto& line : fn.lines) in.get(line);
+	}
+
+	if (!in.done() || !verify(compiled)) return false;
+
+	out = move(compiled);
+	return true;
+}
\ No newline at end of file
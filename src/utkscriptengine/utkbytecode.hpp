@@ -0,0 +1,120 @@
+//===================================================================================================================================
+// @file	utkbytecode.hpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief	Internal header containing the bytecode format shared by the compiler, the cache and the
+//			interpreter of UTK::ScriptEngine. Not installed, nothing outside src/utkscriptengine includes it.
+//
+// @note    Instructions are 32-bit words, the opcode in the low byte then either three 8-bit operands
+//          (A, B, C) or A and a 16-bit Bx/sBx. Registers are frame relative, a call's arguments are laid
+//          out in the caller's registers so they become the callee's first registers without copying.
+//===================================================================================================================================
+
+#pragma once
+
+#include "scriptengine/utkscriptengine.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace UTK::ScriptEngine {
+
+	//===================================================================================================================================
+	//											              INSTRUCTION ENCODING
+	//===================================================================================================================================
+
+	namespace Internal {
+
+		// The order here is the order of the interpreter's dispatch table, keep the two in step
+		enum class opcode : std::uint8_t {
+			move,			// R[A] = R[B]
+			loadConst,		// R[A] = K[Bx]
+			loadInt,		// R[A] = sBx
+			loadNil,		// R[A] = nil
+			loadBool,		// R[A] = B != 0
+			add,			// R[A] = R[B] + R[C], numbers add, a string on either side concatenates
+			sub,			// R[A] = R[B] - R[C]
+			mul,			// R[A] = R[B] * R[C]
+			div,			// R[A] = R[B] / R[C]
+			mod,			// R[A] = fmod(R[B], R[C])
+			neg,			// R[A] = -R[B]
+			logicalNot,		// R[A] = !truthy(R[B])
+			equal,			// R[A] = R[B] == R[C]
+			notEqual,		// R[A] = R[B] != R[C]
+			less,			// R[A] = R[B] < R[C], numbers or strings
+			lessEqual,		// R[A] = R[B] <= R[C]
+			jump,			// pc += sBx
+			jumpIf,			// if truthy(R[A]) pc += sBx
+			jumpIfNot,		// if !truthy(R[A]) pc += sBx
+			call,			// R[A] = functions[B](R[A] .. R[A + C - 1])
+			callNative,		// R[A] = natives[B](R[A] .. R[A + C - 1])
+			ret,			// return R[A]
+			retNil,			// return nil
+			count
+		};
+
+		inline constexpr std::uint32_t encode(opcode op, std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+			return static_cast<std::uint32_t>(op) | (a << 8) | (b << 16) | (c << 24);
+		}
+		inline constexpr std::uint32_t encodeBx(opcode op, std::uint32_t a, std::uint32_t bx) {
+			return static_cast<std::uint32_t>(op) | (a << 8) | (bx << 16);
+		}
+		inline constexpr std::uint32_t encodeSBx(opcode op, std::uint32_t a, std::int32_t sbx) {
+			return encodeBx(op, a, static_cast<std::uint32_t>(sbx + 0x8000));
+		}
+
+		inline constexpr opcode opOf(std::uint32_t ins) { return static_cast<opcode>(ins & 0xFF); }
+		inline constexpr std::uint32_t argA(std::uint32_t ins) { return (ins >> 8) & 0xFF; }
+		inline constexpr std::uint32_t argB(std::uint32_t ins) { return (ins >> 16) & 0xFF; }
+		inline constexpr std::uint32_t argC(std::uint32_t ins) { return ins >> 24; }
+		inline constexpr std::uint32_t argBx(std::uint32_t ins) { return ins >> 16; }
+		inline constexpr std::int32_t argSBx(std::uint32_t ins) { return static_cast<std::int32_t>(ins >> 16) - 0x8000; }
+
+		inline constexpr std::size_t maxRegisters = 250;
+		inline constexpr std::size_t maxConstants = 0xFFFF;
+		inline constexpr std::int32_t maxJump = 0x7FFF;
+
+		/**
+		 * @brief One compiled function, index 0 of a program is the script's top level
+		 */
+		struct chunk {
+			std::string name;
+			std::uint8_t parameters = 0;
+			std::uint8_t registers = 0;				// Frame size, parameters included
+			std::vector<std::uint32_t> code;
+			std::vector<std::uint32_t> lines;		// Source line of each instruction, for error messages
+		};
+	}
+
+	//===================================================================================================================================
+	//											                 COMPILED PROGRAM
+	//===================================================================================================================================
+
+	struct program {
+		Hash::hash128 sourceHash;
+		std::vector<value> constants;
+		std::vector<std::string> natives;			// Host functions called, bound by name at run time
+		std::vector<Internal::chunk> functions;
+	};
+
+	namespace Internal {
+
+		/**
+		 * @brief Parses and compiles source in a single pass
+		 *
+		 * @throws std::runtime_error "line N: ..." on a syntax error.
+		 */
+		program compileSource(std::string_view source);
+
+		/**
+		 * @brief Flat binary form used for the disk cache, tagged with a format version
+		 */
+		std::string serialize(const program& compiled);
+
+		/**
+		 * @return false if the bytes are truncated, from another format version or otherwise malformed.
+		 */
+		bool deserialize(std::string_view bytes, program& out);
+	}
+}
\ No newline at end of file
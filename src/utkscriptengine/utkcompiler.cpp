@@ -0,0 +1,792 @@
+//===================================================================================================================================
+// @file	utkcompiler.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the single pass compiler of UTK::ScriptEngine, source text straight to
+//			register bytecode with no syntax tree in between.
+//
+// @note    Expressions leave their result in a register and report which one. A bare local reports its own
+//          register so reading a variable costs nothing, anything else lands in the next free temporary.
+//          Locals occupy the bottom of the frame in declaration order and temporaries sit above them, so
+//          every statement starts and ends with the free register just past the last live local.
+//===================================================================================================================================
+
+#include "utkbytecode.hpp"
+#include <unordered_map>
+#include <system_error>
+#include <stdexcept>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cmath>
+
+using namespace std;
+using namespace UTK::ScriptEngine;
+using namespace UTK::ScriptEngine::Internal;
+
+//===================================================================================================================================
+//											                    LEXER
+//===================================================================================================================================
+
+namespace {
+
+	enum class token : uint8_t {
+		end, number, string, identifier,
+		kwLet, kwFn, kwIf, kwElse, kwWhile, kwBreak, kwContinue, kwReturn, kwTrue, kwFalse, kwNil,
+		leftParen, rightParen, leftBrace, rightBrace, comma, semicolon,
+		assign, equal, notEqual, less, lessEqual, greater, greaterEqual,
+		plus, minus, star, slash, percent, bang, andAnd, orOr
+	};
+
+	struct lexeme {
+		token type = token::end;
+		string_view text;			// Strings exclude their quotes and are still escaped
+		uint32_t line = 1;
+	};
+
+	[[noreturn]] void fail(uint32_t line, const string& message) {
+		throw runtime_error("line " + to_string(line) + ": " + message);
+	}
+
+	string describe(const lexeme& lex) {
+		switch (lex.type) {
+		case token::end: return "end of script";
+		case token::string: return "\"" + string(lex.text) + "\"";
+		default: return "'" + string(lex.text) + "'";
+		}
+	}
+
+	token keyword(string_view word) {
+		static const unordered_map<string_view, token> keywords = {
+			{ "let", token::kwLet }, { "fn", token::kwFn }, { "if", token::kwIf }, { "else", token::kwElse },
+			{ "while", token::kwWhile }, { "break", token::kwBreak }, { "continue", token::kwContinue },
+			{ "return", token::kwReturn }, { "true", token::kwTrue }, { "false", token::kwFalse }, { "nil", token::kwNil }
+		};
+
+		auto it = keywords.find(word);
+		return it == keywords.end() ? token::identifier : it->second;
+	}
+
+	class lexer {
+	private:
+		string_view _source;
+		size_t _pos = 0;
+		uint32_t _line = 1;
+
+		bool at(char c) const { return _pos < _source.size() && _source[_pos] == c; }
+
+		void skipSpace() {
+			while (_pos < _source.size()) {
+				const char c = _source[_pos];
+				if (c == '\n') {
+					_line++;
+					_pos++;
+				}
+				else if (c == ' ' || c == '\t' || c == '\r') {
+					_pos++;
+				}
+				else if (c == '/' && _pos + 1 < _source.size() && _source[_pos + 1] == '/') {
+					while (_pos < _source.size() && _source[_pos] != '\n') _pos++;
+				}
+				else {
+					break;
+				}
+			}
+		}
+
+	public:
+		explicit lexer(string_view source) : _source(source) {}
+
+		lexeme next() {
+			skipSpace();
+
+			lexeme lex;
+			lex.line = _line;
+			if (_pos >= _source.size()) return lex;
+
+			const size_t start = _pos;
+			const char c = _source[_pos++];
+
+			auto isIdent = [](char ch) { return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_'; };
+			auto isDigit = [](char ch) { return ch >= '0' && ch <= '9'; };
+
+			if (isDigit(c)) {
+				while (_pos < _source.size() && (isDigit(_source[_pos]) || _source[_pos] == '.')) _pos++;
+				lex.type = token::number;
+			}
+			else if (isIdent(c)) {
+				while (_pos < _source.size() && isIdent(_source[_pos])) _pos++;
+				lex.type = keyword(_source.substr(start, _pos - start));
+			}
+			else if (c == '"') {
+				while (_pos < _source.size() && _source[_pos] != '"') {
+					if (_source[_pos] == '\n') fail(_line, "unterminated string");
+					if (_source[_pos] == '\\') _pos++;
+					_pos++;
+				}
+				if (_pos >= _source.size()) fail(_line, "unterminated string");
+
+				lex.type = token::string;
+				lex.text = _source.substr(start + 1, _pos - start - 1);
+				_pos++;
+				return lex;
+			}
+			else {
+				auto pair = [&](char second, token two, token one) {
+					if (at(second)) {
+						_pos++;
+						return two;
+					}
+					return one;
+				};
+
+				switch (c) {
+				case '(': lex.type = token::leftParen; break;
+				case ')': lex.type = token::rightParen; break;
+				case '{': lex.type = token::leftBrace; break;
+				case '}': lex.type = token::rightBrace; break;
+				case ',': lex.type = token::comma; break;
+				case ';': lex.type = token::semicolon; break;
+				case '+': lex.type = token::plus; break;
+				case '-': lex.type = token::minus; break;
+				case '*': lex.type = token::star; break;
+				case '/': lex.type = token::slash; break;
+				case '%': lex.type = token::percent; break;
+				case '=': lex.type = pair('=', token::equal, token::assign); break;
+				case '!': lex.type = pair('=', token::notEqual, token::bang); break;
+				case '<': lex.type = pair('=', token::lessEqual, token::less); break;
+				case '>': lex.type = pair('=', token::greaterEqual, token::greater); break;
+				case '&':
+					if (!at('&')) fail(_line, "unexpected '&', did you mean '&&'");
+					_pos++;
+					lex.type = token::andAnd;
+					break;
+				case '|':
+					if (!at('|')) fail(_line, "unexpected '|', did you mean '||'");
+					_pos++;
+					lex.type = token::orOr;
+					break;
+				default:
+					fail(_line, "unexpected character '" + string(1, c) + "'");
+				}
+			}
+
+			lex.text = _source.substr(start, _pos - start);
+			return lex;
+		}
+	};
+
+	//===================================================================================================================================
+	//											                  COMPILER
+	//===================================================================================================================================
+
+	class compiler {
+	private:
+		struct signature {
+			uint16_t index;
+			uint8_t parameters;
+		};
+
+		struct local {
+			string_view name;
+			uint32_t reg;
+			uint32_t depth;
+		};
+
+		struct loop {
+			size_t start;
+			vector<size_t> breaks;
+		};
+
+		// Everything that belongs to the function being emitted, swapped out while a fn body compiles
+		struct functionState {
+			chunk* fn = nullptr;
+			vector<local> locals;
+			vector<loop> loops;
+			uint32_t depth = 0;
+			uint32_t freeReg = 0;
+			size_t barrier = 0;			// No instruction before this index may be rewritten, a jump lands here
+		};
+
+		lexer _lexer;
+		lexeme _current;
+		lexeme _peek;
+		uint32_t _line = 1;				// Line of the last consumed token, stamped on emitted instructions
+		program& _out;
+
+		unordered_map<string_view, signature> _functions;
+		unordered_map<string_view, uint16_t> _natives;
+		unordered_map<uint64_t, uint16_t> _numbers;
+		unordered_map<string, uint16_t> _strings;
+
+		functionState _state;
+
+		//===================================================================================================================================
+		//											                TOKEN HANDLING
+		//===================================================================================================================================
+
+		void advance() {
+			_line = _current.line;
+			_current = _peek;
+			_peek = _lexer.next();
+		}
+
+		bool match(token type) {
+			if (_current.type != type) return false;
+			advance();
+			return true;
+		}
+
+		lexeme expect(token type, const char* what) {
+			if (_current.type != type) fail(_current.line, string("expected ") + what + " but found " + describe(_current));
+
+			lexeme lex = _current;
+			advance();
+			return lex;
+		}
+
+		//===================================================================================================================================
+		//											               EMISSION HELPERS
+		//===================================================================================================================================
+
+		size_t emit(uint32_t ins) {
+			_state.fn->code.push_back(ins);
+			_state.fn->lines.push_back(_line);
+			return _state.fn->code.size() - 1;
+		}
+
+		uint32_t allocReg() {
+			const uint32_t reg = _state.freeReg++;
+			if (_state.freeReg > maxRegisters) fail(_line, "expression too complex, out of registers");
+
+			_state.fn->registers = max(_state.fn->registers, static_cast<uint8_t>(_state.freeReg));
+			return reg;
+		}
+
+		uint32_t localsTop() const {
+			return _state.locals.empty() ? 0 : _state.locals.back().reg + 1;
+		}
+
+		const local* findLocal(string_view name) const {
+			for (auto it = _state.locals.rbegin(); it != _state.locals.rend(); ++it) {
+				if (it->name == name) return &*it;
+			}
+			return nullptr;
+		}
+
+		size_t emitJump(opcode op, uint32_t reg) {
+			return emit(encodeSBx(op, reg, 0));
+		}
+
+		/// Points a forward jump at the next instruction to be emitted
+		void patchJump(size_t at) {
+			auto& code = _state.fn->code;
+			const auto offset = static_cast<int64_t>(code.size()) - static_cast<int64_t>(at) - 1;
+			if (offset > maxJump) fail(_line, "block too large to jump over");
+
+			code[at] = encodeSBx(opOf(code[at]), argA(code[at]), static_cast<int32_t>(offset));
+			_state.barrier = code.size();
+		}
+
+		void emitLoop(size_t start) {
+			const auto offset = static_cast<int64_t>(start) - static_cast<int64_t>(_state.fn->code.size()) - 1;
+			if (offset < -maxJump) fail(_line, "loop body too large");
+
+			emit(encodeSBx(opcode::jump, 0, static_cast<int32_t>(offset)));
+		}
+
+		static bool writesA(opcode op) {
+			return op <= opcode::lessEqual;
+		}
+
+		/**
+		 * @brief Gets the value in src into dst, rewriting the instruction that produced a temporary in
+		 *		  place of a move where that is safe
+		 */
+		void moveInto(uint32_t dst, uint32_t src) {
+			if (dst == src) return;
+
+			auto& code = _state.fn->code;
+			if (src >= localsTop() && code.size() > _state.barrier) {
+				uint32_t& last = code.back();
+				if (writesA(opOf(last)) && argA(last) == src) {
+					last = (last & ~0xFF00u) | (dst << 8);
+					return;
+				}
+			}
+			emit(encode(opcode::move, dst, src, 0));
+		}
+
+		uint16_t numberConstant(double number) {
+			uint64_t bits;
+			memcpy(&bits, &number, sizeof(bits));
+
+			auto [it, inserted] = _numbers.try_emplace(bits, static_cast<uint16_t>(_out.constants.size()));
+			if (inserted) {
+				if (_out.constants.size() >= maxConstants) fail(_line, "too many constants");
+				_out.constants.emplace_back(number);
+			}
+			return it->second;
+		}
+
+		uint16_t stringConstant(string text) {
+			auto [it, inserted] = _strings.try_emplace(text, static_cast<uint16_t>(_out.constants.size()));
+			if (inserted) {
+				if (_out.constants.size() >= maxConstants) fail(_line, "too many constants");
+				_out.constants.emplace_back(move(text));
+			}
+			return it->second;
+		}
+
+		string unescape(const lexeme& lex) {
+			string text;
+			text.reserve(lex.text.size());
+
+			for (size_t i = 0; i < lex.text.size(); i++) {
+				if (lex.text[i] != '\\') {
+					text += lex.text[i];
+					continue;
+				}
+
+				switch (lex.text[++i]) {
+				case 'n': text += '\n'; break;
+				case 't': text += '\t'; break;
+				case 'r': text += '\r'; break;
+				case '0': text += '\0'; break;
+				case '\\': text += '\\'; break;
+				case '"': text += '"'; break;
+				default: fail(lex.line, "unknown escape '\\" + string(1, lex.text[i]) + "'");
+				}
+			}
+			return text;
+		}
+
+		//===================================================================================================================================
+		//											                 EXPRESSIONS
+		//===================================================================================================================================
+
+		uint32_t numberLiteral(const lexeme& lex, bool negate) {
+			double number = 0.0;
+			auto [end, ec] = from_chars(lex.text.data(), lex.text.data() + lex.text.size(), number);
+			if (ec != errc() || end != lex.text.data() + lex.text.size()) fail(lex.line, "malformed number " + describe(lex));
+			if (negate) number = -number;
+
+			const uint32_t dst = allocReg();
+			if (number == trunc(number) && number >= -32768.0 && number <= 32767.0 && !(number == 0.0 && signbit(number))) {
+				emit(encodeSBx(opcode::loadInt, dst, static_cast<int32_t>(number)));
+			}
+			else {
+				emit(encodeBx(opcode::loadConst, dst, numberConstant(number)));
+			}
+			return dst;
+		}
+
+		uint32_t call(const lexeme& name) {
+			expect(token::leftParen, "'('");
+
+			const uint32_t base = _state.freeReg;
+			uint32_t count = 0;
+
+			if (_current.type != token::rightParen) {
+				do {
+					const uint32_t slot = _state.freeReg;
+					const uint32_t reg = expression();
+					_state.freeReg = slot;
+					moveInto(allocReg(), reg);
+
+					if (++count > 255) fail(name.line, "too many arguments");
+				} while (match(token::comma));
+			}
+			expect(token::rightParen, "')'");
+
+			_state.freeReg = base;
+			const uint32_t dst = allocReg();
+
+			if (auto it = _functions.find(name.text); it != _functions.end()) {
+				if (count != it->second.parameters) {
+					fail(name.line, string(name.text) + " expects " + to_string(it->second.parameters) + " arguments, got " + to_string(count));
+				}
+				emit(encode(opcode::call, base, it->second.index, count));
+			}
+			else {
+				auto [nit, inserted] = _natives.try_emplace(name.text, static_cast<uint16_t>(_out.natives.size()));
+				if (inserted) {
+					if (_out.natives.size() > 255) fail(name.line, "too many host functions");
+					_out.natives.emplace_back(name.text);
+				}
+				emit(encode(opcode::callNative, base, nit->second, count));
+			}
+			return dst;
+		}
+
+		uint32_t primary() {
+			const lexeme lex = _current;
+
+			switch (lex.type) {
+			case token::number:
+				advance();
+				return numberLiteral(lex, false);
+
+			case token::string: {
+				advance();
+				const uint16_t index = stringConstant(unescape(lex));
+				const uint32_t dst = allocReg();
+				emit(encodeBx(opcode::loadConst, dst, index));
+				return dst;
+			}
+
+			case token::kwTrue:
+			case token::kwFalse: {
+				advance();
+				const uint32_t dst = allocReg();
+				emit(encode(opcode::loadBool, dst, lex.type == token::kwTrue, 0));
+				return dst;
+			}
+
+			case token::kwNil: {
+				advance();
+				const uint32_t dst = allocReg();
+				emit(encode(opcode::loadNil, dst, 0, 0));
+				return dst;
+			}
+
+			case token::identifier:
+				advance();
+				if (_current.type == token::leftParen) return call(lex);
+				if (const local* var = findLocal(lex.text)) return var->reg;
+				fail(lex.line, "undefined variable '" + string(lex.text) + "'");
+
+			case token::leftParen: {
+				advance();
+				const uint32_t reg = expression();
+				expect(token::rightParen, "')'");
+				return reg;
+			}
+
+			default:
+				fail(lex.line, "expected an expression but found " + describe(lex));
+			}
+		}
+
+		uint32_t unary() {
+			if (_current.type != token::minus && _current.type != token::bang) return primary();
+
+			const token op = _current.type;
+			advance();
+
+			if (op == token::minus && _current.type == token::number) {
+				const lexeme lex = _current;
+				advance();
+				return numberLiteral(lex, true);
+			}
+
+			const uint32_t base = _state.freeReg;
+			const uint32_t operand = unary();
+			_state.freeReg = base;
+
+			const uint32_t dst = allocReg();
+			emit(encode(op == token::minus ? opcode::neg : opcode::logicalNot, dst, operand, 0));
+			return dst;
+		}
+
+		static int precedence(token type) {
+			switch (type) {
+			case token::orOr: return 1;
+			case token::andAnd: return 2;
+			case token::equal: case token::notEqual: return 3;
+			case token::less: case token::lessEqual: case token::greater: case token::greaterEqual: return 4;
+			case token::plus: case token::minus: return 5;
+			case token::star: case token::slash: case token::percent: return 6;
+			default: return 0;
+			}
+		}
+
+		uint32_t binary(int minPrecedence) {
+			const uint32_t base = _state.freeReg;
+			uint32_t left = unary();
+
+			for (int prec = precedence(_current.type); prec >= minPrecedence && prec > 0; prec = precedence(_current.type)) {
+				const token op = _current.type;
+				advance();
+
+				if (op == token::andAnd || op == token::orOr) {
+					// Short circuit, the left value stays as the result unless the right side runs
+					_state.freeReg = base;
+					const uint32_t dst = allocReg();
+					if (left != dst) emit(encode(opcode::move, dst, left, 0));
+
+					const size_t skip = emitJump(op == token::andAnd ? opcode::jumpIfNot : opcode::jumpIf, dst);
+					const uint32_t right = binary(prec + 1);
+					moveInto(dst, right);
+
+					_state.freeReg = base + 1;
+					patchJump(skip);
+					left = dst;
+					continue;
+				}
+
+				const uint32_t right = binary(prec + 1);
+				_state.freeReg = base;
+				const uint32_t dst = allocReg();
+
+				switch (op) {
+				case token::plus: emit(encode(opcode::add, dst, left, right)); break;
+				case token::minus: emit(encode(opcode::sub, dst, left, right)); break;
+				case token::star: emit(encode(opcode::mul, dst, left, right)); break;
+				case token::slash: emit(encode(opcode::div, dst, left, right)); break;
+				case token::percent: emit(encode(opcode::mod, dst, left, right)); break;
+				case token::equal: emit(encode(opcode::equal, dst, left, right)); break;
+				case token::notEqual: emit(encode(opcode::notEqual, dst, left, right)); break;
+				case token::less: emit(encode(opcode::less, dst, left, right)); break;
+				case token::lessEqual: emit(encode(opcode::lessEqual, dst, left, right)); break;
+				case token::greater: emit(encode(opcode::less, dst, right, left)); break;
+				case token::greaterEqual: emit(encode(opcode::lessEqual, dst, right, left)); break;
+				default: break;
+				}
+				left = dst;
+			}
+			return left;
+		}
+
+		uint32_t expression() {
+			return binary(1);
+		}
+
+		//===================================================================================================================================
+		//											                 STATEMENTS
+		//===================================================================================================================================
+
+		void endScope() {
+			_state.depth--;
+			while (!_state.locals.empty() && _state.locals.back().depth > _state.depth) _state.locals.pop_back();
+			_state.freeReg = localsTop();
+		}
+
+		void block() {
+			expect(token::leftBrace, "'{'");
+			_state.depth++;
+
+			while (_current.type != token::rightBrace && _current.type != token::end) statement();
+
+			expect(token::rightBrace, "'}'");
+			endScope();
+		}
+
+		void letStatement() {
+			const lexeme name = expect(token::identifier, "a variable name");
+			expect(token::assign, "'='");
+
+			const uint32_t base = _state.freeReg;
+			const uint32_t reg = expression();
+
+			// A fresh temporary is already sitting where the new local goes, just claim it
+			_state.freeReg = base;
+			const uint32_t slot = allocReg();
+			if (reg != slot) emit(encode(opcode::move, slot, reg, 0));
+
+			_state.locals.push_back({ name.text, slot, _state.depth });
+		}
+
+		void assignment(const lexeme& name) {
+			const local* var = findLocal(name.text);
+			if (!var) fail(name.line, "assignment to undeclared variable '" + string(name.text) + "', declare it with let");
+
+			const uint32_t target = var->reg;
+			moveInto(target, expression());
+		}
+
+		void ifStatement() {
+			const uint32_t condition = expression();
+			const size_t skipThen = emitJump(opcode::jumpIfNot, condition);
+			_state.freeReg = localsTop();
+
+			block();
+
+			if (match(token::kwElse)) {
+				const size_t skipElse = emitJump(opcode::jump, 0);
+				patchJump(skipThen);
+
+				if (match(token::kwIf)) ifStatement();
+				else block();
+
+				patchJump(skipElse);
+			}
+			else {
+				patchJump(skipThen);
+			}
+		}
+
+		void whileStatement() {
+			const size_t start = _state.fn->code.size();
+			_state.barrier = start;
+
+			const uint32_t condition = expression();
+			const size_t exit = emitJump(opcode::jumpIfNot, condition);
+			_state.freeReg = localsTop();
+
+			_state.loops.push_back({ start, {} });
+			block();
+			emitLoop(start);
+
+			patchJump(exit);
+			for (size_t at : _state.loops.back().breaks) patchJump(at);
+			_state.loops.pop_back();
+		}
+
+		void returnStatement() {
+			if (_current.type == token::rightBrace || _current.type == token::semicolon || _current.type == token::end) {
+				emit(encode(opcode::retNil, 0, 0, 0));
+				return;
+			}
+			emit(encode(opcode::ret, expression(), 0, 0));
+		}
+
+		void functionDeclaration(const lexeme& keyword) {
+			if (_state.fn != &_out.functions[0] || _state.depth != 0) fail(keyword.line, "functions can only be declared at the top level");
+
+			const lexeme name = expect(token::identifier, "a function name");
+			const signature sig = _functions.at(name.text);
+
+			functionState outer = move(_state);
+			_state = functionState{};
+			_state.fn = &_out.functions[sig.index];
+			_state.depth = 1;
+
+			expect(token::leftParen, "'('");
+			if (_current.type != token::rightParen) {
+				do {
+					const lexeme param = expect(token::identifier, "a parameter name");
+					if (findLocal(param.text)) fail(param.line, "duplicate parameter '" + string(param.text) + "'");
+					_state.locals.push_back({ param.text, allocReg(), 1 });
+				} while (match(token::comma));
+			}
+			expect(token::rightParen, "')'");
+			_state.fn->parameters = static_cast<uint8_t>(_state.locals.size());
+
+			block();
+			emit(encode(opcode::retNil, 0, 0, 0));
+
+			_state = move(outer);
+		}
+
+		void statement() {
+			const lexeme lex = _current;
+
+			switch (lex.type) {
+			case token::kwLet:
+				advance();
+				letStatement();
+				break;
+
+			case token::kwIf:
+				advance();
+				ifStatement();
+				break;
+
+			case token::kwWhile:
+				advance();
+				whileStatement();
+				break;
+
+			case token::kwFn:
+				advance();
+				functionDeclaration(lex);
+				break;
+
+			case token::kwReturn:
+				advance();
+				returnStatement();
+				break;
+
+			case token::kwBreak:
+			case token::kwContinue:
+				advance();
+				if (_state.loops.empty()) fail(lex.line, describe(lex) + " outside of a loop");
+
+				if (lex.type == token::kwBreak) _state.loops.back().breaks.push_back(emitJump(opcode::jump, 0));
+				else emitLoop(_state.loops.back().start);
+				break;
+
+			case token::leftBrace:
+				block();
+				break;
+
+			case token::identifier:
+				if (_peek.type == token::assign) {
+					advance();
+					advance();
+					assignment(lex);
+					break;
+				}
+				[[fallthrough]];
+
+			default:
+				expression();
+				break;
+			}
+
+			_state.freeReg = localsTop();
+			match(token::semicolon);
+		}
+
+		/// Finds every top level fn up front so calls can be compiled before the definition is reached
+		void declareFunctions(string_view source) {
+			lexer scan(source);
+			int depth = 0;
+			vector<pair<string_view, uint8_t>> found;
+
+			for (lexeme lex = scan.next(); lex.type != token::end; lex = scan.next()) {
+				if (lex.type == token::leftBrace) depth++;
+				else if (lex.type == token::rightBrace) depth--;
+				if (lex.type != token::kwFn || depth != 0) continue;
+
+				const lexeme name = scan.next();
+				if (name.type != token::identifier) fail(name.line, "expected a function name but found " + describe(name));
+				if (scan.next().type != token::leftParen) fail(name.line, "expected '(' after " + string(name.text));
+
+				uint32_t parameters = 0;
+				for (lexeme param = scan.next(); param.type != token::rightParen && param.type != token::end; param = scan.next()) {
+					if (param.type == token::identifier) parameters++;
+				}
+				if (parameters > maxRegisters) fail(name.line, "too many parameters");
+
+				if (_functions.contains(name.text)) fail(name.line, "function '" + string(name.text) + "' declared twice");
+				if (found.size() + 1 > 255) fail(name.line, "too many functions");
+				_functions.emplace(name.text, signature{ static_cast<uint16_t>(found.size() + 1), static_cast<uint8_t>(parameters) });
+				found.emplace_back(name.text, static_cast<uint8_t>(parameters));
+			}
+
+			// Sized once, emission holds pointers into this vector
+			_out.functions.resize(found.size() + 1);
+			_out.functions[0].name = "<script>";
+			for (size_t i = 0; i < found.size(); i++) _out.functions[i + 1].name = string(found[i].first);
+		}
+
+	public:
+		compiler(string_view source, program& out) : _lexer(source), _out(out) {
+			declareFunctions(source);
+
+			_peek = _lexer.next();
+			advance();
+		}
+
+		void run() {
+			_state.fn = &_out.functions[0];
+
+			while (_current.type != token::end) statement();
+			emit(encode(opcode::retNil, 0, 0, 0));
+		}
+	};
+}
+
+//===================================================================================================================================
+//											                COMPILER ENTRY POINT
+//===================================================================================================================================
+
+program UTK::ScriptEngine::Internal::compileSource(string_view source) {
+
+	program out;
+	compiler(source, out).run();
+	return out;
+}
\ No newline at end of file
@@ -0,0 +1,528 @@
+//===================================================================================================================================
+// @file	utkscriptengine.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the script values, the bytecode interpreter and the compiled program cache
+//			of UTK::ScriptEngine.
+//
+// @note    The interpreter threads dispatch with computed goto on GCC and Clang, every handler jumps
+//          straight to the next one through a label table instead of back to a shared switch, which keeps
+//          the branch predictor working per opcode. Other compilers get the equivalent switch loop.
+//===================================================================================================================================
+
+#include "utkbytecode.hpp"
+#include <system_error>
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <cmath>
+
+using namespace std;
+using namespace UTK::ScriptEngine;
+using namespace UTK::ScriptEngine::Internal;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define UTK_SCRIPT_COMPUTED_GOTO 1
+#else
+#define UTK_SCRIPT_COMPUTED_GOTO 0
+#endif
+
+//===================================================================================================================================
+//											              VALUE METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+bool value::asBool() const {
+
+	if (auto b = get_if<bool>(&_data)) return *b;
+	throw runtime_error("value is not a bool");
+}
+
+double value::asNumber() const {
+
+	if (auto n = get_if<double>(&_data)) return *n;
+	throw runtime_error("value is not a number");
+}
+
+const string& value::asString() const {
+
+	if (auto s = get_if<shared_ptr<const string>>(&_data)) return **s;
+	throw runtime_error("value is not a string");
+}
+
+string value::toString() const {
+
+	switch (type()) {
+	case kind::nil: return "nil";
+	case kind::boolean: return asBool() ? "true" : "false";
+	case kind::string: return asString();
+	case kind::number: break;
+	}
+
+	const double n = asNumber();
+	char text[32];
+	const int length = (n == trunc(n) && fabs(n) < 1e15)
+		? snprintf(text, sizeof(text), "%.0f", n)
+		: snprintf(text, sizeof(text), "%.14g", n);
+	return string(text, static_cast<size_t>(max(length, 0)));
+}
+
+bool UTK::ScriptEngine::operator==(const value& left, const value& right) {
+
+	if (left._data.index() != right._data.index()) return false;
+
+	switch (left.type()) {
+	case value::kind::nil: return true;
+	case value::kind::boolean: return left.asBool() == right.asBool();
+	case value::kind::number: return left.asNumber() == right.asNumber();
+	case value::kind::string: return left.asString() == right.asString();
+	}
+	return false;
+}
+
+//===================================================================================================================================
+//											                   INTERPRETER
+//===================================================================================================================================
+
+namespace UTK::ScriptEngine::Internal {
+
+	struct machine {
+		struct frame {
+			const chunk* fn;
+			const uint32_t* pc;
+			size_t base;
+		};
+
+		[[noreturn]] static void fail(const chunk* fn, const uint32_t* pc, const string& message) {
+			const auto at = static_cast<size_t>(pc - fn->code.data()) - 1;
+			throw runtime_error("line " + to_string(fn->lines[at]) + ": " + message);
+		}
+
+		static const double* number(const value& v) { return get_if<double>(&v._data); }
+		static const shared_ptr<const string>* text(const value& v) { return get_if<shared_ptr<const string>>(&v._data); }
+
+		static value execute(const program& compiled, const vector<const nativeFunction*>& natives, size_t maxCallDepth);
+	};
+}
+
+#if UTK_SCRIPT_COMPUTED_GOTO
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+value machine::execute(const program& compiled, const vector<const nativeFunction*>& natives, size_t maxCallDepth) {
+
+	const chunk* fn = &compiled.functions[0];
+	const uint32_t* pc = fn->code.data();
+	const value* constants = compiled.constants.data();
+
+	vector<value> stack(max<size_t>(fn->registers, 64));
+	vector<frame> frames;
+	size_t base = 0;
+	value* R = stack.data();
+	uint32_t ins;
+
+	// Arithmetic shared by the numeric opcodes, anything that is not two numbers is a script error
+#define VM_ARITH(expr, what)																					\
+	{																											\
+		const double* x = number(R[argB(ins)]);																	\
+		const double* y = number(R[argC(ins)]);																	\
+		if (!x || !y) fail(fn, pc, string("cannot ") + what + " " + R[argB(ins)].toString() + " and " + R[argC(ins)].toString());	\
+		R[argA(ins)]._data = (expr);																			\
+	}
+
+#define VM_COMPARE(op)																							\
+	{																											\
+		const value& l = R[argB(ins)];																			\
+		const value& r = R[argC(ins)];																			\
+		bool result;																							\
+		if (const double *x = number(l), *y = number(r); x && y) result = *x op *y;								\
+		else if (auto s = text(l), t = text(r); s && t) result = **s op **t;									\
+		else fail(fn, pc, "cannot compare " + l.toString() + " with " + r.toString());							\
+		R[argA(ins)]._data = result;																			\
+	}
+
+#if UTK_SCRIPT_COMPUTED_GOTO
+	static void* const dispatch[] = {
+		&&op_move, &&op_loadConst, &&op_loadInt, &&op_loadNil, &&op_loadBool,
+		&&op_add, &&op_sub, &&op_mul, &&op_div, &&op_mod, &&op_neg, &&op_logicalNot,
+		&&op_equal, &&op_notEqual, &&op_less, &&op_lessEqual,
+		&&op_jump, &&op_jumpIf, &&op_jumpIfNot, &&op_call, &&op_callNative, &&op_ret, &&op_retNil
+	};
+	static_assert(size(dispatch) == static_cast<size_t>(opcode::count), "dispatch table out of step with opcode");
+
+#define VM_CASE(name) op_##name:
+#define VM_NEXT() do { ins = *pc++; goto *dispatch[ins & 0xFF]; } while (0)
+
+	VM_NEXT();
+#else
+#define VM_CASE(name) case opcode::name:
+#define VM_NEXT() break
+
+	for (;;) {
+		ins = *pc++;
+		switch (opOf(ins)) {
+#endif
+
+		VM_CASE(move) {
+			R[argA(ins)] = R[argB(ins)];
+			VM_NEXT();
+		}
+
+		VM_CASE(loadConst) {
+			R[argA(ins)] = constants[argBx(ins)];
+			VM_NEXT();
+		}
+
+		VM_CASE(loadInt) {
+			R[argA(ins)]._data = static_cast<double>(argSBx(ins));
+			VM_NEXT();
+		}
+
+		VM_CASE(loadNil) {
+			R[argA(ins)]._data = monostate{};
+			VM_NEXT();
+		}
+
+		VM_CASE(loadBool) {
+			R[argA(ins)]._data = argB(ins) != 0;
+			VM_NEXT();
+		}
+
+		VM_CASE(add) {
+			const value& l = R[argB(ins)];
+			const value& r = R[argC(ins)];
+
+			if (const double *x = number(l), *y = number(r); x && y) {
+				R[argA(ins)]._data = *x + *y;
+			}
+			else if (text(l) || text(r)) {
+				R[argA(ins)] = value(l.toString() + r.toString());
+			}
+			else {
+				fail(fn, pc, "cannot add " + l.toString() + " and " + r.toString());
+			}
+			VM_NEXT();
+		}
+
+		VM_CASE(sub) {
+			VM_ARITH(*x - *y, "subtract");
+			VM_NEXT();
+		}
+
+		VM_CASE(mul) {
+			VM_ARITH(*x * *y, "multiply");
+			VM_NEXT();
+		}
+
+		VM_CASE(div) {
+			VM_ARITH(*x / *y, "divide");
+			VM_NEXT();
+		}
+
+		VM_CASE(mod) {
+			VM_ARITH(fmod(*x, *y), "take the remainder of");
+			VM_NEXT();
+		}
+
+		VM_CASE(neg) {
+			const double* x = number(R[argB(ins)]);
+			if (!x) fail(fn, pc, "cannot negate " + R[argB(ins)].toString());
+			R[argA(ins)]._data = -*x;
+			VM_NEXT();
+		}
+
+		VM_CASE(logicalNot) {
+			R[argA(ins)]._data = !R[argB(ins)].truthy();
+			VM_NEXT();
+		}
+
+		VM_CASE(equal) {
+			R[argA(ins)]._data = R[argB(ins)] == R[argC(ins)];
+			VM_NEXT();
+		}
+
+		VM_CASE(notEqual) {
+			R[argA(ins)]._data = !(R[argB(ins)] == R[argC(ins)]);
+			VM_NEXT();
+		}
+
+		VM_CASE(less) {
+			VM_COMPARE(<);
+			VM_NEXT();
+		}
+
+		VM_CASE(lessEqual) {
+			VM_COMPARE(<=);
+			VM_NEXT();
+		}
+
+		VM_CASE(jump) {
+			pc += argSBx(ins);
+			VM_NEXT();
+		}
+
+		VM_CASE(jumpIf) {
+			if (R[argA(ins)].truthy()) pc += argSBx(ins);
+			VM_NEXT();
+		}
+
+		VM_CASE(jumpIfNot) {
+			if (!R[argA(ins)].truthy()) pc += argSBx(ins);
+			VM_NEXT();
+		}
+
+		VM_CASE(call) {
+			const chunk* callee = &compiled.functions[argB(ins)];
+			if (frames.size() >= maxCallDepth) fail(fn, pc, "call depth limit reached calling " + callee->name);
+
+			frames.push_back({ fn, pc, base });
+			base += argA(ins);
+
+			// The arguments are already in place, they are the callee's first registers
+			if (stack.size() < base + callee->registers) stack.resize(max(stack.size() * 2, base + callee->registers));
+
+			fn = callee;
+			pc = fn->code.data();
+			R = stack.data() + base;
+			VM_NEXT();
+		}
+
+		VM_CASE(callNative) {
+			const nativeFunction& native = *natives[argB(ins)];
+			value result;
+
+			try {
+				result = native(span<const value>(R + argA(ins), argC(ins)));
+			}
+			catch (const exception& e) {
+				fail(fn, pc, e.what());
+			}
+
+			R[argA(ins)] = move(result);
+			VM_NEXT();
+		}
+
+		VM_CASE(ret) {
+			value result = move(R[argA(ins)]);
+			if (frames.empty()) return result;
+
+			// Callee register 0 is the caller's call register
+			stack[base] = move(result);
+
+			const frame caller = frames.back();
+			frames.pop_back();
+			fn = caller.fn;
+			pc = caller.pc;
+			base = caller.base;
+			R = stack.data() + base;
+			VM_NEXT();
+		}
+
+		VM_CASE(retNil) {
+			if (frames.empty()) return value();
+
+			stack[base] = value();
+
+			const frame caller = frames.back();
+			frames.pop_back();
+			fn = caller.fn;
+			pc = caller.pc;
+			base = caller.base;
+			R = stack.data() + base;
+			VM_NEXT();
+		}
+
+#if !UTK_SCRIPT_COMPUTED_GOTO
+		case opcode::count:
+			break;
+		}
+	}
+#endif
+
+#undef VM_CASE
+#undef VM_NEXT
+#undef VM_ARITH
+#undef VM_COMPARE
+}
+
+#if UTK_SCRIPT_COMPUTED_GOTO
+#pragma GCC diagnostic pop
+#endif
+
+//===================================================================================================================================
+//											          SCRIPT ENGINE METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+namespace {
+
+	filesystem::path cachePath(const filesystem::path& directory, const UTK::Hash::hash128& key) {
+		char name[40];
+		snprintf(name, sizeof(name), "%016llx%016llx.utkbc",
+			static_cast<unsigned long long>(key.high), static_cast<unsigned long long>(key.low));
+		return directory / name;
+	}
+
+	void registerBuiltins(scriptEngine& engine) {
+
+		engine.registerFunction("print", [](span<const value> args) {
+			string line;
+			for (size_t i = 0; i < args.size(); i++) {
+				if (i) line += ' ';
+				line += args[i].toString();
+			}
+			line += '\n';
+			cout << line << flush;
+			return value();
+		});
+
+		engine.registerFunction("assert", [](span<const value> args) {
+			if (args.empty() || args.size() > 2) throw runtime_error("assert expects a condition and an optional message");
+			if (!args[0].truthy()) {
+				throw runtime_error(args.size() == 2 ? "assertion failed: " + args[1].toString() : string("assertion failed"));
+			}
+			return value();
+		});
+
+		engine.registerFunction("len", [](span<const value> args) {
+			if (args.size() != 1 || !args[0].isString()) throw runtime_error("len expects one string");
+			return value(static_cast<double>(args[0].asString().size()));
+		});
+
+		engine.registerFunction("str", [](span<const value> args) {
+			if (args.size() != 1) throw runtime_error("str expects one value");
+			return value(args[0].toString());
+		});
+
+		engine.registerFunction("num", [](span<const value> args) {
+			if (args.size() != 1 || !args[0].isString()) throw runtime_error("num expects one string");
+
+			const string& text = args[0].asString();
+			char* end = nullptr;
+			const double n = strtod(text.c_str(), &end);
+			return (end == text.c_str() || *end != '\0') ? value() : value(n);
+		});
+
+		engine.registerFunction("clock", [](span<const value>) {
+			return value(chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count());
+		});
+	}
+}
+
+scriptEngine::scriptEngine(engineOptions options) : _options(move(options)) {
+
+	registerBuiltins(*this);
+}
+
+scriptEngine::~scriptEngine() = default;
+
+void scriptEngine::registerFunction(string name, nativeFunction fn) {
+
+	_natives[move(name)] = move(fn);
+}
+
+shared_ptr<const program> scriptEngine::loadCached(const UTK::Hash::hash128& key) {
+
+	if (_options.cacheDirectory.empty()) return nullptr;
+
+	ifstream file(cachePath(_options.cacheDirectory, key), ios::binary);
+	if (!file) return nullptr;
+
+	ostringstream bytes;
+	bytes << file.rdbuf();
+
+	auto loaded = make_shared<program>();
+	if (!deserialize(bytes.view(), *loaded) || !(loaded->sourceHash == key)) return nullptr;
+	return loaded;
+}
+
+void scriptEngine::storeCached(const program& compiled) {
+
+	if (_options.cacheDirectory.empty()) return;
+
+	// The cache is best effort, a read-only or missing directory just means compiling every time
+	error_code ec;
+	filesystem::create_directories(_options.cacheDirectory, ec);
+
+	const auto target = cachePath(_options.cacheDirectory, compiled.sourceHash);
+	auto temporary = target;
+	temporary += ".tmp" + to_string(hash<thread::id>{}(this_thread::get_id()));
+
+	{
+		ofstream file(temporary, ios::binary | ios::trunc);
+		if (!file) return;
+
+		const string bytes = serialize(compiled);
+		file.write(bytes.data(), static_cast<streamsize>(bytes.size()));
+		if (!file.flush()) {
+			file.close();
+			filesystem::remove(temporary, ec);
+			return;
+		}
+	}
+
+	// Readers only ever see a complete file, another process writing the same key is harmless
+	filesystem::rename(temporary, target, ec);
+	if (ec) filesystem::remove(temporary, ec);
+}
+
+shared_ptr<const program> scriptEngine::compile(string_view source) {
+
+	const auto key = UTK::Hash::hash128Of(source);
+
+	{
+		lock_guard<mutex> lock(_cacheMutex);
+		if (auto it = _programs.find(key); it != _programs.end()) {
+			_stats.memoryHits++;
+			return it->second;
+		}
+	}
+
+	shared_ptr<const program> compiled = loadCached(key);
+	const bool fromDisk = compiled != nullptr;
+
+	if (!fromDisk) {
+		auto fresh = make_shared<program>(compileSource(source));
+		fresh->sourceHash = key;
+		storeCached(*fresh);
+		compiled = move(fresh);
+	}
+
+	lock_guard<mutex> lock(_cacheMutex);
+	(fromDisk ? _stats.diskHits : _stats.compiles)++;
+	return _programs.try_emplace(key, move(compiled)).first->second;
+}
+
+shared_ptr<const program> scriptEngine::compileFile(const filesystem::path& path) {
+
+	ifstream file(path, ios::binary);
+	if (!file) throw runtime_error("cannot open script " + path.string());
+
+	ostringstream source;
+	source << file.rdbuf();
+	return compile(source.view());
+}
+
+value scriptEngine::run(const program& compiled) const {
+
+	// Host functions are bound by name per run, so a cached program never holds a stale binding
+	vector<const nativeFunction*> natives;
+	natives.reserve(compiled.natives.size());
+
+	for (const auto& name : compiled.natives) {
+		auto it = _natives.find(name);
+		if (it == _natives.end()) throw runtime_error("script calls unknown function '" + name + "'");
+		natives.push_back(&it->second);
+	}
+
+	return machine::execute(compiled, natives, _options.maxCallDepth);
+}
+
+cacheStats scriptEngine::stats() const {
+
+	lock_guard<mutex> lock(_cacheMutex);
+	return _stats;
+}
\ No newline at end of file
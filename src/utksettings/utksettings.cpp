@@ -0,0 +1,431 @@
+//===================================================================================================================================
+// @file	utksettings.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the snapshots, the store and the file watcher behind UTK::Settings.
+//
+// @note    Each thread keeps a few of the snapshots it has read pinned in a thread_local cache keyed by
+//          version, versions are unique across every store so the version alone identifies an entry. A
+//          read is one acquire load compared against the front of that cache, only a thread that sees a
+//          new version takes the store's mutex to pin it.
+//===================================================================================================================================
+
+#include "settings/utksettings.hpp"
+#include "json/utkjson.hpp"
+#include <condition_variable>
+#include <stdexcept>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <chrono>
+#include <array>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <poll.h>
+#include <cerrno>
+#endif
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Settings;
+
+namespace JSON = UTK::JSON;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	atomic<uint64_t> nextVersion{ 1 };
+
+	struct heldSnapshot {
+		uint64_t version = 0;
+		shared_ptr<const snapshot> pinned;
+	};
+
+	/// Snapshots this thread has read, most recently used first
+	thread_local array<heldSnapshot, 4> readerCache;
+
+	const char* typeName(const value& setting) {
+		switch (setting.index()) {
+		case 0: return "null";
+		case 1: return "a bool";
+		case 2: return "an integer";
+		case 3: return "a number";
+		case 4: return "a string";
+		default: return "a list";
+		}
+	}
+
+	[[noreturn]] void wrongType(string_view key, const value& setting, const char* expected) {
+		throw runtime_error("Setting '" + string(key) + "' is " + typeName(setting) + ", not " + expected);
+	}
+
+	scalar toScalar(const JSON::element& node) {
+		switch (node.type()) {
+		case JSON::kind::null:
+			return monostate{};
+		case JSON::kind::boolean:
+			return node.getBool();
+		case JSON::kind::string:
+			return node.getString();
+		case JSON::kind::number:
+			// Integers too large for 64 bits are kept as the nearest double rather than rejected
+			if (node.isInteger()) {
+				try {
+					return node.getInt64();
+				}
+				catch (const runtime_error&) {}
+			}
+			return node.getDouble();
+		default:
+			throw logic_error("Settings lists and objects are not scalars");
+		}
+	}
+
+	string readFile(const filesystem::path& path) {
+		ifstream file(path, ios::binary);
+		if (!file) throw runtime_error("Failed to open settings file: " + path.string());
+
+		string text{ istreambuf_iterator<char>(file), istreambuf_iterator<char>() };
+		if (file.bad()) throw runtime_error("Failed to read settings file: " + path.string());
+		return text;
+	}
+}
+
+//===================================================================================================================================
+//											            SNAPSHOT METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+shared_ptr<const snapshot> snapshot::parse(string_view json) {
+
+	const JSON::document doc = JSON::document::parse(json);
+	if (doc.root().type() != JSON::kind::object) throw runtime_error("Settings must be a JSON object");
+
+	auto built = make_shared<snapshot>();
+	string key;
+
+	auto flatten = [&](auto& self, const JSON::object& members) -> void {
+		for (const JSON::member& entry : members) {
+			if (entry.key.empty() || entry.key.find_first_of(".\\") != string_view::npos) {
+				throw runtime_error("Setting key '" + string(entry.key) + "' must be non-empty without '.' or escapes");
+			}
+
+			const size_t parentLength = key.size();
+			if (parentLength) key += '.';
+			key += entry.key;
+
+			switch (entry.value.type()) {
+			case JSON::kind::object:
+				self(self, entry.value.getObject());
+				break;
+
+			case JSON::kind::array: {
+				vector<scalar> items;
+				for (const JSON::element& item : entry.value.getArray()) {
+					if (item.type() == JSON::kind::array || item.type() == JSON::kind::object) {
+						throw runtime_error("Setting '" + key + "' is a list holding a list or object, lists may only hold plain values");
+					}
+					items.push_back(toScalar(item));
+				}
+				built->_values.emplace(key, move(items));
+				break;
+			}
+
+			default:
+				// Repeated keys keep their first value, matching JSON::object::find
+				visit([&](auto&& single) { built->_values.emplace(key, move(single)); }, toScalar(entry.value));
+			}
+
+			key.resize(parentLength);
+		}
+	};
+
+	flatten(flatten, doc.root().getObject());
+	built->_version = nextVersion.fetch_add(1, memory_order_relaxed);
+
+	return built;
+}
+
+const value* snapshot::find(string_view key) const {
+
+	auto it = _values.find(key);
+	return (it != _values.end()) ? &it->second : nullptr;
+}
+
+optional<bool> snapshot::getBool(string_view key) const {
+
+	const value* setting = find(key);
+	if (!setting) return nullopt;
+	if (auto* flag = get_if<bool>(setting)) return *flag;
+	wrongType(key, *setting, "a bool");
+}
+
+optional<int64_t> snapshot::getInt(string_view key) const {
+
+	const value* setting = find(key);
+	if (!setting) return nullopt;
+	if (auto* number = get_if<int64_t>(setting)) return *number;
+	wrongType(key, *setting, "an integer");
+}
+
+optional<double> snapshot::getDouble(string_view key) const {
+
+	const value* setting = find(key);
+	if (!setting) return nullopt;
+	if (auto* number = get_if<double>(setting)) return *number;
+	if (auto* number = get_if<int64_t>(setting)) return static_cast<double>(*number);
+	wrongType(key, *setting, "a number");
+}
+
+optional<string_view> snapshot::getString(string_view key) const {
+
+	const value* setting = find(key);
+	if (!setting) return nullopt;
+	if (auto* text = get_if<string>(setting)) return string_view(*text);
+	wrongType(key, *setting, "a string");
+}
+
+const vector<scalar>* snapshot::getList(string_view key) const {
+
+	const value* setting = find(key);
+	if (!setting) return nullptr;
+	if (auto* items = get_if<vector<scalar>>(setting)) return items;
+	wrongType(key, *setting, "a list");
+}
+
+//===================================================================================================================================
+//													    FILE WATCHER DEFINITION
+//===================================================================================================================================
+
+class UTK::Settings::Internal::fileWatcher {
+private:
+	filesystem::path _path;
+	function<void()> _onChange;
+
+#if defined(__linux__)
+	int _inotify = -1;
+	int _wake = -1;				// eventfd written by the destructor to stop the thread
+#else
+	mutex _mutex;
+	condition_variable _stop;
+	bool _stopping = false;
+#endif
+
+	thread _thread;
+
+	/// Editors often save in several writes, a change is only reported once the file has been quiet this long
+	static constexpr int settleMs = 50;
+
+#if defined(__linux__)
+	void run() {
+
+		const string name = _path.filename().string();
+		alignas(inotify_event) char buffer[4096];
+		pollfd fds[2] = { { _inotify, POLLIN, 0 }, { _wake, POLLIN, 0 } };
+
+		for (;;) {
+			if (::poll(fds, 2, -1) < 0) {
+				if (errno == EINTR) continue;
+				return;
+			}
+
+			bool changed = false;
+			do {
+				if (fds[1].revents) return;
+
+				const ssize_t length = ::read(_inotify, buffer, sizeof(buffer));
+				for (ssize_t at = 0; at < length; ) {
+					const auto* event = reinterpret_cast<const inotify_event*>(buffer + at);
+					if (event->len && name == event->name) changed = true;
+					at += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+				}
+			} while (::poll(fds, 2, settleMs) > 0);
+
+			if (changed) _onChange();
+		}
+	}
+#else
+	static filesystem::file_time_type lastWrite(const filesystem::path& path) {
+		error_code ec;
+		auto stamp = filesystem::last_write_time(path, ec);
+		return ec ? filesystem::file_time_type::min() : stamp;
+	}
+
+	void run() {
+
+		auto stamp = lastWrite(_path);
+		unique_lock<mutex> lock(_mutex);
+
+		while (!_stop.wait_for(lock, milliseconds(500), [this] { return _stopping; })) {
+			const auto latest = lastWrite(_path);
+			if (latest == stamp) continue;
+
+			stamp = latest;
+			lock.unlock();
+			this_thread::sleep_for(milliseconds(settleMs));
+			_onChange();
+			lock.lock();
+		}
+	}
+#endif
+
+public:
+	fileWatcher(filesystem::path path, function<void()> onChange) : _path(move(path)), _onChange(move(onChange)) {
+
+#if defined(__linux__)
+		// The directory is watched rather than the file, saving through a rename replaces the file's inode
+		const filesystem::path directory = _path.has_parent_path() ? _path.parent_path() : filesystem::path(".");
+
+		_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (_inotify < 0) throw runtime_error("Failed to create inotify instance for " + _path.string());
+
+		if (inotify_add_watch(_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+			close(_inotify);
+			throw runtime_error("Failed to watch settings directory: " + directory.string());
+		}
+
+		_wake = eventfd(0, EFD_CLOEXEC);
+		if (_wake < 0) {
+			close(_inotify);
+			throw runtime_error("Failed to create settings watcher wake event");
+		}
+#endif
+
+		_thread = thread(&fileWatcher::run, this);
+	}
+
+	~fileWatcher() {
+
+#if defined(__linux__)
+		const uint64_t one = 1;
+		[[maybe_unused]] auto written = ::write(_wake, &one, sizeof(one));
+#else
+		{
+			lock_guard<mutex> lock(_mutex);
+			_stopping = true;
+		}
+		_stop.notify_one();
+#endif
+
+		if (_thread.joinable()) _thread.join();
+
+#if defined(__linux__)
+		close(_wake);
+		close(_inotify);
+#endif
+	}
+
+	fileWatcher(const fileWatcher&) = delete;
+	fileWatcher& operator=(const fileWatcher&) = delete;
+};
+
+//===================================================================================================================================
+//											           SETTINGS STORE METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+settingsStore::settingsStore(filesystem::path path, bool watch) : _path(move(path)) {
+
+	_snapshot = snapshot::parse(readFile(_path));
+	_version.store(_snapshot->version(), memory_order_release);
+
+	if (watch) _watcher = make_unique<Internal::fileWatcher>(_path, [this] { reload(); });
+}
+
+// The watcher is stopped first so no reload runs against a half destroyed store
+settingsStore::~settingsStore() {
+	_watcher.reset();
+}
+
+const snapshot& settingsStore::current() const {
+
+	const uint64_t version = _version.load(memory_order_acquire);
+	const heldSnapshot& front = readerCache[0];
+
+	if (front.version == version) return *front.pinned;
+	return refresh(version);
+}
+
+const snapshot& settingsStore::refresh(uint64_t version) const {
+
+	// Another store's snapshot may sit at the front, look further back before pinning a new one
+	auto held = find_if(readerCache.begin() + 1, readerCache.end(), [version](const heldSnapshot& entry) {
+		return entry.version == version;
+	});
+
+	if (held == readerCache.end()) {
+		held = readerCache.end() - 1;
+		held->pinned = pin();
+		held->version = held->pinned->version();
+	}
+
+	rotate(readerCache.begin(), held, held + 1);
+	return *readerCache[0].pinned;
+}
+
+shared_ptr<const snapshot> settingsStore::pin() const {
+
+	lock_guard<mutex> lock(_mutex);
+	return _snapshot;
+}
+
+bool settingsStore::reload() {
+
+	lock_guard<mutex> reloading(_reloadMutex);
+	shared_ptr<const snapshot> next;
+
+	try {
+		next = snapshot::parse(readFile(_path));
+	}
+	catch (const exception& e) {
+		lock_guard<mutex> lock(_mutex);
+		_lastError = e.what();
+		return false;
+	}
+
+	{
+		lock_guard<mutex> lock(_mutex);
+		_snapshot = next;
+		_lastError.clear();
+		_version.store(next->version(), memory_order_release);
+	}
+
+	for (auto& [id, fn] : _subscribers) {
+		try {
+			fn(*next);
+		}
+		catch (const exception& e) {
+			lock_guard<mutex> lock(_mutex);
+			_lastError = e.what();
+		}
+	}
+
+	return true;
+}
+
+string settingsStore::lastError() const {
+
+	lock_guard<mutex> lock(_mutex);
+	return _lastError;
+}
+
+uint64_t settingsStore::subscribe(Callback fn) {
+
+	lock_guard<mutex> reloading(_reloadMutex);
+
+	fn(*pin());
+	_subscribers.emplace_back(_nextSubscriber, move(fn));
+	return _nextSubscriber++;
+}
+
+void settingsStore::unsubscribe(uint64_t id) {
+
+	lock_guard<mutex> reloading(_reloadMutex);
+	erase_if(_subscribers, [id](const auto& subscriber) { return subscriber.first == id; });
+}
\ No newline at end of file
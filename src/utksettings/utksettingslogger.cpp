@@ -0,0 +1,120 @@
+//===================================================================================================================================
+// @file	utksettingslogger.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the binding that drives a logDispatcher's operation filters and sink
+//			queues from UTK::Settings.
+//===================================================================================================================================
+
+#include "settings/utksettings.hpp"
+#include "dispatchers/utkdispatch.hpp"
+#include <stdexcept>
+#include <array>
+
+using namespace std;
+using namespace UTK::Settings;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	/// Matches the defaults of logDispatcher's constructor
+	constexpr size_t defaultCapacity = 4096;
+
+	constexpr array<pair<string_view, Logger>, 4> sinkNames {{
+		{ "terminal"sv, Logger::TERMINAL },
+		{ "json"sv, Logger::JSON },
+		{ "csv"sv, Logger::CSV },
+		{ "archive"sv, Logger::ARCHIVE }
+	}};
+
+	constexpr array<pair<string_view, Operations>, 8> operationNames {{
+		{ "LG_WR"sv, Operations::LG_WR },
+		{ "LG_RD"sv, Operations::LG_RD },
+		{ "LG_IN"sv, Operations::LG_IN },
+		{ "LG_OUT"sv, Operations::LG_OUT },
+		{ "LG_IDL"sv, Operations::LG_IDL },
+		{ "LG_ERR"sv, Operations::LG_ERR },
+		{ "LG_MSG"sv, Operations::LG_MSG },
+		{ "LG_NOP"sv, Operations::LG_NOP }
+	}};
+
+	struct sinkPlan {
+		Logger lg;
+		vector<Operations> operations;
+		bool configured = false;
+		size_t capacity = defaultCapacity;
+		Backpressure policy = Backpressure::DROP;
+	};
+
+	Operations parseOperation(const scalar& item, const string& key) {
+
+		const string* name = get_if<string>(&item);
+		if (!name) throw runtime_error("Setting '" + key + "' must list operations by name");
+
+		for (const auto& [known, op] : operationNames) {
+			if (known == *name) return op;
+		}
+		throw runtime_error("Setting '" + key + "' names unknown operation '" + *name + "'");
+	}
+}
+
+//===================================================================================================================================
+//											              LOGGER BINDING ENTRY POINTS
+//===================================================================================================================================
+
+void UTK::Settings::applyLoggerSettings(const snapshot& settings, logDispatcher& dispatcher, string_view prefix) {
+
+	// Everything is validated before anything is applied so a bad file never leaves the logger half configured
+	vector<sinkPlan> plans;
+
+	for (const auto& [name, lg] : sinkNames) {
+		const string base = string(prefix) + "." + string(name) + ".";
+		sinkPlan plan;
+		plan.lg = lg;
+
+		const string operationsKey = base + "operations";
+		if (const auto* listed = settings.getList(operationsKey)) {
+			for (const scalar& item : *listed) {
+				plan.operations.push_back(parseOperation(item, operationsKey));
+			}
+		}
+		else {
+			for (const auto& [known, op] : operationNames) {
+				plan.operations.push_back(op);
+			}
+		}
+
+		const auto capacity = settings.getInt(base + "capacity");
+		const auto policy = settings.getString(base + "backpressure");
+
+		if (capacity) {
+			if (*capacity < 1) throw runtime_error("Setting '" + base + "capacity' must be at least 1");
+			plan.capacity = static_cast<size_t>(*capacity);
+		}
+		if (policy) {
+			if (*policy == "block") plan.policy = Backpressure::BLOCK;
+			else if (*policy != "drop") throw runtime_error("Setting '" + base + "backpressure' must be \"drop\" or \"block\"");
+		}
+		plan.configured = capacity || policy;
+
+		plans.push_back(move(plan));
+	}
+
+	for (const auto& plan : plans) {
+		dispatcher.setOperationFilter(plan.lg, plan.operations);
+		if (plan.configured) dispatcher.configureSink(plan.lg, plan.capacity, plan.policy);
+	}
+}
+
+uint64_t UTK::Settings::bindLogger(settingsStore& store, logDispatcher& dispatcher, string prefix) {
+
+	return store.subscribe([&dispatcher, prefix = move(prefix)](const snapshot& settings) {
+		applyLoggerSettings(settings, dispatcher, prefix);
+	});
+}
\ No newline at end of file
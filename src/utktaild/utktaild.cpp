@@ -0,0 +1,77 @@
+//===================================================================================================================================
+// @file	utktaild.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+// 
+// @brief   Log tail service. Follows the files sinks write to, reading only what is appended, and keeps
+//			rolling counts of each operation and the latest errors for scripts/utk_dashboard.py.
+// 
+// @note    Usage: utktaild <socket path> <offsets file> <terminal|archive>:<path>... [--from-start]
+//			Each connection to the socket is sent one JSON snapshot and closed.
+//===================================================================================================================================
+
+#include "dispatchers/utkfollower.hpp"
+#include <string_view>
+#include <iostream>
+#include <csignal>
+#include <atomic>
+#include <string>
+
+using namespace std;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+
+static atomic<bool> running{ true };
+
+extern "C" void onStopSignal(int) {
+	running = false;
+}
+
+int main(int argc, char* argv[]) {
+
+	if (argc < 4) {
+		cerr << "Usage: " << argv[0] << " <socket path> <offsets file> <terminal|archive>:<path>... [--from-start]\n";
+		return 1;
+	}
+
+	try {
+		bool fromStart = false;
+		for (int i = 3; i < argc; i++) {
+			if (argv[i] == "--from-start"sv) fromStart = true;
+		}
+
+		signal(SIGINT, onStopSignal);
+		signal(SIGTERM, onStopSignal);
+
+		logFollower follower(argv[2]);
+		for (int i = 3; i < argc; i++) {
+			const string_view source = argv[i];
+			if (source == "--from-start"sv) continue;
+
+			const size_t split = source.find(':');
+			const string_view format = source.substr(0, split);
+			if (split == string_view::npos || (format != "terminal"sv && format != "archive"sv)) {
+				cerr << "[utktaild] Expected terminal:<path> or archive:<path>, got " << source << "\n";
+				return 1;
+			}
+
+			follower.follow(string(source.substr(split + 1)), (format == "archive"sv) ? Logger::ARCHIVE : Logger::TERMINAL, fromStart);
+		}
+
+		rollingAggregates aggregates;
+		tailService service(argv[1], follower, aggregates);
+		cerr << "[utktaild] Serving snapshots on " << argv[1] << "\n";
+
+		while (running) {
+			service.poll(250);
+		}
+
+		follower.saveOffsets();
+	}
+	catch (const std::exception& e) {
+		cerr << "[utktaild] " << e.what() << "\n";
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
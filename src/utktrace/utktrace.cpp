@@ -0,0 +1,514 @@
+//===================================================================================================================================
+// @file	utktrace.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the per-thread span buffers, their registry and the trace exporters.
+//===================================================================================================================================
+
+#include "trace/utktrace.hpp"
+#include "dispatchers/utkdispatch.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <fstream>
+#include <array>
+#include <deque>
+#include <mutex>
+
+#if defined(__WINDOWS__)
+#include <process.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Trace;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+using namespace UTK::Types::LogEntry;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	/// Spans per buffer chunk, a thread takes the registry lock once per chunk
+	constexpr size_t chunkSpans = 4096;
+	constexpr size_t defaultSpanLimit = size_t(1) << 20;
+	constexpr size_t spareChunks = 16;
+
+	/// Shortest steady clock interval the tick rate is measured over
+	constexpr nanoseconds minCalibration = milliseconds(10);
+
+	struct spanRecord {
+		const char* name;
+		uint64_t begin;
+		uint64_t end;
+	};
+
+	/// Written by one thread, read under the registry lock up to count
+	struct spanChunk {
+		array<spanRecord, chunkSpans> spans;
+		atomic<uint32_t> count = 0;		// Spans written, released after each span
+		uint32_t consumed = 0;			// Spans already drained, only touched under the registry lock
+		uint32_t thread = 0;
+	};
+
+	/// A recording thread's open chunk, the chunk pointer only changes under the registry lock
+	struct threadBuffer {
+		unique_ptr<spanChunk> current;
+		uint32_t index = 0;
+	};
+
+	int64_t osThreadId(uint32_t index) {
+#if defined(__linux__)
+		static_cast<void>(index);
+		return static_cast<int64_t>(syscall(SYS_gettid));
+#elif defined(__WINDOWS__)
+		static_cast<void>(index);
+		return static_cast<int64_t>(GetCurrentThreadId());
+#else
+		return index;
+#endif
+	}
+
+	int64_t processId() {
+#if defined(__WINDOWS__)
+		return _getpid();
+#else
+		return getpid();
+#endif
+	}
+
+	void appendJsonString(string& out, string_view text) {
+
+		static constexpr char hex[] = "0123456789abcdef";
+
+		out.push_back('"');
+		for (const char c : text) {
+			const auto byte = static_cast<unsigned char>(c);
+			if (c == '"' || c == '\\') {
+				out.push_back('\\');
+				out.push_back(c);
+			}
+			else if (byte < 0x20) {
+				out.append("\\u00");
+				out.push_back(hex[byte >> 4]);
+				out.push_back(hex[byte & 0xF]);
+			}
+			else {
+				out.push_back(c);
+			}
+		}
+		out.push_back('"');
+	}
+
+	/// Trace event times are microseconds, written with three decimals so nanoseconds survive
+	void appendMicroseconds(string& out, int64_t ns) {
+
+		if (ns < 0) {
+			out.push_back('-');
+			ns = -ns;
+		}
+		out.append(to_string(ns / 1000));
+
+		const auto fraction = static_cast<int>(ns % 1000);
+		const char digits[4] = { '.', static_cast<char>('0' + fraction / 100), static_cast<char>('0' + fraction / 10 % 10), static_cast<char>('0' + fraction % 10) };
+		out.append(digits, sizeof(digits));
+	}
+}
+
+//===================================================================================================================================
+//											      TRACE REGISTRY DEFINITION
+//===================================================================================================================================
+
+class UTK::Trace::Internal::traceRegistry {
+private:
+	mutable mutex _mutex;
+	deque<unique_ptr<spanChunk>> _full;			// Chunks waiting to be drained, oldest first
+	vector<unique_ptr<spanChunk>> _spare;
+	vector<threadBuffer*> _live;
+	vector<traceThread> _threads;
+	size_t _spanLimit = defaultSpanLimit;
+	size_t _heldSpans = 0;					// Spans in _full not yet drained
+	uint64_t _dropped = 0;
+
+	// The tick rate is remeasured on each conversion batch against this starting point
+	const uint64_t _startTick;
+	const steady_clock::time_point _startTime;
+	mutable double _ticksPerNs = 1.0;
+
+	unique_ptr<spanChunk> takeChunk(uint32_t thread) {
+
+		unique_ptr<spanChunk> chunk;
+		if (_spare.empty()) {
+			chunk = make_unique<spanChunk>();
+		}
+		else {
+			chunk = move(_spare.back());
+			_spare.pop_back();
+			chunk->count.store(0, memory_order_relaxed);
+			chunk->consumed = 0;
+		}
+		chunk->thread = thread;
+		return chunk;
+	}
+
+	/// Moves a thread's chunk onto the drain queue, dropping the oldest queued chunks past the span limit
+	void retire(unique_ptr<spanChunk> chunk) {
+
+		const uint32_t pending = chunk->count.load(memory_order_acquire) - chunk->consumed;
+		if (!pending) {
+			if (_spare.size() < spareChunks) _spare.push_back(move(chunk));
+			return;
+		}
+
+		_heldSpans += pending;
+		_full.push_back(move(chunk));
+
+		while (_heldSpans > _spanLimit && _full.size() > 1) {
+			auto& oldest = _full.front();
+			const uint32_t lost = oldest->count.load(memory_order_relaxed) - oldest->consumed;
+			_heldSpans -= lost;
+			_dropped += lost;
+			if (_spare.size() < spareChunks) _spare.push_back(move(oldest));
+			_full.pop_front();
+		}
+	}
+
+	static void copySpans(spanChunk& chunk, vector<traceSpan>& out) {
+
+		const uint32_t count = chunk.count.load(memory_order_acquire);
+		for (uint32_t i = chunk.consumed; i < count; i++) {
+			const spanRecord& span = chunk.spans[i];
+			out.push_back({ span.name, span.begin, span.end, chunk.thread });
+		}
+		chunk.consumed = count;
+	}
+
+public:
+	traceRegistry() : _startTick(ticks()), _startTime(steady_clock::now()) {}
+
+	threadBuffer* attach() {
+
+		auto buffer = make_unique<threadBuffer>();
+
+		lock_guard<mutex> lock(_mutex);
+		buffer->index = static_cast<uint32_t>(_threads.size());
+		buffer->current = takeChunk(buffer->index);
+
+		_threads.push_back({ buffer->index, osThreadId(buffer->index), {} });
+		_live.push_back(buffer.get());
+		return buffer.release();
+	}
+
+	/// Called as a recording thread exits, its last chunk stays queued for the next drain
+	void detach(threadBuffer* buffer) {
+
+		lock_guard<mutex> lock(_mutex);
+		retire(move(buffer->current));
+		_live.erase(find(_live.begin(), _live.end(), buffer));
+		delete buffer;
+	}
+
+	/// Swaps a full chunk for an empty one, the only time a recording thread locks
+	spanChunk* rotate(threadBuffer& buffer) {
+
+		lock_guard<mutex> lock(_mutex);
+		retire(move(buffer.current));
+		buffer.current = takeChunk(buffer.index);
+		return buffer.current.get();
+	}
+
+	void nameThread(uint32_t index, string name) {
+		lock_guard<mutex> lock(_mutex);
+		_threads[index].name = move(name);
+	}
+
+	void setSpanLimit(size_t spans) {
+		lock_guard<mutex> lock(_mutex);
+		_spanLimit = max<size_t>(spans, 1);
+	}
+
+	uint64_t dropped() const {
+		lock_guard<mutex> lock(_mutex);
+		return _dropped;
+	}
+
+	size_t drain(vector<traceSpan>& out) {
+
+		const size_t before = out.size();
+
+		lock_guard<mutex> lock(_mutex);
+		out.reserve(before + _heldSpans + _live.size() * 64);
+
+		for (auto& chunk : _full) {
+			copySpans(*chunk, out);
+			if (_spare.size() < spareChunks) _spare.push_back(move(chunk));
+		}
+		_full.clear();
+		_heldSpans = 0;
+
+		// Live threads keep writing past the count read here, those spans go in the next drain
+		for (threadBuffer* buffer : _live) {
+			copySpans(*buffer->current, out);
+		}
+
+		return out.size() - before;
+	}
+
+	vector<traceThread> threads() const {
+		lock_guard<mutex> lock(_mutex);
+		return _threads;
+	}
+
+	/// Measures the tick rate over everything since the tracer started, waiting out a too short interval
+	void calibrate() const {
+
+		steady_clock::time_point now = steady_clock::now();
+		while (now - _startTime < minCalibration) now = steady_clock::now();
+		const uint64_t tick = ticks();
+
+		const auto elapsed = duration_cast<nanoseconds>(now - _startTime).count();
+		lock_guard<mutex> lock(_mutex);
+		_ticksPerNs = static_cast<double>(tick - _startTick) / static_cast<double>(elapsed);
+		if (!(_ticksPerNs > 0.0)) _ticksPerNs = 1.0;
+	}
+
+	int64_t toNanoseconds(uint64_t tick) const {
+
+		double rate;
+		{
+			lock_guard<mutex> lock(_mutex);
+			rate = _ticksPerNs;
+		}
+
+		// Ticks are unsigned, a span recorded before the tracer started is simply negative
+		const auto delta = static_cast<int64_t>(tick - _startTick);
+		return static_cast<int64_t>(static_cast<double>(delta) / rate);
+	}
+};
+
+//===================================================================================================================================
+//											       SPAN RECORDING IMPLEMENTATION
+//===================================================================================================================================
+
+namespace {
+
+	/// Never destroyed, threads still recording while statics are torn down have somewhere to write
+	UTK::Trace::Internal::traceRegistry& globalRegistry() {
+		static auto* registry = new UTK::Trace::Internal::traceRegistry();
+		return *registry;
+	}
+
+	/// Detaches the thread's buffer as it exits
+	struct threadSlot {
+		threadBuffer* buffer = nullptr;
+		~threadSlot();
+	};
+
+#if defined(__GNUC__) && !defined(__WINDOWS__)
+#define UTK_TRACE_TLS [[gnu::tls_model("initial-exec")]]
+#else
+#define UTK_TRACE_TLS
+#endif
+
+	// The recording path only touches trivially destructible thread_locals, which need no init guard. Initial-exec
+	// makes the chunk pointer a fixed offset from the thread pointer, rather than a __tls_get_addr call per span.
+	UTK_TRACE_TLS thread_local spanChunk* tlsChunk = nullptr;
+	thread_local bool tlsExited = false;
+	thread_local threadSlot tlsSlot;
+
+	threadSlot::~threadSlot() {
+		if (buffer) globalRegistry().detach(buffer);
+		buffer = nullptr;
+		tlsChunk = nullptr;
+		tlsExited = true;
+	}
+
+	threadBuffer& attachThread() {
+
+		if (!tlsSlot.buffer) {
+			tlsSlot.buffer = globalRegistry().attach();
+			tlsChunk = tlsSlot.buffer->current.get();
+		}
+		return *tlsSlot.buffer;
+	}
+
+	/// Slow path of recordSpan, attaches the thread on its first span and rotates full chunks
+	[[gnu::noinline]] spanChunk* nextChunk() {
+
+		// Spans from destructors running after the thread's slot has gone are dropped
+		if (tlsExited) return nullptr;
+
+		threadBuffer& buffer = attachThread();
+		if (tlsChunk->count.load(memory_order_relaxed) < chunkSpans) return tlsChunk;
+
+		tlsChunk = globalRegistry().rotate(buffer);
+		return tlsChunk;
+	}
+}
+
+void UTK::Trace::recordSpan(const char* name, uint64_t begin, uint64_t end) noexcept {
+
+	spanChunk* chunk = tlsChunk;
+	uint32_t count = chunk ? chunk->count.load(memory_order_relaxed) : chunkSpans;
+
+	if (count == chunkSpans) {
+		try {
+			chunk = nextChunk();
+		}
+		catch (...) {
+			chunk = nullptr;		// Out of memory for a new chunk, the span is lost rather than the caller
+		}
+		if (!chunk) return;
+		count = chunk->count.load(memory_order_relaxed);
+	}
+
+	chunk->spans[count] = { name, begin, end };
+	chunk->count.store(count + 1, memory_order_release);
+}
+
+//===================================================================================================================================
+//											         TRACER METHOD IMPLEMENTATIONS
+//===================================================================================================================================
+
+tracer::tracer() : _registry(globalRegistry()) {}
+
+tracer::~tracer() = default;
+
+tracer& tracer::global() {
+	static tracer instance;
+	return instance;
+}
+
+void tracer::nameThread(string name) {
+	_registry.nameThread(attachThread().index, move(name));
+}
+
+void tracer::setSpanLimit(size_t spans) {
+	_registry.setSpanLimit(spans);
+}
+
+uint64_t tracer::dropped() const {
+	return _registry.dropped();
+}
+
+size_t tracer::drain(vector<traceSpan>& out) {
+	return _registry.drain(out);
+}
+
+vector<traceThread> tracer::threads() const {
+	return _registry.threads();
+}
+
+int64_t tracer::toNanoseconds(uint64_t tick) const {
+	return _registry.toNanoseconds(tick);
+}
+
+size_t tracer::exportChromeTrace(const string& path) {
+
+	vector<traceSpan> spans;
+	drain(spans);
+	_registry.calibrate();
+
+	ofstream file(path, ios::binary | ios::trunc);
+	if (!file) throw runtime_error("Unable to open trace file: " + path);
+
+	const string pid = to_string(processId());
+	const vector<traceThread> known = threads();
+
+	string out;
+	out.reserve(64 + known.size() * 96 + spans.size() * 112);
+	out.append("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+	bool first = true;
+	auto beginEvent = [&]() {
+		if (!first) out.push_back(',');
+		first = false;
+		out.append("\n{");
+	};
+
+	// Metadata events name each thread's track in the viewer
+	for (const auto& thread : known) {
+		if (thread.name.empty()) continue;
+		beginEvent();
+		out.append("\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":").append(pid);
+		out.append(",\"tid\":").append(to_string(thread.osId)).append(",\"args\":{\"name\":");
+		appendJsonString(out, thread.name);
+		out.append("}}");
+	}
+
+	for (const auto& span : spans) {
+		const int64_t begin = toNanoseconds(span.begin);
+		const int64_t end = toNanoseconds(span.end);
+
+		beginEvent();
+		out.append("\"ph\":\"X\",\"cat\":\"utk\",\"name\":");
+		appendJsonString(out, span.name ? span.name : "");
+		out.append(",\"pid\":").append(pid);
+		out.append(",\"tid\":").append(to_string(span.thread < known.size() ? known[span.thread].osId : span.thread));
+		out.append(",\"ts\":");
+		appendMicroseconds(out, begin);
+		out.append(",\"dur\":");
+		appendMicroseconds(out, max<int64_t>(end - begin, 0));
+		out.push_back('}');
+
+		// Written in pieces so a long trace never holds the whole document in memory
+		if (out.size() > (size_t(1) << 20)) {
+			file.write(out.data(), static_cast<streamsize>(out.size()));
+			out.clear();
+		}
+	}
+
+	out.append("\n]}\n");
+	file.write(out.data(), static_cast<streamsize>(out.size()));
+	if (!file.flush()) throw runtime_error("Unable to write trace file: " + path);
+
+	return spans.size();
+}
+
+size_t tracer::dispatchTo(logDispatcher& dispatcher, Logger lg, Operations op) {
+
+	vector<traceSpan> spans;
+	drain(spans);
+	if (spans.empty()) return 0;
+
+	_registry.calibrate();
+
+	static const KeyIds keys = {
+		keyTable::global().intern("span"),
+		keyTable::global().intern("thread"),
+		keyTable::global().intern("start_ns"),
+		keyTable::global().intern("duration_ns")
+	};
+
+	const vector<traceThread> known = threads();
+
+	vector<logEntry> entries;
+	entries.reserve(spans.size());
+	for (const auto& span : spans) {
+		const int64_t begin = toNanoseconds(span.begin);
+		const int64_t end = toNanoseconds(span.end);
+
+		logEntry entry{ lg, op, {}, {} };
+		entry.keyIds = keys;
+		entry.formatValues = {
+			span.name ? span.name : "",
+			span.thread < known.size() && !known[span.thread].name.empty() ? known[span.thread].name : to_string(span.thread),
+			to_string(begin),
+			to_string(max<int64_t>(end - begin, 0))
+		};
+		entries.push_back(move(entry));
+	}
+
+	dispatcher.pushEntries(move(entries));
+	return spans.size();
+}
\ No newline at end of file
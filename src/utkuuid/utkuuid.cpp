@@ -0,0 +1,353 @@
+//===================================================================================================================================
+// @file	utkuuid.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Source file containing the UUID generators, formatting and parsing provided by UTK::UUID.
+//===================================================================================================================================
+
+#include "uuid/utkuuid.hpp"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <thread>
+
+#if !defined(__WINDOWS__)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#if defined(ARCH_x64)
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <emmintrin.h>
+	#endif
+#endif
+
+using namespace std;
+using namespace UTK::UUID;
+
+//===================================================================================================================================
+//											        HELPER FUNCTIONS & UTILITIES
+//===================================================================================================================================
+
+namespace {
+
+	constexpr uint64_t counterBits = 42;		// 12 bits of rand_a plus the top 30 bits of rand_b
+	constexpr uint64_t counterMask = (uint64_t{ 1 } << counterBits) - 1;
+
+	/**
+	 * @brief Newest millisecond handed out by any thread, v7 timestamps never fall behind it
+	 */
+	atomic<uint64_t> sharedMilliseconds{ 0 };
+
+	/**
+	 * @brief Bumped in the child after every fork, thread states seeded under an older value seed again
+	 *
+	 * @note A forked child inherits the parent's thread local state byte for byte, without this the two
+	 *		 processes would go on to produce the same v4 values and the same v7 sequence.
+	 */
+	atomic<uint64_t> forkGeneration{ 0 };
+
+#if !defined(__WINDOWS__)
+	extern "C" void onForkChild() {
+		forkGeneration.fetch_add(1, memory_order_relaxed);
+	}
+
+	const bool forkHandlerInstalled = pthread_atfork(nullptr, nullptr, onForkChild) == 0;
+#endif
+
+	/**
+	 * @brief Per thread generator state, wyrand for the random bits and the v7 sequence
+	 */
+	struct threadState {
+		uint64_t rng = 0;
+		uint64_t lastMilliseconds = 0;
+		uint64_t counter = 0;
+		uint64_t generation = 0;
+
+		threadState() {
+			seed();
+		}
+
+		/**
+		 * @brief Draws a new seed and drops the v7 sequence, so the next v7 value starts a fresh one
+		 */
+		void seed() {
+			// One random_device read per seeding, mixed with the thread id and the process id
+			random_device device;
+			rng = (static_cast<uint64_t>(device()) << 32) ^ device() ^
+				  (static_cast<uint64_t>(hash<thread::id>{}(this_thread::get_id())) * 0x9E3779B97F4A7C15ULL);
+		#if !defined(__WINDOWS__)
+			rng ^= static_cast<uint64_t>(getpid()) * 0xC2B2AE3D27D4EB4FULL;
+		#endif
+			lastMilliseconds = 0;
+			counter = 0;
+			generation = forkGeneration.load(memory_order_relaxed);
+		}
+
+		uint64_t next() {
+			rng += 0xA0761D6478BD642FULL;
+		#if defined(__SIZEOF_INT128__)
+			__extension__ typedef unsigned __int128 uint128;
+			const uint128 product = static_cast<uint128>(rng) * (rng ^ 0xE7037ED1A0B428DBULL);
+			return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+		#elif defined(_MSC_VER) && defined(ARCH_x64)
+			uint64_t high;
+			const uint64_t low = _umul128(rng, rng ^ 0xE7037ED1A0B428DBULL, &high);
+			return low ^ high;
+		#else
+			const uint64_t a = rng, b = rng ^ 0xE7037ED1A0B428DBULL;
+			const uint64_t loLo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+			const uint64_t hiLo = (a >> 32) * (b & 0xFFFFFFFF);
+			const uint64_t loHi = (a & 0xFFFFFFFF) * (b >> 32);
+			const uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+			return ((cross << 32) | (loLo & 0xFFFFFFFF)) ^ ((hiLo >> 32) + (cross >> 32) + (a >> 32) * (b >> 32));
+		#endif
+		}
+
+		/**
+		 * @brief Starts a fresh random sequence, the top bit is left clear so the counter has room to grow
+		 */
+		void reseedCounter() {
+			counter = next() & (counterMask >> 1);
+		}
+	};
+
+	threadState& localState() {
+		thread_local threadState state;
+		if (state.generation != forkGeneration.load(memory_order_relaxed)) [[unlikely]] state.seed();
+		return state;
+	}
+
+	inline void storeBigEndian(uint8_t* out, uint64_t value) {
+		// Written as shifts so the compiler emits a single byte swap
+		value = ((value & 0x00FF00FF00FF00FFULL) << 8) | ((value >> 8) & 0x00FF00FF00FF00FFULL);
+		value = ((value & 0x0000FFFF0000FFFFULL) << 16) | ((value >> 16) & 0x0000FFFF0000FFFFULL);
+		value = (value << 32) | (value >> 32);
+		memcpy(out, &value, sizeof(value));
+	}
+
+	inline uuid makeUuid(uint64_t high, uint64_t low) {
+		uuid id;
+		storeBigEndian(id.bytes.data(), high);
+		storeBigEndian(id.bytes.data() + 8, low);
+		return id;
+	}
+
+	inline uuid makeV4(threadState& state) {
+		const uint64_t high = (state.next() & 0xFFFFFFFFFFFF0FFFULL) | 0x0000000000004000ULL;
+		const uint64_t low = (state.next() & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+		return makeUuid(high, low);
+	}
+
+	uint64_t clockMilliseconds() {
+		const auto now = chrono::system_clock::now().time_since_epoch();
+		return static_cast<uint64_t>(chrono::duration_cast<chrono::milliseconds>(now).count());
+	}
+
+	/**
+	 * @brief Moves the thread onto the current millisecond, keeping the shared timestamp monotonic
+	 */
+	void advanceClock(threadState& state) {
+		uint64_t now = clockMilliseconds();
+		uint64_t shared = sharedMilliseconds.load(memory_order_relaxed);
+
+		// Only the first thread into a new millisecond writes, everyone else just reads
+		while (now > shared && !sharedMilliseconds.compare_exchange_weak(shared, now, memory_order_relaxed)) {}
+		now = max(now, shared);
+
+		if (now > state.lastMilliseconds) {
+			state.lastMilliseconds = now;
+			state.reseedCounter();
+		}
+	}
+
+	inline uuid makeV7(threadState& state) {
+		if (++state.counter > counterMask) {
+			// Sequence exhausted within one millisecond, borrow the next one rather than repeat
+			state.lastMilliseconds++;
+			state.reseedCounter();
+		}
+
+		const uint64_t high = (state.lastMilliseconds << 16) | 0x7000 | (state.counter >> 30);
+		const uint64_t low = 0x8000000000000000ULL | ((state.counter & 0x3FFFFFFF) << 32) | (state.next() & 0xFFFFFFFF);
+		return makeUuid(high, low);
+	}
+
+	constexpr char hexDigits[] = "0123456789abcdef";
+
+	/**
+	 * @brief Expands the 16 bytes of id into 32 lower case hex chars
+	 */
+	inline void toHex(const uuid& id, char* out) {
+	#if defined(ARCH_x64)
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(id.bytes.data()));
+		const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+		const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask);
+		const __m128i low = _mm_and_si128(bytes, nibbleMask);
+
+		// Interleave so each byte's high nibble comes first, then map 0-15 to '0'-'9','a'-'f'
+		__m128i first = _mm_unpacklo_epi8(high, low);
+		__m128i second = _mm_unpackhi_epi8(high, low);
+
+		const __m128i nine = _mm_set1_epi8(9);
+		const __m128i zero = _mm_set1_epi8('0');
+		const __m128i letterGap = _mm_set1_epi8('a' - '0' - 10);
+
+		first = _mm_add_epi8(_mm_add_epi8(first, zero), _mm_and_si128(_mm_cmpgt_epi8(first, nine), letterGap));
+		second = _mm_add_epi8(_mm_add_epi8(second, zero), _mm_and_si128(_mm_cmpgt_epi8(second, nine), letterGap));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), first);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), second);
+	#else
+		for (size_t i = 0; i < 16; i++) {
+			out[i * 2] = hexDigits[id.bytes[i] >> 4];
+			out[i * 2 + 1] = hexDigits[id.bytes[i] & 0x0F];
+		}
+	#endif
+	}
+
+	/**
+	 * @brief Packs 32 hex chars of either case into 16 bytes
+	 *
+	 * @return False if any char is not a hex digit.
+	 */
+	inline bool fromHex(const char* hex, uint8_t* out) {
+	#if defined(ARCH_x64)
+		__m128i values[2];
+
+		for (size_t i = 0; i < 2; i++) {
+			const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i * 16));
+
+			// Digits map to 0-9 and letters(folded to lower case) to 10-15, everything else is rejected.
+			// The unsigned range checks are done as signed compares after biasing by 0x80.
+			const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+			const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+			const __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+
+			const __m128i isDigit = _mm_cmplt_epi8(_mm_xor_si128(digit, bias), _mm_set1_epi8(static_cast<char>(0x80 + 10)));
+			const __m128i isLetter = _mm_cmplt_epi8(_mm_xor_si128(letter, bias), _mm_set1_epi8(static_cast<char>(0x80 + 6)));
+
+			if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) return false;
+
+			values[i] = _mm_or_si128(_mm_and_si128(isDigit, digit),
+									 _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+		}
+
+		// Each 16-bit lane holds (high nibble, low nibble), combine them and pack down to bytes
+		const __m128i lowMask = _mm_set1_epi16(0x00FF);
+		__m128i packed[2];
+		for (size_t i = 0; i < 2; i++) {
+			const __m128i highNibbles = _mm_and_si128(values[i], lowMask);
+			const __m128i lowNibbles = _mm_srli_epi16(values[i], 8);
+			packed[i] = _mm_or_si128(_mm_slli_epi16(highNibbles, 4), lowNibbles);
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(packed[0], packed[1]));
+		return true;
+	#else
+		auto nibble = [](char c) -> int {
+			if (c >= '0' && c <= '9') return c - '0';
+			c = static_cast<char>(c | 0x20);
+			if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+			return -1;
+		};
+
+		for (size_t i = 0; i < 16; i++) {
+			const int high = nibble(hex[i * 2]);
+			const int low = nibble(hex[i * 2 + 1]);
+			if (high < 0 || low < 0) return false;
+			out[i] = static_cast<uint8_t>((high << 4) | low);
+		}
+		return true;
+	#endif
+	}
+}
+
+//===================================================================================================================================
+//											               GENERATOR FUNCTIONS
+//===================================================================================================================================
+
+uuid UTK::UUID::generateV4() {
+
+	return makeV4(localState());
+}
+
+uuid UTK::UUID::generateV7() {
+
+	threadState& state = localState();
+	advanceClock(state);
+	return makeV7(state);
+}
+
+void UTK::UUID::generateV4(span<uuid> out) {
+
+	threadState& state = localState();
+	for (uuid& id : out) {
+		id = makeV4(state);
+	}
+}
+
+void UTK::UUID::generateV7(span<uuid> out) {
+
+	threadState& state = localState();
+	advanceClock(state);
+	for (uuid& id : out) {
+		id = makeV7(state);
+	}
+}
+
+//===================================================================================================================================
+//											          FORMATTING & PARSING FUNCTIONS
+//===================================================================================================================================
+
+void UTK::UUID::format(const uuid& id, char* out) {
+
+	char hex[32];
+	toHex(id, hex);
+
+	// Canonical 8-4-4-4-12 grouping, fixed size copies compile down to plain moves
+	memcpy(out, hex, 8);
+	memcpy(out + 9, hex + 8, 4);
+	memcpy(out + 14, hex + 12, 4);
+	memcpy(out + 19, hex + 16, 4);
+	memcpy(out + 24, hex + 20, 12);
+	out[8] = out[13] = out[18] = out[23] = '-';
+}
+
+void UTK::UUID::format(span<const uuid> ids, char* out) {
+
+	for (const uuid& id : ids) {
+		format(id, out);
+		out += textLength;
+	}
+}
+
+string UTK::UUID::toString(const uuid& id) {
+
+	string text(textLength, '\0');
+	format(id, text.data());
+	return text;
+}
+
+optional<uuid> UTK::UUID::parse(string_view text) {
+
+	if (text.size() != textLength) return nullopt;
+	if (text[8] != '-' || text[13] != '-' || text[18] != '-' || text[23] != '-') return nullopt;
+
+	char hex[32];
+	memcpy(hex, text.data(), 8);
+	memcpy(hex + 8, text.data() + 9, 4);
+	memcpy(hex + 12, text.data() + 14, 4);
+	memcpy(hex + 16, text.data() + 19, 4);
+	memcpy(hex + 20, text.data() + 24, 12);
+
+	uuid id;
+	if (!fromHex(hex, id.bytes.data())) return nullopt;
+	return id;
+}
\ No newline at end of file
@@ -0,0 +1,210 @@
+//===================================================================================================================================
+// @file	archive_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for the archive writer and reader, chiefly that a frame failing its checksum is treated as torn.
+//
+// @note    Frames are damaged by flipping a byte inside a block's stored payload, found from the seek table.
+//===================================================================================================================================
+
+#include "dispatchers/utkarchive.hpp"
+#include "dispatchers/utkexecutor.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <stdexcept>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace std;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+using namespace UTK::Types::LogEntry;
+
+namespace {
+
+	/// Size of the frame header in front of each block's payload
+	constexpr uint64_t frameHeaderBytes = 40;
+
+	filesystem::path scratchFile(const string& name) {
+		auto path = filesystem::temp_directory_path() / ("utk_" + name + "_" + to_string(getpid()) + ".archive");
+		filesystem::remove(path);
+		return path;
+	}
+
+	logEntry entryFor(int index) {
+		return makeLogEntry(Logger::ARCHIVE, Operations::LG_WR, { "index", "message" },
+			{ to_string(index), "value " + to_string(index * 7919 % 1000) }, "archive_test.cpp", index, "entryFor");
+	}
+
+	/// Writes count entries stamped 0, 1, 2... in small blocks, leaving the archive closed unless told not to
+	vector<archiveBlock> writeArchive(const filesystem::path& path, int count, bool close = true) {
+		taskExecutor executor(executorOptions{ .workers = 2 });
+		archiveWriter writer(path.string(), archiveOptions{ .blockBytes = 4096, .executor = &executor });
+
+		for (int i = 0; i < count; i++) writer.append(entryFor(i), i);
+
+		writer.flush();
+		if (close) writer.close();
+
+		vector<archiveBlock> blocks = writer.blocks();
+
+		// Leave without the destructor's close(), as a writer killed after its last flush would
+		if (!close) {
+			ifstream original(path, ios::binary);
+			const string bytes((istreambuf_iterator<char>(original)), istreambuf_iterator<char>());
+			writer.close();
+			ofstream(path, ios::binary | ios::trunc).write(bytes.data(), static_cast<streamsize>(bytes.size()));
+		}
+		return blocks;
+	}
+
+	/// Flips one byte in the middle of a block's stored payload
+	void damage(const filesystem::path& path, const archiveBlock& block) {
+		fstream file(path, ios::binary | ios::in | ios::out);
+		const auto at = static_cast<streamoff>(block.offset + frameHeaderBytes + block.storedBytes / 2);
+
+		char byte = 0;
+		file.seekg(at);
+		file.read(&byte, 1);
+		byte = static_cast<char>(byte ^ 0x20);
+		file.seekp(at);
+		file.write(&byte, 1);
+	}
+
+	/// Every index next() yields from the start
+	vector<int> streamed(archiveReader& reader) {
+		vector<int> indices;
+		archivedEntry archived;
+		while (reader.next(archived)) indices.push_back(stoi(archived.entry.formatValues[0]));
+		return indices;
+	}
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(ArchiveTest, RoundTripsEveryEntry) {
+
+	const auto path = scratchFile("roundtrip");
+	const auto written = writeArchive(path, 5000);
+	ASSERT_GT(written.size(), 4u);
+
+	archiveReader reader(path.string());
+	EXPECT_TRUE(reader.complete());
+	EXPECT_EQ(reader.blocks().size(), written.size());
+
+	const vector<int> indices = streamed(reader);
+	ASSERT_EQ(indices.size(), 5000u);
+	for (int i = 0; i < 5000; i++) ASSERT_EQ(indices[static_cast<size_t>(i)], i);
+
+	const auto ranged = reader.range(1000, 1999);
+	ASSERT_EQ(ranged.size(), 1000u);
+	EXPECT_EQ(ranged.front().timeStamp, 1000);
+	EXPECT_EQ(ranged.back().entry.formatValues[1], entryFor(1999).formatValues[1]);
+
+	filesystem::remove(path);
+}
+
+TEST(ArchiveTest, NextStopsAtADamagedFrame) {
+
+	const auto path = scratchFile("damaged_next");
+	const auto written = writeArchive(path, 5000);
+	const size_t bad = written.size() / 2;
+	damage(path, written[bad]);
+
+	archiveReader reader(path.string());
+	const vector<int> indices = streamed(reader);
+
+	// Everything before the damaged block, nothing from it or after it, and no exception
+	uint64_t before = 0;
+	for (size_t b = 0; b < bad; b++) before += written[b].entries;
+	EXPECT_EQ(indices.size(), before);
+	EXPECT_EQ(reader.blocks().size(), bad);
+	EXPECT_FALSE(reader.complete());
+
+	filesystem::remove(path);
+}
+
+TEST(ArchiveTest, ReadBlockRefusesADamagedFrame) {
+
+	const auto path = scratchFile("damaged_block");
+	const auto written = writeArchive(path, 5000);
+	const size_t bad = written.size() - 2;
+	damage(path, written[bad]);
+
+	archiveReader reader(path.string());
+
+	vector<archivedEntry> entries;
+	reader.readBlock(0, entries);
+	EXPECT_EQ(entries.size(), written[0].entries);
+
+	EXPECT_THROW(reader.readBlock(bad, entries), runtime_error);
+	EXPECT_EQ(reader.blocks().size(), bad);
+	EXPECT_THROW(reader.readBlock(bad + 1, entries), out_of_range);
+
+	filesystem::remove(path);
+}
+
+TEST(ArchiveTest, RebuiltIndexEndsBeforeADamagedFrame) {
+
+	// No seek table, so the reader walks the frames and has to check each one itself
+	const auto path = scratchFile("damaged_scan");
+	const auto written = writeArchive(path, 5000, false);
+	const size_t bad = 3;
+	damage(path, written[bad]);
+
+	{
+		archiveReader reader(path.string());
+		EXPECT_FALSE(reader.complete());
+		EXPECT_EQ(reader.blocks().size(), bad);
+	}
+
+	// A writer continuing the archive cuts the damaged frame off and carries on after the last good one
+	{
+		archiveWriter writer(path.string());
+		EXPECT_EQ(writer.blocks().size(), bad);
+		writer.append(entryFor(-1), 100000);
+		writer.close();
+	}
+
+	archiveReader reader(path.string());
+	EXPECT_TRUE(reader.complete());
+	const vector<int> indices = streamed(reader);
+	ASSERT_FALSE(indices.empty());
+	EXPECT_EQ(indices.back(), -1);
+
+	filesystem::remove(path);
+}
+
+TEST(ArchiveTest, TornFrameIsPickedUpOnceWhole) {
+
+	const auto path = scratchFile("torn");
+	const auto written = writeArchive(path, 5000, false);
+	ASSERT_GT(written.size(), 2u);
+
+	ifstream original(path, ios::binary);
+	const string bytes((istreambuf_iterator<char>(original)), istreambuf_iterator<char>());
+	original.close();
+
+	// The last frame is whole in length but its payload is still zeros, as a crash mid-write can leave it
+	const archiveBlock& last = written.back();
+	string torn = bytes;
+	fill(torn.begin() + static_cast<ptrdiff_t>(last.offset + frameHeaderBytes), torn.end(), '\0');
+	ofstream(path, ios::binary | ios::trunc).write(torn.data(), static_cast<streamsize>(torn.size()));
+
+	archiveReader reader(path.string());
+	EXPECT_EQ(reader.blocks().size(), written.size() - 1);
+
+	// The writer finishes the frame, refresh() now finds it and next() carries on into it
+	const size_t before = streamed(reader).size();
+	ofstream(path, ios::binary | ios::trunc).write(bytes.data(), static_cast<streamsize>(bytes.size()));
+
+	EXPECT_EQ(reader.refresh(), 1u);
+	EXPECT_EQ(before + streamed(reader).size(), 5000u);
+
+	filesystem::remove(path);
+}
\ No newline at end of file
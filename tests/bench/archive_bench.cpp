@@ -0,0 +1,131 @@
+//===================================================================================================================================
+// @file	archive_bench.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Write and read throughput of the log archive for a range of block sizes, and the compression ratio it gets
+//			on generated log traffic.
+//
+// @note    Usage: archive_bench [milliseconds per measurement(default: 200)]
+//			Results are MB/s of encoded entries in and out, and raw bytes over stored bytes across every block.
+//			Frames are checksummed, so the read column includes verifying them.
+//===================================================================================================================================
+
+#include "dispatchers/utkarchive.hpp"
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <unistd.h>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+using namespace UTK::Types::LogEntry;
+
+namespace {
+
+	constexpr size_t blockSizes[] = { 16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024 };
+	constexpr size_t entryCount = 1 << 14;
+
+	/// Keeps results alive so the reads are not optimized away
+	volatile uint64_t sink = 0;
+
+	/// Log traffic shaped like a real service: a handful of call sites, repeated keys, varying values
+	vector<logEntry> generateEntries() {
+
+		static const char* const functions[] = { "handleRequest", "openSession", "flushCache", "retryUpload" };
+		static const char* const paths[] = { "/api/v1/users", "/api/v1/orders", "/health", "/api/v2/search" };
+
+		vector<logEntry> entries;
+		entries.reserve(entryCount);
+
+		uint32_t state = 0x9E3779B1;
+		for (size_t i = 0; i < entryCount; i++) {
+			state = state * 1664525u + 1013904223u;
+			const uint32_t site = state >> 30;
+			const uint32_t value = (state >> 8) & 0xFFFF;
+
+			entries.push_back(makeLogEntry(Logger::ARCHIVE, Operations::LG_WR, { "path", "status", "micros", "request" },
+				{ paths[site], (value % 17 == 0) ? "500" : "200", to_string(value % 5000), to_string(i) },
+				"service.cpp", static_cast<int>(100 + site * 40), functions[site]));
+		}
+		return entries;
+	}
+
+	void report(const vector<logEntry>& entries, size_t blockBytes, milliseconds runTime) {
+
+		const auto path = filesystem::temp_directory_path() / ("utk_archive_bench_" + to_string(getpid()) + ".archive");
+
+		// Write the entries repeatedly into one archive until the time is up
+		uint64_t written = 0;
+		filesystem::remove(path);
+		const auto writeBegan = steady_clock::now();
+		auto now = writeBegan;
+		{
+			archiveWriter writer(path.string(), archiveOptions{ .blockBytes = blockBytes });
+			int64_t stamp = 0;
+			while (now - writeBegan < runTime) {
+				for (const auto& entry : entries) writer.append(entry, stamp++);
+				written += entries.size();
+				now = steady_clock::now();
+			}
+			writer.close();
+			now = steady_clock::now();
+		}
+		const double writeSeconds = duration_cast<duration<double>>(now - writeBegan).count();
+
+		uint64_t raw = 0;
+		uint64_t stored = 0;
+		uint64_t read = 0;
+		uint64_t folded = 0;
+
+		// Stream it back from the start as many times as fits
+		const auto readBegan = steady_clock::now();
+		now = readBegan;
+		while (read == 0 || now - readBegan < runTime) {
+			archiveReader reader(path.string());
+			if (raw == 0) {
+				for (const auto& block : reader.blocks()) {
+					raw += block.rawBytes;
+					stored += block.storedBytes;
+				}
+			}
+
+			archivedEntry archived;
+			while (reader.next(archived)) {
+				folded += static_cast<uint64_t>(archived.timeStamp);
+				read++;
+			}
+			now = steady_clock::now();
+		}
+		const double readSeconds = duration_cast<duration<double>>(now - readBegan).count();
+
+		sink = sink + folded;
+		filesystem::remove(path);
+
+		// Throughput in raw, encoded bytes, so the columns compare across block sizes
+		const double bytesPerEntry = static_cast<double>(raw) / static_cast<double>(written);
+		cout << setw(12) << blockBytes / 1024 << setw(12) << fixed << setprecision(1)
+			 << static_cast<double>(written) * bytesPerEntry / writeSeconds / 1e6
+			 << setw(12) << static_cast<double>(read) * bytesPerEntry / readSeconds / 1e6
+			 << setw(12) << setprecision(2) << static_cast<double>(raw) / static_cast<double>(stored)
+			 << setw(12) << setprecision(1) << bytesPerEntry << "\n";
+	}
+}
+
+int main(int argc, char* argv[]) {
+
+	const milliseconds runTime((argc > 1) ? stoi(argv[1]) : 200);
+	const vector<logEntry> entries = generateEntries();
+
+	cout << setw(12) << "block KiB" << setw(12) << "write MB/s" << setw(12) << "read MB/s"
+		 << setw(12) << "ratio" << setw(12) << "bytes/entry" << "\n";
+
+	for (size_t blockBytes : blockSizes) report(entries, blockBytes, runTime);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+//===================================================================================================================================
+// @file	caching_bench.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Throughput of shardedLruCache from 1 up to 64 threads, against the same cache with a single shard.
+//
+// @note    Usage: caching_bench [milliseconds per run(default: 500)]
+//			Every thread runs a 90% get / 10% put mix over a key space four times the capacity, with most
+//			lookups landing on a hot fifth of the keys. Throughput is millions of operations per second summed
+//			over all threads.
+//===================================================================================================================================
+
+#include "caching/utkcaching.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Caching;
+
+namespace {
+
+	constexpr size_t capacity = 1 << 16;
+	constexpr uint64_t keySpace = capacity * 4;
+	constexpr uint64_t hotKeys = keySpace / 5;
+
+	using benchCache = shardedLruCache<uint64_t, uint64_t>;
+
+	/// Cheap per thread generator so the benchmark measures the cache rather than the random numbers
+	struct splitMix {
+		uint64_t state;
+
+		uint64_t next() {
+			uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			return z ^ (z >> 31);
+		}
+	};
+
+	struct runResult {
+		double mops;
+		double hitRate;
+	};
+
+	runResult run(benchCache& cache, unsigned threads, milliseconds runTime) {
+
+		atomic<bool> start{ false };
+		atomic<bool> stop{ false };
+		vector<uint64_t> operations(threads, 0);
+		vector<thread> workers;
+
+		for (unsigned t = 0; t < threads; t++) {
+			workers.emplace_back([&, t] {
+				splitMix random{ t + 1 };
+				uint64_t done = 0;
+
+				while (!start.load(memory_order_acquire)) this_thread::yield();
+
+				while (!stop.load(memory_order_relaxed)) {
+					for (int i = 0; i < 256; i++) {
+						const uint64_t r = random.next();
+						const uint64_t key = (r & 0xff) < 205 ? (r >> 8) % hotKeys : (r >> 8) % keySpace;
+
+						if ((r >> 56) % 10 == 0) cache.put(key, r);
+						else cache.get(key);
+					}
+					done += 256;
+				}
+				operations[t] = done;
+			});
+		}
+
+		const auto began = steady_clock::now();
+		start.store(true, memory_order_release);
+		this_thread::sleep_for(runTime);
+		stop = true;
+		for (auto& worker : workers) worker.join();
+		const double seconds = duration_cast<duration<double>>(steady_clock::now() - began).count();
+
+		uint64_t total = 0;
+		for (uint64_t done : operations) total += done;
+
+		return { static_cast<double>(total) / seconds / 1e6, cache.stats().hitRate() };
+	}
+
+	runResult runFresh(size_t shards, unsigned threads, milliseconds runTime) {
+
+		benchCache cache(cacheCapacity{ capacity, 0 }, shards);
+		for (uint64_t key = 0; key < capacity; key++) cache.put(key, key);
+
+		return run(cache, threads, runTime);
+	}
+}
+
+int main(int argc, char* argv[]) {
+
+	const milliseconds runTime((argc > 1) ? stoi(argv[1]) : 500);
+
+	cout << "shardedLruCache<uint64_t, uint64_t>, " << capacity << " entries, "
+		 << thread::hardware_concurrency() << " hardware threads\n\n";
+	cout << setw(8) << "threads" << setw(14) << "sharded Mops" << setw(10) << "hit rate"
+		 << setw(16) << "1 shard Mops" << setw(10) << "speedup" << "\n";
+
+	for (unsigned threads = 1; threads <= 64; threads *= 2) {
+		const runResult sharded = runFresh(0, threads, runTime);
+		const runResult single = runFresh(1, threads, runTime);
+
+		cout << fixed << setprecision(2)
+			 << setw(8) << threads << setw(14) << sharded.mops << setw(10) << sharded.hitRate
+			 << setw(16) << single.mops << setw(9) << sharded.mops / single.mops << "x\n";
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+//===================================================================================================================================
+// @file	hash_bench.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Throughput of every XXH3 and CRC32C kernel the running CPU supports, from short keys to large buffers.
+//
+// @note    Usage: hash_bench [milliseconds per measurement(default: 200)]
+//			Results are GB/s of input hashed, the same buffer is hashed repeatedly so it stays in cache.
+//===================================================================================================================================
+
+#include "hash/utkhash.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Hash;
+
+namespace {
+
+	constexpr size_t sizes[] = { 16, 64, 256, 1024, 4096, 65536, 1 << 20 };
+
+	/// Keeps results alive so the calls are not optimized away
+	volatile uint64_t sink = 0;
+
+	template<typename Hash>
+	double gigabytesPerSecond(const vector<uint8_t>& buffer, size_t length, milliseconds runTime, Hash hash) {
+
+		uint64_t calls = 0;
+		uint64_t folded = 0;
+		const auto began = steady_clock::now();
+		auto now = began;
+
+		// Check the clock every batch only, short inputs hash in a few nanoseconds
+		const uint64_t batch = max<uint64_t>(1, (1 << 20) / length);
+		while (now - began < runTime) {
+			for (uint64_t i = 0; i < batch; i++) {
+				folded += hash(buffer.data() + (i & 7), length);
+			}
+			calls += batch;
+			now = steady_clock::now();
+		}
+
+		sink = sink + folded;
+		const double seconds = duration_cast<duration<double>>(now - began).count();
+		return static_cast<double>(calls * length) / seconds / 1e9;
+	}
+
+	template<typename Hash>
+	void report(const string& name, const vector<uint8_t>& buffer, milliseconds runTime, Hash hash) {
+		cout << setw(20) << left << name << right;
+		for (size_t length : sizes) {
+			cout << setw(10) << fixed << setprecision(2) << gigabytesPerSecond(buffer, length, runTime, hash);
+		}
+		cout << "\n";
+	}
+}
+
+int main(int argc, char* argv[]) {
+
+	const milliseconds runTime((argc > 1) ? stoi(argv[1]) : 200);
+
+	vector<uint8_t> buffer(sizes[size(sizes) - 1] + 8);
+	uint32_t state = 0x9E3779B1;
+	for (auto& byte : buffer) {
+		state = state * 1664525u + 1013904223u;
+		byte = static_cast<uint8_t>(state >> 24);
+	}
+
+	const kernelSet selected = activeKernels();
+	cout << "Automatically selected: hash " << selected.hash << ", crc " << selected.crc << "\n\n";
+
+	cout << setw(20) << left << "GB/s" << right;
+	for (size_t length : sizes) cout << setw(10) << length;
+	cout << "\n";
+
+	for (auto kernel : availableHashKernels()) {
+		selectHashKernel(kernel);
+		report("xxh3-64 " + string(kernel), buffer, runTime, [](const uint8_t* data, size_t length) {
+			return hash64(data, length);
+		});
+		report("xxh3-128 " + string(kernel), buffer, runTime, [](const uint8_t* data, size_t length) {
+			return hash128Of(data, length).low;
+		});
+	}
+
+	for (auto kernel : availableCrcKernels()) {
+		selectCrcKernel(kernel);
+		report("crc32c " + string(kernel), buffer, runTime, [](const uint8_t* data, size_t length) {
+			return uint64_t{ crc32c(data, length) };
+		});
+	}
+
+	selectHashKernel(selected.hash);
+	selectCrcKernel(selected.crc);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+//===================================================================================================================================
+// @file	json_bench.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Parse throughput of every UTK::JSON stage one kernel the running CPU supports, over generated log
+//			records, number arrays and escape heavy strings.
+//
+// @note    Usage: json_bench [milliseconds per measurement(default: 200)]
+//			Results are GB/s of input parsed and, for the NDJSON column, every record's fields read back too.
+//===================================================================================================================================
+
+#include "json/utkjson.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::JSON;
+
+namespace {
+
+	/// Keeps results alive so the parses are not optimized away
+	volatile uint64_t sink = 0;
+
+	/// Small deterministic generator, the documents are identical from run to run
+	class generator {
+	private:
+		uint32_t _state = 0x9E3779B1;
+
+	public:
+		uint32_t next() {
+			_state = _state * 1664525u + 1013904223u;
+			return _state >> 8;
+		}
+	};
+
+	/// NDJSON log records shaped like the dispatcher's JSON sink output
+	string logRecords(size_t bytes) {
+		static const char* levels[] = { "TRACE", "DEBUG", "INFO", "WARN", "ERROR" };
+		generator random;
+		string text;
+
+		while (text.size() < bytes) {
+			const uint32_t r = random.next();
+			text += "{\"seq\":" + to_string(text.size()) + ",\"time\":" + to_string(1700000000000ULL + r)
+				 + ",\"level\":\"" + levels[r % 5] + "\",\"thread\":" + to_string(r % 64)
+				 + ",\"message\":\"request " + to_string(r) + " finished in " + to_string(r % 1000) + "ms\""
+				 + ",\"tags\":[\"io\",\"net\"],\"ok\":" + ((r & 1) ? "true" : "false") + "}\n";
+		}
+		return text;
+	}
+
+	/// One large array of mixed integers and doubles
+	string numberArray(size_t bytes) {
+		generator random;
+		string text = "[";
+
+		while (text.size() < bytes) {
+			const uint32_t r = random.next();
+			text += (r & 1) ? to_string(r) : to_string(static_cast<double>(r) / 1e5) + "e-" + to_string(r % 300);
+			text += ",";
+		}
+		text.back() = ']';
+		return text;
+	}
+
+	/// One large array of strings full of escapes and quotes, the worst case for the quote mask
+	string escapedStrings(size_t bytes) {
+		generator random;
+		string text = "[";
+
+		while (text.size() < bytes) {
+			text += "\"path\\\\to\\\\file " + to_string(random.next()) + " said \\\"hi\\\"\\n\\t\\u00e9\",";
+		}
+		text.back() = ']';
+		return text;
+	}
+
+	template<typename Parse>
+	double gigabytesPerSecond(const string& text, milliseconds runTime, Parse parse) {
+
+		uint64_t passes = 0;
+		const auto began = steady_clock::now();
+		auto now = began;
+
+		while (now - began < runTime) {
+			sink = sink + parse(text);
+			passes++;
+			now = steady_clock::now();
+		}
+
+		const double seconds = duration_cast<duration<double>>(now - began).count();
+		return static_cast<double>(passes * text.size()) / seconds / 1e9;
+	}
+
+	uint64_t parseOnly(const string& text) {
+		return document::parse(text, parseMode::many).size();
+	}
+
+	uint64_t parseAndRead(const string& text) {
+		uint64_t folded = 0;
+		string scratch;
+		forEachDocument(string_view(text), [&](element record) {
+			folded += record["seq"].getUint64();
+			folded += record["level"].getString(scratch).size();
+			folded += static_cast<uint64_t>(record["ok"].getBool());
+		});
+		return folded;
+	}
+}
+
+int main(int argc, char* argv[]) {
+
+	const milliseconds runTime((argc > 1) ? stoi(argv[1]) : 200);
+
+	const size_t bytes = 16 << 20;
+	const string records = logRecords(bytes);
+	const string numbers = numberArray(bytes);
+	const string strings = escapedStrings(bytes);
+
+	const string_view selected = activeKernel();
+	cout << "Automatically selected: " << selected << "\n\n";
+
+	cout << setw(12) << left << "GB/s" << right << setw(12) << "ndjson" << setw(12) << "ndjson+read"
+		 << setw(12) << "numbers" << setw(12) << "strings" << "\n";
+
+	for (auto kernel : availableKernels()) {
+		selectKernel(kernel);
+		cout << setw(12) << left << kernel << right << fixed << setprecision(2)
+			 << setw(12) << gigabytesPerSecond(records, runTime, parseOnly)
+			 << setw(12) << gigabytesPerSecond(records, runTime, parseAndRead)
+			 << setw(12) << gigabytesPerSecond(numbers, runTime, parseOnly)
+			 << setw(12) << gigabytesPerSecond(strings, runTime, parseOnly) << "\n";
+	}
+
+	selectKernel(selected);
+	return 0;
+}
\ No newline at end of file
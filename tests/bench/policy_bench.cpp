@@ -0,0 +1,85 @@
+//===================================================================================================================================
+// @file	policy_bench.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Hit rate of every ttlCache policy on generated access traces, through evaluatePolicies, so a policy
+//			can be chosen from numbers.
+//
+// @note    Usage: policy_bench [accesses per trace(default: 1000000)]
+//			The skewed trace draws from a Zipf-like distribution over keys ten times the largest capacity.
+//			The scan trace is the same with a one-off sweep of never repeated keys through its middle third.
+//===================================================================================================================================
+
+#include "caching/utkttlcache.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cmath>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Caching;
+
+namespace {
+
+	constexpr size_t capacities[] = { 1000, 4000, 16000 };
+	constexpr uint64_t keySpace = 160000;
+
+	/// Zipf-like keys, the low keys are far more popular than the high ones
+	vector<uint64_t> skewedTrace(size_t accesses) {
+		vector<uint64_t> trace(accesses);
+		uint32_t state = 0x9E3779B1;
+		for (auto& key : trace) {
+			state = state * 1664525u + 1013904223u;
+			const double unit = static_cast<double>(state >> 8) / static_cast<double>(1u << 24);
+			key = static_cast<uint64_t>(pow(unit, 4.0) * static_cast<double>(keySpace));
+		}
+		return trace;
+	}
+
+	/// The skewed trace with its middle third replaced by keys outside the key space, each seen once
+	vector<uint64_t> scanTrace(size_t accesses) {
+		vector<uint64_t> trace = skewedTrace(accesses);
+		for (size_t i = accesses / 3; i < 2 * accesses / 3; i++) trace[i] = keySpace + i;
+		return trace;
+	}
+
+	string policyName(cachePolicy policy) {
+		switch (policy) {
+			case cachePolicy::LRU:				return "LRU";
+			case cachePolicy::WINDOW_TINY_LFU:	return "W-TinyLFU";
+			default:							return "unknown";
+		}
+	}
+
+	void report(const string& name, const vector<uint64_t>& trace) {
+		for (size_t capacity : capacities) {
+			const auto began = steady_clock::now();
+			const auto results = evaluatePolicies(trace, capacity);
+			const double seconds = duration_cast<duration<double>>(steady_clock::now() - began).count();
+
+			for (const auto& result : results) {
+				cout << setw(16) << left << name << setw(12) << policyName(result.policy) << right
+					 << setw(10) << capacity << setw(10) << fixed << setprecision(2) << result.stats.hitRate() * 100.0
+					 << setw(12) << result.stats.evictions << setw(12) << result.stats.rejections
+					 << setw(12) << setprecision(1) << static_cast<double>(trace.size() * results.size()) / seconds / 1e6 << "\n";
+			}
+		}
+	}
+}
+
+int main(int argc, char* argv[]) {
+
+	const size_t accesses = (argc > 1) ? stoul(argv[1]) : 1000000;
+
+	cout << setw(16) << left << "trace" << setw(12) << "policy" << right << setw(10) << "capacity"
+		 << setw(10) << "hit %" << setw(12) << "evictions" << setw(12) << "rejections" << setw(12) << "Mops/s" << "\n";
+
+	report("skewed", skewedTrace(accesses));
+	report("skewed + scan", scanTrace(accesses));
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+//===================================================================================================================================
+// @file	random_bench.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Throughput of the UTK::Random engines and bulk distributions, against std::mt19937_64 and the
+//			standard distributions as a baseline.
+//
+// @note    Usage: random_bench [milliseconds per measurement(default: 200)]
+//			Results are millions of values per second, filling a 4096 element buffer repeatedly.
+//===================================================================================================================================
+
+#include "random/utkrandom.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <random>
+#include <chrono>
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Random;
+
+namespace {
+
+	constexpr size_t bufferSize = 4096;
+
+	/// Keeps results alive so the fills are not optimized away
+	volatile double sink = 0;
+
+	template<typename T, typename Fill>
+	void report(const string& name, milliseconds runTime, Fill fill) {
+
+		vector<T> buffer(bufferSize);
+		uint64_t values = 0;
+		const auto began = steady_clock::now();
+		auto now = began;
+
+		while (now - began < runTime) {
+			for (int i = 0; i < 16; i++) fill(span<T>(buffer));
+			values += 16 * bufferSize;
+			now = steady_clock::now();
+		}
+
+		sink = sink + static_cast<double>(buffer[bufferSize / 2]);
+		const double seconds = duration_cast<duration<double>>(now - began).count();
+		cout << setw(40) << left << name << right << setw(10) << fixed << setprecision(1)
+			 << static_cast<double>(values) / seconds / 1e6 << "\n";
+	}
+
+	template<typename Engine>
+	void reportEngine(const string& name, milliseconds runTime) {
+		Engine engine;
+
+		report<uint64_t>(name + " bits", runTime, [&](span<uint64_t> out) { fillBits(engine, out); });
+		report<double>(name + " uniform double", runTime, [&](span<double> out) { fillUniform(engine, out, -1.0, 1.0); });
+		report<float>(name + " uniform float", runTime, [&](span<float> out) { fillUniform(engine, out, -1.0f, 1.0f); });
+		report<int32_t>(name + " uniform int [0, 999]", runTime, [&](span<int32_t> out) { fillUniform(engine, out, 0, 999); });
+		report<double>(name + " normal double", runTime, [&](span<double> out) { fillNormal(engine, out); });
+	}
+}
+
+int main(int argc, char* argv[]) {
+
+	const milliseconds runTime((argc > 1) ? stoi(argv[1]) : 200);
+
+	cout << "xoshiro256ppx8 kernel: " << activeKernel() << "\n\n";
+	cout << setw(40) << left << "Mvalues/s" << right << "\n";
+
+	reportEngine<xoshiro256pp>("xoshiro256++", runTime);
+	reportEngine<xoshiro256ppx8>("xoshiro256++ x8", runTime);
+	reportEngine<pcg32>("pcg32", runTime);
+
+	// The standard library one value at a time, what the fill functions replace
+	mt19937_64 standard(42);
+	uniform_real_distribution<double> real(-1.0, 1.0);
+	uniform_int_distribution<int32_t> integer(0, 999);
+	normal_distribution<double> normal;
+
+	report<uint64_t>("mt19937_64 bits", runTime, [&](span<uint64_t> out) { for (auto& v : out) v = standard(); });
+	report<double>("mt19937_64 uniform double", runTime, [&](span<double> out) { for (auto& v : out) v = real(standard); });
+	report<int32_t>("mt19937_64 uniform int [0, 999]", runTime, [&](span<int32_t> out) { for (auto& v : out) v = integer(standard); });
+	report<double>("mt19937_64 normal double", runTime, [&](span<double> out) { for (auto& v : out) v = normal(standard); });
+
+	return 0;
+}
\ No newline at end of file
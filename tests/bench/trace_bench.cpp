@@ -0,0 +1,145 @@
+//===================================================================================================================================
+// @file	trace_bench.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Cost of recording a span with UTK_TRACE_SCOPE, from one thread and from several at once, against the
+//			20ns per span the tracer is meant to stay under.
+//
+// @note    Usage: trace_bench [milliseconds per measurement(default: 200)]
+//			Results are nanoseconds per span with the cost of an empty loop taken off. The tracer is drained
+//			between batches, outside the timed region, so the buffers never grow past one batch per thread.
+//			The two counter reads are shown on their own as well: under a hypervisor that traps rdtsc they
+//			can cost more than the rest of the span put together.
+//===================================================================================================================================
+
+#include "trace/utktrace.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Trace;
+
+namespace {
+
+	constexpr uint64_t batch = 1 << 16;
+	constexpr double targetNanoseconds = 20.0;
+
+	/// Keeps results alive so the loops are not optimized away
+	volatile uint64_t sink = 0;
+
+	/// Nanoseconds per iteration of body, timed in batches until runTime has been spent inside them
+	template<typename Body>
+	double nanosecondsPerCall(milliseconds runTime, Body body) {
+
+		uint64_t calls = 0;
+		nanoseconds spent{ 0 };
+		vector<traceSpan> drained;
+
+		while (spent < runTime) {
+			const auto began = steady_clock::now();
+			for (uint64_t i = 0; i < batch; i++) body(i);
+			spent += steady_clock::now() - began;
+			calls += batch;
+
+			drained.clear();
+			tracer::global().drain(drained);
+		}
+		return static_cast<double>(spent.count()) / static_cast<double>(calls);
+	}
+
+	double emptyLoop(milliseconds runTime) {
+		return nanosecondsPerCall(runTime, [](uint64_t i) { sink = i; });
+	}
+
+	double counterReads(milliseconds runTime) {
+		return nanosecondsPerCall(runTime, [](uint64_t) { sink = ticks() + ticks(); });
+	}
+
+	/// recordSpan alone, with the counter reads taken out
+	double recordOnly(milliseconds runTime) {
+		return nanosecondsPerCall(runTime, [](uint64_t i) {
+			recordSpan("bench.record", i, i + 1);
+			sink = i;
+		});
+	}
+
+	double scopedSpans(milliseconds runTime) {
+		return nanosecondsPerCall(runTime, [](uint64_t i) {
+			UTK_TRACE_SCOPE("bench.span");
+			sink = i;
+		});
+	}
+
+	/// Every thread records spans at once, reports the slowest thread's cost
+	double contendedSpans(unsigned threads, milliseconds runTime) {
+
+		vector<double> costs(threads);
+		vector<thread> workers;
+		for (unsigned t = 0; t < threads; t++) {
+			workers.emplace_back([&costs, t, runTime] {
+				uint64_t calls = 0;
+				const auto began = steady_clock::now();
+				auto now = began;
+				while (now - began < runTime) {
+					for (uint64_t i = 0; i < batch; i++) {
+						UTK_TRACE_SCOPE("bench.contended");
+						sink = i;
+					}
+					calls += batch;
+					now = steady_clock::now();
+				}
+				costs[t] = static_cast<double>(duration_cast<nanoseconds>(now - began).count()) / static_cast<double>(calls);
+			});
+		}
+
+		// Drain alongside the writers, as an exporter would, so their chunks are recycled
+		vector<traceSpan> drained;
+		for (const auto began = steady_clock::now(); steady_clock::now() - began < runTime;) {
+			drained.clear();
+			tracer::global().drain(drained);
+			this_thread::sleep_for(milliseconds(5));
+		}
+		for (auto& worker : workers) worker.join();
+
+		drained.clear();
+		tracer::global().drain(drained);
+		return *max_element(costs.begin(), costs.end());
+	}
+
+	void report(const string& name, double nanoseconds) {
+		cout << setw(28) << left << name << right << setw(10) << fixed << setprecision(2) << nanoseconds
+			 << setw(10) << ((nanoseconds < targetNanoseconds) ? "ok" : "OVER") << "\n";
+	}
+}
+
+int main(int argc, char* argv[]) {
+
+	const milliseconds runTime((argc > 1) ? stoi(argv[1]) : 200);
+
+	// Let the tick rate settle and the thread's first chunk be allocated before timing anything
+	scopedSpans(milliseconds(20));
+
+	cout << "UTK_TRACE_SCOPE " << (UTK_TRACE_ENABLED ? "enabled" : "compiled out") << ", target "
+		 << targetNanoseconds << "ns per span\n\n";
+	cout << setw(28) << left << "ns/span" << right << "\n";
+
+	const double baseline = emptyLoop(runTime);
+	report("empty loop", baseline);
+	report("two ticks() reads", counterReads(runTime) - baseline);
+	report("recordSpan", recordOnly(runTime) - baseline);
+	report("scope, 1 thread", scopedSpans(runTime) - baseline);
+
+	const unsigned threads = max(2u, thread::hardware_concurrency());
+	report("scope, " + to_string(threads) + " threads", contendedSpans(threads, runTime) - baseline);
+
+	cout << "\ndropped: " << tracer::global().dropped() << "\n";
+	return 0;
+}
\ No newline at end of file
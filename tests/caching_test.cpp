@@ -0,0 +1,358 @@
+//===================================================================================================================================
+// @file	caching_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for the caches in UTK::Caching: LRU eviction order, byte budgets, heterogeneous lookups,
+//			the counters and the node pool, then the timing wheel and ttlCache's expiry and admission.
+//
+// @note    ttlCache runs on manualClock, so time only moves when a test advances it.
+//===================================================================================================================================
+
+#include "caching/utkcaching.hpp"
+#include "caching/utkttlcache.hpp"
+#include <gtest/gtest.h>
+#include <string_view>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Caching;
+
+namespace {
+
+	/// Weighs an entry by the length of its value alone, so byte budgets are easy to reason about
+	struct lengthWeigher {
+		size_t operator()(const string&, const string& value) const { return value.size(); }
+	};
+
+	using stringCache = lruCache<string, string, cacheHash, equal_to<>, lengthWeigher>;
+
+	/// Clock that only moves when told to
+	struct manualClock {
+		using rep = int64_t;
+		using period = nano;
+		using duration = nanoseconds;
+		using time_point = chrono::time_point<manualClock>;
+		static constexpr bool is_steady = true;
+
+		static inline duration elapsed{ 0 };
+
+		static time_point now() { return time_point(elapsed); }
+		static void advance(duration by) { elapsed += by; }
+	};
+
+	using manualCache = ttlCache<int, int, cacheHash, equal_to<>, manualClock>;
+
+	ttlOptions optionsFor(cachePolicy policy, size_t maxEntries) {
+		ttlOptions options;
+		options.maxEntries = maxEntries;
+		options.policy = policy;
+		return options;
+	}
+
+	/// Timer that remembers the advance it was popped by
+	struct testTimer : timerNode {
+		uint64_t firedFrom = 0;
+		uint64_t firedAt = 0;
+	};
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(CachingTest, EvictsLeastRecentlyUsedFirst) {
+
+	lruCache<int, int> cache(cacheCapacity{ .maxEntries = 3 });
+	cache.put(1, 10);
+	cache.put(2, 20);
+	cache.put(3, 30);
+
+	// Reading 1 makes 2 the oldest
+	ASSERT_NE(cache.get(1), nullptr);
+	cache.put(4, 40);
+
+	EXPECT_FALSE(cache.contains(2));
+	EXPECT_TRUE(cache.contains(1));
+	EXPECT_TRUE(cache.contains(3));
+	EXPECT_TRUE(cache.contains(4));
+
+	// Replacing a value counts as a use too
+	cache.put(3, 31);
+	cache.put(5, 50);
+	EXPECT_FALSE(cache.contains(1));
+	EXPECT_EQ(*cache.get(3), 31);
+	EXPECT_EQ(cache.size(), 3u);
+}
+
+TEST(CachingTest, ByteBudgetEvictsAsManyEntriesAsItTakes) {
+
+	stringCache cache(cacheCapacity{ .maxBytes = 100 });
+	for (int i = 0; i < 5; i++) cache.put("small" + to_string(i), string(20, 'x'));
+	EXPECT_EQ(cache.bytes(), 100u);
+
+	// 70 bytes only fit once the four oldest 20 byte entries have gone
+	cache.put("large", string(70, 'y'));
+	EXPECT_EQ(cache.size(), 2u);
+	EXPECT_EQ(cache.bytes(), 90u);
+	EXPECT_TRUE(cache.contains("small4"));
+	EXPECT_TRUE(cache.contains("large"));
+	EXPECT_EQ(cache.stats().evictions, 4u);
+
+	// Growing a value in place is weighed again as well
+	cache.put("small4", string(40, 'z'));
+	EXPECT_EQ(cache.size(), 1u);
+	EXPECT_EQ(cache.bytes(), 40u);
+}
+
+TEST(CachingTest, LooksUpStringKeysWithoutBuildingAString) {
+
+	lruCache<string, int> cache;
+	cache.put("alpha", 1);
+	cache.put(string("beta"), 2);
+
+	const string_view alpha = "alpha, and more"sv.substr(0, 5);
+	ASSERT_NE(cache.get(alpha), nullptr);
+	EXPECT_EQ(*cache.get(alpha), 1);
+	EXPECT_EQ(*cache.get("beta"), 2);
+	EXPECT_TRUE(cache.contains("beta"sv));
+	EXPECT_EQ(cache.get("gamma"sv), nullptr);
+
+	EXPECT_TRUE(cache.erase(alpha));
+	EXPECT_FALSE(cache.contains("alpha"));
+}
+
+TEST(CachingTest, CountsHitsMissesAndEvictions) {
+
+	lruCache<int, int> cache(cacheCapacity{ .maxEntries = 2 });
+	cache.put(1, 1);
+	cache.put(2, 2);
+	cache.put(2, 3);
+	cache.put(3, 3);
+
+	cache.get(2);
+	cache.get(3);
+	cache.get(1);
+
+	// contains() is not a lookup as far as the counters go
+	cache.contains(2);
+
+	const cacheStats& stats = cache.stats();
+	EXPECT_EQ(stats.insertions, 3u);
+	EXPECT_EQ(stats.evictions, 1u);
+	EXPECT_EQ(stats.hits, 2u);
+	EXPECT_EQ(stats.misses, 1u);
+	EXPECT_DOUBLE_EQ(stats.hitRate(), 2.0 / 3.0);
+
+	cache.resetStats();
+	EXPECT_EQ(cache.stats().hits, 0u);
+	EXPECT_DOUBLE_EQ(cache.stats().hitRate(), 0.0);
+}
+
+TEST(CachingTest, ErasedNodesAreReused) {
+
+	lruCache<int, string> cache;
+	cache.put(1, "one");
+	const string* first = cache.get(1);
+
+	// The pool hands the freed storage straight back out for the next insert
+	ASSERT_TRUE(cache.erase(1));
+	cache.put(2, "two");
+	EXPECT_EQ(cache.get(2), first);
+	EXPECT_EQ(*cache.get(2), "two");
+
+	cache.clear();
+	EXPECT_EQ(cache.size(), 0u);
+	cache.put(3, "three");
+	EXPECT_EQ(cache.get(3), first);
+}
+
+TEST(CachingTest, ShardedCacheKeepsItsTotalCapacity) {
+
+	shardedLruCache<string, int> cache(cacheCapacity{ .maxEntries = 64 }, 4);
+	EXPECT_EQ(cache.shardCount(), 4u);
+
+	vector<thread> workers;
+	for (int t = 0; t < 4; t++) {
+		workers.emplace_back([&cache, t] {
+			for (int i = 0; i < 1000; i++) {
+				const string key = to_string(t) + ":" + to_string(i);
+				cache.put(key, i);
+				cache.get(key);
+			}
+		});
+	}
+	for (auto& worker : workers) worker.join();
+
+	// Each shard holds at most its share, 16 here
+	EXPECT_LE(cache.size(), 64u);
+	EXPECT_EQ(cache.stats().insertions, 4000u);
+	EXPECT_EQ(cache.stats().hits + cache.stats().misses, 4000u);
+
+	EXPECT_EQ(cache.getOrCompute(string_view("computed"), [](string_view) { return 7; }), 7);
+	EXPECT_EQ(cache.get("computed"), 7);
+}
+
+TEST(CachingTest, TimingWheelFiresEveryTimerOnItsTick) {
+
+	timingWheel wheel;
+	vector<testTimer> timers(2000);
+
+	// Expiries across every level and past the wheel's 2^24 tick range, a tenth cancelled again
+	uint32_t state = 0x9E3779B1;
+	for (size_t i = 0; i < timers.size(); i++) {
+		state = state * 1664525u + 1013904223u;
+		const uint64_t expiry = 1 + (uint64_t{ state } >> (state % 24));
+		wheel.schedule(&timers[i], expiry);
+		if (i % 10 == 0) wheel.cancel(&timers[i]);
+	}
+
+	// Uneven jumps, from single ticks to idle stretches longer than a whole level
+	uint64_t tick = 0;
+	size_t fired = 0;
+	while (fired < timers.size() - timers.size() / 10) {
+		state = state * 1664525u + 1013904223u;
+		const uint64_t from = tick;
+		tick += (state % 4 == 0) ? (state >> 8) : (state % 64);
+
+		while (timerNode* n = wheel.popExpired(tick)) {
+			static_cast<testTimer*>(n)->firedFrom = from;
+			static_cast<testTimer*>(n)->firedAt = tick;
+			fired++;
+		}
+		ASSERT_LT(tick, uint64_t{ 1 } << 34);
+	}
+
+	// Each timer fired on the first advance that reached its expiry, never earlier or later
+	for (size_t i = 0; i < timers.size(); i++) {
+		if (i % 10 == 0) {
+			EXPECT_EQ(timers[i].firedAt, 0u);
+			continue;
+		}
+		EXPECT_GT(timers[i].expiry, timers[i].firedFrom);
+		EXPECT_LE(timers[i].expiry, timers[i].firedAt);
+	}
+}
+
+TEST(CachingTest, TimingWheelSkipsIdleTime) {
+
+	timingWheel wheel;
+	testTimer soon, later;
+	wheel.schedule(&soon, 10);
+	wheel.schedule(&later, 3600000);
+
+	EXPECT_EQ(wheel.popExpired(10), &soon);
+	EXPECT_EQ(wheel.popExpired(3599999), nullptr);
+	EXPECT_EQ(wheel.now(), 3599999u);
+	EXPECT_EQ(wheel.popExpired(3600000), &later);
+	EXPECT_EQ(wheel.popExpired(3600000), nullptr);
+}
+
+TEST(CachingTest, EntriesExpireAfterTheirTimeToLive) {
+
+	manualCache cache(optionsFor(cachePolicy::LRU, 16));
+	cache.put(1, 10, milliseconds(10));
+	cache.put(2, 20);
+
+	manualClock::advance(milliseconds(9));
+	ASSERT_NE(cache.get(1), nullptr);
+
+	manualClock::advance(milliseconds(2));
+	EXPECT_EQ(cache.get(1), nullptr);
+	EXPECT_NE(cache.get(2), nullptr);
+	EXPECT_EQ(cache.stats().expirations, 1u);
+
+	// An hour idle with a timer still pending
+	cache.put(3, 30, hours(2));
+	manualClock::advance(hours(1));
+	EXPECT_NE(cache.get(3), nullptr);
+	manualClock::advance(hours(1));
+	cache.expire();
+	EXPECT_EQ(cache.entries(), 1u);
+}
+
+TEST(CachingTest, ReplacingAnEntryReschedulesIt) {
+
+	manualCache cache(optionsFor(cachePolicy::WINDOW_TINY_LFU, 16));
+	cache.put(1, 10, milliseconds(10));
+
+	manualClock::advance(milliseconds(8));
+	cache.put(1, 11, milliseconds(10));
+
+	manualClock::advance(milliseconds(8));
+	ASSERT_NE(cache.get(1), nullptr);
+	EXPECT_EQ(*cache.get(1), 11);
+
+	manualClock::advance(milliseconds(3));
+	EXPECT_EQ(cache.get(1), nullptr);
+	EXPECT_EQ(cache.stats().expirations, 1u);
+}
+
+TEST(CachingTest, NoTimeToLiveOrEraseCancelsTheTimer) {
+
+	manualCache cache(optionsFor(cachePolicy::LRU, 16));
+	cache.put(1, 10, milliseconds(5));
+	cache.put(2, 20, milliseconds(5));
+
+	// A ttl of 0 means never, erasing takes the timer out along with the entry
+	cache.put(1, 11, nanoseconds(0));
+	EXPECT_TRUE(cache.erase(2));
+
+	manualClock::advance(seconds(1));
+	cache.expire();
+
+	ASSERT_NE(cache.get(1), nullptr);
+	EXPECT_EQ(cache.stats().expirations, 0u);
+	EXPECT_EQ(cache.entries(), 1u);
+}
+
+TEST(CachingTest, TinyLfuKeepsHotEntriesThroughAScan) {
+
+	auto hotHitsAfterScan = [](cachePolicy policy) {
+		manualCache cache(optionsFor(policy, 100));
+
+		// 80 hot keys, each seen often
+		for (int round = 0; round < 20; round++) {
+			for (int key = 0; key < 80; key++) {
+				if (!cache.get(key)) cache.put(key, key);
+			}
+		}
+
+		// A one-off scan ten times the capacity
+		for (int key = 1000; key < 2000; key++) {
+			if (!cache.get(key)) cache.put(key, key);
+		}
+
+		int hits = 0;
+		for (int key = 0; key < 80; key++) hits += cache.get(key) ? 1 : 0;
+		return hits;
+	};
+
+	EXPECT_GE(hotHitsAfterScan(cachePolicy::WINDOW_TINY_LFU), 75);
+	EXPECT_EQ(hotHitsAfterScan(cachePolicy::LRU), 0);
+}
+
+TEST(CachingTest, EvaluatePoliciesReportsEveryPolicy) {
+
+	// The same keys over and over fit in any policy, so both hit on everything after the first pass
+	vector<uint64_t> trace;
+	for (int round = 0; round < 10; round++) {
+		for (uint64_t key = 0; key < 50; key++) trace.push_back(key);
+	}
+
+	const auto results = evaluatePolicies(trace, 100);
+	ASSERT_EQ(results.size(), 2u);
+	EXPECT_EQ(results[0].policy, cachePolicy::LRU);
+	EXPECT_EQ(results[1].policy, cachePolicy::WINDOW_TINY_LFU);
+	for (const auto& result : results) {
+		EXPECT_EQ(result.stats.misses, 50u);
+		EXPECT_EQ(result.stats.hits, 450u);
+	}
+}
\ No newline at end of file
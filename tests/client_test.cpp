@@ -0,0 +1,327 @@
+//===================================================================================================================================
+// @file	client_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for httpClient's pooling, pipelining and response framing against an in-process loopback server.
+//
+// @note    The server is deliberately simple, a blocking thread per connection answering pipelined requests in
+//			order. What it answers depends on the path, see loopbackServer::respond.
+//===================================================================================================================================
+
+#include "client/utkclient.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Client;
+
+namespace {
+
+	/**
+	 * @brief HTTP/1.1 server on 127.0.0.1 and an ephemeral port
+	 *
+	 * @note Paths:
+	 *			/item/<n>		"item <n>" with Content-Length
+	 *			/chunked/<n>	"item <n>" split into one chunk per byte, each sent by its own write
+	 *			/close/<n>		"item <n>" then closes the connection, dropping anything pipelined behind it
+	 *			/echo			The request body
+	 *		 HEAD gets the GET headers, Content-Length included, and no body.
+	 */
+	class loopbackServer {
+	private:
+		int _listener = -1;
+		uint16_t _port = 0;
+		thread _acceptor;
+
+		mutex _mutex;
+		vector<int> _connections;
+		vector<thread> _handlers;
+		atomic<size_t> _accepted{ 0 };
+
+		static bool sendAll(int fd, string_view bytes) {
+			while (!bytes.empty()) {
+				const ssize_t sent = ::send(fd, bytes.data(), bytes.size(), MSG_NOSIGNAL);
+				if (sent <= 0) return false;
+				bytes.remove_prefix(static_cast<size_t>(sent));
+			}
+			return true;
+		}
+
+		static string_view headerValue(string_view head, string_view name) {
+			for (size_t at = head.find("\r\n"); at != string_view::npos && at + 2 < head.size(); at = head.find("\r\n", at + 2)) {
+				const string_view line = head.substr(at + 2, head.find("\r\n", at + 2) - at - 2);
+				const size_t colon = line.find(':');
+				if (colon != name.size() || !equal(name.begin(), name.end(), line.begin(), [](char a, char b) { return tolower(a) == tolower(b); })) continue;
+
+				string_view value = line.substr(colon + 1);
+				while (!value.empty() && value.front() == ' ') value.remove_prefix(1);
+				return value;
+			}
+			return {};
+		}
+
+		/// Writes the response to one request, false once the connection should close
+		static bool respond(int fd, string_view method, string_view target, string_view body) {
+
+			const bool head = method == "HEAD";
+			const size_t slash = target.rfind('/');
+			const string content = (target == "/echo") ? string(body) : "item " + string(target.substr(slash + 1));
+
+			if (target.starts_with("/chunked/")) {
+				if (!sendAll(fd, "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n")) return false;
+				if (head) return true;
+
+				for (char c : content) {
+					if (!sendAll(fd, "1\r\n" + string(1, c) + "\r\n")) return false;
+				}
+				return sendAll(fd, "0\r\nX-Trailer: done\r\n\r\n");
+			}
+
+			const bool closing = target.starts_with("/close/");
+			string reply = "HTTP/1.1 200 OK\r\nContent-Length: " + to_string(content.size()) + "\r\n";
+			if (closing) reply += "Connection: close\r\n";
+			reply += "\r\n";
+			if (!head) reply += content;
+
+			return sendAll(fd, reply) && !closing;
+		}
+
+		/// Answers requests in the order they arrive until the client closes or a response asks to
+		void serve(int fd) {
+
+			string buffer;
+			char chunk[16384];
+
+			for (;;) {
+				const size_t headEnd = buffer.find("\r\n\r\n");
+				if (headEnd == string::npos) {
+					const ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+					if (received <= 0) break;
+					buffer.append(chunk, static_cast<size_t>(received));
+					continue;
+				}
+
+				size_t length = 0;
+				const string_view declared = headerValue(string_view(buffer.data(), headEnd + 2), "Content-Length");
+				from_chars(declared.data(), declared.data() + declared.size(), length);
+
+				// Reading the body may move the buffer, so the request line is only looked at afterwards
+				while (buffer.size() < headEnd + 4 + length) {
+					const ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+					if (received <= 0) return;
+					buffer.append(chunk, static_cast<size_t>(received));
+				}
+
+				const string_view line = string_view(buffer).substr(0, buffer.find("\r\n"));
+				const size_t space = line.find(' ');
+				const string_view method = line.substr(0, space);
+				const string_view target = line.substr(space + 1, line.rfind(' ') - space - 1);
+
+				if (!respond(fd, method, target, string_view(buffer).substr(headEnd + 4, length))) break;
+				buffer.erase(0, headEnd + 4 + length);
+			}
+
+			::shutdown(fd, SHUT_RDWR);
+		}
+
+	public:
+		loopbackServer() {
+			_listener = ::socket(AF_INET, SOCK_STREAM, 0);
+			if (_listener < 0) throw runtime_error("socket failed");
+
+			sockaddr_in address{};
+			address.sin_family = AF_INET;
+			address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			socklen_t size = sizeof(address);
+
+			if (::bind(_listener, reinterpret_cast<sockaddr*>(&address), size) != 0 || ::listen(_listener, 128) != 0
+				|| ::getsockname(_listener, reinterpret_cast<sockaddr*>(&address), &size) != 0)
+			{
+				throw runtime_error("cannot listen on loopback");
+			}
+			_port = ntohs(address.sin_port);
+
+			_acceptor = thread([this] {
+				for (int fd; (fd = ::accept(_listener, nullptr, nullptr)) >= 0;) {
+					int on = 1;
+					::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+					_accepted++;
+
+					lock_guard<mutex> lock(_mutex);
+					_connections.push_back(fd);
+					_handlers.emplace_back([this, fd] { serve(fd); });
+				}
+			});
+		}
+
+		~loopbackServer() {
+			::shutdown(_listener, SHUT_RDWR);
+			_acceptor.join();
+			::close(_listener);
+
+			lock_guard<mutex> lock(_mutex);
+			for (int fd : _connections) ::shutdown(fd, SHUT_RDWR);
+			for (auto& handler : _handlers) handler.join();
+			for (int fd : _connections) ::close(fd);
+		}
+
+		string url(string_view path) const {
+			return "http://127.0.0.1:" + to_string(_port) + string(path);
+		}
+
+		size_t accepted() const { return _accepted; }
+	};
+
+	request requestFor(string method, string url, string body = {}) {
+		request req;
+		req.method = move(method);
+		req.url = move(url);
+		req.body = move(body);
+		return req;
+	}
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(ClientTest, ThousandsOfPipelinedGets) {
+
+	constexpr int count = 2000;
+	loopbackServer server;
+	httpClient client;
+
+	vector<request> requests;
+	for (int i = 0; i < count; i++) requests.push_back(requestFor("GET", server.url("/item/" + to_string(i))));
+
+	auto futures = client.fetchAll(move(requests));
+	ASSERT_EQ(futures.size(), static_cast<size_t>(count));
+
+	for (int i = 0; i < count; i++) {
+		const response reply = futures[static_cast<size_t>(i)].get();
+		ASSERT_EQ(reply.status(), 200);
+		ASSERT_EQ(reply.body(), "item " + to_string(i));
+	}
+
+	const clientStats stats = client.stats();
+	EXPECT_EQ(stats.responsesReceived, static_cast<uint64_t>(count));
+	EXPECT_EQ(stats.failures, 0u);
+	EXPECT_GT(stats.maxInFlight, 1u);
+	EXPECT_LE(stats.connectionsOpened, clientOptions{}.maxConnectionsPerHost);
+	EXPECT_EQ(server.accepted(), stats.connectionsOpened);
+}
+
+TEST(ClientTest, ChunkedBodiesAreReassembled) {
+
+	loopbackServer server;
+	httpClient client;
+
+	vector<request> requests;
+	for (int i = 0; i < 200; i++) {
+		// Interleaved with plain responses on the same pipelines, so each framing must end exactly where it should
+		requests.push_back(requestFor("GET", server.url("/chunked/" + to_string(i * 7919))));
+		requests.push_back(requestFor("GET", server.url("/item/" + to_string(i))));
+	}
+
+	auto futures = client.fetchAll(move(requests));
+	for (int i = 0; i < 200; i++) {
+		const response chunked = futures[static_cast<size_t>(i) * 2].get();
+		const response plain = futures[static_cast<size_t>(i) * 2 + 1].get();
+
+		EXPECT_EQ(chunked.body(), "item " + to_string(i * 7919));
+		EXPECT_EQ(plain.body(), "item " + to_string(i));
+	}
+	EXPECT_EQ(client.stats().failures, 0u);
+}
+
+TEST(ClientTest, ConnectionCloseInsidePipelines) {
+
+	constexpr int count = 600;
+	loopbackServer server;
+	httpClient client;
+
+	// Every tenth response closes its connection, whatever was pipelined behind it has to be resent elsewhere
+	vector<request> requests;
+	for (int i = 0; i < count; i++) {
+		const string path = (i % 10 == 5) ? "/close/" : "/item/";
+		requests.push_back(requestFor("GET", server.url(path + to_string(i))));
+	}
+
+	auto futures = client.fetchAll(move(requests));
+	for (int i = 0; i < count; i++) {
+		const response reply = futures[static_cast<size_t>(i)].get();
+		ASSERT_EQ(reply.body(), "item " + to_string(i));
+	}
+
+	const clientStats stats = client.stats();
+	EXPECT_EQ(stats.failures, 0u);
+	EXPECT_GE(stats.connectionsOpened, static_cast<uint64_t>(count / 10));
+}
+
+TEST(ClientTest, HeadResponsesHaveNoBody) {
+
+	loopbackServer server;
+	httpClient client;
+
+	vector<request> requests;
+	for (int i = 0; i < 100; i++) {
+		requests.push_back(requestFor("HEAD", server.url("/item/" + to_string(i))));
+		requests.push_back(requestFor("GET", server.url("/item/" + to_string(i))));
+	}
+	requests.push_back(requestFor("HEAD", server.url("/chunked/1")));
+	requests.push_back(requestFor("GET", server.url("/item/last")));
+
+	auto futures = client.fetchAll(move(requests));
+	for (int i = 0; i < 100; i++) {
+		const response head = futures[static_cast<size_t>(i) * 2].get();
+		const response get = futures[static_cast<size_t>(i) * 2 + 1].get();
+
+		// The declared length describes the GET body, the HEAD response must not wait for it
+		EXPECT_EQ(head.status(), 200);
+		EXPECT_TRUE(head.body().empty());
+		EXPECT_EQ(head.header("content-length"), to_string(get.body().size()));
+		EXPECT_EQ(get.body(), "item " + to_string(i));
+	}
+
+	EXPECT_TRUE(futures[200].get().body().empty());
+	EXPECT_EQ(futures[201].get().body(), "item last");
+}
+
+TEST(ClientTest, PostBodiesAreSentAndEchoed) {
+
+	loopbackServer server;
+	httpClient client;
+
+	const vector<string> bodies = { "", "x", string(100000, 'p'), "{\"key\":\"value\"}" };
+
+	// POST mixed with pipelined GETs, it waits for a connection of its own rather than joining a pipeline
+	vector<request> requests;
+	for (const string& body : bodies) {
+		requests.push_back(requestFor("POST", server.url("/echo"), body));
+		requests.push_back(requestFor("GET", server.url("/item/0")));
+	}
+
+	auto futures = client.fetchAll(move(requests));
+	for (size_t i = 0; i < bodies.size(); i++) {
+		EXPECT_EQ(futures[i * 2].get().body(), bodies[i]);
+		EXPECT_EQ(futures[i * 2 + 1].get().body(), "item 0");
+	}
+
+	const response single = client.fetch(requestFor("POST", server.url("/echo"), "once")).get();
+	EXPECT_EQ(single.body(), "once");
+	EXPECT_EQ(client.stats().failures, 0u);
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+//===================================================================================================================================
+// @file	collector_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for collecting entries from many processes on the same machine through shared-memory rings.
+//
+// @note    Publishers are forked children, the collector runs in the test process and writes what it
+//          gathers to an ARCHIVE sink that is read back afterwards.
+//===================================================================================================================================
+
+#include "dispatchers/utkdispatch.hpp"
+#include "dispatchers/utkarchive.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <map>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+using namespace UTK::Types::LogEntry;
+
+namespace {
+
+	filesystem::path scratchDirectory(const string& name) {
+		auto path = filesystem::temp_directory_path() / ("utk_" + name + "_" + to_string(getpid()));
+		filesystem::remove_all(path);
+		filesystem::create_directories(path);
+		return path;
+	}
+
+	/// Polls the collector until condition holds or timeout passes
+	template<typename Condition>
+	bool pollUntil(logCollector& collector, Condition condition, milliseconds timeout = seconds(10)) {
+		const auto deadline = steady_clock::now() + timeout;
+		while (!condition()) {
+			if (steady_clock::now() > deadline) return false;
+			collector.poll(5);
+		}
+		return true;
+	}
+
+	/// Registers, publishes its entries, then waits for the go byte before exiting so the ring is attached first
+	[[noreturn]] void publisherChild(const string& socketPath, int go, int process, int count) {
+
+		int status = 1;
+		try {
+			collectorClient client(socketPath, static_cast<uint32_t>(count));
+			for (int i = 0; i < count; i++) {
+				client.publish(makeLogEntry(Logger::ARCHIVE, Operations::LG_WR, { "process", "index" },
+					{ to_string(process), to_string(i) }, "collector_test.cpp", 1, "publisherChild"));
+			}
+
+			char byte;
+			status = (::read(go, &byte, 1) == 1 && client.dropped() == 0) ? 0 : 2;
+		}
+		catch (...) {}
+
+		_exit(status);
+	}
+
+	/// Connects to the collector and registers name as if it were this process's ring
+	void registerName(const string& socketPath, const string& name) {
+
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		socketPath.copy(address.sun_path, sizeof(address.sun_path) - 1);
+
+		int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) _exit(1);
+
+		const string line = name + "\n";
+		_exit(send(fd, line.data(), line.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(line.size()) ? 0 : 1);
+	}
+
+	bool sharedObjectExists(const string& name) {
+		int fd = shm_open(name.c_str(), O_RDONLY, 0);
+		if (fd >= 0) close(fd);
+		return fd >= 0;
+	}
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(CollectorTest, MergesEveryProcessInPublishOrder) {
+
+	constexpr int processes = 4;
+	constexpr int count = 2000;
+
+	const auto directory = scratchDirectory("collector");
+	const string socketPath = (directory / "collector.sock").string();
+	const string archivePath = (directory / "collected.archive").string();
+
+	int go[2];
+	ASSERT_EQ(pipe(go), 0);
+
+	vector<pid_t> children;
+	{
+		logDispatcher dispatcher(4096, Backpressure::BLOCK);
+		dispatcher.enableArchive(archivePath);
+		{
+			logCollector collector(socketPath, dispatcher, 20);
+
+			for (int process = 0; process < processes; process++) {
+				pid_t child = fork();
+				if (child == 0) publisherChild(socketPath, go[0], process, count);
+				children.push_back(child);
+			}
+
+			EXPECT_TRUE(pollUntil(collector, [&] { return collector.ringCount() == processes; }));
+
+			char bytes[processes] = {};
+			EXPECT_EQ(::write(go[1], bytes, sizeof(bytes)), static_cast<ssize_t>(sizeof(bytes)));
+
+			for (pid_t child : children) {
+				int status = 0;
+				waitpid(child, &status, 0);
+				EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+			}
+
+			EXPECT_TRUE(pollUntil(collector, [&] { return collector.ringCount() == 0; }));
+		}
+		dispatcher.flush();
+	}
+	close(go[0]);
+	close(go[1]);
+
+	// Nothing lost, and every process's entries come out in the order it published them
+	archiveReader reader(archivePath);
+	map<string, vector<int>> indices;
+	archivedEntry archived;
+	while (reader.next(archived)) {
+		ASSERT_EQ(archived.entry.formatValues.size(), 2u);
+		indices[archived.entry.formatValues[0]].push_back(stoi(archived.entry.formatValues[1]));
+	}
+
+	ASSERT_EQ(indices.size(), static_cast<size_t>(processes));
+	for (const auto& [process, published] : indices) {
+		ASSERT_EQ(published.size(), static_cast<size_t>(count)) << "process " << process;
+		EXPECT_TRUE(is_sorted(published.begin(), published.end())) << "process " << process;
+	}
+
+	filesystem::remove_all(directory);
+}
+
+TEST(CollectorTest, OnlyUnlinksRingsItsClientsOwn) {
+
+	const auto directory = scratchDirectory("collector_names");
+	const string socketPath = (directory / "collector.sock").string();
+
+	// A ring named like a client's, but for a pid other than the process registering it
+	auto victim = sharedRing::create("/utk." + to_string(getpid()) + ".4000000000", 16);
+	const string foreign = "/utktest.foreign." + to_string(getpid());
+	int fd = shm_open(foreign.c_str(), O_RDWR | O_CREAT, 0600);
+	ASSERT_GE(fd, 0);
+	close(fd);
+
+	logDispatcher dispatcher;
+	{
+		logCollector collector(socketPath, dispatcher);
+
+		for (const string& name : { victim->name(), foreign }) {
+			pid_t child = fork();
+			if (child == 0) registerName(socketPath, name);
+
+			int status = 0;
+			waitpid(child, &status, 0);
+			EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+			// The registration is refused, and the disconnect that follows unlinks nothing
+			for (int i = 0; i < 10; i++) collector.poll(5);
+			EXPECT_EQ(collector.ringCount(), 0u);
+		}
+	}
+
+	EXPECT_TRUE(sharedObjectExists(victim->name()));
+	EXPECT_TRUE(sharedObjectExists(foreign));
+
+	shm_unlink(foreign.c_str());
+	filesystem::remove_all(directory);
+}
\ No newline at end of file
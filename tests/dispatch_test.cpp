@@ -0,0 +1,498 @@
+//===================================================================================================================================
+// @file	dispatch_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for logDispatcher's per-sink queues, backpressure and routing rules.
+//
+// @note    The TERMINAL sink is stalled by pointing stdout at a pipe nobody reads until the test says so.
+//===================================================================================================================================
+
+#include "dispatchers/utkdispatch.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <algorithm>
+#include <optional>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <unistd.h>
+#include <fcntl.h>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+using namespace UTK::Types::LogEntry;
+
+namespace {
+
+	/// Points stdout at a pipe, so the terminal sink stalls once the pipe is full and nothing drains it
+	class stdoutPipe {
+	private:
+		int _read = -1;
+		int _write = -1;
+		int _saved = -1;
+		thread _reader;
+		atomic<size_t> _lines{ 0 };
+
+	public:
+		stdoutPipe() {
+			int fds[2];
+			if (pipe(fds) != 0) throw runtime_error("pipe failed");
+			_read = fds[0];
+			_write = fds[1];
+
+			fflush(stdout);
+			_saved = dup(STDOUT_FILENO);
+			dup2(_write, STDOUT_FILENO);
+		}
+
+		~stdoutPipe() {
+			restore();
+			if (_reader.joinable()) _reader.join();
+			close(_read);
+		}
+
+		/// Makes writes to the pipe fail with EAGAIN instead of waiting once it is full
+		void nonBlocking() {
+			fcntl(_write, F_SETFL, fcntl(_write, F_GETFL) | O_NONBLOCK);
+		}
+
+		/// Starts reading the pipe, letting the terminal sink make progress again
+		void drain() {
+			_reader = thread([this] {
+				char buffer[4096];
+				for (ssize_t received; (received = ::read(_read, buffer, sizeof(buffer))) > 0;) {
+					_lines += static_cast<size_t>(count(buffer, buffer + received, '\n'));
+				}
+			});
+		}
+
+		/// Puts stdout back, the reader sees the end of the pipe once everything written so far is read
+		void restore() {
+			if (_saved < 0) return;
+
+			dup2(_saved, STDOUT_FILENO);
+			close(_saved);
+			close(_write);
+			_saved = -1;
+		}
+
+		/// Lines read so far, final once restore() has been called and the reader joined
+		size_t lines() {
+			if (_saved < 0 && _reader.joinable()) _reader.join();
+			return _lines;
+		}
+	};
+
+	filesystem::path scratchDirectory(const string& name) {
+		auto path = filesystem::temp_directory_path() / ("utk_" + name + "_" + to_string(getpid()));
+		filesystem::remove_all(path);
+		filesystem::create_directories(path);
+		return path;
+	}
+
+	optional<sinkStats> statsFor(const logDispatcher& dispatcher, Logger lg) {
+		for (const auto& stats : dispatcher.getSinkStats()) {
+			if (stats.lg == lg) return stats;
+		}
+		return nullopt;
+	}
+
+	/// Polls until condition holds or timeout passes
+	template<typename Condition>
+	bool eventually(Condition condition, milliseconds timeout = seconds(10)) {
+		const auto deadline = steady_clock::now() + timeout;
+		while (!condition()) {
+			if (steady_clock::now() > deadline) return false;
+			this_thread::sleep_for(milliseconds(1));
+		}
+		return true;
+	}
+
+	logEntry entryFor(Logger lg, int index) {
+		return makeLogEntry(lg, Operations::LG_WR, { "index", "padding" }, { to_string(index), string(64, 'x') }, "dispatch_test.cpp", 1, "test");
+	}
+
+	/// Entries each sink has taken once everything pushed so far is dispatched, indexed by Logger
+	array<uint64_t, loggerCount> routedCounts(logDispatcher& dispatcher) {
+		dispatcher.dispatchLogs();
+		dispatcher.flush();
+
+		array<uint64_t, loggerCount> counts{};
+		for (const auto& stats : dispatcher.getSinkStats()) counts[static_cast<size_t>(stats.lg)] = stats.enqueued;
+		return counts;
+	}
+
+	/// JSON and CSV entries that routing rules are matched against, JSON is the producer's choice
+	logEntry routedEntry(Operations op, vector<string> keys = { "index" }, vector<string> values = { "0" },
+		const string& file = "src/service/handler.cpp") {
+		return makeLogEntry(Logger::JSON, op, move(keys), move(values), file, 1, "test");
+	}
+
+	routeRule ruleFor(sinkMask sinks, vector<Operations> ops = {}, string key = {}, optional<string> value = nullopt, string file = {}) {
+		routeRule rule;
+		rule.ops = move(ops);
+		rule.key = move(key);
+		rule.value = move(value);
+		rule.file = move(file);
+		rule.sinks = sinks;
+		return rule;
+	}
+
+	/// Dispatcher whose ARCHIVE sink writes into a scratch directory rather than the working directory
+	struct routedDispatcher {
+		filesystem::path directory;
+		logDispatcher dispatcher;
+
+		explicit routedDispatcher(const string& name, Backpressure policy = Backpressure::BLOCK)
+			: directory(scratchDirectory(name)), dispatcher(4096, policy)
+		{
+			dispatcher.enableArchive((directory / "routed.archive").string());
+		}
+		~routedDispatcher() {
+			filesystem::remove_all(directory);
+		}
+	};
+
+	constexpr size_t terminalSink = static_cast<size_t>(Logger::TERMINAL);
+	constexpr size_t jsonSink = static_cast<size_t>(Logger::JSON);
+	constexpr size_t csvSink = static_cast<size_t>(Logger::CSV);
+	constexpr size_t archiveSink = static_cast<size_t>(Logger::ARCHIVE);
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(DispatchTest, StalledSinkDoesNotHoldBackOtherSinks) {
+
+	constexpr int count = 5000;
+	constexpr size_t capacity = 64;
+	const auto directory = scratchDirectory("stalled");
+
+	stdoutPipe terminal;
+	{
+		logDispatcher dispatcher(capacity, Backpressure::BLOCK);
+		dispatcher.enableArchive((directory / "stalled.archive").string());
+
+		for (int i = 0; i < count; i++) {
+			dispatcher.pushEntry(entryFor(Logger::TERMINAL, i));
+			dispatcher.pushEntry(entryFor(Logger::ARCHIVE, i));
+		}
+
+		atomic<bool> dispatched{ false };
+		thread producer([&] {
+			dispatcher.dispatchLogs();
+			dispatched = true;
+		});
+
+		// The archive sink takes all of its entries while the terminal sink is stuck on a full pipe,
+		// and the stats stay readable throughout
+		EXPECT_TRUE(eventually([&] {
+			auto archive = statsFor(dispatcher, Logger::ARCHIVE);
+			return archive && archive->written == count;
+		}));
+
+		// No ASSERTs until the producer is joined, returning early would destroy a joinable thread
+		const sinkStats stalled = statsFor(dispatcher, Logger::TERMINAL).value_or(sinkStats{ Logger::TERMINAL });
+		EXPECT_LT(stalled.written, static_cast<uint64_t>(count));
+		EXPECT_LE(stalled.depth, capacity);
+		EXPECT_FALSE(dispatched);
+
+		terminal.drain();
+		producer.join();
+		dispatcher.flush();
+
+		auto finished = statsFor(dispatcher, Logger::TERMINAL);
+		ASSERT_TRUE(finished.has_value());
+		EXPECT_EQ(finished->written, static_cast<uint64_t>(count));
+		EXPECT_EQ(finished->dropped, 0u);
+		EXPECT_LE(finished->highWater, capacity);
+	}
+	terminal.restore();
+
+	EXPECT_EQ(terminal.lines(), static_cast<size_t>(count));
+	filesystem::remove_all(directory);
+}
+
+TEST(DispatchTest, DropPolicyDropsOnlyWhatDoesNotFit) {
+
+	constexpr int count = 2000;
+	constexpr size_t capacity = 16;
+
+	stdoutPipe terminal;
+	{
+		logDispatcher dispatcher(capacity, Backpressure::DROP);
+		for (int i = 0; i < count; i++) {
+			dispatcher.pushEntry(entryFor(Logger::TERMINAL, i));
+		}
+		dispatcher.dispatchLogs();
+
+		auto stalled = statsFor(dispatcher, Logger::TERMINAL);
+		ASSERT_TRUE(stalled.has_value());
+		EXPECT_EQ(stalled->enqueued + stalled->dropped, static_cast<uint64_t>(count));
+		EXPECT_LE(stalled->depth, capacity);
+
+		terminal.drain();
+		dispatcher.flush();
+
+		auto finished = statsFor(dispatcher, Logger::TERMINAL);
+		EXPECT_EQ(finished->written, finished->enqueued);
+	}
+	terminal.restore();
+}
+
+TEST(DispatchTest, NonBlockingStdoutLosesNothing) {
+
+	constexpr int count = 3000;
+
+	stdoutPipe terminal;
+	terminal.nonBlocking();
+	{
+		logDispatcher dispatcher;
+		for (int i = 0; i < count; i++) {
+			dispatcher.pushEntry(entryFor(Logger::TERMINAL, i));
+		}
+		dispatcher.dispatchLogs();
+
+		// The pipe fills long before every entry is written, the sink waits for room rather than dropping the batch
+		this_thread::sleep_for(milliseconds(50));
+		terminal.drain();
+		dispatcher.flush();
+
+		auto finished = statsFor(dispatcher, Logger::TERMINAL);
+		ASSERT_TRUE(finished.has_value());
+		EXPECT_EQ(finished->written, static_cast<uint64_t>(count));
+	}
+	terminal.restore();
+
+	EXPECT_EQ(terminal.lines(), static_cast<size_t>(count));
+}
+
+TEST(DispatchTest, ResizingABlockedSinkReleasesTheDispatch) {
+
+	constexpr int count = 5000;
+	constexpr size_t capacity = 16;
+
+	stdoutPipe terminal;
+	{
+		logDispatcher dispatcher(capacity, Backpressure::BLOCK);
+		for (int i = 0; i < count; i++) {
+			dispatcher.pushEntry(entryFor(Logger::TERMINAL, i));
+		}
+
+		atomic<bool> dispatched{ false };
+		thread producer([&] {
+			dispatcher.dispatchLogs();
+			dispatched = true;
+		});
+
+		// Wait until the dispatch is stuck on the full sink, then make room for everything while it still is
+		EXPECT_TRUE(eventually([&] {
+			auto stalled = statsFor(dispatcher, Logger::TERMINAL);
+			return stalled && stalled->depth == capacity;
+		}));
+		EXPECT_FALSE(dispatched);
+
+		dispatcher.configureSink(Logger::TERMINAL, count, Backpressure::BLOCK);
+
+		// Nothing reads the pipe yet, so only the new capacity can let the dispatch finish
+		EXPECT_TRUE(eventually([&] { return dispatched.load(); }));
+
+		terminal.drain();
+		producer.join();
+		dispatcher.flush();
+
+		auto finished = statsFor(dispatcher, Logger::TERMINAL);
+		ASSERT_TRUE(finished.has_value());
+		EXPECT_EQ(finished->written, static_cast<uint64_t>(count));
+		EXPECT_EQ(finished->dropped, 0u);
+		EXPECT_GT(finished->highWater, capacity);
+	}
+	terminal.restore();
+
+	EXPECT_EQ(terminal.lines(), static_cast<size_t>(count));
+}
+
+TEST(DispatchTest, SwitchingABlockedSinkToDropReleasesTheDispatch) {
+
+	constexpr int count = 5000;
+	constexpr size_t capacity = 16;
+
+	stdoutPipe terminal;
+	{
+		logDispatcher dispatcher(capacity, Backpressure::BLOCK);
+		for (int i = 0; i < count; i++) {
+			dispatcher.pushEntry(entryFor(Logger::TERMINAL, i));
+		}
+
+		atomic<bool> dispatched{ false };
+		thread producer([&] {
+			dispatcher.dispatchLogs();
+			dispatched = true;
+		});
+
+		EXPECT_TRUE(eventually([&] {
+			auto stalled = statsFor(dispatcher, Logger::TERMINAL);
+			return stalled && stalled->depth == capacity;
+		}));
+
+		// Same capacity, so the dispatch can only finish by dropping what does not fit
+		dispatcher.configureSink(Logger::TERMINAL, capacity, Backpressure::DROP);
+		EXPECT_TRUE(eventually([&] { return dispatched.load(); }));
+
+		terminal.drain();
+		producer.join();
+		dispatcher.flush();
+
+		auto finished = statsFor(dispatcher, Logger::TERMINAL);
+		ASSERT_TRUE(finished.has_value());
+		EXPECT_GT(finished->dropped, 0u);
+		EXPECT_EQ(finished->written + finished->dropped, static_cast<uint64_t>(count));
+	}
+	terminal.restore();
+}
+
+TEST(DispatchTest, OperationRuleFansOutToEverySink) {
+
+	stdoutPipe terminal;
+	terminal.drain();
+	{
+		routedDispatcher routed("route_fanout");
+		logDispatcher& dispatcher = routed.dispatcher;
+		dispatcher.setRoutes({ ruleFor(sinkBit(Logger::TERMINAL) | sinkBit(Logger::CSV) | sinkBit(Logger::ARCHIVE), { Operations::LG_ERR }) });
+
+		for (int i = 0; i < 3; i++) dispatcher.pushEntry(routedEntry(Operations::LG_ERR));
+		for (int i = 0; i < 2; i++) dispatcher.pushEntry(routedEntry(Operations::LG_WR));
+
+		const auto counts = routedCounts(dispatcher);
+		EXPECT_EQ(counts[terminalSink], 3u);
+		EXPECT_EQ(counts[csvSink], 3u);
+		EXPECT_EQ(counts[archiveSink], 3u);
+		EXPECT_EQ(counts[jsonSink], 2u);
+	}
+	terminal.restore();
+	EXPECT_EQ(terminal.lines(), 3u);
+}
+
+TEST(DispatchTest, KeyRulesRouteByPresenceAndValue) {
+
+	routedDispatcher routed("route_keys");
+	logDispatcher& dispatcher = routed.dispatcher;
+	dispatcher.setRoutes({
+		ruleFor(sinkBit(Logger::CSV), {}, "user"),
+		ruleFor(sinkBit(Logger::ARCHIVE), {}, "status", "500")
+	});
+
+	dispatcher.pushEntry(routedEntry(Operations::LG_MSG, { "user" }, { "jac" }));
+	dispatcher.pushEntry(routedEntry(Operations::LG_WR, { "index", "user" }, { "1", "" }));
+	dispatcher.pushEntry(routedEntry(Operations::LG_WR, { "status" }, { "500" }));
+	dispatcher.pushEntry(routedEntry(Operations::LG_WR, { "status" }, { "200" }));
+	dispatcher.pushEntry(routedEntry(Operations::LG_WR, { "users" }, { "2" }));
+
+	// The last entry holds both keys and goes to both sinks
+	dispatcher.pushEntry(routedEntry(Operations::LG_ERR, { "status", "user" }, { "500", "jac" }));
+
+	const auto counts = routedCounts(dispatcher);
+	EXPECT_EQ(counts[csvSink], 3u);
+	EXPECT_EQ(counts[archiveSink], 2u);
+	EXPECT_EQ(counts[jsonSink], 2u);
+}
+
+TEST(DispatchTest, SourceFileRuleMatchesThePathSuffix) {
+
+	routedDispatcher routed("route_file");
+	logDispatcher& dispatcher = routed.dispatcher;
+	dispatcher.setRoutes({ ruleFor(sinkBit(Logger::CSV), {}, {}, nullopt, "network/socket.cpp") });
+
+	dispatcher.pushEntry(routedEntry(Operations::LG_WR, { "index" }, { "0" }, "/build/src/network/socket.cpp"));
+	dispatcher.pushEntry(routedEntry(Operations::LG_WR, { "index" }, { "1" }, "network/socket.cpp"));
+	dispatcher.pushEntry(routedEntry(Operations::LG_WR, { "index" }, { "2" }, "network/socket.cpp.bak"));
+	dispatcher.pushEntry(routedEntry(Operations::LG_WR, { "index" }, { "3" }, "src/socket.cpp"));
+
+	const auto counts = routedCounts(dispatcher);
+	EXPECT_EQ(counts[csvSink], 2u);
+	EXPECT_EQ(counts[jsonSink], 2u);
+}
+
+TEST(DispatchTest, UnmatchedEntriesGoToTheProducersSink) {
+
+	routedDispatcher routed("route_fallback");
+	logDispatcher& dispatcher = routed.dispatcher;
+	dispatcher.setRoutes({ ruleFor(sinkBit(Logger::ARCHIVE), { Operations::LG_ERR }, "fatal") });
+
+	// Wrong operation, or right operation without the key, both fall back to entry.lg
+	dispatcher.pushEntry(routedEntry(Operations::LG_WR, { "fatal" }, { "1" }));
+	dispatcher.pushEntry(routedEntry(Operations::LG_ERR));
+	dispatcher.pushEntry(makeLogEntry(Logger::CSV, Operations::LG_IDL, { "index" }, { "0" }, "dispatch_test.cpp", 1, "test"));
+	dispatcher.pushEntry(routedEntry(Operations::LG_ERR, { "fatal" }, { "1" }));
+
+	EXPECT_TRUE(dispatcher.isEnabled(Logger::JSON, Operations::LG_ERR));
+
+	const auto counts = routedCounts(dispatcher);
+	EXPECT_EQ(counts[jsonSink], 2u);
+	EXPECT_EQ(counts[csvSink], 1u);
+	EXPECT_EQ(counts[archiveSink], 1u);
+}
+
+TEST(DispatchTest, EmptyRoutesRestoreTheDefault) {
+
+	routedDispatcher routed("route_reset");
+	logDispatcher& dispatcher = routed.dispatcher;
+
+	// Every operation to the archive, none of it to the producer's sink
+	dispatcher.setRoutes({ ruleFor(sinkBit(Logger::ARCHIVE)) });
+	dispatcher.pushEntry(routedEntry(Operations::LG_WR));
+	auto counts = routedCounts(dispatcher);
+	EXPECT_EQ(counts[archiveSink], 1u);
+	EXPECT_EQ(counts[jsonSink], 0u);
+
+	dispatcher.setRoutes({});
+	dispatcher.pushEntry(routedEntry(Operations::LG_WR));
+	counts = routedCounts(dispatcher);
+	EXPECT_EQ(counts[archiveSink], 1u);
+	EXPECT_EQ(counts[jsonSink], 1u);
+}
+
+TEST(DispatchTest, ReapplyingRoutesWhileProducersPush) {
+
+	routedDispatcher routed("route_reapply");
+	logDispatcher& dispatcher = routed.dispatcher;
+
+	const vector<routeRule> toCsv{ ruleFor(sinkBit(Logger::CSV)) };
+	const vector<routeRule> toArchive{ ruleFor(sinkBit(Logger::ARCHIVE)) };
+
+	// A settings reload loop, with producers routing through every table as it is replaced
+	constexpr uint64_t perProducer = 5000;
+	atomic<int> running{ 2 };
+	vector<thread> producers;
+	for (int t = 0; t < 2; t++) {
+		producers.emplace_back([&] {
+			for (uint64_t i = 0; i < perProducer; i++) dispatcher.pushEntry(routedEntry(Operations::LG_WR));
+			running--;
+		});
+	}
+
+	uint64_t reapplied = 0;
+	while (running > 0 || reapplied < 1000) {
+		dispatcher.setRoutes((reapplied++ % 2) ? toArchive : toCsv);
+		if (reapplied % 256 == 0) dispatcher.dispatchLogs();
+	}
+	for (auto& producer : producers) producer.join();
+	if (reapplied % 2) dispatcher.setRoutes(toArchive);
+
+	const auto counts = routedCounts(dispatcher);
+	EXPECT_EQ(counts[csvSink] + counts[archiveSink], 2 * perProducer);
+	EXPECT_EQ(counts[jsonSink], 0u);
+
+	// The last table set is the one in force
+	dispatcher.pushEntry(routedEntry(Operations::LG_WR));
+	const auto after = routedCounts(dispatcher);
+	EXPECT_EQ(after[archiveSink], counts[archiveSink] + 1);
+}
\ No newline at end of file
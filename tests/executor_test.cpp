@@ -0,0 +1,226 @@
+//===================================================================================================================================
+// @file	executor_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for taskExecutor's tasks, continuations, parallelFor and the way each passes exceptions on.
+//
+// @note    Most tests use a small pool of their own, so waiting inside workers is tested with more tasks than threads.
+//===================================================================================================================================
+
+#include "dispatchers/utkexecutor.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+using namespace std;
+using namespace UTK::Dispatch;
+
+namespace {
+
+	executorOptions poolOf(size_t workers) {
+		executorOptions options;
+		options.workers = workers;
+		return options;
+	}
+
+	/// Recursive fan out where every task waits on the two it spawns, starves a pool that blocks while waiting
+	uint64_t fibonacci(taskExecutor& executor, uint32_t n) {
+		if (n < 12) return (n < 2) ? n : fibonacci(executor, n - 1) + fibonacci(executor, n - 2);
+
+		auto left = executor.submit([&executor, n] { return fibonacci(executor, n - 1); });
+		auto right = executor.submit([&executor, n] { return fibonacci(executor, n - 2); });
+		return left.get() + right.get();
+	}
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(ExecutorTest, SubmitReturnsResults) {
+
+	taskExecutor executor(poolOf(4));
+
+	auto number = executor.submit([] { return 42; });
+	auto text = executor.submit([] { return string("done"); });
+
+	atomic<bool> ran{ false };
+	auto nothing = executor.submit([&] { ran = true; });
+
+	EXPECT_EQ(number.get(), 42);
+	EXPECT_EQ(text.get(), "done");
+	nothing.get();
+	EXPECT_TRUE(ran);
+	EXPECT_TRUE(nothing.ready());
+}
+
+TEST(ExecutorTest, WaitingInsideWorkersDoesNotStarveThePool) {
+
+	taskExecutor executor(poolOf(2));
+	EXPECT_EQ(fibonacci(executor, 24), 46368u);
+}
+
+TEST(ExecutorTest, SubmittedExceptionsRethrowFromGet) {
+
+	taskExecutor executor(poolOf(2));
+
+	auto failing = executor.submit([]() -> int { throw invalid_argument("bad input"); });
+	EXPECT_THROW(failing.get(), invalid_argument);
+
+	// The pool is unaffected
+	EXPECT_EQ(executor.submit([] { return 7; }).get(), 7);
+}
+
+TEST(ExecutorTest, ParallelForVisitsEveryIndexOnce) {
+
+	taskExecutor executor(poolOf(4));
+
+	for (size_t grain : { size_t{ 0 }, size_t{ 1 }, size_t{ 7 }, size_t{ 1000 }, size_t{ 1 } << 30 }) {
+		constexpr size_t begin = 100, end = 100 + 50000;
+		vector<atomic<int>> visits(end);
+
+		executor.parallelFor(begin, end, [&](size_t i) { visits[i].fetch_add(1, memory_order_relaxed); }, grain);
+
+		for (size_t i = 0; i < end; i++) {
+			ASSERT_EQ(visits[i].load(), (i < begin) ? 0 : 1) << "index " << i << ", grain " << grain;
+		}
+	}
+}
+
+TEST(ExecutorTest, ParallelForOnAnEmptyRangeDoesNothing) {
+
+	taskExecutor executor(poolOf(2));
+	atomic<int> calls{ 0 };
+
+	executor.parallelFor(5, 5, [&](size_t) { calls++; });
+	executor.parallelFor(9, 3, [&](size_t) { calls++; });
+	EXPECT_EQ(calls, 0);
+}
+
+TEST(ExecutorTest, ParallelForRethrowsAndSkipsTheRest) {
+
+	taskExecutor executor(poolOf(4));
+	constexpr size_t count = 1000000;
+	atomic<size_t> calls{ 0 };
+
+	EXPECT_THROW(executor.parallelFor(0, count, [&](size_t i) {
+		calls.fetch_add(1, memory_order_relaxed);
+		if (i == 1000) throw runtime_error("index 1000");
+	}, 100), runtime_error);
+
+	// Ranges already running finish their grain, everything after the failure is seen is skipped
+	EXPECT_LT(calls.load(), count);
+
+	// Every range job has finished by the time parallelFor rethrows, so the pool is free again
+	atomic<size_t> after{ 0 };
+	executor.parallelFor(0, 1000, [&](size_t) { after++; });
+	EXPECT_EQ(after, 1000u);
+}
+
+TEST(ExecutorTest, NestedParallelForFromTasks) {
+
+	taskExecutor executor(poolOf(2));
+	vector<task<size_t>> tasks;
+
+	for (size_t t = 0; t < 8; t++) {
+		tasks.push_back(executor.submit([&executor, t] {
+			atomic<size_t> sum{ 0 };
+			executor.parallelFor(0, 1000, [&](size_t i) { sum.fetch_add(i * t, memory_order_relaxed); }, 10);
+			return sum.load();
+		}));
+	}
+
+	for (size_t t = 0; t < tasks.size(); t++) {
+		EXPECT_EQ(tasks[t].get(), t * 499500);
+	}
+}
+
+TEST(ExecutorTest, ContinuationsChainResults) {
+
+	taskExecutor executor(poolOf(4));
+
+	auto chained = executor.submit([] { return 20; })
+		.then([](int n) { return n + 1; })
+		.then([](int n) { return n * 2; })
+		.then([](int n) { return "answer " + to_string(n); });
+
+	EXPECT_EQ(chained.get(), "answer 42");
+
+	// Void on either side of a continuation
+	atomic<int> stage{ 0 };
+	auto voids = executor.submit([&] { stage = 1; })
+		.then([&] { EXPECT_EQ(stage.load(), 1); stage = 2; return 5; })
+		.then([&](int n) { stage = 2 + n; });
+
+	voids.get();
+	EXPECT_EQ(stage, 7);
+}
+
+TEST(ExecutorTest, ContinuationOnAFinishedTaskStillRuns) {
+
+	taskExecutor executor(poolOf(2));
+
+	auto first = executor.submit([] { return string("early"); });
+	first.wait();
+	ASSERT_TRUE(first.ready());
+
+	EXPECT_EQ(first.then([](string s) { return s + " bird"; }).get(), "early bird");
+}
+
+TEST(ExecutorTest, ManyContinuationsOnOneVoidTask) {
+
+	taskExecutor executor(poolOf(4));
+	atomic<bool> release{ false };
+	atomic<int> runs{ 0 };
+
+	auto gate = executor.submit([&] { while (!release) this_thread::yield(); });
+
+	vector<task<void>> followers;
+	for (int i = 0; i < 100; i++) followers.push_back(gate.then([&] { runs++; }));
+
+	EXPECT_EQ(runs, 0);
+	release = true;
+
+	for (auto& follower : followers) follower.get();
+	EXPECT_EQ(runs, 100);
+}
+
+TEST(ExecutorTest, ExceptionsSkipContinuationsAndPropagate) {
+
+	taskExecutor executor(poolOf(2));
+	atomic<int> skipped{ 0 };
+
+	auto chained = executor.submit([]() -> int { throw out_of_range("first"); })
+		.then([&](int n) { skipped++; return n + 1; })
+		.then([&](int n) { skipped++; return to_string(n); });
+
+	EXPECT_THROW(chained.get(), out_of_range);
+	EXPECT_EQ(skipped, 0);
+
+	// A continuation that throws fails its own task only
+	auto midway = executor.submit([] { return 1; })
+		.then([](int) -> int { throw logic_error("second"); })
+		.then([&](int) { skipped++; });
+
+	EXPECT_THROW(midway.get(), logic_error);
+	EXPECT_EQ(skipped, 0);
+}
+
+TEST(ExecutorTest, DestructionRunsEverythingQueued) {
+
+	atomic<int> runs{ 0 };
+	{
+		taskExecutor executor(poolOf(2));
+
+		for (int i = 0; i < 1000; i++) {
+			executor.submit([&] { runs++; }).then([&] { runs++; });
+		}
+	}
+
+	EXPECT_EQ(runs, 2000);
+}
\ No newline at end of file
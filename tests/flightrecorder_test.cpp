@@ -0,0 +1,145 @@
+//===================================================================================================================================
+// @file	flightrecorder_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for the flight recorder's crash handling and what a restart keeps of a crashed ring.
+//
+// @note    Every crash happens in a forked child, the parent reads the ring it left behind.
+//===================================================================================================================================
+
+#include "dispatchers/utkflightrecorder.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+using namespace UTK::Types::LogEntry;
+
+namespace {
+
+	constexpr int recorded = 10;
+	constexpr int handlerExitCode = 42;
+
+	string ringPath(const string& name) {
+		auto path = filesystem::temp_directory_path() / ("utk_" + name + "_" + to_string(getpid()) + ".ring");
+		filesystem::remove(path);
+		return path.string();
+	}
+
+	void recordEntries(flightRecorder& recorder, int count) {
+		for (int i = 0; i < count; i++) {
+			recorder.record(makeLogEntry(Logger::TERMINAL, Operations::LG_WR, { "index" }, { to_string(i) }, "flightrecorder_test.cpp", 1, "test"));
+		}
+	}
+
+	extern "C" void applicationHandler(int) {
+		_exit(handlerExitCode);
+	}
+
+	/// Records into path from a child that then aborts, returns the child's wait status
+	int crashChild(const string& path, bool ownHandler) {
+
+		pid_t child = fork();
+		if (child == 0) {
+			if (ownHandler) std::signal(SIGABRT, applicationHandler);
+
+			flightRecorder recorder(path, 64);
+			flightRecorder::installCrashHandlers();
+			flightRecorder::installCrashHandlers();
+			recordEntries(recorder, recorded);
+			abort();
+		}
+
+		int status = 0;
+		waitpid(child, &status, 0);
+		return status;
+	}
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(FlightRecorderTest, CrashRunsTheDefaultActionAfterMarkingTheRing) {
+
+	const string path = ringPath("default_action");
+	const int status = crashChild(path, false);
+
+	ASSERT_TRUE(WIFSIGNALED(status));
+	EXPECT_EQ(WTERMSIG(status), SIGABRT);
+
+	int crashSignal = 0;
+	auto records = flightRecorder::recover(path, 100, &crashSignal);
+	EXPECT_EQ(crashSignal, SIGABRT);
+	EXPECT_EQ(records.size(), static_cast<size_t>(recorded));
+
+	filesystem::remove(path);
+}
+
+TEST(FlightRecorderTest, CrashChainsToTheApplicationHandler) {
+
+	const string path = ringPath("chained");
+	const int status = crashChild(path, true);
+
+	ASSERT_TRUE(WIFEXITED(status));
+	EXPECT_EQ(WEXITSTATUS(status), handlerExitCode);
+
+	int crashSignal = 0;
+	flightRecorder::recover(path, 100, &crashSignal);
+	EXPECT_EQ(crashSignal, SIGABRT);
+
+	filesystem::remove(path);
+}
+
+TEST(FlightRecorderTest, ReopeningKeepsTheCrashMarker) {
+
+	const string path = ringPath("reopened");
+	crashChild(path, false);
+
+	{
+		flightRecorder restarted(path, 64);
+		recordEntries(restarted, 1);
+	}
+
+	int crashSignal = -1;
+	crashMarker previousCrash;
+	auto records = flightRecorder::recover(path, 100, &crashSignal, &previousCrash);
+
+	EXPECT_EQ(crashSignal, 0);
+	EXPECT_EQ(previousCrash.signal, SIGABRT);
+	EXPECT_EQ(previousCrash.sequence, static_cast<uint64_t>(recorded));
+	ASSERT_EQ(records.size(), static_cast<size_t>(recorded + 1));
+	EXPECT_EQ(records.back().sequence, static_cast<uint64_t>(recorded));
+
+	filesystem::remove(path);
+}
+
+TEST(FlightRecorderTest, RecoverIgnoresADamagedSlotCount) {
+
+	const string path = ringPath("damaged_count");
+	{
+		flightRecorder recorder(path, 64);
+		recordEntries(recorder, recorded);
+	}
+
+	// slotCount sits after the magic, version and slot size, claim four billion slots the file cannot hold
+	{
+		fstream file(path, ios::binary | ios::in | ios::out);
+		const uint32_t slotCount = 0xFFFFFFFF;
+		file.seekp(16);
+		file.write(reinterpret_cast<const char*>(&slotCount), sizeof(slotCount));
+	}
+
+	vector<flightRecord> records;
+	ASSERT_NO_THROW(records = flightRecorder::recover(path, 100));
+	ASSERT_EQ(records.size(), static_cast<size_t>(recorded));
+	EXPECT_EQ(records.back().formatValues[0], to_string(recorded - 1));
+
+	filesystem::remove(path);
+}
\ No newline at end of file
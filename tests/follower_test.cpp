@@ -0,0 +1,306 @@
+//===================================================================================================================================
+// @file	follower_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for the log follower, the rolling aggregates it feeds and the tail service: reading lines appended
+//			after following starts, lines split across writes, resuming from saved offsets, rotation, truncation,
+//			per second counts and the snapshot handed out over the socket.
+//
+// @note    Each test follows TERMINAL output written to its own scratch directory. The follower never blocks, so
+//			reads are retried until the expected entries arrive or the test gives up.
+//===================================================================================================================================
+
+#include "dispatchers/utkfollower.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+using namespace std;
+using namespace std::chrono;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+using namespace UTK::Types::LogEntry;
+
+namespace {
+
+	filesystem::path scratchDirectory(const string& name) {
+		auto path = filesystem::temp_directory_path() / ("utk_" + name + "_" + to_string(getpid()));
+		filesystem::remove_all(path);
+		filesystem::create_directories(path);
+		return path;
+	}
+
+	/// A line as the terminal sink writes it, the index doubles as the line number
+	string lineFor(string_view tag, int index) {
+		return "18/10/2026 12:00:00 follower_test.cpp:" + to_string(index) + ":writer " + string(tag) + " index " + to_string(index) + "\n";
+	}
+
+	void append(const filesystem::path& path, const string& text) {
+		ofstream file(path, ios::app | ios::binary);
+		file << text;
+	}
+
+	/// Reads until out holds count entries, then a little longer to catch any that should not be there
+	bool readUntil(logFollower& follower, vector<followedEntry>& out, size_t count, milliseconds timeout = seconds(10)) {
+
+		const auto deadline = steady_clock::now() + timeout;
+		while (out.size() < count) {
+			if (steady_clock::now() > deadline) return false;
+			follower.read(out);
+			this_thread::sleep_for(milliseconds(1));
+		}
+
+		this_thread::sleep_for(milliseconds(20));
+		follower.read(out);
+		return true;
+	}
+
+	vector<int> indicesOf(const vector<followedEntry>& entries) {
+		vector<int> indices;
+		for (const auto& followed : entries) indices.push_back(followed.entry.fileLine.value_or(-1));
+		return indices;
+	}
+
+	followedEntry entryAt(int64_t second, Operations op, int line, const string& value) {
+		return { second * 1'000'000'000, makeLogEntry(Logger::TERMINAL, op, { "code" }, { value }, "follower_test.cpp", line, "fails") };
+	}
+}
+
+//===================================================================================================================================
+//												 TESTS
+//===================================================================================================================================
+
+TEST(FollowerTest, ReadsOnlyLinesAppendedAfterFollowing) {
+
+	const auto directory = scratchDirectory("follower_append");
+	const auto path = directory / "terminal.log";
+	append(path, lineFor("[WRITE]", 0) + lineFor("[WRITE]", 1));
+
+	logFollower follower;
+	follower.follow(path.string(), Logger::TERMINAL);
+	append(path, lineFor("[WRITE]", 2) + lineFor("[READ]", 3) + lineFor("", 4));
+
+	vector<followedEntry> entries;
+	ASSERT_TRUE(readUntil(follower, entries, 3));
+	EXPECT_EQ(indicesOf(entries), (vector<int>{ 2, 3, 4 }));
+
+	const logEntry& read = entries[1].entry;
+	EXPECT_EQ(read.op, Operations::LG_RD);
+	EXPECT_EQ(read.fileName, "follower_test.cpp");
+	EXPECT_EQ(read.funcName, "writer");
+	EXPECT_EQ(read.formatKeys, (FormatStrings{ "index" }));
+	EXPECT_EQ(read.formatValues, (FormatStrings{ "3" }));
+	EXPECT_EQ(entries[2].entry.op, Operations::LG_NOP);
+
+	// Following from the start instead picks up what was already there
+	logFollower fromStart;
+	fromStart.follow(path.string(), Logger::TERMINAL, true);
+
+	vector<followedEntry> all;
+	ASSERT_TRUE(readUntil(fromStart, all, 5));
+	EXPECT_EQ(indicesOf(all), (vector<int>{ 0, 1, 2, 3, 4 }));
+
+	filesystem::remove_all(directory);
+}
+
+TEST(FollowerTest, HalfWrittenLineWaitsForTheRest) {
+
+	const auto directory = scratchDirectory("follower_partial");
+	const auto path = directory / "terminal.log";
+	append(path, "");
+
+	logFollower follower;
+	follower.follow(path.string(), Logger::TERMINAL, true);
+
+	const string line = lineFor("[ERROR]", 7);
+	const size_t split = line.find(":writer") + 4;
+	append(path, line.substr(0, split));
+
+	vector<followedEntry> entries;
+	EXPECT_FALSE(readUntil(follower, entries, 1, milliseconds(100)));
+	ASSERT_EQ(follower.files().size(), 1u);
+	EXPECT_EQ(follower.files()[0].position, 0u);
+	EXPECT_EQ(follower.files()[0].unparsed, 0u);
+
+	append(path, line.substr(split));
+	ASSERT_TRUE(readUntil(follower, entries, 1));
+	ASSERT_EQ(entries.size(), 1u);
+	EXPECT_EQ(entries[0].entry.op, Operations::LG_ERR);
+	EXPECT_EQ(entries[0].entry.funcName, "writer");
+	EXPECT_EQ(entries[0].entry.formatValues, (FormatStrings{ "7" }));
+	EXPECT_EQ(follower.files()[0].position, line.size());
+
+	filesystem::remove_all(directory);
+}
+
+TEST(FollowerTest, ResumesFromSavedOffsets) {
+
+	const auto directory = scratchDirectory("follower_resume");
+	const auto path = directory / "terminal.log";
+	const string offsets = (directory / "offsets").string();
+	append(path, lineFor("[WRITE]", 0) + lineFor("[WRITE]", 1));
+
+	// The half written line at the end is not counted as read, the next run starts at its beginning
+	const string split = lineFor("[WRITE]", 2);
+	{
+		logFollower follower(offsets);
+		follower.follow(path.string(), Logger::TERMINAL, true);
+		append(path, split.substr(0, 10));
+
+		vector<followedEntry> entries;
+		ASSERT_TRUE(readUntil(follower, entries, 2));
+		EXPECT_EQ(indicesOf(entries), (vector<int>{ 0, 1 }));
+	}
+
+	append(path, split.substr(10) + lineFor("[WRITE]", 3));
+
+	// fromStart is ignored once the file has a saved offset
+	logFollower follower(offsets);
+	follower.follow(path.string(), Logger::TERMINAL, true);
+
+	vector<followedEntry> entries;
+	ASSERT_TRUE(readUntil(follower, entries, 2));
+	EXPECT_EQ(indicesOf(entries), (vector<int>{ 2, 3 }));
+
+	filesystem::remove_all(directory);
+}
+
+TEST(FollowerTest, RotationFinishesTheOldFileThenReadsTheNewOne) {
+
+	const auto directory = scratchDirectory("follower_rotate");
+	const auto path = directory / "terminal.log";
+	append(path, "");
+
+	logFollower follower;
+	follower.follow(path.string(), Logger::TERMINAL, true);
+	append(path, lineFor("[WRITE]", 0) + lineFor("[WRITE]", 1));
+
+	vector<followedEntry> entries;
+	ASSERT_TRUE(readUntil(follower, entries, 2));
+
+	// Written just before the rename, so it is still owed from the old file
+	append(path, lineFor("[WRITE]", 2));
+	filesystem::rename(path, directory / "terminal.log.1");
+	append(path, lineFor("[WRITE]", 3) + lineFor("[WRITE]", 4));
+
+	ASSERT_TRUE(readUntil(follower, entries, 5));
+	EXPECT_EQ(indicesOf(entries), (vector<int>{ 0, 1, 2, 3, 4 }));
+	EXPECT_EQ(follower.files()[0].position, filesystem::file_size(path));
+
+	filesystem::remove_all(directory);
+}
+
+TEST(FollowerTest, TruncationReadsFromTheStart) {
+
+	const auto directory = scratchDirectory("follower_truncate");
+	const auto path = directory / "terminal.log";
+	append(path, "");
+
+	logFollower follower;
+	follower.follow(path.string(), Logger::TERMINAL, true);
+	append(path, lineFor("[WRITE]", 0) + lineFor("[WRITE]", 1) + lineFor("[WRITE]", 2));
+
+	vector<followedEntry> entries;
+	ASSERT_TRUE(readUntil(follower, entries, 3));
+
+	// copytruncate style, the same file emptied in place and written again
+	{
+		ofstream file(path, ios::trunc | ios::binary);
+		file << lineFor("[WRITE]", 10);
+	}
+
+	ASSERT_TRUE(readUntil(follower, entries, 4));
+	EXPECT_EQ(indicesOf(entries), (vector<int>{ 0, 1, 2, 10 }));
+	EXPECT_EQ(follower.files()[0].position, filesystem::file_size(path));
+
+	filesystem::remove_all(directory);
+}
+
+TEST(FollowerTest, AggregatesCountEachOperationPerSecond) {
+
+	rollingAggregates aggregates(60, 2);
+
+	aggregates.add(entryAt(100, Operations::LG_WR, 1, "0"));
+	aggregates.add(entryAt(100, Operations::LG_RD, 1, "0"));
+	aggregates.add(entryAt(100, Operations::LG_WR, 1, "0"));
+	aggregates.add(entryAt(101, Operations::LG_ERR, 2, "1"));
+	aggregates.add(entryAt(101, Operations::LG_ERR, 3, "2"));
+	aggregates.add(entryAt(101, Operations::LG_ERR, 4, "3"));
+
+	// Older than the window, only the totals count it
+	aggregates.add(entryAt(10, Operations::LG_WR, 1, "0"));
+
+	const string expected =
+		"{\"window\":60,\"operations\":[\"write\",\"read\",\"login\",\"logout\",\"idle\",\"error\",\"message\",\"none\"],"
+		"\"totals\":[3,1,0,0,0,3,0,0],"
+		"\"seconds\":[{\"second\":100,\"counts\":[2,1,0,0,0,0,0,0]},{\"second\":101,\"counts\":[0,0,0,0,0,3,0,0]}],"
+		"\"errors\":["
+		"{\"time\":101000000000,\"file\":\"follower_test.cpp\",\"line\":3,\"function\":\"fails\",\"keys\":[\"code\"],\"values\":[\"2\"]},"
+		"{\"time\":101000000000,\"file\":\"follower_test.cpp\",\"line\":4,\"function\":\"fails\",\"keys\":[\"code\"],\"values\":[\"3\"]}]}";
+	EXPECT_EQ(aggregates.toJson(101'500'000'000), expected);
+
+	// Once the window has moved past them the seconds drop out, the totals and errors stay
+	const string later = aggregates.toJson(200'000'000'000);
+	EXPECT_NE(later.find("\"seconds\":[]"), string::npos);
+	EXPECT_NE(later.find("\"totals\":[3,1,0,0,0,3,0,0]"), string::npos);
+	EXPECT_NE(later.find("\"line\":4"), string::npos);
+}
+
+TEST(FollowerTest, TailServiceHandsOutOneSnapshotPerConnection) {
+
+	const auto directory = scratchDirectory("follower_tail");
+	const auto path = directory / "terminal.log";
+	const string socketPath = (directory / "tail.sock").string();
+	append(path, "");
+
+	logFollower follower;
+	rollingAggregates aggregates;
+	follower.follow(path.string(), Logger::TERMINAL, true);
+	tailService service(socketPath, follower, aggregates);
+
+	append(path, lineFor("[WRITE]", 0) + lineFor("[ERROR]", 1) + "not a log line\n");
+
+	const auto deadline = steady_clock::now() + seconds(10);
+	while (follower.files()[0].entries < 2 && steady_clock::now() < deadline) service.poll(10);
+	ASSERT_EQ(follower.files()[0].entries, 2u);
+
+	atomic<bool> done = false;
+	string received;
+	thread client([&] {
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		socketPath.copy(address.sun_path, sizeof(address.sun_path) - 1);
+
+		const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) {
+			char buffer[4096];
+			for (ssize_t count; (count = ::read(fd, buffer, sizeof(buffer))) > 0;) received.append(buffer, static_cast<size_t>(count));
+		}
+		if (fd >= 0) close(fd);
+		done = true;
+	});
+
+	while (!done && steady_clock::now() < deadline) service.poll(10);
+	client.join();
+
+	// One line of JSON, then the service hangs up
+	ASSERT_FALSE(received.empty());
+	EXPECT_EQ(received.find('\n'), received.size() - 1);
+	EXPECT_TRUE(received.starts_with("{\"time\":"));
+	EXPECT_NE(received.find("\"path\":\"" + filesystem::absolute(path).lexically_normal().string() + "\""), string::npos);
+	EXPECT_NE(received.find("\"format\":\"terminal\""), string::npos);
+	EXPECT_NE(received.find("\"entries\":2,\"unparsed\":1,\"open\":true"), string::npos);
+	EXPECT_NE(received.find("\"totals\":[1,0,0,0,0,1,0,0]"), string::npos);
+	EXPECT_NE(received.find("\"function\":\"writer\""), string::npos);
+
+	filesystem::remove_all(directory);
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+//===================================================================================================================================
+// @file	hash_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Reference vectors for XXH3 and CRC32C, checked against every kernel the running CPU supports.
+//
+// @note    The XXH3 values come from the reference xxHash implementation(python-xxhash 4.0.1) over the
+//          buffer testBuffer() produces. Lengths are picked to hit every size class of the algorithm.
+//===================================================================================================================================
+
+#include "hash/utkhash.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace UTK::Hash;
+
+namespace {
+
+	struct xxh3Vector {
+		size_t length;
+		uint64_t seed;
+		uint64_t hash64;
+		uint64_t low128;
+		uint64_t high128;
+	};
+
+	constexpr xxh3Vector xxh3Vectors[] {
+		{      0, 0x0000000000000000ULL, 0x2D06800538D394C2ULL, 0x6001C324468D497FULL, 0x99AA06D3014798D8ULL },
+		{      1, 0x0000000000000000ULL, 0x74D3766CA02423F3ULL, 0x74D3766CA02423F3ULL, 0x9D1B9BC4078A3E72ULL },
+		{      3, 0x0000000000000000ULL, 0x9E77E470A7018920ULL, 0x9E77E470A7018920ULL, 0xF17AD1260222D503ULL },
+		{      4, 0x0000000000000000ULL, 0x093645744145D7E3ULL, 0x2B989D1C64E5D525ULL, 0x7773DA98153CB5B7ULL },
+		{      8, 0x0000000000000000ULL, 0x854C59BC83F9A7B7ULL, 0x276C2687A5F5EFEDULL, 0x466DBE3D39E0277CULL },
+		{      9, 0x0000000000000000ULL, 0xFB2102F80BD05046ULL, 0xB0F6B17D854A7046ULL, 0x92253D7AA912AB34ULL },
+		{     16, 0x0000000000000000ULL, 0x294D5381D3D9F990ULL, 0x6DB2F52D0A861D16ULL, 0x89FEA34B1F06876BULL },
+		{     17, 0x0000000000000000ULL, 0x79770199644B19D3ULL, 0x45327D3FCDE1230EULL, 0x545CA4427EA43887ULL },
+		{    128, 0x0000000000000000ULL, 0x7A255DC3181C5EDEULL, 0x6AD735E15873144CULL, 0xE452A994DFC5E46EULL },
+		{    129, 0x0000000000000000ULL, 0x074F486FF94B8E7DULL, 0xB26FF49BAB458182ULL, 0x71C7E046323861F6ULL },
+		{    240, 0x0000000000000000ULL, 0x414BBB0678EA02E0ULL, 0xCDEEF06A9F961043ULL, 0xB549D9B897EB2830ULL },
+		{    241, 0x0000000000000000ULL, 0xEF60A4FC8B25F1CCULL, 0xEF60A4FC8B25F1CCULL, 0xAF822D00A7A3CFCCULL },
+		{   1024, 0x0000000000000000ULL, 0x53DE00D98BA8BAD5ULL, 0x53DE00D98BA8BAD5ULL, 0x204E503C2B83CEDBULL },
+		{   4096, 0x0000000000000000ULL, 0xACF8C0A7ADC95AE3ULL, 0xACF8C0A7ADC95AE3ULL, 0x2353E2AAA62F2EA1ULL },
+		{ 100000, 0x0000000000000000ULL, 0x3A4CF7903F96376DULL, 0x3A4CF7903F96376DULL, 0xDC7813EDAB46448DULL },
+		{      0, 0x9E3779B185EBCA8DULL, 0xA8A6B918B2F0364AULL, 0xA986DFC5D7605BFEULL, 0x00FEAA732A3CE25EULL },
+		{      1, 0x9E3779B185EBCA8DULL, 0x5DF8C7AFCDDD0C40ULL, 0x5DF8C7AFCDDD0C40ULL, 0xBEE543076B018D8EULL },
+		{      3, 0x9E3779B185EBCA8DULL, 0x3489EFEB48ED7CF1ULL, 0x3489EFEB48ED7CF1ULL, 0x1C170A781D8E936DULL },
+		{      4, 0x9E3779B185EBCA8DULL, 0xDE35B8F90D96BAD2ULL, 0x44930E2261BF29B6ULL, 0xA5A980AB0DEC78C3ULL },
+		{      8, 0x9E3779B185EBCA8DULL, 0xD215648E2B393E6EULL, 0x818EA59E2E1FA9BFULL, 0x0D5FFD4AB01F8A9DULL },
+		{      9, 0x9E3779B185EBCA8DULL, 0x0E8C26A2305DEE60ULL, 0x687C52658385D738ULL, 0xF3512FA411ABEE45ULL },
+		{     16, 0x9E3779B185EBCA8DULL, 0xBBA249B798FB872CULL, 0x3A7EAD1BF447EEAFULL, 0x75D896477F98C763ULL },
+		{     17, 0x9E3779B185EBCA8DULL, 0x44638A2E5A472D77ULL, 0x7C2ADAE15BF53E8CULL, 0x1822EA164AFE7935ULL },
+		{    128, 0x9E3779B185EBCA8DULL, 0x07247D5F7730A16BULL, 0xC6CD6ED0644D6FF9ULL, 0xDBA0D238E8E8DBADULL },
+		{    129, 0x9E3779B185EBCA8DULL, 0x5A7777B12E4DCDC7ULL, 0xF1C971BFE1CFFF10ULL, 0xACB6B6689E19B51FULL },
+		{    240, 0x9E3779B185EBCA8DULL, 0x66A9DD2E4C14960AULL, 0xF645B267DEF7DA01ULL, 0xC0403CFB0C10B8A8ULL },
+		{    241, 0x9E3779B185EBCA8DULL, 0x77490E285B31AA53ULL, 0x77490E285B31AA53ULL, 0x27ED7BD91C2AA417ULL },
+		{   1024, 0x9E3779B185EBCA8DULL, 0x0BA3C36476F965F3ULL, 0x0BA3C36476F965F3ULL, 0x236AF80309C46B59ULL },
+		{   4096, 0x9E3779B185EBCA8DULL, 0x010484EE2D814D94ULL, 0x010484EE2D814D94ULL, 0x238CAED356FEA56AULL },
+		{ 100000, 0x9E3779B185EBCA8DULL, 0xA3293C7E847A17D1ULL, 0xA3293C7E847A17D1ULL, 0x70EF3B7E4B1DE606ULL },
+	};
+
+	/// Bytes from a 32-bit LCG, top byte of each state
+	const vector<uint8_t>& testBuffer() {
+		static const vector<uint8_t> buffer = [] {
+			vector<uint8_t> bytes(100000);
+			uint32_t state = 0x9E3779B1;
+			for (auto& byte : bytes) {
+				state = state * 1664525u + 1013904223u;
+				byte = static_cast<uint8_t>(state >> 24);
+			}
+			return bytes;
+		}();
+		return buffer;
+	}
+
+	/// Bit at a time CRC32C, slow but obviously right
+	uint32_t referenceCrc32c(const uint8_t* data, size_t length) {
+		uint32_t crc = 0xFFFFFFFF;
+		for (size_t i = 0; i < length; i++) {
+			crc ^= data[i];
+			for (int bit = 0; bit < 8; bit++) {
+				crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+			}
+		}
+		return ~crc;
+	}
+
+	/// Puts the automatically selected kernels back after each test
+	class HashTest : public ::testing::Test {
+	private:
+		kernelSet _selected = activeKernels();
+
+	protected:
+		void TearDown() override {
+			selectHashKernel(_selected.hash);
+			selectCrcKernel(_selected.crc);
+		}
+	};
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST_F(HashTest, Xxh3MatchesReferenceOnEveryKernel) {
+
+	const auto& buffer = testBuffer();
+
+	for (auto kernel : availableHashKernels()) {
+		ASSERT_TRUE(selectHashKernel(kernel));
+		SCOPED_TRACE(string(kernel));
+
+		for (const auto& vector : xxh3Vectors) {
+			SCOPED_TRACE("length " + to_string(vector.length) + " seed " + to_string(vector.seed));
+
+			EXPECT_EQ(hash64(buffer.data(), vector.length, vector.seed), vector.hash64);
+			EXPECT_EQ(hash128Of(buffer.data(), vector.length, vector.seed), (hash128{ vector.low128, vector.high128 }));
+		}
+	}
+}
+
+TEST_F(HashTest, StreamingMatchesOneShotForAnySplit) {
+
+	const auto& buffer = testBuffer();
+
+	for (auto kernel : availableHashKernels()) {
+		ASSERT_TRUE(selectHashKernel(kernel));
+		SCOPED_TRACE(string(kernel));
+
+		for (const auto& vector : xxh3Vectors) {
+			for (size_t chunk : { size_t{ 1 }, size_t{ 7 }, size_t{ 64 }, size_t{ 333 }, size_t{ 4096 } }) {
+				SCOPED_TRACE("length " + to_string(vector.length) + " chunk " + to_string(chunk));
+
+				hashStream stream(vector.seed);
+				for (size_t offset = 0; offset < vector.length; offset += chunk) {
+					stream.update(buffer.data() + offset, min(chunk, vector.length - offset));
+				}
+
+				EXPECT_EQ(stream.digest64(), vector.hash64);
+				EXPECT_EQ(stream.digest128(), (hash128{ vector.low128, vector.high128 }));
+			}
+		}
+	}
+}
+
+TEST_F(HashTest, Crc32cMatchesReferenceOnEveryKernel) {
+
+	const auto& buffer = testBuffer();
+	const vector<uint8_t> zeros(32, 0x00);
+	const vector<uint8_t> ones(32, 0xFF);
+	vector<uint8_t> ascending(32);
+	for (size_t i = 0; i < ascending.size(); i++) ascending[i] = static_cast<uint8_t>(i);
+
+	for (auto kernel : availableCrcKernels()) {
+		ASSERT_TRUE(selectCrcKernel(kernel));
+		SCOPED_TRACE(string(kernel));
+
+		// RFC 3720 appendix B.4 and the usual check value
+		EXPECT_EQ(crc32c("123456789"), 0xE3069283u);
+		EXPECT_EQ(crc32c(zeros.data(), zeros.size()), 0x8A9136AAu);
+		EXPECT_EQ(crc32c(ones.data(), ones.size()), 0x62A8AB43u);
+		EXPECT_EQ(crc32c(ascending.data(), ascending.size()), 0x46DD794Eu);
+		EXPECT_EQ(crc32c(nullptr, 0), 0u);
+
+		// Every alignment and tail length the wide kernels split the input into
+		for (size_t offset = 0; offset < 16; offset++) {
+			for (size_t length : { size_t{ 1 }, size_t{ 7 }, size_t{ 8 }, size_t{ 63 }, size_t{ 255 }, size_t{ 1000 }, size_t{ 65537 } }) {
+				EXPECT_EQ(crc32c(buffer.data() + offset, length), referenceCrc32c(buffer.data() + offset, length))
+					<< "offset " << offset << " length " << length;
+			}
+		}
+
+		// Continuing a checksum equals taking it over the whole input at once
+		crc32cStream stream;
+		for (size_t offset = 0; offset < 10000; offset += 333) {
+			stream.update(buffer.data() + offset, min<size_t>(333, 10000 - offset));
+		}
+		EXPECT_EQ(stream.digest(), referenceCrc32c(buffer.data(), 10000));
+	}
+}
+
+TEST_F(HashTest, UnknownKernelsAreRefused) {
+
+	const kernelSet before = activeKernels();
+
+	EXPECT_FALSE(selectHashKernel("no-such-kernel"));
+	EXPECT_FALSE(selectCrcKernel("no-such-kernel"));
+	EXPECT_EQ(activeKernels().hash, before.hash);
+	EXPECT_EQ(activeKernels().crc, before.crc);
+}
\ No newline at end of file
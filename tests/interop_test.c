@@ -0,0 +1,192 @@
+//===================================================================================================================================
+// @file	interop_test.c
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for the UTK C ABI, compiled as C so the header is proven to stand on its own without C++.
+//
+// @note    A plain program rather than a GoogleTest suite, every failed check is printed to stderr and the exit
+//			status is the number of failures. Entries go to the terminal sink with stdout pointed at a pipe.
+//===================================================================================================================================
+
+#include "interop/utkinterop.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			failures++; \
+		} \
+	} while (0)
+
+/// Borrowed string over a literal, deliberately without its terminator
+static utk_str text(const char* literal) {
+	utk_str str = { literal, strlen(literal) };
+	return str;
+}
+
+static utk_log_entry entryFor(const utk_kv* fields, size_t count) {
+	utk_log_entry entry;
+	memset(&entry, 0, sizeof(entry));
+	entry.logger = UTK_LOGGER_TERMINAL;
+	entry.op = UTK_OP_MSG;
+	entry.fields = fields;
+	entry.fieldCount = count;
+	entry.file = text("interop_test.c");
+	entry.line = __LINE__;
+	entry.function = text("entryFor");
+	return entry;
+}
+
+/// Everything the sinks wrote to stdout since the pipe was installed, stdout is restored first
+static size_t captured(int readEnd, int savedStdout, char* buffer, size_t size) {
+	fflush(stdout);
+	dup2(savedStdout, STDOUT_FILENO);
+	close(savedStdout);
+
+	size_t total = 0;
+	ssize_t received;
+	while (total + 1 < size && (received = read(readEnd, buffer + total, size - total - 1)) > 0) total += (size_t)received;
+	buffer[total] = '\0';
+	close(readEnd);
+	return total;
+}
+
+static void pushesReachTheSink(void) {
+
+	int fds[2];
+	CHECK(pipe(fds) == 0);
+	fflush(stdout);
+	const int savedStdout = dup(STDOUT_FILENO);
+	dup2(fds[1], STDOUT_FILENO);
+	close(fds[1]);
+
+	utk_dispatcher* dispatcher = utk_dispatcher_create(64, UTK_BACKPRESSURE_BLOCK);
+	CHECK(dispatcher != NULL);
+
+	// The key and value are slices of a longer buffer, only length bytes may be read
+	const char* buffer = "singlevalueXXXX";
+	utk_kv single = { { buffer, 6 }, { buffer + 6, 5 } };
+	utk_log_entry entry = entryFor(&single, 1);
+	CHECK(utk_log_push(dispatcher, &entry) == UTK_OK);
+	CHECK(strcmp(utk_last_error(), "") == 0);
+
+	utk_kv fields[3] = { { text("batch"), text("first") }, { text("batch"), text("second") }, { text("batch"), text("third") } };
+	utk_log_entry batch[3] = { entryFor(&fields[0], 1), entryFor(&fields[1], 1), entryFor(&fields[2], 1) };
+	CHECK(utk_log_push_batch(dispatcher, batch, 3) == UTK_OK);
+
+	// An empty batch is valid, with or without an array
+	CHECK(utk_log_push_batch(dispatcher, NULL, 0) == UTK_OK);
+	CHECK(utk_log_push_batch(dispatcher, batch, 0) == UTK_OK);
+
+	CHECK(utk_flush(dispatcher) == UTK_OK);
+	utk_dispatcher_destroy(dispatcher);
+
+	char output[8192];
+	captured(fds[0], savedStdout, output, sizeof(output));
+
+	CHECK(strstr(output, "single") != NULL);
+	CHECK(strstr(output, "value") != NULL);
+	CHECK(strstr(output, "XXXX") == NULL);
+	CHECK(strstr(output, "first") != NULL);
+	CHECK(strstr(output, "second") != NULL);
+	CHECK(strstr(output, "third") != NULL);
+}
+
+static void invalidArgumentsAreRefused(void) {
+
+	utk_dispatcher* dispatcher = utk_dispatcher_create(16, UTK_BACKPRESSURE_DROP);
+	CHECK(dispatcher != NULL);
+
+	utk_kv field = { text("key"), text("value") };
+	utk_log_entry good = entryFor(&field, 1);
+
+	CHECK(utk_log_push(NULL, &good) == UTK_ERR_INVALID_ARGUMENT);
+	CHECK(strlen(utk_last_error()) > 0);
+	CHECK(utk_log_push(dispatcher, NULL) == UTK_ERR_INVALID_ARGUMENT);
+
+	utk_log_entry badLogger = good;
+	badLogger.logger = 99;
+	CHECK(utk_log_push(dispatcher, &badLogger) == UTK_ERR_INVALID_ARGUMENT);
+
+	utk_log_entry badOperation = good;
+	badOperation.op = UTK_OP_NOP + 1;
+	CHECK(utk_log_push(dispatcher, &badOperation) == UTK_ERR_INVALID_ARGUMENT);
+
+	utk_log_entry nullFields = good;
+	nullFields.fields = NULL;
+	CHECK(utk_log_push(dispatcher, &nullFields) == UTK_ERR_INVALID_ARGUMENT);
+
+	utk_kv nullValue = { text("key"), { NULL, 3 } };
+	utk_log_entry badField = entryFor(&nullValue, 1);
+	CHECK(utk_log_push(dispatcher, &badField) == UTK_ERR_INVALID_ARGUMENT);
+
+	utk_log_entry nullFile = good;
+	nullFile.file.data = NULL;
+	CHECK(utk_log_push(dispatcher, &nullFile) == UTK_ERR_INVALID_ARGUMENT);
+
+	// NULL with a zero length is an empty string, not an error
+	utk_kv empty = { { NULL, 0 }, { NULL, 0 } };
+	utk_log_entry emptyField = entryFor(&empty, 1);
+	emptyField.file.data = NULL;
+	emptyField.file.length = 0;
+	CHECK(utk_log_push(dispatcher, &emptyField) == UTK_OK);
+	CHECK(strcmp(utk_last_error(), "") == 0);
+
+	// The batch names the first bad entry
+	utk_log_entry batch[4] = { good, good, badLogger, badOperation };
+	CHECK(utk_log_push_batch(dispatcher, batch, 4) == UTK_ERR_INVALID_ARGUMENT);
+	CHECK(strstr(utk_last_error(), "Entry 2") != NULL);
+
+	CHECK(utk_log_push_batch(NULL, batch, 2) == UTK_ERR_INVALID_ARGUMENT);
+	CHECK(utk_log_push_batch(dispatcher, NULL, 2) == UTK_ERR_INVALID_ARGUMENT);
+
+	CHECK(utk_dispatcher_create(0, UTK_BACKPRESSURE_DROP) == NULL);
+	CHECK(utk_dispatcher_create(16, 7) == NULL);
+	CHECK(strlen(utk_last_error()) > 0);
+
+	utk_dispatcher_destroy(dispatcher);
+	utk_dispatcher_destroy(NULL);
+}
+
+static void rejectedBatchQueuesNothing(void) {
+
+	int fds[2];
+	CHECK(pipe(fds) == 0);
+	fflush(stdout);
+	const int savedStdout = dup(STDOUT_FILENO);
+	dup2(fds[1], STDOUT_FILENO);
+	close(fds[1]);
+
+	utk_dispatcher* dispatcher = utk_dispatcher_create(16, UTK_BACKPRESSURE_BLOCK);
+
+	utk_kv field = { text("marker"), text("should-not-appear") };
+	utk_log_entry batch[2] = { entryFor(&field, 1), entryFor(&field, 1) };
+	batch[1].fields = NULL;
+
+	CHECK(utk_log_push_batch(dispatcher, batch, 2) == UTK_ERR_INVALID_ARGUMENT);
+	CHECK(strstr(utk_last_error(), "Entry 1") != NULL);
+	CHECK(utk_flush(dispatcher) == UTK_OK);
+	utk_dispatcher_destroy(dispatcher);
+
+	char output[4096];
+	captured(fds[0], savedStdout, output, sizeof(output));
+	CHECK(strstr(output, "should-not-appear") == NULL);
+}
+
+int main(void) {
+
+	CHECK(utk_version() == UTK_VERSION);
+
+	pushesReachTheSink();
+	invalidArgumentsAreRefused();
+	rejectedBatchQueuesNothing();
+
+	if (failures) fprintf(stderr, "%d checks failed\n", failures);
+	return failures;
+}
\ No newline at end of file
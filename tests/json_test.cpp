@@ -0,0 +1,113 @@
+//===================================================================================================================================
+// @file	json_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for UTK::JSON number conversion at the edges of the double range, repeated on every stage one kernel.
+//===================================================================================================================================
+
+#include "json/utkjson.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <cmath>
+#include <limits>
+#include <string>
+
+using namespace std;
+using namespace UTK::JSON;
+
+namespace {
+
+	/// Runs check once per kernel the CPU supports, restoring the automatic choice afterwards
+	template<typename Check>
+	void onEveryKernel(Check check) {
+		const string_view selected = activeKernel();
+		for (auto kernel : availableKernels()) {
+			ASSERT_TRUE(selectKernel(kernel));
+			SCOPED_TRACE(string(kernel));
+			check();
+		}
+		selectKernel(selected);
+	}
+
+	/// Parses text as an array and returns its numbers in order
+	vector<double> doublesOf(const string& text) {
+		const document doc = document::parse(text);
+		vector<double> numbers;
+		for (element value : doc.root().getArray()) numbers.push_back(value.getDouble());
+		return numbers;
+	}
+
+	/// Pads an array past several 64 byte blocks, so the values land in the SIMD path rather than a tail
+	string padded(const string& values) {
+		return "[" + string(200, ' ') + values + string(200, ' ') + "]";
+	}
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(JsonTest, UnderflowReadsAsSignedZero) {
+
+	onEveryKernel([] {
+		const vector<double> numbers = doublesOf(padded("2.5e-810, -2.5e-610, 2e-324, -0.0000001e-320, 1e-99999999999999999999999"));
+		ASSERT_EQ(numbers.size(), 5u);
+
+		for (size_t i = 0; i < numbers.size(); i++) EXPECT_EQ(numbers[i], 0.0) << i;
+		EXPECT_FALSE(signbit(numbers[0]));
+		EXPECT_TRUE(signbit(numbers[1]));
+		EXPECT_FALSE(signbit(numbers[2]));
+		EXPECT_TRUE(signbit(numbers[3]));
+		EXPECT_FALSE(signbit(numbers[4]));
+	});
+}
+
+TEST(JsonTest, DenormalsAreKept) {
+
+	onEveryKernel([] {
+		const vector<double> numbers = doublesOf(padded("4.9406564584124654e-324, -1e-320, 2.2250738585072011e-308"));
+		ASSERT_EQ(numbers.size(), 3u);
+
+		EXPECT_EQ(numbers[0], numeric_limits<double>::denorm_min());
+		EXPECT_EQ(numbers[1], -1e-320);
+		EXPECT_EQ(fpclassify(numbers[2]), FP_SUBNORMAL);
+	});
+}
+
+TEST(JsonTest, OverflowThrows) {
+
+	onEveryKernel([] {
+		// Negative exponents that still overflow, the digits before the point outweigh them
+		for (const string& text : { string("1e309"), string("-1e400"), string("1e99999999999999999999999"), "1" + string(400, '0') + "e-50" }) {
+			const document doc = document::parse(padded(text));
+			EXPECT_THROW(doc.root().at(0).getDouble(), runtime_error) << text;
+		}
+	});
+}
+
+TEST(JsonTest, NegativeZeroKeepsItsSign) {
+
+	onEveryKernel([] {
+		const vector<double> numbers = doublesOf(padded("-0, -0.0, -0e10, 0, -0E-999"));
+		ASSERT_EQ(numbers.size(), 5u);
+
+		EXPECT_TRUE(signbit(numbers[0]));
+		EXPECT_TRUE(signbit(numbers[1]));
+		EXPECT_TRUE(signbit(numbers[2]));
+		EXPECT_FALSE(signbit(numbers[3]));
+		EXPECT_TRUE(signbit(numbers[4]));
+
+		// Bare top level value, the scan ends inside the number rather than at a bracket
+		EXPECT_TRUE(signbit(document::parse("-0").root().getDouble()));
+	});
+}
+
+TEST(JsonTest, IntegersStillRejectOutOfRange) {
+
+	const document doc = document::parse("[9223372036854775807, 9223372036854775808, -1]");
+	EXPECT_EQ(doc.root().at(0).getInt64(), numeric_limits<int64_t>::max());
+	EXPECT_THROW(doc.root().at(1).getInt64(), runtime_error);
+	EXPECT_EQ(doc.root().at(1).getUint64(), 9223372036854775808ULL);
+	EXPECT_THROW(doc.root().at(2).getUint64(), runtime_error);
+}
\ No newline at end of file
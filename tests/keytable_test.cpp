@@ -0,0 +1,150 @@
+//===================================================================================================================================
+// @file	keytable_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for the key interning table: stable ids, lookups, the preformatted sink forms, its capacity
+//			and interning from many threads at once.
+//
+// @note    Each test uses its own keyTable apart from the entryKey test, which has to go through the global one.
+//===================================================================================================================================
+
+#include "dispatchers/utkkeytable.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+using namespace std;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+using namespace UTK::Types::LogEntry;
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(KeyTableTest, InterningTwiceGivesTheSameId) {
+
+	keyTable table;
+	const KeyId user = table.intern("user");
+	const KeyId status = table.intern("status");
+
+	EXPECT_NE(user, status);
+	EXPECT_EQ(table.intern("user"), user);
+	EXPECT_EQ(table.intern(string("status")), status);
+	EXPECT_EQ(table.size(), 2u);
+
+	ASSERT_NE(table.lookup(user), nullptr);
+	EXPECT_EQ(table.lookup(user)->name, "user");
+	EXPECT_EQ(table.lookup(status)->name, "status");
+}
+
+TEST(KeyTableTest, UnknownNamesAndIdsAreNotFound) {
+
+	keyTable table;
+	const KeyId known = table.intern("known");
+
+	EXPECT_EQ(table.find("known"), known);
+	EXPECT_FALSE(table.find("unknown").has_value());
+	EXPECT_FALSE(table.find("know").has_value());
+	EXPECT_FALSE(table.find("").has_value());
+
+	EXPECT_EQ(table.lookup(known + 1), nullptr);
+	EXPECT_EQ(table.lookup(static_cast<KeyId>(keyTable::capacity)), nullptr);
+	EXPECT_EQ(table.size(), 1u);
+}
+
+TEST(KeyTableTest, PreformatsJsonAndCsvForms) {
+
+	keyTable table;
+	auto forms = [&](const string& name) { return *table.lookup(table.intern(name)); };
+
+	const internedKey plain = forms("plain");
+	EXPECT_EQ(plain.json, "\"plain\":");
+	EXPECT_EQ(plain.csv, "plain");
+
+	const internedKey quoted = forms("say \"hi\"\\now");
+	EXPECT_EQ(quoted.json, "\"say \\\"hi\\\"\\\\now\":");
+	EXPECT_EQ(quoted.csv, "\"say \"\"hi\"\"\\now\"");
+
+	const internedKey control = forms("tab\there\x01");
+	EXPECT_EQ(control.json, "\"tab\\u0009here\\u0001\":");
+	EXPECT_EQ(control.csv, "tab\there\x01");
+
+	EXPECT_EQ(forms("a,b").csv, "\"a,b\"");
+	EXPECT_EQ(forms("two\nlines").csv, "\"two\nlines\"");
+	EXPECT_EQ(forms("two\nlines").json, "\"two\\u000alines\":");
+}
+
+TEST(KeyTableTest, ThrowsOnceFull) {
+
+	keyTable table;
+	for (size_t i = 0; i < keyTable::capacity; i++) {
+		ASSERT_EQ(table.intern("key" + to_string(i)), static_cast<KeyId>(i));
+	}
+	EXPECT_EQ(table.size(), keyTable::capacity);
+
+	// Full, but everything already in it can still be found and interned again
+	EXPECT_THROW(table.intern("one too many"), runtime_error);
+	EXPECT_EQ(table.intern("key0"), 0u);
+	EXPECT_EQ(table.find("key" + to_string(keyTable::capacity - 1)), static_cast<KeyId>(keyTable::capacity - 1));
+	EXPECT_EQ(table.size(), keyTable::capacity);
+}
+
+TEST(KeyTableTest, ConcurrentInterningAgreesOnIds) {
+
+	constexpr int threads = 8;
+	constexpr int names = 500;
+
+	keyTable table;
+	vector<vector<KeyId>> ids(threads, vector<KeyId>(names));
+	atomic<bool> start{ false };
+
+	// Every thread interns the same names, each in a different order, and reads them back lock-free as it goes
+	vector<thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&, t] {
+			while (!start) this_thread::yield();
+			for (int i = 0; i < names; i++) {
+				const int name = (i * 7 + t * 61) % names;
+				ids[t][name] = table.intern("name" + to_string(name));
+
+				const internedKey* key = table.lookup(ids[t][name]);
+				if (!key || key->name != "name" + to_string(name)) ids[t][name] = static_cast<KeyId>(keyTable::capacity);
+			}
+		});
+	}
+	start = true;
+	for (auto& worker : workers) worker.join();
+
+	EXPECT_EQ(table.size(), static_cast<size_t>(names));
+	for (int t = 1; t < threads; t++) EXPECT_EQ(ids[t], ids[0]);
+
+	vector<KeyId> sorted = ids[0];
+	sort(sorted.begin(), sorted.end());
+	for (int i = 0; i < names; i++) EXPECT_EQ(sorted[static_cast<size_t>(i)], static_cast<KeyId>(i));
+}
+
+TEST(KeyTableTest, EntryKeyMatchesForInternedAndStringKeys) {
+
+	keyTable& table = keyTable::global();
+	const logEntry byName = makeLogEntry(Logger::JSON, Operations::LG_WR, { "request", "latency" }, { "7", "12" });
+
+	logEntry byId = makeLogEntry(Logger::JSON, Operations::LG_WR, {}, { "7", "12" });
+	byId.keyIds = { table.intern("request"), table.intern("latency") };
+
+	ASSERT_EQ(entryKeyCount(byName), 2u);
+	ASSERT_EQ(entryKeyCount(byId), 2u);
+	for (size_t i = 0; i < 2; i++) EXPECT_EQ(entryKey(byName, i), entryKey(byId, i));
+
+	// Out of range indices are empty either way, an id nothing was interned under is flagged
+	EXPECT_EQ(entryKey(byName, 2), "");
+	EXPECT_EQ(entryKey(byId, 2), "");
+
+	byId.keyIds.push_back(static_cast<KeyId>(keyTable::capacity + 1));
+	EXPECT_EQ(entryKey(byId, 2), "<unknown_key>");
+}
\ No newline at end of file
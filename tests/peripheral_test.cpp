@@ -0,0 +1,279 @@
+//===================================================================================================================================
+// @file	peripheral_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for serialEngine and each framer, over pseudo terminal pairs standing in for serial devices.
+//
+// @note    The engine opens the pty's slave end like any serial device, the test drives the master end. Bytes
+//			are fed a few at a time so every framer sees frames split across reads.
+//===================================================================================================================================
+
+#include "peripheral/utkperipheral.hpp"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <cstdio>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <pty.h>
+#include <poll.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Peripheral;
+
+namespace {
+
+	/// A pty pair, the slave's path is handed to the engine and the test keeps the master
+	class ptyPair {
+	private:
+		int _master = -1;
+		string _slavePath;
+
+	public:
+		ptyPair() {
+			int slave = -1;
+			char name[256];
+			if (openpty(&_master, &slave, name, nullptr, nullptr) != 0) throw runtime_error("openpty failed");
+
+			// The engine opens its own descriptor, this one only existed to get the name
+			_slavePath = name;
+			::close(slave);
+		}
+
+		~ptyPair() { ::close(_master); }
+
+		const string& slavePath() const { return _slavePath; }
+
+		/// Writes bytes to the engine's side a few at a time, pausing so each piece arrives as its own read
+		void feed(string_view bytes, size_t piece = 7) {
+			for (size_t at = 0; at < bytes.size(); at += piece) {
+				const string_view part = bytes.substr(at, piece);
+				if (::write(_master, part.data(), part.size()) != static_cast<ssize_t>(part.size())) throw runtime_error("pty write failed");
+				this_thread::sleep_for(microseconds(50));
+			}
+		}
+
+		/// Reads what the engine wrote until size bytes have arrived or nothing more comes for a second
+		string receive(size_t size) {
+			string bytes;
+			char buffer[4096];
+			pollfd readable{ _master, POLLIN, 0 };
+
+			while (bytes.size() < size && poll(&readable, 1, 1000) > 0) {
+				const ssize_t received = ::read(_master, buffer, sizeof(buffer));
+				if (received <= 0) break;
+				bytes.append(buffer, static_cast<size_t>(received));
+			}
+			return bytes;
+		}
+	};
+
+	/// Frames delivered by the engine, in order
+	class frameLog {
+	private:
+		mutable mutex _mutex;
+		vector<string> _frames;
+
+	public:
+		serialEngine::FrameHandler handler() {
+			return [this](portId, string_view frame) {
+				lock_guard<mutex> lock(_mutex);
+				_frames.emplace_back(frame);
+			};
+		}
+
+		/// Waits for count frames, returns whatever arrived if they do not within a few seconds
+		vector<string> waitFor(size_t count) const {
+			const auto deadline = steady_clock::now() + seconds(5);
+			for (;;) {
+				{
+					lock_guard<mutex> lock(_mutex);
+					if (_frames.size() >= count || steady_clock::now() > deadline) return _frames;
+				}
+				this_thread::sleep_for(milliseconds(1));
+			}
+		}
+	};
+
+	/// Payloads covering every byte value, including each framer's delimiters and escapes
+	vector<string> binaryPayloads(size_t count, size_t maxLength) {
+		vector<string> payloads;
+		uint32_t state = 0x9E3779B1;
+		for (size_t i = 0; i < count; i++) {
+			string payload(1 + i % maxLength, '\0');
+			for (auto& c : payload) {
+				state = state * 1664525u + 1013904223u;
+				c = static_cast<char>(state >> 24);
+			}
+			payloads.push_back(move(payload));
+		}
+		return payloads;
+	}
+
+	/// Sends payloads encoded by framer through the pty and checks they come back as the same frames
+	void expectRoundTrip(unique_ptr<IFramer> framer, const vector<string>& payloads) {
+		ptyPair pty;
+		frameLog frames;
+		serialEngine engine;
+
+		string wire;
+		for (const string& payload : payloads) framer->encode(payload, wire);
+
+		const portId id = engine.open(pty.slavePath(), portSettings{}, move(framer), frames.handler());
+		pty.feed(wire);
+
+		EXPECT_EQ(frames.waitFor(payloads.size()), payloads);
+
+		const portStats stats = engine.stats(id);
+		EXPECT_EQ(stats.bytesRead, wire.size());
+		EXPECT_EQ(stats.framesRead, payloads.size());
+		EXPECT_EQ(stats.bytesDiscarded, 0u);
+	}
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(PeripheralTest, DelimitedFrames) {
+
+	vector<string> lines;
+	for (int i = 0; i < 300; i++) lines.push_back("line " + to_string(i) + string(static_cast<size_t>(i % 40), '.'));
+
+	expectRoundTrip(make_unique<delimitedFramer>("\n"), lines);
+
+	// A two byte delimiter split across reads, and a lone \r inside a frame
+	lines.push_back("carriage\rreturn");
+	expectRoundTrip(make_unique<delimitedFramer>("\r\n"), lines);
+}
+
+TEST(PeripheralTest, OversizedDelimitedFrameIsDiscarded) {
+
+	ptyPair pty;
+	frameLog frames;
+	serialEngine engine;
+
+	const portId id = engine.open(pty.slavePath(), portSettings{}, make_unique<delimitedFramer>("\n", 64), frames.handler());
+	pty.feed("before\n" + string(1000, 'x') + "\nafter\n", 100);
+
+	EXPECT_EQ(frames.waitFor(2), (vector<string>{ "before", "after" }));
+	EXPECT_GE(engine.stats(id).bytesDiscarded, 1000u);
+}
+
+TEST(PeripheralTest, LengthPrefixedFrames) {
+
+	expectRoundTrip(make_unique<lengthPrefixedFramer>(1, true), binaryPayloads(200, 255));
+	expectRoundTrip(make_unique<lengthPrefixedFramer>(2, true), binaryPayloads(100, 1000));
+	expectRoundTrip(make_unique<lengthPrefixedFramer>(2, false), binaryPayloads(100, 1000));
+	expectRoundTrip(make_unique<lengthPrefixedFramer>(4, false), binaryPayloads(50, 3000));
+}
+
+TEST(PeripheralTest, FixedFrames) {
+
+	vector<string> payloads = binaryPayloads(300, 1);
+	for (auto& payload : payloads) payload.resize(12, static_cast<char>(payload[0] ^ 0x5A));
+
+	expectRoundTrip(make_unique<fixedFramer>(12), payloads);
+}
+
+TEST(PeripheralTest, SlipFrames) {
+
+	// Random bytes hit END(0xC0) and ESC(0xDB) often enough, the fixed ones make sure of it
+	vector<string> payloads = binaryPayloads(200, 300);
+	payloads.push_back("\xC0");
+	payloads.push_back("\xDB\xDC\xDB\xDD");
+	payloads.push_back("\xC0\xC0\xDB");
+
+	expectRoundTrip(make_unique<slipFramer>(), payloads);
+}
+
+TEST(PeripheralTest, SlipSkipsEmptyFramesBetweenEnds) {
+
+	ptyPair pty;
+	frameLog frames;
+	serialEngine engine;
+
+	engine.open(pty.slavePath(), portSettings{}, make_unique<slipFramer>(), frames.handler());
+	pty.feed("\xC0\xC0\xC0one\xC0\xC0two\xC0");
+
+	EXPECT_EQ(frames.waitFor(2), (vector<string>{ "one", "two" }));
+}
+
+TEST(PeripheralTest, SendsQueuedTogetherShareAWrite) {
+
+	constexpr int count = 200;
+
+	ptyPair pty;
+	serialEngine engine;
+
+	// The handler holds the engine thread, so everything sent meanwhile is waiting when it returns
+	promise<void> started;
+	auto onFrame = [&](portId, string_view) {
+		started.set_value();
+		this_thread::sleep_for(milliseconds(100));
+	};
+	const portId id = engine.open(pty.slavePath(), portSettings{}, make_unique<delimitedFramer>("\n"), onFrame);
+
+	pty.feed("go\n");
+	started.get_future().wait();
+
+	string expected;
+	for (int i = 0; i < count; i++) {
+		const string payload = "message " + to_string(i);
+		ASSERT_TRUE(engine.send(id, payload));
+		expected += payload + "\n";
+	}
+
+	EXPECT_EQ(pty.receive(expected.size()), expected);
+
+	const portStats stats = engine.stats(id);
+	EXPECT_EQ(stats.bytesWritten, expected.size());
+	EXPECT_LT(stats.writeCalls, 5u);
+}
+
+TEST(PeripheralTest, WritesFromManyThreadsArriveWhole) {
+
+	constexpr int threads = 4;
+	constexpr int perThread = 250;
+
+	ptyPair pty;
+	serialEngine engine;
+	const portId id = engine.open(pty.slavePath(), portSettings{}, make_unique<slipFramer>(), [](portId, string_view) {});
+
+	// Written back into a framer on the test's side, each send must come out as one intact frame
+	string wire;
+	thread reader([&] { wire = pty.receive(SIZE_MAX); });
+
+	vector<thread> writers;
+	for (int t = 0; t < threads; t++) {
+		writers.emplace_back([&, t] {
+			for (int i = 0; i < perThread; i++) engine.send(id, "thread " + to_string(t) + " message " + to_string(i));
+		});
+	}
+	for (auto& writer : writers) writer.join();
+	reader.join();
+
+	slipFramer decoder;
+	vector<int> nextIndex(threads, 0);
+	size_t frames = 0;
+	for (size_t at = 0; at < wire.size();) {
+		const auto scan = decoder.next(wire.data() + at, wire.size() - at);
+		if (scan.consumed == 0) break;
+		at += scan.consumed;
+		if (!scan.found) continue;
+
+		// Per thread order is kept, threads interleave only between whole frames
+		int t = 0, i = 0;
+		ASSERT_EQ(sscanf(string(scan.frame).c_str(), "thread %d message %d", &t, &i), 2) << scan.frame;
+		EXPECT_EQ(i, nextIndex[static_cast<size_t>(t)]++);
+		frames++;
+	}
+
+	EXPECT_EQ(frames, static_cast<size_t>(threads * perThread));
+	EXPECT_LT(engine.stats(id).writeCalls, static_cast<uint64_t>(threads * perThread));
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+//===================================================================================================================================
+// @file	progressbar_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for the progress bar counters and the renderer thread's handling of stdout.
+//
+// @note    stdout is pointed at a pipe for each test, so the output can be read back or made to fail.
+//===================================================================================================================================
+
+#include "progressbar/utkprogressbar.hpp"
+#include <gtest/gtest.h>
+#include <csignal>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Progressbar;
+
+namespace {
+
+	/// Swaps stdout for the write end of a pipe until destroyed
+	class stdoutPipe {
+	private:
+		int _read = -1;
+		int _saved = -1;
+
+	public:
+		stdoutPipe() {
+			int fds[2];
+			if (pipe(fds) != 0) throw runtime_error("pipe failed");
+			_read = fds[0];
+
+			fflush(stdout);
+			_saved = dup(STDOUT_FILENO);
+			dup2(fds[1], STDOUT_FILENO);
+			close(fds[1]);
+		}
+
+		~stdoutPipe() {
+			restore();
+			if (_read >= 0) close(_read);
+		}
+
+		/// Closes the read end, so every later write to stdout fails with EPIPE
+		void breakPipe() {
+			close(_read);
+			_read = -1;
+		}
+
+		void restore() {
+			if (_saved < 0) return;
+			dup2(_saved, STDOUT_FILENO);
+			close(_saved);
+			_saved = -1;
+		}
+
+		/// Everything written so far, call after restore() so the read sees the end of the pipe
+		string contents() {
+			string text;
+			char buffer[4096];
+			for (ssize_t received; (received = ::read(_read, buffer, sizeof(buffer))) > 0;) {
+				text.append(buffer, static_cast<size_t>(received));
+			}
+			return text;
+		}
+	};
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(ProgressbarTest, CountsTicksFromEveryThread) {
+
+	stdoutPipe output;
+	{
+		progressDisplay display(progressOptions{ .forceQuiet = true });
+		progressBar& bar = display.addBar("work", 8000);
+
+		vector<thread> workers;
+		for (int t = 0; t < 8; t++) {
+			workers.emplace_back([&] { for (int i = 0; i < 1000; i++) bar.tick(); });
+		}
+		for (auto& worker : workers) worker.join();
+
+		EXPECT_EQ(bar.count(), 8000u);
+		bar.finish();
+	}
+	output.restore();
+
+	const string text = output.contents();
+	EXPECT_NE(text.find("work"), string::npos);
+	EXPECT_NE(text.find("100.0%"), string::npos);
+}
+
+TEST(ProgressbarTest, FailingStdoutStopsRenderingInsteadOfTerminating) {
+
+	// Writes to the broken pipe should fail with EPIPE rather than kill the test
+	auto previous = signal(SIGPIPE, SIG_IGN);
+
+	stdoutPipe output;
+	output.breakPipe();
+	{
+		progressOptions options;
+		options.refreshInterval = milliseconds(1);
+		options.quietInterval = milliseconds(1);
+
+		progressDisplay display(options);
+		progressBar& bar = display.addBar("work", 100);
+
+		// Give the renderer a few frames to hit the failing write
+		for (int i = 0; i < 100; i++) {
+			bar.tick();
+			this_thread::sleep_for(milliseconds(1));
+		}
+		bar.finish();
+	}
+	output.restore();
+
+	signal(SIGPIPE, previous);
+
+	// Getting here at all is the test, an exception escaping the renderer thread calls std::terminate
+	SUCCEED();
+}
\ No newline at end of file
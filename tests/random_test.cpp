@@ -0,0 +1,123 @@
+//===================================================================================================================================
+// @file	random_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for the bulk distributions in UTK::Random, chiefly that the range limits hold at the extremes.
+//===================================================================================================================================
+
+#include "random/utkrandom.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace std;
+using namespace UTK::Random;
+
+namespace {
+
+	/// Engine returning the same word every time, drives the distributions to the ends of their ranges
+	template<uint64_t Word>
+	struct constantEngine {
+		using result_type = uint64_t;
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return numeric_limits<result_type>::max(); }
+		result_type operator()() { return Word; }
+	};
+
+	using allOnes = constantEngine<~uint64_t{ 0 }>;
+	using allZeros = constantEngine<0>;
+
+	template<typename T>
+	void expectWithin(const vector<T>& values, T low, T high) {
+		for (T value : values) {
+			ASSERT_GE(value, low);
+			ASSERT_LT(value, high);
+		}
+	}
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(RandomTest, FloatUniformNeverReturnsHigh) {
+
+	allOnes engine;
+	vector<float> values(1000);
+
+	// Every bit set is the largest unit value, which used to round up to exactly high in float
+	for (auto [low, high] : { pair{ 0.0f, 1.0f }, pair{ -1.0f, 1.0f }, pair{ 0.1f, 0.3f }, pair{ 1e6f, 1e6f + 1.0f } }) {
+		fillUniform(engine, span<float>(values), low, high);
+		expectWithin(values, low, high);
+	}
+}
+
+TEST(RandomTest, DoubleUniformNeverReturnsHigh) {
+
+	allOnes engine;
+	vector<double> values(1000);
+
+	for (auto [low, high] : { pair{ 0.0, 1.0 }, pair{ -1.0, 1.0 }, pair{ 0.1, 0.3 }, pair{ 1e15, 1e15 + 1.0 } }) {
+		fillUniform(engine, span<double>(values), low, high);
+		expectWithin(values, low, high);
+	}
+}
+
+TEST(RandomTest, UniformStartsAtLow) {
+
+	allZeros engine;
+	vector<float> floats(16);
+	vector<double> doubles(16);
+
+	fillUniform(engine, span<float>(floats), -2.5f, 4.0f);
+	fillUniform(engine, span<double>(doubles), -2.5, 4.0);
+
+	EXPECT_TRUE(all_of(floats.begin(), floats.end(), [](float v) { return v == -2.5f; }));
+	EXPECT_TRUE(all_of(doubles.begin(), doubles.end(), [](double v) { return v == -2.5; }));
+}
+
+TEST(RandomTest, UniformCoversTheRangeEvenly) {
+
+	xoshiro256ppx8 engine(42);
+	vector<float> values(1 << 20);
+	fillUniform(engine, span<float>(values), 0.0f, 1.0f);
+
+	expectWithin(values, 0.0f, 1.0f);
+	const double mean = accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+	EXPECT_NEAR(mean, 0.5, 0.002);
+}
+
+TEST(RandomTest, IntegerUniformIsInclusive) {
+
+	pcg32 engine(7);
+	vector<int> values(10000);
+	fillUniform(engine, span<int>(values), -3, 3);
+
+	EXPECT_EQ(*min_element(values.begin(), values.end()), -3);
+	EXPECT_EQ(*max_element(values.begin(), values.end()), 3);
+}
+
+TEST(RandomTest, JumpedStreamsDoNotOverlap) {
+
+	auto streams = makeStreams(xoshiro256pp(1), 4);
+	vector<vector<uint64_t>> outputs;
+	for (auto& stream : streams) {
+		vector<uint64_t> words(1024);
+		fillBits(stream, span<uint64_t>(words));
+		sort(words.begin(), words.end());
+		outputs.push_back(move(words));
+	}
+
+	for (size_t a = 0; a < outputs.size(); a++) {
+		for (size_t b = a + 1; b < outputs.size(); b++) {
+			vector<uint64_t> shared;
+			set_intersection(outputs[a].begin(), outputs[a].end(), outputs[b].begin(), outputs[b].end(), back_inserter(shared));
+			EXPECT_TRUE(shared.empty());
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+//===================================================================================================================================
+// @file	scriptengine_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for the script engine's bytecode cache, chiefly that damaged cache files are recompiled rather than run.
+//
+// @note    Each test works in its own directory under the system temporary directory, removed when the test ends.
+//===================================================================================================================================
+
+#include "scriptengine/utkscriptengine.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+
+using namespace std;
+using namespace UTK::ScriptEngine;
+
+namespace {
+
+	/// Loops, calls and constants, so a cached copy exercises jumps, call indices and the constant table
+	constexpr string_view script = R"(
+		fn triangle(n) {
+			let total = 0
+			while n > 0 { total = total + n  n = n - 1 }
+			return total
+		}
+		return "sum " + str(triangle(100))
+	)";
+
+	/// Fresh cache directory, removed with everything in it when destroyed
+	class cacheDirectory {
+	private:
+		filesystem::path _path;
+
+	public:
+		cacheDirectory() {
+			const auto* test = testing::UnitTest::GetInstance()->current_test_info();
+			_path = filesystem::temp_directory_path() / ("utk_" + string(test->name()) + "_" + to_string(getpid()));
+			filesystem::remove_all(_path);
+		}
+
+		~cacheDirectory() {
+			error_code ec;
+			filesystem::remove_all(_path, ec);
+		}
+
+		const filesystem::path& path() const { return _path; }
+
+		/// The single cache file a compile wrote
+		filesystem::path onlyFile() const {
+			filesystem::path found;
+			for (const auto& entry : filesystem::directory_iterator(_path)) {
+				EXPECT_TRUE(found.empty()) << "more than one cache file";
+				found = entry.path();
+			}
+			return found;
+		}
+	};
+
+	string readAll(const filesystem::path& path) {
+		ifstream file(path, ios::binary);
+		return string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+	}
+
+	void writeAll(const filesystem::path& path, const string& bytes) {
+		ofstream file(path, ios::binary | ios::trunc);
+		file.write(bytes.data(), static_cast<streamsize>(bytes.size()));
+	}
+
+	/// Compiles and runs the script with a fresh engine, returning what it reported about the cache
+	cacheStats runFresh(const filesystem::path& directory) {
+		scriptEngine engine(engineOptions{ .cacheDirectory = directory });
+		EXPECT_EQ(engine.runSource(script), value("sum 5050"));
+		return engine.stats();
+	}
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(ScriptEngineTest, SecondEngineLoadsFromDisk) {
+
+	cacheDirectory cache;
+
+	EXPECT_EQ(runFresh(cache.path()).compiles, 1u);
+
+	const cacheStats second = runFresh(cache.path());
+	EXPECT_EQ(second.diskHits, 1u);
+	EXPECT_EQ(second.compiles, 0u);
+}
+
+TEST(ScriptEngineTest, CorruptedCacheIsRecompiled) {
+
+	cacheDirectory cache;
+	runFresh(cache.path());
+
+	const filesystem::path file = cache.onlyFile();
+	const string original = readAll(file);
+	ASSERT_GT(original.size(), 64u);
+
+	// One flipped bit anywhere past the header, magic and version still match so only the checksum can catch it
+	for (size_t offset = 16; offset < original.size(); offset += original.size() / 16) {
+		string damaged = original;
+		damaged[offset] = static_cast<char>(damaged[offset] ^ 0x01);
+		writeAll(file, damaged);
+
+		const cacheStats stats = runFresh(cache.path());
+		EXPECT_EQ(stats.diskHits, 0u) << "offset " << offset;
+		EXPECT_EQ(stats.compiles, 1u) << "offset " << offset;
+
+		// The recompile replaces the damaged file
+		EXPECT_EQ(readAll(file), original) << "offset " << offset;
+	}
+}
+
+TEST(ScriptEngineTest, TruncatedCacheIsRecompiled) {
+
+	cacheDirectory cache;
+	runFresh(cache.path());
+
+	const filesystem::path file = cache.onlyFile();
+	const string original = readAll(file);
+
+	for (size_t length : { size_t{ 0 }, size_t{ 7 }, size_t{ 16 }, original.size() / 2, original.size() - 1 }) {
+		writeAll(file, original.substr(0, length));
+
+		const cacheStats stats = runFresh(cache.path());
+		EXPECT_EQ(stats.diskHits, 0u) << "length " << length;
+		EXPECT_EQ(stats.compiles, 1u) << "length " << length;
+	}
+}
\ No newline at end of file
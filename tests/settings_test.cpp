@@ -0,0 +1,244 @@
+//===================================================================================================================================
+// @file	settings_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for UTK::Settings: snapshot parsing and getters, reloads that fail, subscriber ordering and
+//			the logger binding's all-or-nothing application.
+//
+// @note    Settings files are written to the temp directory, stores are created without a watcher unless
+//			the test is about watching.
+//===================================================================================================================================
+
+#include "settings/utksettings.hpp"
+#include "dispatchers/utkdispatch.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <stdexcept>
+#include <fstream>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace std;
+using namespace chrono;
+using namespace UTK::Settings;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+
+namespace {
+
+	/// Settings file removed when the test ends
+	class settingsFile {
+	private:
+		filesystem::path _path;
+
+	public:
+		settingsFile(const string& name, const string& json)
+			: _path(filesystem::temp_directory_path() / ("utk_" + name + "_" + to_string(getpid()) + ".json"))
+		{
+			write(json);
+		}
+		~settingsFile() {
+			filesystem::remove(_path);
+		}
+
+		/// Replaces the file the way editors do, through a temporary and a rename
+		void write(const string& json) const {
+			const auto temporary = filesystem::path(_path).concat(".tmp");
+			ofstream(temporary, ios::binary | ios::trunc) << json;
+			filesystem::rename(temporary, _path);
+		}
+
+		const filesystem::path& path() const { return _path; }
+	};
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(SettingsTest, FlattensNestedObjectsIntoDottedKeys) {
+
+	const auto settings = snapshot::parse(R"({
+		"logger": { "terminal": { "capacity": 64, "backpressure": "block" }, "enabled": true },
+		"name": "service",
+		"ports": [ 80, 443 ]
+	})");
+
+	EXPECT_EQ(settings->size(), 5u);
+	EXPECT_EQ(settings->getInt("logger.terminal.capacity"), 64);
+	EXPECT_EQ(settings->getString("logger.terminal.backpressure"), "block");
+	EXPECT_EQ(settings->getBool("logger.enabled"), true);
+	EXPECT_EQ(settings->getString("name"), "service");
+	EXPECT_FALSE(settings->contains("logger"));
+	EXPECT_FALSE(settings->contains("logger.terminal"));
+
+	const auto* ports = settings->getList("ports");
+	ASSERT_NE(ports, nullptr);
+	ASSERT_EQ(ports->size(), 2u);
+	EXPECT_EQ(get<int64_t>((*ports)[1]), 443);
+
+	EXPECT_FALSE(settings->getInt("missing").has_value());
+	EXPECT_EQ(settings->getList("missing"), nullptr);
+}
+
+TEST(SettingsTest, RejectsDottedKeysAndListsOfObjects) {
+
+	EXPECT_THROW(snapshot::parse(R"({ "logger.terminal": 1 })"), runtime_error);
+	EXPECT_THROW(snapshot::parse(R"({ "outer": { "in.ner": 1 } })"), runtime_error);
+	EXPECT_THROW(snapshot::parse(R"({ "": 1 })"), runtime_error);
+	EXPECT_THROW(snapshot::parse(R"({ "sinks": [ { "name": "json" } ] })"), runtime_error);
+	EXPECT_THROW(snapshot::parse(R"({ "grid": [ [ 1, 2 ] ] })"), runtime_error);
+	EXPECT_THROW(snapshot::parse(R"([ 1, 2 ])"), runtime_error);
+	EXPECT_THROW(snapshot::parse(R"({ "open": )"), runtime_error);
+}
+
+TEST(SettingsTest, KeepsIntegersAndDoublesApart) {
+
+	const auto settings = snapshot::parse(R"({ "whole": 3, "fraction": 2.5, "text": "3" })");
+
+	EXPECT_EQ(settings->getInt("whole"), 3);
+	EXPECT_DOUBLE_EQ(*settings->getDouble("whole"), 3.0);
+	EXPECT_DOUBLE_EQ(*settings->getDouble("fraction"), 2.5);
+
+	// No silent truncation of a fraction or conversion of a string
+	EXPECT_THROW(settings->getInt("fraction"), runtime_error);
+	EXPECT_THROW(settings->getInt("text"), runtime_error);
+	EXPECT_THROW(settings->getDouble("text"), runtime_error);
+	EXPECT_THROW(settings->getBool("whole"), runtime_error);
+}
+
+TEST(SettingsTest, FailedReloadKeepsThePreviousSnapshot) {
+
+	settingsFile file("failed_reload", R"({ "value": 1 })");
+	settingsStore store(file.path(), false);
+
+	const uint64_t version = store.current().version();
+	EXPECT_EQ(store.current().getInt("value"), 1);
+
+	file.write(R"({ "value": )");
+	EXPECT_FALSE(store.reload());
+	EXPECT_FALSE(store.lastError().empty());
+	EXPECT_EQ(store.current().version(), version);
+	EXPECT_EQ(store.current().getInt("value"), 1);
+
+	file.write(R"({ "value": 2 })");
+	EXPECT_TRUE(store.reload());
+	EXPECT_TRUE(store.lastError().empty());
+	EXPECT_GT(store.current().version(), version);
+	EXPECT_EQ(store.current().getInt("value"), 2);
+}
+
+TEST(SettingsTest, PinnedSnapshotOutlivesReloads) {
+
+	settingsFile file("pinned", R"({ "value": 1 })");
+	settingsStore store(file.path(), false);
+
+	const auto pinned = store.pin();
+	file.write(R"({ "value": 2 })");
+	ASSERT_TRUE(store.reload());
+
+	EXPECT_EQ(pinned->getInt("value"), 1);
+	EXPECT_EQ(store.current().getInt("value"), 2);
+}
+
+TEST(SettingsTest, SubscribersRunInOrderUntilUnsubscribed) {
+
+	settingsFile file("subscribers", R"({ "value": 1 })");
+	settingsStore store(file.path(), false);
+
+	vector<string> calls;
+	const auto first = store.subscribe([&](const snapshot& s) { calls.push_back("first " + to_string(*s.getInt("value"))); });
+	const auto second = store.subscribe([&](const snapshot& s) { calls.push_back("second " + to_string(*s.getInt("value"))); });
+	EXPECT_NE(first, second);
+
+	file.write(R"({ "value": 2 })");
+	ASSERT_TRUE(store.reload());
+
+	store.unsubscribe(first);
+	file.write(R"({ "value": 3 })");
+	ASSERT_TRUE(store.reload());
+
+	EXPECT_EQ(calls, (vector<string>{ "first 1", "second 1", "first 2", "second 2", "second 3" }));
+
+	// A subscriber whose first call throws is never added
+	EXPECT_THROW(store.subscribe([](const snapshot&) { throw runtime_error("rejected"); }), runtime_error);
+	ASSERT_TRUE(store.reload());
+	EXPECT_TRUE(store.lastError().empty());
+}
+
+TEST(SettingsTest, WatcherReloadsWhenTheFileIsReplaced) {
+
+	settingsFile file("watched", R"({ "value": 1 })");
+	settingsStore store(file.path());
+
+	file.write(R"({ "value": 2 })");
+
+	const auto deadline = steady_clock::now() + seconds(5);
+	while (store.current().getInt("value") != 2 && steady_clock::now() < deadline) {
+		this_thread::sleep_for(milliseconds(5));
+	}
+	EXPECT_EQ(store.current().getInt("value"), 2);
+}
+
+TEST(SettingsTest, AppliesLoggerFilters) {
+
+	logDispatcher dispatcher;
+	const auto settings = snapshot::parse(R"({
+		"logger": { "json": { "operations": [ "LG_ERR", "LG_WR" ], "capacity": 16, "backpressure": "block" } }
+	})");
+
+	applyLoggerSettings(*settings, dispatcher);
+
+	EXPECT_TRUE(dispatcher.isEnabled(Logger::JSON, Operations::LG_ERR));
+	EXPECT_TRUE(dispatcher.isEnabled(Logger::JSON, Operations::LG_WR));
+	EXPECT_FALSE(dispatcher.isEnabled(Logger::JSON, Operations::LG_MSG));
+
+	// Sinks the file does not mention accept every operation
+	EXPECT_TRUE(dispatcher.isEnabled(Logger::CSV, Operations::LG_MSG));
+	EXPECT_TRUE(dispatcher.isEnabled(Logger::TERMINAL, Operations::LG_IDL));
+}
+
+TEST(SettingsTest, BadLoggerSettingsLeaveThePreviousFiltersApplied) {
+
+	settingsFile file("bound", R"({ "logger": { "csv": { "operations": [ "LG_ERR" ] } } })");
+	settingsStore store(file.path(), false);
+	logDispatcher dispatcher;
+
+	const auto id = bindLogger(store, dispatcher);
+	EXPECT_TRUE(dispatcher.isEnabled(Logger::CSV, Operations::LG_ERR));
+	EXPECT_FALSE(dispatcher.isEnabled(Logger::CSV, Operations::LG_MSG));
+
+	// An unknown operation on csv, and a bad policy on json that comes first, must not touch either sink
+	for (const char* bad : {
+		R"({ "logger": { "csv": { "operations": [ "LG_MSG", "LG_NOPE" ] } } })",
+		R"({ "logger": { "json": { "backpressure": "sometimes" }, "csv": { "operations": [ "LG_MSG" ] } } })" }) {
+
+		file.write(bad);
+		EXPECT_TRUE(store.reload());
+		EXPECT_FALSE(store.lastError().empty());
+		EXPECT_TRUE(dispatcher.isEnabled(Logger::CSV, Operations::LG_ERR));
+		EXPECT_FALSE(dispatcher.isEnabled(Logger::CSV, Operations::LG_MSG));
+		EXPECT_TRUE(dispatcher.isEnabled(Logger::JSON, Operations::LG_MSG));
+	}
+
+	file.write(R"({ "logger": { "csv": { "operations": [ "LG_MSG" ] } } })");
+	EXPECT_TRUE(store.reload());
+	EXPECT_TRUE(store.lastError().empty());
+	EXPECT_TRUE(dispatcher.isEnabled(Logger::CSV, Operations::LG_MSG));
+	EXPECT_FALSE(dispatcher.isEnabled(Logger::CSV, Operations::LG_ERR));
+
+	// Unbound, later reloads leave the dispatcher alone
+	store.unsubscribe(id);
+	file.write(R"({ "logger": { "csv": { "operations": [ "LG_ERR" ] } } })");
+	EXPECT_TRUE(store.reload());
+	EXPECT_FALSE(dispatcher.isEnabled(Logger::CSV, Operations::LG_ERR));
+
+	// Binding to settings that are already bad throws and applies nothing
+	file.write(R"({ "logger": { "terminal": { "capacity": 0 } } })");
+	ASSERT_TRUE(store.reload());
+	EXPECT_THROW(bindLogger(store, dispatcher), runtime_error);
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+//===================================================================================================================================
+// @file	trace_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for the span tracer: nested spans recorded on two threads, exported as Chrome trace events and
+//			dispatched as log entries.
+//
+// @note    The exported file has one event per line, so it is read back line by line rather than with a JSON
+//			parser. Dispatched entries are read back through a flight recorder, which resolves interned keys.
+//===================================================================================================================================
+
+#include "trace/utktrace.hpp"
+#include "dispatchers/utkdispatch.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <algorithm>
+#include <fstream>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cmath>
+#include <map>
+#include <unistd.h>
+
+using namespace std;
+using namespace UTK::Trace;
+using namespace UTK::Dispatch;
+using namespace UTK::Types::States;
+
+namespace {
+
+	constexpr int rounds = 50;
+
+	/// A complete("X") event from an exported trace, times in nanoseconds
+	struct exportedEvent {
+		string name;
+		string tid;
+		int64_t ts;
+		int64_t dur;
+	};
+
+	filesystem::path scratchFile(const string& name, const string& extension) {
+		auto path = filesystem::temp_directory_path() / ("utk_" + name + "_" + to_string(getpid()) + extension);
+		filesystem::remove(path);
+		return path;
+	}
+
+	/// Keeps the spans from being empty, so containment is checked on real widths
+	void spin() {
+		volatile uint64_t sink = 0;
+		for (int i = 0; i < 2000; i++) sink = sink + static_cast<uint64_t>(i);
+	}
+
+	/// Two threads, each recording rounds of an outer span around two inner spans
+	void recordNestedSpans() {
+		vector<thread> workers;
+		for (int t = 0; t < 2; t++) {
+			workers.emplace_back([t] {
+				tracer::global().nameThread("trace_test " + to_string(t));
+				for (int i = 0; i < rounds; i++) {
+					UTK_TRACE_SCOPE("outer");
+					spin();
+					{
+						UTK_TRACE_SCOPE("inner");
+						spin();
+					}
+					{
+						UTK_TRACE_SCOPE("inner");
+						spin();
+					}
+				}
+			});
+		}
+		for (auto& worker : workers) worker.join();
+	}
+
+	/// The text of a field's value in one event line, up to the next comma or closing brace
+	string field(const string& line, const string& name) {
+		const string marker = "\"" + name + "\":";
+		const size_t at = line.find(marker);
+		if (at == string::npos) return {};
+
+		const size_t begin = at + marker.size();
+		if (line[begin] == '"') return line.substr(begin + 1, line.find('"', begin + 1) - begin - 1);
+		return line.substr(begin, line.find_first_of(",}", begin) - begin);
+	}
+
+	int64_t microsecondsToNanoseconds(const string& text) {
+		return llround(stod(text) * 1000.0);
+	}
+
+	vector<exportedEvent> completeEvents(const filesystem::path& path) {
+		ifstream file(path);
+		vector<exportedEvent> events;
+		for (string line; getline(file, line);) {
+			if (field(line, "ph") != "X") continue;
+			events.push_back({ field(line, "name"), field(line, "tid"),
+				microsecondsToNanoseconds(field(line, "ts")), microsecondsToNanoseconds(field(line, "dur")) });
+		}
+		return events;
+	}
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(TraceTest, ExportsNestedSpansAsCompleteEvents) {
+
+	if (!UTK_TRACE_ENABLED) GTEST_SKIP() << "UTK_TRACE_SCOPE is compiled out";
+
+	vector<traceSpan> stale;
+	tracer::global().drain(stale);
+	recordNestedSpans();
+
+	const auto path = scratchFile("trace", ".json");
+	ASSERT_EQ(tracer::global().exportChromeTrace(path.string()), static_cast<size_t>(2 * rounds * 3));
+
+	// The file is one JSON document, with named tracks for both threads
+	ifstream file(path);
+	const string text((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+	EXPECT_EQ(text.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+	EXPECT_NE(text.find("\"name\":\"trace_test 0\""), string::npos);
+	EXPECT_NE(text.find("\"name\":\"trace_test 1\""), string::npos);
+
+	const vector<exportedEvent> events = completeEvents(path);
+	ASSERT_EQ(events.size(), static_cast<size_t>(2 * rounds * 3));
+
+	map<string, vector<exportedEvent>> byThread;
+	for (const auto& event : events) {
+		EXPECT_GE(event.dur, 0) << event.name;
+		byThread[event.tid].push_back(event);
+	}
+	ASSERT_EQ(byThread.size(), 2u);
+
+	// Every inner span sits inside exactly one outer span of its own thread
+	for (auto& [tid, spans] : byThread) {
+		vector<exportedEvent> outers, inners;
+		for (const auto& span : spans) (span.name == "outer" ? outers : inners).push_back(span);
+		ASSERT_EQ(outers.size(), static_cast<size_t>(rounds));
+		ASSERT_EQ(inners.size(), static_cast<size_t>(2 * rounds));
+
+		for (const auto& inner : inners) {
+			const auto containing = count_if(outers.begin(), outers.end(), [&](const exportedEvent& outer) {
+				return outer.ts <= inner.ts && inner.ts + inner.dur <= outer.ts + outer.dur;
+			});
+			EXPECT_EQ(containing, 1) << "inner span at " << inner.ts << " on thread " << tid;
+		}
+	}
+
+	filesystem::remove(path);
+}
+
+TEST(TraceTest, DispatchesSpansWithInternedKeys) {
+
+	if (!UTK_TRACE_ENABLED) GTEST_SKIP() << "UTK_TRACE_SCOPE is compiled out";
+
+	vector<traceSpan> stale;
+	tracer::global().drain(stale);
+	recordNestedSpans();
+
+	const auto ring = scratchFile("trace", ".ring");
+	size_t dispatched = 0;
+	{
+		logDispatcher dispatcher;
+		dispatcher.enableFlightRecorder(ring.string(), 1024);
+		dispatched = tracer::global().dispatchTo(dispatcher, Logger::CSV, Operations::LG_IDL);
+	}
+	ASSERT_EQ(dispatched, static_cast<size_t>(2 * rounds * 3));
+
+	// Entries carry ids only, so the names below come back through the global key table
+	for (const char* key : { "span", "thread", "start_ns", "duration_ns" }) {
+		EXPECT_TRUE(keyTable::global().find(key).has_value()) << key;
+	}
+
+	const auto records = flightRecorder::recover(ring.string(), 1024);
+	ASSERT_EQ(records.size(), dispatched);
+
+	size_t outer = 0;
+	for (const auto& record : records) {
+		EXPECT_EQ(record.lg, Logger::CSV);
+		EXPECT_EQ(record.op, Operations::LG_IDL);
+		ASSERT_EQ(record.formatKeys, (vector<string>{ "span", "thread", "start_ns", "duration_ns" }));
+		ASSERT_EQ(record.formatValues.size(), 4u);
+
+		outer += (record.formatValues[0] == "outer") ? 1 : 0;
+		EXPECT_EQ(record.formatValues[1].rfind("trace_test ", 0), 0u);
+		EXPECT_NO_THROW(static_cast<void>(stoll(record.formatValues[2])));
+		EXPECT_GE(stoll(record.formatValues[3]), 0);
+	}
+	EXPECT_EQ(outer, static_cast<size_t>(2 * rounds));
+
+	EXPECT_EQ(tracer::global().dispatchTo(*make_unique<logDispatcher>(), Logger::CSV), 0u);
+	filesystem::remove(ring);
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+//===================================================================================================================================
+// @file	uuid_test.cpp
+// @author	Jac Jenkins
+// @date	18/10/2026
+//
+// @brief   Tests for the UUID generators, including that a forked child does not repeat its parent's values.
+//===================================================================================================================================
+
+#include "uuid/utkuuid.hpp"
+#include <gtest/gtest.h>
+#include <unordered_set>
+#include <algorithm>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace UTK::UUID;
+
+namespace {
+
+	constexpr size_t batch = 64;
+
+	/// The next batch of v4 and v7 values from the calling thread
+	vector<uuid> nextValues() {
+		vector<uuid> ids(batch * 2);
+		generateV4(span<uuid>(ids).first(batch));
+		generateV7(span<uuid>(ids).last(batch));
+		return ids;
+	}
+}
+
+//===================================================================================================================================
+//															 TESTS
+//===================================================================================================================================
+
+TEST(UuidTest, VersionAndVariantBits) {
+
+	for (int i = 0; i < 1000; i++) {
+		const uuid v4 = generateV4();
+		const uuid v7 = generateV7();
+
+		EXPECT_EQ(v4.version(), 4u);
+		EXPECT_EQ(v7.version(), 7u);
+		EXPECT_EQ(v4.bytes[8] & 0xC0, 0x80);
+		EXPECT_EQ(v7.bytes[8] & 0xC0, 0x80);
+	}
+}
+
+TEST(UuidTest, V7IsStrictlyIncreasingWithinAThread) {
+
+	vector<uuid> ids(100000);
+	generateV7(ids);
+
+	EXPECT_TRUE(adjacent_find(ids.begin(), ids.end(), greater_equal<uuid>()) == ids.end());
+}
+
+TEST(UuidTest, FormatAndParseRoundTrip) {
+
+	const uuid id = generateV4();
+	const string text = toString(id);
+
+	ASSERT_EQ(text.size(), textLength);
+	EXPECT_EQ(parse(text), id);
+
+	string upper = text;
+	transform(upper.begin(), upper.end(), upper.begin(), [](char c) { return static_cast<char>(toupper(c)); });
+	EXPECT_EQ(parse(upper), id);
+
+	EXPECT_FALSE(parse(text.substr(1)).has_value());
+	EXPECT_FALSE(parse("0123456789abcdef0123456789abcdef0123").has_value());
+}
+
+TEST(UuidTest, ForkedChildDoesNotRepeatParent) {
+
+	// Seed this thread first, the child inherits the state as it is at the fork
+	generateV4();
+	generateV7();
+
+	int channel[2];
+	ASSERT_EQ(pipe(channel), 0);
+
+	pid_t child = fork();
+	if (child == 0) {
+		const vector<uuid> ids = nextValues();
+		const auto size = static_cast<ssize_t>(ids.size() * sizeof(uuid));
+		_exit(::write(channel[1], ids.data(), static_cast<size_t>(size)) == size ? 0 : 1);
+	}
+
+	const vector<uuid> parent = nextValues();
+
+	vector<uuid> forked(batch * 2);
+	const auto expected = static_cast<ssize_t>(forked.size() * sizeof(uuid));
+	ssize_t received = 0;
+	while (received < expected) {
+		ssize_t chunk = ::read(channel[0], reinterpret_cast<char*>(forked.data()) + received, static_cast<size_t>(expected - received));
+		if (chunk <= 0) break;
+		received += chunk;
+	}
+
+	int status = 0;
+	waitpid(child, &status, 0);
+	close(channel[0]);
+	close(channel[1]);
+
+	ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+	ASSERT_EQ(received, expected);
+
+	unordered_set<uuid> seen(parent.begin(), parent.end());
+	for (const uuid& id : forked) {
+		EXPECT_FALSE(seen.contains(id)) << toString(id);
+	}
+}
\ No newline at end of file